@@ -275,6 +275,20 @@ public:
     void queryByFeature(const Feature& feature, const Size& feature_index, const String& ion_mode, std::vector<AccurateMassSearchResult>& results) const;
     void queryByConsensusFeature(const ConsensusFeature& cfeat, const Size& cf_index, const Size& number_of_maps, const String& ion_mode, std::vector<AccurateMassSearchResult>& results) const;
 
+    /**
+      @brief search all features of @p fmap (see queryByFeature()) in parallel
+
+      Features are processed in order of increasing m/z. @p results[i] holds the hits of feature @em i.
+    */
+    void queryByFeatures(const FeatureMap& fmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult> >& results) const;
+
+    /**
+      @brief search all consensus features of @p cmap (see queryByConsensusFeature()) in parallel
+
+      Consensus features are processed in order of increasing m/z. @p results[i] holds the hits of consensus feature @em i.
+    */
+    void queryByConsensusFeatures(const ConsensusMap& cmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult> >& results) const;
+
     /// main method of AccurateMassSearchEngine
     /// input map is not const, since it will get annotated with results
     void run(FeatureMap&, MzTab&) const;
@@ -342,6 +356,16 @@ private:
     void parseAdductsFile_(const String& filename, std::vector<AdductInfo>& result);
     void searchMass_(double neutral_query_mass, double diff_mass, std::pair<Size, Size>& hit_indices) const;
 
+    /// parse the formulas of all DB entries once and record which adducts each entry is compatible with (see AdductInfo::isCompatible())
+    void computeAdductCompatibility_();
+
+    /// bit mask lookup of AdductInfo::isCompatible() for DB entry @p entry_index and adduct @p adduct_index of @p adducts
+    bool isCompatible_(const std::vector<UInt64>& compatibility, Size adduct_count, Size entry_index, Size adduct_index) const
+    {
+      const Size words = (adduct_count + 63) / 64;
+      return (compatibility[entry_index * words + adduct_index / 64] >> (adduct_index % 64)) & 1;
+    }
+
     /// add search results to a Consensus/Feature
     void annotate_(const std::vector<AccurateMassSearchResult>&, BaseFeature&) const;
 
@@ -406,6 +430,13 @@ private:
     std::vector<AdductInfo> pos_adducts_;
     std::vector<AdductInfo> neg_adducts_;
 
+    /// adduct compatibility bit masks (one block of ceil(#adducts/64) words per DB entry in mass_mappings_)
+    std::vector<UInt64> pos_adduct_compatibility_;
+    std::vector<UInt64> neg_adduct_compatibility_;
+
+    /// DB entries whose formula could not be parsed (reported when the entry is hit)
+    std::vector<bool> formula_parse_failed_;
+
     String database_name_;
     String database_version_;
 
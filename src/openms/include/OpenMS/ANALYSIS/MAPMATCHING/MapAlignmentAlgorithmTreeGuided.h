@@ -85,6 +85,8 @@ public:
      * @param feature_maps Vector of input maps (FeatureMap) whose distance is to be calculated.
      * @param tree Vector of BinaryTreeNodes that will be computed
      * @param maps_ranges Vector to store all sorted RTs of extracted identifications for each map in @p feature_maps; needed to determine the 10/90 percentiles
+     *
+     * @exception Exception::IllegalArgument is thrown if @p feature_maps is empty
     */
     static void buildTree(std::vector<FeatureMap>& feature_maps, std::vector<BinaryTreeNode>& tree, std::vector<std::vector<double>>& maps_ranges);
 
@@ -96,6 +98,8 @@ public:
      * @param maps_ranges Vector that contains all sorted RTs of extracted identifications for each map; needed to determine the 10/90 percentiles.
      * @param map_transformed FeatureMap to store all features of combined maps with original and transformed RTs in order of alignment.
      * @param trafo_order Vector to store indices of maps in order of alignment.
+     *
+     * @exception Exception::IllegalArgument is thrown if @p feature_maps_transformed is empty
     */
     void treeGuidedAlignment(const std::vector<BinaryTreeNode>& tree, std::vector<FeatureMap>& feature_maps_transformed,
                              std::vector<std::vector<double>>& maps_ranges, FeatureMap& map_transformed,
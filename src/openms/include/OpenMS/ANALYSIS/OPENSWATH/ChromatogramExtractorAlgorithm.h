@@ -98,6 +98,12 @@ public:
      * @param ppm Whether mz_extraction_window is in ppm or in Th
      * @param filter Which function to apply in m/z space (currently "tophat" only)
      *
+     * The spectra are processed in a sweep over RT: for each spectrum, only
+     * the coordinates whose RT window contains the spectrum are extracted.
+     * Blocks of consecutive spectra are processed in parallel (using a
+     * lightClone() of @p input per thread) and the output is identical to a
+     * sequential extraction.
+     *
     */
     void extractChromatograms(const OpenSwath::SpectrumAccessPtr input,
         std::vector< OpenSwath::ChromatogramPtr >& output,
@@ -184,6 +190,34 @@ private:
 
     int getFilterNr_(const String& filter);
 
+    /// Intensities extracted from a block of consecutive spectra
+    struct ExtractionBlock_
+    {
+      /// Extracted intensities as (coordinate index, intensity), grouped by spectrum
+      std::vector<std::pair<Size, double> > hits;
+      /// Per spectrum: RT and end of its intensities in @p hits
+      std::vector<std::pair<double, Size> > scans;
+    };
+
+    /**
+     * @brief Extract the active coordinates from the spectra [scan_start, scan_end)
+     *
+     * @param always_active Coordinates without RT window (sorted by index)
+     * @param by_rt_start Coordinates with RT window (sorted by rt_start)
+     * @param block The result
+    */
+    void extractBlock_(const OpenSwath::SpectrumAccessPtr& input,
+                       Size scan_start,
+                       Size scan_end,
+                       const std::vector<ExtractionCoordinates>& extraction_coordinates,
+                       const std::vector<Size>& always_active,
+                       const std::vector<Size>& by_rt_start,
+                       double mz_extraction_window,
+                       bool ppm,
+                       double im_extraction_window,
+                       int used_filter,
+                       ExtractionBlock_& block);
+
   };
 
 }
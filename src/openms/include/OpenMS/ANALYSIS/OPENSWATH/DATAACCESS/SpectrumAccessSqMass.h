@@ -52,12 +52,13 @@ namespace OpenMS
    * @brief An implementation of the Spectrum Access interface using SQL files
    *
    * The interface takes an MzMLSqliteHandler object to access spectra and
-   * chromatograms from a sqlite file (sqMass). Currently access to individual
-   * spectra and chromatograms are not supported due to large overhead of
-   * opening a DB connection and performing a single query.
+   * chromatograms from a sqlite file (sqMass). Access to individual spectra
+   * is slow due to the large overhead of opening a DB connection and
+   * performing a single query for each of them.
    *
    * Instead, the users should use getAllSpectra which returns all available
-   * spectra together.
+   * spectra together or getSpectraById which returns a given set of spectra
+   * from a single query.
    *
    * The interface allows to be constructed in a way as to only provide access
    * to a subset of spectra / chromatograms by supplying a set of indices which
@@ -114,6 +115,22 @@ public:
     /// Load all spectra from the underlying sqMass file into memory
     void getAllSpectra(std::vector< OpenSwath::SpectrumPtr > & spectra, std::vector< OpenSwath::SpectrumMeta > & spectra_meta) const;
 
+    /**
+      @brief Load a set of spectra from the underlying sqMass file into memory
+
+      All spectra are read in a single query and their data is decoded in
+      parallel, which is much faster than calling getSpectrumById repeatedly.
+      The results are returned in the order of @p ids (which may contain
+      duplicates).
+
+      @param ids Spectra to load (indices into this interface, see getNrSpectra)
+      @param spectra The loaded spectra
+      @param spectra_meta The meta data of the loaded spectra
+
+      @throw Exception::IllegalArgument if an id is out of range
+    */
+    void getSpectraById(const std::vector<int> & ids, std::vector< OpenSwath::SpectrumPtr > & spectra, std::vector< OpenSwath::SpectrumMeta > & spectra_meta) const;
+
     std::vector<std::size_t> getSpectraByRT(double /* RT */, double /* deltaRT */) const override;
 
     size_t getNrSpectra() const override;
@@ -315,6 +315,9 @@ private:
     // data
     OpenSwath::SpectrumAccessPtr ms1_map_;
 
+    /// Summed spectra shared by the scoring objects of all peak groups (the object is used by a single thread)
+    OpenSwathScoring::SpectrumCachePtr spectrum_cache_;
+
   };
 }
 
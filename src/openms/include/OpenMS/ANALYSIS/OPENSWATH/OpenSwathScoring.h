@@ -45,6 +45,8 @@
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathScores.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DIAScoring.h>
 
+#include <list>
+#include <map>
 #include <vector>
 #include <boost/shared_ptr.hpp>
 #include <boost/make_shared.hpp>
@@ -70,6 +72,81 @@ namespace OpenMS
 
   public:
 
+    /** @brief Least-recently-used cache for added-up (summed) spectra
+     *
+     * Scoring a single peak group fetches the spectrum around the same
+     * retention time several times (plain, drift-filtered and MS1 variants)
+     * and neighbouring peak groups frequently snap to the same spectra. The
+     * cache stores the result of getAddedSpectra_ keyed by the map, the set
+     * of spectrum indices used, the drift range and the addition settings.
+     *
+     * Each entry keeps a reference to its map so that the map address used
+     * in the key cannot be reused while the entry is alive. Cached spectra
+     * are shared and must not be modified by the caller.
+     *
+     * @note The cache is not thread-safe, use one cache per scoring thread.
+    */
+    class OPENMS_DLLAPI SpectrumCache
+    {
+    public:
+
+      /// Constructor (a capacity of zero disables caching)
+      explicit SpectrumCache(Size capacity = 32);
+
+      /// Returns the cached spectrum for @p key (and marks it as most recently used) or an empty pointer
+      OpenSwath::SpectrumPtr get(const OpenSwath::SpectrumAccessPtr& map,
+                                 const std::vector<std::size_t>& indices,
+                                 double drift_lower,
+                                 double drift_upper,
+                                 bool resample,
+                                 double spacing);
+
+      /// Stores @p spectrum, evicting the least recently used entry if full
+      void put(const OpenSwath::SpectrumAccessPtr& map,
+               const std::vector<std::size_t>& indices,
+               double drift_lower,
+               double drift_upper,
+               bool resample,
+               double spacing,
+               const OpenSwath::SpectrumPtr& spectrum);
+
+      /// Removes all entries
+      void clear();
+
+      /// Number of cached spectra
+      Size size() const;
+
+      /// Maximal number of cached spectra
+      Size getCapacity() const;
+
+    private:
+
+      struct Key
+      {
+        const OpenSwath::ISpectrumAccess* map;
+        std::vector<std::size_t> indices;
+        double drift_lower;
+        double drift_upper;
+        bool resample;
+        double spacing;
+
+        bool operator<(const Key& rhs) const;
+      };
+
+      struct Entry
+      {
+        Key key;
+        OpenSwath::SpectrumAccessPtr map; ///< keeps the map (and thus the key address) alive
+        OpenSwath::SpectrumPtr spectrum;
+      };
+
+      Size capacity_;
+      std::list<Entry> entries_; ///< most recently used first
+      std::map<Key, std::list<Entry>::iterator> lookup_;
+    };
+
+    typedef boost::shared_ptr<SpectrumCache> SpectrumCachePtr;
+
     /// Constructor
     OpenSwathScoring();
 
@@ -94,6 +171,19 @@ namespace OpenMS
                     const OpenSwath_Scores_Usage & su,
                     const std::string& spectrum_addition_method);
 
+    /** @brief Sets the cache used for added-up spectra
+     *
+     * By default, every scoring object has its own cache. Scoring objects
+     * that are created per peak group may share a longer-lived cache to reuse
+     * spectra across neighbouring peak groups, as long as all of them are used
+     * from the same thread. Passing an empty pointer disables caching.
+     *
+    */
+    void setSpectrumCache(const SpectrumCachePtr& cache);
+
+    /// Returns the cache used for added-up spectra (may be empty)
+    const SpectrumCachePtr& getSpectrumCache() const;
+
     /** @brief Score a single peakgroup in a chromatogram using only chromatographic properties.
      *
      * This function only uses the chromatographic properties (coelution,
@@ -262,7 +352,7 @@ namespace OpenMS
      * @return Added up spectrum
      *
     */
-    OpenSwath::SpectrumPtr fetchSpectrumSwath(std::vector<OpenSwath::SwathMap> swath_maps,
+    OpenSwath::SpectrumPtr fetchSpectrumSwath(const std::vector<OpenSwath::SwathMap>& swath_maps,
                                               double RT,
                                               int nr_spectra_to_add,
                                               const double drift_lower,
@@ -311,6 +401,9 @@ namespace OpenMS
                                             const double drift_lower,
                                             const double drift_upper);
 
+    /// Cache for results of getAddedSpectra_
+    SpectrumCachePtr spectrum_cache_;
+
   };
 }
 
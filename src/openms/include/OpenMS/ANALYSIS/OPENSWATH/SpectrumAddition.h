@@ -55,12 +55,22 @@ namespace OpenMS
 public:
 
     /// adds up a list of Spectra by resampling them and then addition of intensities
-    static OpenSwath::SpectrumPtr addUpSpectra(const std::vector<OpenSwath::SpectrumPtr> all_spectra,
+    static OpenSwath::SpectrumPtr addUpSpectra(const std::vector<OpenSwath::SpectrumPtr>& all_spectra,
                                                double sampling_rate,
                                                bool filter_zeros);
 
     /// adds up a list of Spectra by resampling them and then addition of intensities
-    static OpenMS::MSSpectrum addUpSpectra(const std::vector< OpenMS::MSSpectrum> all_spectra,
+    static OpenMS::MSSpectrum addUpSpectra(const std::vector<OpenMS::MSSpectrum>& all_spectra,
+                                           double sampling_rate,
+                                           bool filter_zeros);
+
+    /**
+      @brief adds up a list of Spectra by resampling them and then addition of intensities
+
+      Same as above, but takes ownership of the input: a single input spectrum
+      is moved into the result instead of being copied.
+    */
+    static OpenMS::MSSpectrum addUpSpectra(std::vector<OpenMS::MSSpectrum>&& all_spectra,
                                            double sampling_rate,
                                            bool filter_zeros);
 
@@ -95,8 +95,11 @@ namespace OpenMS
       /**
        * @brief Enumerates precursor masses for all candidates in an XL-MS search
 
-          Assumes the list of peptides and the list of spectrum precursor masses are sorted by mass in ascending order,
-          and the list of mono-link masses is sorted in descending order.
+          Assumes the list of peptides is sorted by mass in ascending order. For each spectrum precursor mass the matching
+          peptides are found by binary search, and the partner windows of cross-linked pairs are tracked with two pointers.
+          The candidates only store the indices of their peptides in @p peptides.
+          The work for each precursor is distributed over the available threads, and the per-thread results are concatenated
+          in a fixed order at the end.
 
        * @param peptides The peptides with precomputed masses from the digestDatabase function
        * @param cross_link_mass_light Mass of the cross-linker, only the light one if a labeled linker is used
@@ -292,8 +295,10 @@ namespace OpenMS
        * @brief Filters the list of candidates for cases that include at least one of the tags in at least one of the two sequences
 
        * @param candidates The list of XLPrecursors as enumerated by e.g. enumerateCrossLinksAndMasses
+       * @param precursor_correction_positions The precursor correction positions of the candidates, filtered alongside them
+       * @param peptide_masses The peptides the indices in @p candidates refer to
        * @param tags The list of tags for the current spectrum produced by the Tagger
        */
-      static void filterPrecursorsByTags(std::vector <OPXLDataStructs::XLPrecursor>& candidates, std::vector< int >& precursor_correction_positions, const std::vector<std::string>& tags);
+      static void filterPrecursorsByTags(std::vector <OPXLDataStructs::XLPrecursor>& candidates, std::vector< int >& precursor_correction_positions, const std::vector<OPXLDataStructs::AASeqWithMass>& peptide_masses, const std::vector<std::string>& tags);
   };
 }
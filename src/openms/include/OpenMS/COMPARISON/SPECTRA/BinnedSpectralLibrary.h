@@ -0,0 +1,211 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+//
+
+#pragma once
+
+#include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrum.h>
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <Eigen/Sparse>
+
+#include <utility>
+#include <vector>
+
+namespace OpenMS
+{
+
+  /**
+    @brief A spectral library binned into a single sparse matrix for batched similarity search
+
+    All library spectra are binned with the same layout as BinnedSpectrum (bin size, unit, spread and offset)
+    and stored as the rows of one compressed sparse row (CSR) matrix. Rows are sorted by precursor m/z, so the
+    library spectra that pass a precursor filter form a contiguous block of rows (see getPrecursorRange()).
+
+    Query spectra are scored by the cosine of the spectral contrast angle (see BinnedSpectralContrastAngle).
+    Instead of comparing one query/library pair at a time, scoreBatch() groups queries with neighboring
+    precursor windows into blocks and scores each block with a single sparse matrix product of the
+    corresponding library rows and the binned queries. Blocks are processed in parallel.
+
+    The binned library can be written to and read from a binary file with store() and load(), so it does not
+    need to be rebuilt from the original library (e.g. MSP) each run. Each row carries a free text identifier
+    (e.g. the annotated peptide sequence) that is persisted alongside the binned intensities. A source fingerprint
+    (see setSourceFingerprint()) is stored as well, so a cache file that is out of date with respect to its source
+    can be detected and rebuilt.
+
+    @ingroup SpectraComparison
+  */
+  class OPENMS_DLLAPI BinnedSpectralLibrary :
+    public ProgressLogger
+  {
+public:
+    /// row-major (CSR) sparse matrix holding one binned library spectrum per row
+    using SparseMatrixType = Eigen::SparseMatrix<float, Eigen::RowMajor>;
+
+    /// half-open range [first, second) of library rows
+    using RowRange = std::pair<Size, Size>;
+
+    /// default constructor (uses the high-resolution defaults of BinnedSpectrum)
+    BinnedSpectralLibrary();
+
+    /// detailed constructor, arguments are forwarded to BinnedSpectrum
+    BinnedSpectralLibrary(float bin_size, bool unit_ppm, UInt spread, float offset);
+
+    /// destructor
+    virtual ~BinnedSpectralLibrary();
+
+    /**
+      @brief Bins @p spectra and builds the library matrix
+
+      Every spectrum needs a precursor. Rows are sorted by the m/z of the first precursor (stable with respect to
+      the input order). Previous content is discarded.
+
+      @param spectra Library spectra (need to be sorted by m/z)
+      @param identifiers One identifier per spectrum, stored with the row
+      @exception Exception::IllegalArgument is thrown if the number of identifiers does not match or a spectrum has no precursor
+    */
+    void build(const std::vector<PeakSpectrum>& spectra, const std::vector<String>& identifiers);
+
+    /// bins a query spectrum with the layout of this library
+    BinnedSpectrum binSpectrum(const PeakSpectrum& spectrum) const;
+
+    /// returns the rows whose precursor m/z lies in [@p mz_low, @p mz_high]
+    RowRange getPrecursorRange(double mz_low, double mz_high) const;
+
+    /**
+      @brief Scores a single query against the library rows in @p range
+
+      @p scores is resized to the size of @p range. Rows or queries without any intensity score zero.
+    */
+    void score(const BinnedSpectrum& query, const RowRange& range, std::vector<double>& scores) const;
+
+    /**
+      @brief Scores many queries, each against its own range of library rows
+
+      Queries are sorted by their range, grouped into blocks of at most @p block_size queries and each block is
+      scored with a single sparse matrix product. The result for query @em i is written to @p scores[i] and
+      corresponds to the rows in @p ranges[i] (same layout as for score()).
+
+      @exception Exception::IllegalArgument is thrown if the sizes of @p queries and @p ranges differ
+    */
+    void scoreBatch(const std::vector<BinnedSpectrum>& queries,
+                    const std::vector<RowRange>& ranges,
+                    std::vector<std::vector<double> >& scores,
+                    Size block_size = 64) const;
+
+    /**
+      @brief Writes the binned library to a binary file
+
+      @exception Exception::UnableToCreateFile is thrown if the file cannot be written
+    */
+    void store(const String& filename) const;
+
+    /**
+      @brief Reads a binned library written by store()
+
+      @exception Exception::FileNotFound is thrown if the file does not exist
+      @exception Exception::ParseError is thrown if the file is not a binned library or is truncated
+    */
+    void load(const String& filename);
+
+    /// number of library spectra
+    Size size() const;
+
+    /// returns true if the library holds no spectra
+    bool empty() const;
+
+    /// the library matrix (one row per spectrum, sorted by precursor m/z)
+    const SparseMatrixType& getMatrix() const;
+
+    /// precursor m/z of each row
+    const std::vector<double>& getPrecursorMZs() const;
+
+    /// precursor charge of each row
+    const std::vector<Int>& getPrecursorCharges() const;
+
+    /// retention time of each row
+    const std::vector<double>& getRTs() const;
+
+    /// identifier of each row
+    const std::vector<String>& getIdentifiers() const;
+
+    /// position of each row in the input of build() (empty after load())
+    const std::vector<Size>& getInputIndices() const;
+
+    /**
+      @brief Sets a free text description of the source the library was built from
+
+      E.g. file name, size and modification time of the original library and the preprocessing parameters.
+      It is stored and loaded with the library, but not changed by build().
+    */
+    void setSourceFingerprint(const String& fingerprint);
+
+    /// returns the source fingerprint (see setSourceFingerprint())
+    const String& getSourceFingerprint() const;
+
+    /// @name Bin layout
+    //@{
+    float getBinSize() const;
+    bool isUnitPPM() const;
+    UInt getBinSpread() const;
+    float getOffset() const;
+    //@}
+
+protected:
+    /// scores the queries in @p block (indices into @p queries) with one matrix product
+    void scoreBlock_(const std::vector<BinnedSpectrum>& queries,
+                     const std::vector<RowRange>& ranges,
+                     const std::vector<Size>& block,
+                     std::vector<std::vector<double> >& scores) const;
+
+    /// computes the Euclidean norm of each row
+    void updateRowNorms_();
+
+    float bin_size_;
+    bool unit_ppm_;
+    UInt bin_spread_;
+    float offset_;
+
+    SparseMatrixType matrix_;
+    std::vector<double> row_norms_;
+    std::vector<double> precursor_mz_;
+    std::vector<Int> precursor_charge_;
+    std::vector<double> rt_;
+    std::vector<String> identifiers_;
+    std::vector<Size> input_index_;
+    String source_fingerprint_;
+  };
+
+}
@@ -5,6 +5,7 @@ set(directory include/OpenMS/COMPARISON/SPECTRA)
 set(sources_list_h
 BinnedSharedPeakCount.h
 BinnedSpectralContrastAngle.h
+BinnedSpectralLibrary.h
 BinnedSpectrum.h
 BinnedSpectrumCompareFunctor.h
 BinnedSumAgreeingIntensities.h
@@ -37,6 +37,8 @@
 #include <OpenMS/CONCEPT/Types.h>
 
 #include <map>
+#include <string>
+#include <vector>
 
 namespace OpenMS
 {
@@ -49,6 +51,10 @@ namespace OpenMS
 
     Use startProgress, setProgress and endProgress for the actual logging.
 
+    If the Profiler is enabled, each startProgress/endProgress pair is recorded as a
+    profiler region (category "progress") named after the label, together with a memory probe.
+    A region is only recorded if the Profiler was already enabled when it was started.
+
     @note All methods are const, so it can be used through a const reference or in const methods as well!
   */
   class OPENMS_DLLAPI ProgressLogger
@@ -130,6 +136,21 @@ protected:
 
     mutable ProgressLoggerImpl* current_logger_;
 
+    /// A profiler region opened by startProgress
+    struct ProfileRegion_
+    {
+      std::string label;
+      double start_us;
+      /// value of @p progress_depth_ before the region was started
+      Size depth;
+    };
+
+    /// number of startProgress calls of this logger not yet ended
+    mutable Size progress_depth_;
+
+    /// open profiler regions (only pushed while the profiler is enabled)
+    mutable std::vector<ProfileRegion_> profile_regions_;
+
   };
 
 } // namespace OpenMS
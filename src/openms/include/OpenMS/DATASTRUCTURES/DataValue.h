@@ -51,6 +51,10 @@ namespace OpenMS
     - Automatic conversion is supported and throws Exceptions in case of invalid conversions.
     - An empty object is created with the default constructor.
 
+    String values are immutable once stored and are shared (reference counted)
+    between copies of a DataValue, so copying meta data that carries string
+    annotations does not allocate.
+
     @ingroup Datastructures
   */
   class OPENMS_DLLAPI DataValue
@@ -432,12 +436,15 @@ protected:
     /// The unit of the data value (if it has one) using UO identifier, otherwise -1.
     int32_t unit_;
 
+    /// Reference counted, immutable string payload (shared between copies)
+    struct SharedString_;
+
     /// Space to store the data
     union
     {
       SignedSize ssize_;
       double dou_;
-      String* str_;
+      SharedString_* str_;
       StringList* str_list_;
       IntList* int_list_;
       DoubleList* dou_list_;
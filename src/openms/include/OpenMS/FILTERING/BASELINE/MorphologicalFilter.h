@@ -34,6 +34,7 @@
 
 #pragma once
 
+#include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/DATASTRUCTURES/DefaultParamHandler.h>
 #include <OpenMS/DATASTRUCTURES/ListUtils.h>
@@ -199,10 +200,6 @@ public:
     template <typename InputIterator, typename OutputIterator>
     void filterRange(InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
     {
-      // the buffer is static only to avoid reallocation
-      static std::vector<typename InputIterator::value_type> buffer;
-      const UInt size = input_end - input_begin;
-
       //determine the struct size in data points if not already set
       if (struct_size_in_datapoints_ == 0)
       {
@@ -210,60 +207,7 @@ public:
       }
 
       //apply the filtering
-      String method = param_.getValue("method");
-      if (method == "identity")
-      {
-        std::copy(input_begin, input_end, output_begin);
-      }
-      else if (method == "erosion")
-      {
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "dilation")
-      {
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "opening")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-      }
-      else if (method == "closing")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyErosion_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-      }
-      else if (method == "gradient")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-        for (UInt i = 0; i < size; ++i) output_begin[i] -= buffer[i];
-      }
-      else if (method == "tophat")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyErosion_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyDilation_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
-      }
-      else if (method == "bothat")
-      {
-        if (buffer.size() < size) buffer.resize(size);
-        applyDilation_(struct_size_in_datapoints_, input_begin, input_end, buffer.begin());
-        applyErosion_(struct_size_in_datapoints_, buffer.begin(), buffer.begin() + size, output_begin);
-        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
-      }
-      else if (method == "erosion_simple")
-      {
-        applyErosionSimple_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
-      else if (method == "dilation_simple")
-      {
-        applyDilationSimple_(struct_size_in_datapoints_, input_begin, input_end, output_begin);
-      }
+      applyMethod_(struct_size_in_datapoints_, param_.getValue("method"), input_begin, input_end, output_begin);
 
       struct_size_in_datapoints_ = 0;
     }
@@ -281,6 +225,8 @@ public:
                 from struc_size and the average spacing, and rounded up to an odd
                 number.
         </ul>
+
+        @exception Exception::IllegalArgument The given method is not one of the values defined in the @em method parameter.
     */
     void filter(MSSpectrum & spectrum)
     {
@@ -291,25 +237,28 @@ public:
       if (spectrum.size() <= 1) { return; }
 
       //Determine structuring element size in datapoints (depending on the unit)
+      UInt struc_size = 0;
       if ((String)(param_.getValue("struc_elem_unit")) == "Thomson")
       {
         const double struc_elem_length = (double)param_.getValue("struc_elem_length");
         const double mz_diff = spectrum.back().getMZ() - spectrum.begin()->getMZ();        
-        struct_size_in_datapoints_ = (UInt)(ceil(struc_elem_length*(double)(spectrum.size() - 1)/mz_diff));
+        struc_size = (UInt)(ceil(struc_elem_length*(double)(spectrum.size() - 1)/mz_diff));
       }
       else
       {
-        struct_size_in_datapoints_ = (UInt)(double)param_.getValue("struc_elem_length");
+        struc_size = (UInt)(double)param_.getValue("struc_elem_length");
       }
       //make it odd (needed for the algorithm)
-      if (!Math::isOdd(struct_size_in_datapoints_)) ++struct_size_in_datapoints_;
+      if (!Math::isOdd(struc_size)) ++struc_size;
 
-      //apply the filtering and overwrite the input data
+      //apply the filtering on a contiguous copy of the intensities and overwrite the input data
+      std::vector<Peak1D::IntensityType> input(spectrum.size());
+      for (Size i = 0; i < spectrum.size(); ++i)
+      {
+        input[i] = spectrum[i].getIntensity();
+      }
       std::vector<Peak1D::IntensityType> output(spectrum.size());
-      filterRange(Internal::intensityIteratorWrapper(spectrum.begin()),
-                  Internal::intensityIteratorWrapper(spectrum.end()),
-                  output.begin()
-                  );
+      applyMethod_(struc_size, param_.getValue("method"), input.begin(), input.end(), output.begin());
 
       //overwrite output with data
       for (Size i = 0; i < spectrum.size(); ++i)
@@ -322,37 +271,102 @@ public:
         @brief Applies the morphological filtering operation to an MSExperiment.
 
         The size of the structuring element is computed for each spectrum individually, if it is given in 'Thomson'.
-        See the filtering method for MSSpectrum for details.
+        See the filtering method for MSSpectrum for details. The spectra are filtered in parallel.
+
+        @exception Exception::IllegalArgument The given method is not one of the values defined in the @em method parameter.
     */
-    void filterExperiment(PeakMap & exp)
-    {
-      startProgress(0, exp.size(), "filtering baseline");
-      for (UInt i = 0; i < exp.size(); ++i)
-      {
-        filter(exp[i]);
-        setProgress(i);
-      }
-      endProgress();
-    }
+    void filterExperiment(PeakMap & exp);
 
 protected:
 
     ///Member for struct size in data points
     UInt struct_size_in_datapoints_;
 
+    /**
+      @brief Applies the morphological operation @p method with a structuring element of @p struc_size data points.
+
+      Does not modify any members, so it can be called concurrently.
+
+      @exception Exception::IllegalArgument The given method is not one of the values defined in the @em method parameter.
+    */
+    template <typename InputIterator, typename OutputIterator>
+    void applyMethod_(UInt struc_size, const String& method, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin) const
+    {
+      typedef typename std::iterator_traits<InputIterator>::value_type ValueType;
+      const UInt size = input_end - input_begin;
+      std::vector<ValueType> buffer;
+
+      if (method == "identity")
+      {
+        std::copy(input_begin, input_end, output_begin);
+      }
+      else if (method == "erosion")
+      {
+        applyErosion_(struc_size, input_begin, input_end, output_begin);
+      }
+      else if (method == "dilation")
+      {
+        applyDilation_(struc_size, input_begin, input_end, output_begin);
+      }
+      else if (method == "opening")
+      {
+        buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
+      }
+      else if (method == "closing")
+      {
+        buffer.resize(size);
+        applyDilation_(struc_size, input_begin, input_end, buffer.begin());
+        applyErosion_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
+      }
+      else if (method == "gradient")
+      {
+        buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, input_begin, input_end, output_begin);
+        for (UInt i = 0; i < size; ++i) output_begin[i] -= buffer[i];
+      }
+      else if (method == "tophat")
+      {
+        buffer.resize(size);
+        applyErosion_(struc_size, input_begin, input_end, buffer.begin());
+        applyDilation_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
+        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
+      }
+      else if (method == "bothat")
+      {
+        buffer.resize(size);
+        applyDilation_(struc_size, input_begin, input_end, buffer.begin());
+        applyErosion_(struc_size, buffer.begin(), buffer.begin() + size, output_begin);
+        for (UInt i = 0; i < size; ++i) output_begin[i] = input_begin[i] - output_begin[i];
+      }
+      else if (method == "erosion_simple")
+      {
+        applyErosionSimple_(struc_size, input_begin, input_end, output_begin);
+      }
+      else if (method == "dilation_simple")
+      {
+        applyDilationSimple_(struc_size, input_begin, input_end, output_begin);
+      }
+      else
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unknown morphological filter method '" + method + "'.");
+      }
+    }
+
     /** @brief Applies erosion.  This implementation uses van Herk's method.
     Only 3 min/max comparisons are required per data point, independent of
     struc_size.
     */
     template <typename InputIterator, typename OutputIterator>
-    void applyErosion_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output)
+    void applyErosion_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output) const
     {
       typedef typename InputIterator::value_type ValueType;
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
+      std::vector<ValueType> buffer(struc_size);
 
       Int anchor;           // anchoring position of the current block
       Int i;                // index relative to anchor, used for 'for' loops
@@ -445,14 +459,13 @@ protected:
     struc_size.
     */
     template <typename InputIterator, typename OutputIterator>
-    void applyDilation_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output)
+    void applyDilation_(Int struc_size, InputIterator input, InputIterator input_end, OutputIterator output) const
     {
       typedef typename InputIterator::value_type ValueType;
       const Int size = input_end - input;
       const Int struc_size_half = struc_size / 2;           // yes, integer division
 
-      static std::vector<ValueType> buffer;
-      if (Int(buffer.size()) < struc_size) buffer.resize(struc_size);
+      std::vector<ValueType> buffer(struc_size);
 
       Int anchor;           // anchoring position of the current block
       Int i;                // index relative to anchor, used for 'for' loops
@@ -542,7 +555,7 @@ protected:
 
     /// Applies erosion.  Simple implementation, possibly faster if struc_size is very small, and used in some special cases.
     template <typename InputIterator, typename OutputIterator>
-    void applyErosionSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
+    void applyErosionSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin) const
     {
       typedef typename InputIterator::value_type ValueType;
       const int size = input_end - input_begin;
@@ -560,7 +573,7 @@ protected:
 
     /// Applies dilation.  Simple implementation, possibly faster if struc_size is very small, and used in some special cases.
     template <typename InputIterator, typename OutputIterator>
-    void applyDilationSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin)
+    void applyDilationSimple_(Int struc_size, InputIterator input_begin, InputIterator input_end, OutputIterator output_begin) const
     {
       typedef typename InputIterator::value_type ValueType;
       const int size = input_end - input_begin;
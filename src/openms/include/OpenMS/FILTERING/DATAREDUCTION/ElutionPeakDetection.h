@@ -163,7 +163,7 @@ private:
     /// Whether to apply S/N filtering
     bool mt_snr_filtering_;
 
-    /// Main function to do the work
+    /// Main function to do the work (appends the detected peaks, @p single_mtraces must not be shared between threads)
     void detectElutionPeaks_(MassTrace&, std::vector<MassTrace>&);
   };
 
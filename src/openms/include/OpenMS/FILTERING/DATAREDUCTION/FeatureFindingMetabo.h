@@ -40,6 +40,7 @@
 #include <OpenMS/CONCEPT/ProgressLogger.h>
 #include <OpenMS/KERNEL/MSChromatogram.h>
 #include <OpenMS/CHEMISTRY/Element.h>
+#include <OpenMS/FILTERING/DATAREDUCTION/IsotopeDistributionCache.h>
 
 #include <vector>
 #include <svm.h>
@@ -191,6 +192,18 @@ public:
 protected:
     void updateMembers_() override;
 
+    /** @brief Perform intensity scoring using the averagine model (for peptides only)
+     *
+     * Compare the isotopic intensity distribution with the theoretical one
+     * expected for peptides, using the averagine model. Compute the cosine
+     * similarity between the two values.
+     *
+     * The averagine patterns are taken from the cache filled in run() (1 Da
+     * mass windows) and only computed on the fly (for the exact mass) if the
+     * mass is outside of the cached range or the cached pattern is too short.
+    */
+    double computeAveragineSimScore_(const std::vector<double>& intensities, const double& molecular_weight) const;
+
 private:
     /**
      * @brief parses a string of element symbols into a vector of Elements
@@ -292,21 +305,14 @@ e conditions are fulfilled. Mainly the
     */
     double scoreRT_(const MassTrace&, const MassTrace&) const;
 
-    /** @brief Perform intensity scoring using the averagine model (for peptides only)
-     *
-     * Compare the isotopic intensity distribution with the theoretical one
-     * expected for peptides, using the averagine model. Compute the cosine
-     * similarity between the two values.
-    */
-    double computeAveragineSimScore_(const std::vector<double>& intensities, const double& molecular_weight) const;
-
     /** @brief Identify groupings of mass traces based on a set of reasonable candidates
      *
      * Takes a set of reasonable candidates for mass trace grouping and checks
      * all combinations of charge and isotopic positions on the candidates. It
      * is assumed that candidates[0] is the monoisotopic trace.
      *
-     * The resulting possible groupings are appended to output_hypotheses.
+     * The resulting possible groupings are appended to output_hypotheses,
+     * which therefore must not be shared between threads.
     */
     void findLocalFeatures_(const std::vector<const MassTrace*>& candidates, double total_intensity, std::vector<FeatureHypothesis>& output_hypotheses) const;
 
@@ -336,6 +342,11 @@ e conditions are fulfilled. Mainly the
 
     bool remove_single_traces_;
     std::vector<const Element*> elements_;
+
+    /// averagine isotope patterns, filled in run() if isotope_filtering_model is 'peptides'
+    IsotopeDistributionCache averagine_cache_;
+    /// expected m/z windows for isotopic positions 1, 2, ... (see getTheoreticIsotopicMassWindow_), filled in run()
+    std::vector<Range> isotope_windows_;
   };
 
 }
@@ -86,10 +86,36 @@ public:
         @brief Smoothes an MSSpectrum containing profile data.
 
         Convolutes the filter and the profile data and writes the result back to the spectrum.
-
-        @exception Exception::IllegalArgument is thrown, if the @em gaussian_width parameter is too small.
+        If the @em gaussian_width parameter is too small (no signal found), an error is logged and the spectrum is left unchanged.
       */
     void filter(MSSpectrum & spectrum)
+    {
+      filterSpectrum_(spectrum, gauss_algo_);
+    }
+
+    /**
+      @brief Smoothes an MSChromatogram.
+
+      @exception Exception::IllegalArgument is thrown, if @em use_ppm_tolerance is set (not applicable to chromatograms).
+    */
+    void filter(MSChromatogram & chromatogram)
+    {
+      filterChromatogram_(chromatogram, gauss_algo_);
+    }
+
+    /**
+      @brief Smoothes an MSExperiment containing profile data.
+
+      Spectra and chromatograms are filtered in parallel, each thread uses its own copy of the filter kernel.
+
+      @exception Exception::IllegalArgument is thrown, if @em use_ppm_tolerance is set and the map contains chromatograms.
+    */
+    void filterExperiment(PeakMap & map);
+
+protected:
+
+    /// Smoothes @p spectrum using @p algo (which is modified if ppm tolerances are used)
+    void filterSpectrum_(MSSpectrum & spectrum, GaussFilterAlgorithm & algo) const
     {
       typedef std::vector<double> ContainerT;
 
@@ -109,7 +135,7 @@ public:
       // apply filter
       ContainerT::iterator mz_out_it = mz_out.begin();
       ContainerT::iterator int_out_it = int_out.begin();
-      found_signal = gauss_algo_.filter(mz_in.begin(), mz_in.end(), int_in.begin(), mz_out_it, int_out_it);
+      found_signal = algo.filter(mz_in.begin(), mz_in.end(), int_in.begin(), mz_out_it, int_out_it);
 
       // If all intensities are zero in the scan and the scan has a reasonable size, throw an exception.
       // This is the case if the Gaussian filter is smaller than the spacing of raw data
@@ -120,6 +146,7 @@ public:
         {
           error_message += String(" The error occurred in the spectrum with retention time ") + spectrum.getRT() + ".";
         }
+#pragma omp critical (LOG_ERROR_access)
         OPENMS_LOG_ERROR << error_message << std::endl;
       }
       else
@@ -135,7 +162,8 @@ public:
       }
     }
 
-    void filter(MSChromatogram & chromatogram)
+    /// Smoothes @p chromatogram using @p algo
+    void filterChromatogram_(MSChromatogram & chromatogram, GaussFilterAlgorithm & algo) const
     {
       typedef std::vector<double> ContainerT;
 
@@ -159,7 +187,7 @@ public:
       // apply filter
       ContainerT::iterator mz_out_it = rt_out.begin();
       ContainerT::iterator int_out_it = int_out.begin();
-      found_signal = gauss_algo_.filter(rt_in.begin(), rt_in.end(), int_in.begin(), mz_out_it, int_out_it);
+      found_signal = algo.filter(rt_in.begin(), rt_in.end(), int_in.begin(), mz_out_it, int_out_it);
 
       // If all intensities are zero in the scan and the scan has a reasonable size, throw an exception.
       // This is the case if the Gaussian filter is smaller than the spacing of raw data
@@ -170,6 +198,7 @@ public:
         {
           error_message += String(" The error occurred in the chromatogram with m/z time ") + chromatogram.getMZ() + ".";
         }
+#pragma omp critical (LOG_ERROR_access)
         OPENMS_LOG_ERROR << error_message << std::endl;
       }
       else
@@ -185,30 +214,6 @@ public:
       }
     }
 
-    /**
-      @brief Smoothes an MSExperiment containing profile data.
-
-      @exception Exception::IllegalArgument is thrown, if the @em gaussian_width parameter is too small.
-    */
-    void filterExperiment(PeakMap & map)
-    {
-      Size progress = 0;
-      startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
-      {
-        filter(map[i]);
-        setProgress(++progress);
-      }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
-      {
-        filter(map.getChromatogram(i));
-        setProgress(++progress);
-      }
-      endProgress();
-    }
-
-protected:
-
     GaussFilterAlgorithm gauss_algo_;
 
     /// The spacing of the pre-tabulated kernel coefficients
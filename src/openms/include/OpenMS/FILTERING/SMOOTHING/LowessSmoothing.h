@@ -49,6 +49,12 @@ namespace OpenMS
     chromatograms. In this case, the window size for the smoothing
     should be set proportional to the peak width (see LowessSmoothing parameters).
 
+    Only the @p window_size nearest points of each point are used for its fit
+    (all other points have zero weight), which are found with a sliding
+    window over the x-sorted data. The fits are computed in parallel. With a
+    positive @p delta, points close to the previously fitted point are
+    linearly interpolated instead of fitted.
+
     Note that this should work best for few datapoints that have strong
     non-linear behavior. For large datasets with mostly linear behavior, use
     FastLowessSmoothing
@@ -69,7 +75,7 @@ public:
 
     typedef std::vector<double> DoubleVector;
 
-    /// Smoothing method that receives x and y coordinates (e.g., RT and intensities) and computes smoothed intensities.
+    /// Smoothing method that receives x and y coordinates (e.g., RT and intensities) and computes smoothed intensities (appended to the output, in the order of the input).
     void smoothData(const DoubleVector &, const DoubleVector &, DoubleVector &);
 
 protected:
@@ -78,6 +84,8 @@ protected:
 private:
     double window_size_;
 
+    double delta_;
+
     double tricube_(double, double);
   };
 
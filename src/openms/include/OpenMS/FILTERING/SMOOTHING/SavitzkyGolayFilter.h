@@ -187,12 +187,20 @@ public:
     */
     void filter(MSSpectrum & spectrum)
     {
-      // copy the data AND META DATA to the output container
-      MSSpectrum output = spectrum;
-      // filter
-      filter(spectrum.begin(), spectrum.end(), output.begin());
-      // swap back
-      std::swap(spectrum, output);
+      if (frame_size_ > spectrum.size()) { return; }
+
+      // filter a contiguous copy of the intensities, positions and meta data stay untouched
+      std::vector<double> intensities(spectrum.size());
+      for (Size p = 0; p < spectrum.size(); ++p)
+      {
+        intensities[p] = spectrum[p].getIntensity();
+      }
+      std::vector<double> smoothed;
+      filterIntensities_(intensities, smoothed);
+      for (Size p = 0; p < spectrum.size(); ++p)
+      {
+        spectrum[p].setIntensity(smoothed[p]);
+      }
     }
 
     /**
@@ -200,35 +208,42 @@ public:
     */
     void filter(MSChromatogram & chromatogram)
     {
-      // copy the data AND META DATA to the output container
-      MSChromatogram output = chromatogram;
-      // filter
-      filter(chromatogram.begin(), chromatogram.end(), output.begin());
-      // swap back
-      std::swap(chromatogram, output);
-    }
+      if (frame_size_ > chromatogram.size()) { return; }
 
-    /**
-      @brief Removed the noise from an MSExperiment containing profile data.
-    */
-    void filterExperiment(PeakMap & map)
-    {
-      Size progress = 0;
-      startProgress(0, map.size() + map.getChromatograms().size(), "smoothing data");
-      for (Size i = 0; i < map.size(); ++i)
+      // filter a contiguous copy of the intensities, positions and meta data stay untouched
+      std::vector<double> intensities(chromatogram.size());
+      for (Size p = 0; p < chromatogram.size(); ++p)
       {
-        filter(map[i]);
-        setProgress(++progress);
+        intensities[p] = chromatogram[p].getIntensity();
       }
-      for (Size i = 0; i < map.getChromatograms().size(); ++i)
+      std::vector<double> smoothed;
+      filterIntensities_(intensities, smoothed);
+      for (Size p = 0; p < chromatogram.size(); ++p)
       {
-        filter(map.getChromatogram(i));
-        setProgress(++progress);
+        chromatogram[p].setIntensity(smoothed[p]);
       }
-      endProgress();
     }
 
+    /**
+      @brief Removed the noise from an MSExperiment containing profile data.
+
+      Spectra and chromatograms are filtered in parallel.
+    */
+    void filterExperiment(PeakMap & map);
+
 protected:
+    /**
+      @brief Smoothes a contiguous intensity array (same result as the iterator version of filter())
+
+      The steady state is computed as one multiply-add pass over the whole
+      block per filter coefficient, which the compiler can vectorize.
+      Negative results are set to zero.
+
+      @param intensities The input intensities, at least @p frame_size_ many
+      @param smoothed The smoothed intensities (resized to the input size)
+    */
+    void filterIntensities_(const std::vector<double>& intensities, std::vector<double>& smoothed) const;
+
     /// Coefficients
     std::vector<double> coeffs_;
 
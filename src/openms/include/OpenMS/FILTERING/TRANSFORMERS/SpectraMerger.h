@@ -205,8 +205,7 @@ public:
     {
 
       // convert spectra's precursors to clusterizable data
-      Size data_size;
-      std::vector<BinaryTreeNode> tree;
+      std::vector<std::vector<Size> > clusters;
       Map<Size, Size> index_mapping;
       // local scope to save memory - we do not need the clustering stuff later
       {
@@ -237,40 +236,11 @@ public:
           bf.setMZ(pcs[0].getMZ());
           data.push_back(bf);
         }
-        data_size = data.size();
-
-        SpectraDistance_ llc;
-        llc.setParameters(param_.copy("precursor_method:", true));
-        SingleLinkage sl;
-        DistanceMatrix<float> dist; // will be filled
-        ClusterHierarchical ch;
 
-        //ch.setThreshold(0.99);
-        // clustering ; threshold is implicitly at 1.0, i.e. distances of 1.0 (== similarity 0) will not be clustered
-        ch.cluster<BaseFeature, SpectraDistance_>(data, llc, sl, tree, dist);
+        // single linkage clustering; distances of 1.0 (== similarity 0) are not clustered
+        clusterPrecursors_(data, clusters);
       }
 
-      // extract the clusters
-      ClusterAnalyzer ca;
-      std::vector<std::vector<Size> > clusters;
-      // count number of real tree nodes (not the -1 ones):
-      Size node_count = 0;
-      for (Size ii = 0; ii < tree.size(); ++ii)
-      {
-        if (tree[ii].distance >= 1)
-        {
-          tree[ii].distance = -1;  // manually set to disconnect, as SingleLinkage does not support it
-        }
-        if (tree[ii].distance != -1)
-        {
-          ++node_count;
-        }
-      }
-      ca.cut(data_size - node_count, tree, clusters);
-
-      //std::cerr << "Treesize: " << (tree.size()+1) << "   #clusters: " << clusters.size() << std::endl;
-      //std::cerr << "tree:\n" << ca.newickTree(tree, true) << "\n";
-
       // convert to blocks
       MergeBlocks spectra_to_merge;
 
@@ -479,6 +449,16 @@ public:
 
 protected:
 
+    /**
+      @brief Single linkage clustering of precursors (RT and m/z) with a cut-off at similarity 0
+
+      Equivalent to ClusterHierarchical with SingleLinkage and SpectraDistance_ (cut at distance 1.0), but only
+      pairs within the RT tolerance are compared (RT sweep), so neither time nor memory is quadratic.
+      Clusters are the connected components of all pairs with non-zero similarity. Elements of each cluster and
+      the clusters themselves are sorted (as returned by ClusterAnalyzer::cut).
+    */
+    void clusterPrecursors_(const std::vector<BaseFeature>& data, std::vector<std::vector<Size> >& clusters) const;
+
     /**
         @brief merges blocks of spectra of a certain level
 
@@ -195,6 +195,15 @@ namespace OpenMS
       */
       virtual void doCleanup_();
 
+      /**
+        @brief Write all buffered spectra to disk
+
+        The binary data arrays of the buffered spectra are encoded in parallel
+        (see MzMLHandler::renderSpectrumDataArrays_), the spectra are then
+        written in the order in which they were consumed.
+      */
+      void flushSpectra_();
+
     protected:
 
       /// File stream (to write mzML)
@@ -206,7 +215,7 @@ namespace OpenMS
       bool writing_spectra_;
       /// Stores whether we are currently writing chromatograms
       bool writing_chromatograms_;
-      /// Number of spectra written
+      /// Number of spectra written (including those still in spectra_buffer_)
       Size spectra_written_;
       /// Number of chromatograms written
       Size chromatograms_written_;
@@ -226,6 +235,8 @@ namespace OpenMS
       std::vector<std::vector< ConstDataProcessingPtr > > dps_;
       /// The dataprocessing to be added to each spectrum/chromatogram
       DataProcessingPtr additional_dataprocessing_;
+      /// Processed spectra waiting to be encoded and written
+      std::vector<SpectrumType> spectra_buffer_;
     };
 
     /**
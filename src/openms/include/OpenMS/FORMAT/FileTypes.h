@@ -114,6 +114,7 @@ namespace OpenMS
       JSON,               ///< JavaScript Object Notation file (.json)
       RAW,                ///< Thermo Raw File (.raw)
       EXE,                ///< Executable (.exe)
+      OMSBIN,             ///< %OpenMS binary container for features, consensus features and identifications (.omsbin), see OMSBinFile
       SIZE_OF_TYPE        ///< No file type. Simply stores the number of types
     };
 
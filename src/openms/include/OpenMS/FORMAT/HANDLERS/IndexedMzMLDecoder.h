@@ -54,6 +54,12 @@ namespace OpenMS
     to extract all elements contained in the <indexList> tag and thus get access
     to all spectra and chromatogram offsets.
 
+    For mzML files without (or with a broken) index, scanOffsets reconstructs
+    the same information by scanning the whole file for <spectrum> and
+    <chromatogram> start tags (in parallel, chunk by chunk). The result can be
+    stored next to the mzML file as a sidecar index (see storeSidecarIndex and
+    loadSidecarIndex) to avoid repeated scans.
+
   */
   class OPENMS_DLLAPI IndexedMzMLDecoder
   {
@@ -106,6 +112,58 @@ namespace OpenMS
     */
     std::streampos findIndexListOffset(String filename, int buffersize = 1023);
 
+    /**
+      @brief Reconstructs the offsets of all spectra and chromatograms by scanning the file
+
+      The file is split into chunks of @p chunk_size bytes which are searched
+      concurrently for <spectrum> and <chromatogram> start tags. The offsets
+      (position of the '<') and the @em id attributes of all tags are collected
+      in file order and validated: ids must be present and unique and, if an
+      @em index attribute is present, it must match the position of the tag.
+
+      This works for any mzML file, indexed or not.
+
+      @param filename Filename of the input mzML file
+      @param spectra_offsets Output vector containing the positions of all spectra in the file
+      @param chromatograms_offsets Output vector containing the positions of all chromatograms in the file
+      @param chunk_size Number of bytes searched per task
+
+      @return 0 in case of success and -1 otherwise (the found offsets failed validation)
+
+      @throw FileNotFound is thrown if file cannot be found
+    */
+    int scanOffsets(String filename, OffsetVector& spectra_offsets, OffsetVector& chromatograms_offsets, Size chunk_size = 16 * 1024 * 1024);
+
+    /**
+      @brief Checks whether the offsets point to <spectrum> and <chromatogram> start tags
+
+      Only the first, middle and last offset of each vector are checked, which
+      detects indices that do not belong to the file (e.g. after the file was
+      modified) at negligible cost.
+
+      @return true if all checked offsets are valid
+    */
+    bool validateOffsets(String filename, const OffsetVector& spectra_offsets, const OffsetVector& chromatograms_offsets);
+
+    /// Filename of the sidecar index of @p filename ('.offsets' is appended)
+    static String getSidecarFilename(const String& filename);
+
+    /**
+      @brief Stores the offsets in a sidecar index file next to @p filename
+
+      Size and modification time of @p filename are stored as well and checked by loadSidecarIndex.
+
+      @return true on success, false if the sidecar file could not be written (e.g. read-only directory)
+    */
+    bool storeSidecarIndex(String filename, const OffsetVector& spectra_offsets, const OffsetVector& chromatograms_offsets);
+
+    /**
+      @brief Loads the offsets from the sidecar index of @p filename
+
+      @return 0 in case of success and -1 otherwise (no sidecar index, or it does not match the current file)
+    */
+    int loadSidecarIndex(String filename, OffsetVector& spectra_offsets, OffsetVector& chromatograms_offsets);
+
   protected:
 
     /**
@@ -70,6 +70,12 @@ namespace Internal
     extracting all the offsets of the <chromatogram> and <spectrum> tags. These
     offsets are stored as members of this class as well as the offset to the <indexList> element
 
+    If the file carries no (or an inconsistent) index, the offsets are
+    reconstructed by scanning the file for <spectrum> and <chromatogram> tags
+    (see IndexedMzMLDecoder::scanOffsets), unless this was disabled using
+    setIndexReconstruction(). Optionally, a reconstructed index is persisted as
+    a sidecar file next to the mzML file and reused on the next access.
+
     @note This implementation is @a not thread-safe since it keeps internally a
     single file access pointer which it moves when accessing a specific
     data item. The caller is responsible to ensure that access is performed
@@ -98,12 +104,18 @@ namespace Internal
     bool parsing_success_;
     /// Whether to skip XML checks
     bool skip_xml_checks_;
+    /// Whether to reconstruct the offsets by scanning the file if no valid index is present
+    bool reconstruct_index_;
+    /// Whether to write a reconstructed index to a sidecar file
+    bool write_sidecar_index_;
 
     /**
       @brief Try to parse the footer of the indexedmzML
 
       Upon success, the chromatogram and spectra offsets will be populated and
-      parsing_success_ will be set to true.
+      parsing_success_ will be set to true. If the footer is missing or does
+      not point to valid tags, the offsets are taken from a sidecar index or
+      reconstructed by scanning the file (if enabled).
 
       @note You *need* to check getParsingSuccess after calling this!
     */
@@ -147,7 +159,8 @@ namespace Internal
       @note It is invalid to call getSpectrumById or getChromatogramById if this function returns false
 
       @return Whether the parsing of the file was successful (if false, the
-      file most likely was not an indexed mzML file)
+      file most likely was not an indexed mzML file and index reconstruction
+      was disabled or failed)
     */
     bool getParsingSuccess() const;
 
@@ -247,6 +260,30 @@ namespace Internal
       skip_xml_checks_ = skip;
     }
 
+    /**
+      @brief Whether to reconstruct the offsets if the file has no valid index (default: true)
+
+      @note Needs to be called before openFile()
+    */
+    void setIndexReconstruction(bool reconstruct)
+    {
+      reconstruct_index_ = reconstruct;
+    }
+
+    /**
+      @brief Whether to store a reconstructed index in a sidecar file (default: false)
+
+      The sidecar file is named after the mzML file (see
+      IndexedMzMLDecoder::getSidecarFilename) and is only reused as long as
+      the size and modification time of the mzML file do not change.
+
+      @note Needs to be called before openFile()
+    */
+    void setWriteSidecarIndex(bool write)
+    {
+      write_sidecar_index_ = write;
+    }
+
   };
 }
 }
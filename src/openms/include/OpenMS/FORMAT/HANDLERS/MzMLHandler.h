@@ -49,6 +49,9 @@
 #include <OpenMS/FORMAT/ControlledVocabulary.h>
 #include <OpenMS/FORMAT/VALIDATORS/SemanticValidator.h>
 
+#include <atomic>
+#include <deque>
+
 
 //MISSING:
 // - more than one selected ion per precursor (warning if more than one)
@@ -185,6 +188,37 @@ public:
 
       /// Set the IMSDataConsumer consumer which will consume the read data
       void setMSDataConsumer(Interfaces::IMSDataConsumer* consumer);
+
+      /**
+        @brief Decode binary data in a pipeline while parsing (default: false)
+
+        Instead of collecting a batch of spectra/chromatograms and decoding it
+        while parsing is paused, each spectrum/chromatogram is decoded in an
+        OpenMP task as soon as it has been parsed. The decoded data is kept in
+        the pipeline until flushPipeline() is called, which hands it to the
+        consumer (or appends it to the experiment) in the original file order.
+
+        @note To decode in parallel, parsing must run inside an OpenMP parallel
+        region (in a single construct). The caller is expected to pause parsing
+        once pipelineFull() returns true, leave the parallel region and call
+        flushPipeline(), so the consumer never runs inside the parallel region
+        (see MzMLFile::transform).
+      */
+      void setPipelined(bool pipelined);
+
+      /**
+        @brief Whether the pipeline holds as many items (or as much memory) as allowed
+
+        See PeakFileOptions::getPipelineQueueDepth() and PeakFileOptions::getPipelineMemoryCap().
+      */
+      bool pipelineFull() const;
+
+      /**
+        @brief Deliver all items of the pipeline in file order (waits for pending decoding tasks)
+
+        @exception Exception::ParseError is thrown if the binary data of an item could not be decoded
+      */
+      void flushPipeline();
       //@}
 
       /// handler which support partial loading, implement this method
@@ -230,6 +264,25 @@ protected:
       */
       void populateChromatogramsWithData_();
 
+      /// Hand a spectrum to the consumer and/or append it to the experiment
+      void appendSpectrum_(SpectrumType& spectrum);
+
+      /// Hand a chromatogram to the consumer and/or append it to the experiment
+      void appendChromatogram_(ChromatogramType& chromatogram);
+
+      struct PipelineItem;
+
+      /**
+          @brief Add a parsed spectrum/chromatogram to the decoding pipeline
+
+          Spawns a task decoding the binary data of @p item. The item is delivered by flushPipeline().
+      */
+      void schedulePipelineItem_(PipelineItem& item);
+
+      /// Decode the binary data of a single pipeline item (executed in parallel)
+      void decodePipelineItem_(PipelineItem& item);
+
+
       /**
           @brief Add extra data arrays to a spectrum
 
@@ -309,13 +362,32 @@ protected:
                         const Internal::MzMLValidator& validator);
 
 
-      /// Write out a single spectrum
+      /**
+          @brief Write out a single spectrum
+
+          If @p rendered_arrays is given and not empty, it is used verbatim as
+          the m/z and intensity <binaryDataArray> elements (see
+          renderSpectrumDataArrays_). Otherwise the arrays are encoded on the fly.
+      */
       void writeSpectrum_(std::ostream& os,
                           const SpectrumType& spec,
                           Size spec_idx,
                           const Internal::MzMLValidator& validator,
                           bool renew_native_ids,
-                          std::vector<std::vector< ConstDataProcessingPtr > >& dps);
+                          std::vector<std::vector< ConstDataProcessingPtr > >& dps,
+                          const String* rendered_arrays = nullptr);
+
+      /**
+          @brief Encode the m/z and intensity arrays of a batch of spectra in parallel
+
+          After the call, @p rendered holds one entry per spectrum containing
+          its two <binaryDataArray> elements, ready to be passed to
+          writeSpectrum_. Entries of empty spectra (and of spectra that could
+          not be encoded) are left empty, writeSpectrum_ then falls back to
+          encoding them itself.
+      */
+      void renderSpectrumDataArrays_(const std::vector<const SpectrumType*>& spectra,
+                                     std::vector<String>& rendered);
 
       /// Write out a single chromatogram
       void writeChromatogram_(std::ostream& os,
@@ -479,6 +551,31 @@ protected:
       /// Vector of chromatogram data stored for later parallel processing
       std::vector<ChromatogramData> chromatogram_data_;
 
+      /**
+          @brief A spectrum or chromatogram in the decoding pipeline
+
+          The decoding task sets @p done once the data is decoded (or an error
+          occurred); only then the item is accessed again.
+      */
+      struct PipelineItem
+      {
+        bool is_spectrum = true;
+        SpectrumData spectrum_data;
+        ChromatogramData chromatogram_data;
+        /// Estimated memory held by this item (in bytes)
+        Size memory = 0;
+        std::atomic<bool> done{ false };
+        bool error = false;
+        String error_message;
+      };
+
+      /// Whether binary data is decoded in a pipeline (see setPipelined())
+      bool pipelined_{ false };
+      /// Spectra/chromatograms in flight, in file order (references stay valid on push_back/pop_front)
+      std::deque<PipelineItem> pipeline_;
+      /// Estimated memory held by the items in flight (in bytes)
+      Size pipeline_memory_{ 0 };
+
       //@}
       /**@name temporary data structures to hold written data
        *
@@ -105,6 +105,9 @@ public:
       /**
           @brief Read an set of spectra (potentially restricted to a subset)
 
+          The spectra are returned in the order of increasing index. Their
+          binary data is decoded in parallel.
+
           @param exp The result
           @param indices A list of indices restricting the resulting spectra only to those specified here
           @param meta_only Only read the meta data
@@ -114,6 +117,9 @@ public:
       /**
           @brief Read an set of chromatograms (potentially restricted to a subset)
 
+          The chromatograms are returned in the order of increasing index. Their
+          binary data is decoded in parallel.
+
           @param exp The result
           @param indices A list of indices restricting the resulting chromatograms only to those specified here
           @param meta_only Only read the meta data
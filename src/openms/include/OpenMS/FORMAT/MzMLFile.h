@@ -45,6 +45,11 @@
 
 namespace OpenMS
 {
+  namespace Internal
+  {
+    class MzMLHandler;
+  }
+
   /**
     @brief File adapter for MzML files
 
@@ -135,6 +140,14 @@ public:
       does not require a full first pass through the file to compute the
       correct number of spectra and chromatograms in the input file.
 
+      @note If OpenMP is available, parsing and decoding of the binary data
+      run as a pipeline (see PeakFileOptions::setPipelineQueueDepth): the
+      file is read in chunks, and the spectra and chromatograms of a chunk are
+      decoded by multiple threads while parsing continues. After each chunk,
+      the consumer receives them in the original order on the calling thread,
+      outside of any parallel region, so it may use OpenMP itself. Set the
+      queue depth to zero to disable the pipeline.
+
       @param filename_in Filename of input mzML file to transform
       @param consumer Consumer class to operate on the input filename (implementing a transformation)
       @param skip_full_count Whether to skip computing the correct number of spectra and chromatograms in the input file
@@ -194,6 +207,20 @@ protected:
     /// Safe parse that catches exceptions and handles them accordingly
     void safeParse_(const String & filename, Internal::XMLHandler * handler);
 
+    /**
+      @brief Safe parse which decodes the binary data in a pipeline while parsing
+
+      The file is parsed in chunks of at most PeakFileOptions::getPipelineQueueDepth
+      spectra/chromatograms (or PeakFileOptions::getPipelineMemoryCap bytes).
+      The binary data of a chunk is decoded in parallel while parsing, the
+      decoded data is handed to the consumer outside of the parallel region.
+
+      Falls back to safeParse_ if the pipeline is disabled (see
+      PeakFileOptions::getPipelineQueueDepth) or only a single thread is
+      available.
+    */
+    void safeParsePipelined_(const String & filename, Internal::MzMLHandler * handler);
+
 private:
 
     /// Options for loading / storing
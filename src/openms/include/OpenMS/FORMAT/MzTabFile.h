@@ -68,7 +68,14 @@ namespace OpenMS
     // store MzTab file
     void store(const String& filename, const MzTab& mz_tab) const;
 
-    // stream IDs to file
+    /**
+      @brief Stream IDs to file (single pass)
+
+      The optional columns of each section are taken from the stream before
+      its rows are written, so the headers do not necessarily match the rows.
+      Use storeIdentifications() for output identical to storing
+      MzTab::exportIdentificationsToMzTab().
+    */
     void store(
           const String& filename,
           const std::vector<ProteinIdentification>& protein_identifications,
@@ -77,7 +84,17 @@ namespace OpenMS
           bool export_empty_pep_ids = false,
           const String& title = "ID export from OpenMS");
 
-    // stream ConsensusMap to file
+    /**
+      @brief Stream ConsensusMap to file (single pass)
+
+      The optional columns of each section are taken from the stream before
+      its rows are written, hence columns which are only added while
+      generating rows (e.g. peptidoform and subfeature columns) are missing
+      in the header, and the PEP header has no ms_run level score columns.
+      Use storeConsensusMap() for output identical to storing
+      MzTab::exportConsensusMapToMzTab(); this overload is kept for
+      compatibility of existing output.
+    */
     void store(
       const String& filename, 
       const ConsensusMap& cmap,
@@ -87,6 +104,45 @@ namespace OpenMS
       const bool export_subfeatures,
       const bool export_empty_pep_ids = false) const;
 
+    /**
+      @brief Export a consensus map to an mzTab file without building an MzTab object
+
+      Writes the same file as storing the result of
+      MzTab::exportConsensusMapToMzTab() with the same arguments, but the rows
+      are generated section by section and written to disk directly. The data
+      is traversed twice (once to collect the columns of each section, once to
+      write the rows), so memory use does not grow with the number of rows.
+
+      In contrast to the single-pass store(const String&, const ConsensusMap&, ...)
+      overload, the section headers list all optional and ms_run level score
+      columns the rows actually contain. Prefer this function for new code.
+    */
+    void storeConsensusMap(
+      const String& filename,
+      const ConsensusMap& cmap,
+      const bool first_run_inference_only,
+      const bool export_unidentified_features,
+      const bool export_unassigned_ids,
+      const bool export_subfeatures,
+      const bool export_empty_pep_ids = false,
+      const String& title = "ConsensusMap export from OpenMS") const;
+
+    /**
+      @brief Export identifications to an mzTab file without building an MzTab object
+
+      Writes the same file as storing the result of
+      MzTab::exportIdentificationsToMzTab() with the same arguments, in two
+      passes over the data (see storeConsensusMap). Prefer this function over
+      the single-pass store() overload for identifications.
+    */
+    void storeIdentifications(
+      const String& filename,
+      const std::vector<ProteinIdentification>& protein_identifications,
+      const std::vector<PeptideIdentification>& peptide_identifications,
+      const bool first_run_inference_only,
+      const bool export_empty_pep_ids = false,
+      const String& title = "ID export from OpenMS") const;
+
     // Set store behaviour of optional "reliability" and "uri" columns (default=no)
     void storeProteinReliabilityColumn(bool store);
     void storePeptideReliabilityColumn(bool store);
@@ -164,6 +220,16 @@ namespace OpenMS
       }
     }
 
+    /**
+      @brief Write the PRT, PEP and PSM rows produced by a row stream (MzTab::CMMzTabStream or MzTab::IDMzTabStream)
+
+      The stream is constructed twice from @p stream_args: the first pass
+      determines the optional columns of each section, the second pass writes
+      the rows.
+    */
+    template <typename MzTabStream, typename... StreamArgs>
+    void storeStreamed_(const String& filename, const StreamArgs&... stream_args) const;
+
     // auxiliary functions
 
     /// Helper function for "generateMzTabSectionRow_" functions
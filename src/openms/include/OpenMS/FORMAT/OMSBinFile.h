@@ -0,0 +1,153 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <vector>
+
+namespace OpenMS
+{
+  class ConsensusMap;
+  class FeatureMap;
+  class PeptideIdentification;
+  class ProteinIdentification;
+
+  /**
+    @brief Compact binary container for feature maps, consensus maps and identifications
+
+    Meant for passing intermediate results between tools on the same machine,
+    where parsing and writing featureXML, consensusXML or idXML often takes
+    longer than the computation itself.
+
+    Layout (version 1, native byte order):
+    - a fixed header (magic number, format version, byte order mark, content type,
+      offset and size of the string table)
+    - the body: numeric fields of features and consensus features are stored
+      column-wise (all RTs, then all m/z values, ...), followed by the nested
+      data of each element (convex hulls, feature handles, identifications, meta values)
+    - the string table: every distinct string (names, sequences, meta keys and
+      values) is stored once and referenced by its position in the table
+
+    Files are read through a memory mapping. Strings are only decoded when the
+    body refers to them, and meta value keys are resolved against the
+    MetaInfoRegistry once per file.
+
+    The format is not meant for archiving: files are only readable on machines
+    with the same byte order, and a file written by a different format version
+    is rejected. Not stored are ProteinGroup data arrays, ProteinHit modifications,
+    pepXML analysis results of peptide hits and the CV terms of the software
+    of DataProcessing entries (their meta values are stored).
+
+    @ingroup FileIO
+  */
+  class OPENMS_DLLAPI OMSBinFile :
+    public ProgressLogger
+  {
+public:
+    /// Kind of data stored in a file
+    enum ContentType
+    {
+      FEATURES = 1,       ///< a FeatureMap
+      CONSENSUS = 2,      ///< a ConsensusMap
+      IDENTIFICATIONS = 3 ///< protein and peptide identifications
+    };
+
+    /// Current version of the format
+    static const UInt32 FORMAT_VERSION;
+
+    /// Default constructor
+    OMSBinFile();
+
+    /// Destructor
+    ~OMSBinFile();
+
+    /**
+      @brief Returns the content type of a file by reading its header
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a (compatible) binary container
+    */
+    static ContentType getContentType(const String& filename);
+
+    /**
+      @brief Loads a feature map and calls updateRanges()
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a compatible feature container or is truncated
+    */
+    void load(const String& filename, FeatureMap& map);
+
+    /**
+      @brief Stores a feature map
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const FeatureMap& map);
+
+    /**
+      @brief Loads a consensus map and calls updateRanges()
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a compatible consensus container or is truncated
+    */
+    void load(const String& filename, ConsensusMap& map);
+
+    /**
+      @brief Stores a consensus map
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const ConsensusMap& map);
+
+    /**
+      @brief Loads protein and peptide identifications
+
+      @exception Exception::FileNotFound is thrown if the file could not be opened
+      @exception Exception::ParseError is thrown if the file is not a compatible identification container or is truncated
+    */
+    void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids);
+
+    /**
+      @brief Stores protein and peptide identifications
+
+      @exception Exception::UnableToCreateFile is thrown if the file could not be created
+    */
+    void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids);
+  };
+
+} // namespace OpenMS
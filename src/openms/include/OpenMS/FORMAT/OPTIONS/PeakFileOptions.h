@@ -221,6 +221,29 @@ public:
     void setMaxDataPoolSize(Size size);
     //@}
 
+    /**
+        @name Pipeline options
+
+        When transforming a file with a consumer (MzMLFile::transform), XML
+        parsing, decoding of the binary data and handing the data to the
+        consumer can run as a pipeline: the parser hands each spectrum or
+        chromatogram to a pool of decoding threads and the consumer receives
+        the decoded data in the original order. These parameters bound the
+        number of items and the (estimated) memory held between parser and
+        consumer. A queue depth of zero disables the pipeline and falls back
+        to batch processing using the data pool (see above).
+    */
+    //@{
+    /// Get maximal number of spectra/chromatograms in flight between parser and consumer
+    Size getPipelineQueueDepth() const;
+    /// Set maximal number of spectra/chromatograms in flight between parser and consumer (0 disables the pipeline)
+    void setPipelineQueueDepth(Size depth);
+    /// Get maximal memory (in bytes) held by spectra/chromatograms in flight between parser and consumer
+    Size getPipelineMemoryCap() const;
+    /// Set maximal memory (in bytes) held by spectra/chromatograms in flight between parser and consumer
+    void setPipelineMemoryCap(Size bytes);
+    //@}
+
     /// [mzML only!] Whether to use the "selected ion m/z" value as the precursor m/z value (alternative: use the "isolation window target m/z" value)
     bool getPrecursorMZSelectedIon() const;
 
@@ -255,6 +278,8 @@ private:
     MSNumpressCoder::NumpressConfig np_config_int_;
     MSNumpressCoder::NumpressConfig np_config_fda_;
     Size maximal_data_pool_size_;
+    Size pipeline_queue_depth_;
+    Size pipeline_memory_cap_;
     bool precursor_mz_selected_ion_;
   };
 
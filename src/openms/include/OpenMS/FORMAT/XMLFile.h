@@ -38,6 +38,8 @@
 #include <OpenMS/CONCEPT/Types.h>
 #include <OpenMS/DATASTRUCTURES/String.h>
 
+#include <functional>
+
 namespace OpenMS
 {
   namespace Internal
@@ -82,6 +84,20 @@ protected:
       */
       void parse_(const String& filename, XMLHandler* handler);
 
+      /**
+        @brief Parses the XML file given by @p filename in steps, using the handler given by @p handler.
+
+        Behaves like parse_(), but the caller controls the parsing: @p step is
+        called repeatedly with a function which parses the next XML token and
+        returns false once the end of the document is reached. Parsing stops
+        as soon as @p step returns false. This allows to pause parsing, e.g. to
+        leave an OpenMP parallel region in between parsing steps.
+
+        @exception Exception::FileNotFound is thrown if the file is not found
+        @exception Exception::ParseError is thrown if an error occurred during the parsing
+      */
+      void parseProgressive_(const String& filename, XMLHandler* handler, const std::function<bool(const std::function<bool()>&)>& step);
+
       /**
         @brief Parses the in-memory buffer given by @p buffer using the handler given by @p handler.
 
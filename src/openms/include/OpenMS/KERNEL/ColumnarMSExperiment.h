@@ -0,0 +1,310 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+#include <OpenMS/METADATA/SpectrumSettings.h>
+
+#include <iterator>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Compact, column-oriented (struct-of-arrays) storage of the spectra of a run.
+
+    All m/z values of the run are stored in one contiguous array of doubles
+    and all intensities in one contiguous array of floats. A spectrum is
+    described by an offset into these arrays plus a small set of meta data
+    (see SpectrumMeta). Compared to an MSExperiment (Peak1D is padded to 16
+    bytes and every spectrum carries full SpectrumSettings), this needs 12
+    bytes per peak and makes scans over the data cache and SIMD friendly.
+
+    Spectra are accessed through SpectrumView objects, which point directly
+    into the shared arrays (no copy). Algorithms which require an MSSpectrum
+    can materialize single spectra through getSpectrum().
+
+    The container is read-only after construction (apart from appending
+    spectra), hence concurrent read access from several threads is safe.
+
+    @note Chromatograms, data arrays and meta data beyond SpectrumMeta are not
+    kept. Use a regular MSExperiment if these are needed.
+
+    @ingroup Kernel
+  */
+  class OPENMS_DLLAPI ColumnarMSExperiment
+  {
+public:
+
+    /// Compact per-spectrum meta data
+    struct SpectrumMeta
+    {
+      /// Retention time
+      double rt = 0.0;
+      /// Drift time (negative if not available)
+      double drift_time = -1.0;
+      /// m/z of the first precursor (0 if there is none)
+      double precursor_mz = 0.0;
+      /// Charge of the first precursor (0 if unknown or there is none)
+      Int precursor_charge = 0;
+      /// MS level
+      UInt ms_level = 1;
+      /// Spectrum type (profile/centroid)
+      SpectrumSettings::SpectrumType type = SpectrumSettings::UNKNOWN;
+    };
+
+    /**
+      @brief Non-owning view on the peaks and meta data of one spectrum
+
+      The view stays valid as long as the container is neither modified nor destroyed.
+    */
+    class SpectrumView
+    {
+public:
+      /**
+        @brief Random access iterator over the peaks of a view
+
+        Dereferencing yields the peak by value (a Peak1D assembled from the
+        m/z and intensity arrays), which allows to use the view with algorithms
+        written for peak containers (e.g. PeakTypeEstimator).
+      */
+      class ConstIterator
+      {
+public:
+        typedef std::random_access_iterator_tag iterator_category;
+        typedef Peak1D value_type;
+        typedef std::ptrdiff_t difference_type;
+        typedef const Peak1D* pointer;
+        typedef Peak1D reference;
+
+        /// Constructor
+        ConstIterator(const double* mz, const float* intensity) :
+          mz_(mz),
+          intensity_(intensity)
+        {
+        }
+
+        Peak1D operator*() const { return Peak1D(*mz_, *intensity_); }
+        Peak1D operator[](difference_type n) const { return Peak1D(mz_[n], intensity_[n]); }
+
+        ConstIterator& operator++() { ++mz_; ++intensity_; return *this; }
+        ConstIterator operator++(int) { ConstIterator tmp(*this); ++(*this); return tmp; }
+        ConstIterator& operator--() { --mz_; --intensity_; return *this; }
+        ConstIterator operator--(int) { ConstIterator tmp(*this); --(*this); return tmp; }
+        ConstIterator& operator+=(difference_type n) { mz_ += n; intensity_ += n; return *this; }
+        ConstIterator& operator-=(difference_type n) { mz_ -= n; intensity_ -= n; return *this; }
+        ConstIterator operator+(difference_type n) const { return ConstIterator(mz_ + n, intensity_ + n); }
+        ConstIterator operator-(difference_type n) const { return ConstIterator(mz_ - n, intensity_ - n); }
+        difference_type operator-(const ConstIterator& rhs) const { return mz_ - rhs.mz_; }
+
+        bool operator==(const ConstIterator& rhs) const { return mz_ == rhs.mz_; }
+        bool operator!=(const ConstIterator& rhs) const { return mz_ != rhs.mz_; }
+        bool operator<(const ConstIterator& rhs) const { return mz_ < rhs.mz_; }
+        bool operator>(const ConstIterator& rhs) const { return mz_ > rhs.mz_; }
+        bool operator<=(const ConstIterator& rhs) const { return mz_ <= rhs.mz_; }
+        bool operator>=(const ConstIterator& rhs) const { return mz_ >= rhs.mz_; }
+
+protected:
+        const double* mz_;
+        const float* intensity_;
+      };
+
+      typedef ConstIterator const_iterator;
+      typedef Peak1D PeakType;
+
+      /// Constructor
+      SpectrumView(const double* mz, const float* intensity, Size size, const SpectrumMeta& meta, const String& native_id) :
+        mz_(mz),
+        intensity_(intensity),
+        size_(size),
+        meta_(&meta),
+        native_id_(&native_id)
+      {
+      }
+
+      /// Number of peaks
+      Size size() const { return size_; }
+      /// Returns whether the spectrum has no peaks
+      bool empty() const { return size_ == 0; }
+
+      /// m/z of peak @p i
+      double getMZ(Size i) const { return mz_[i]; }
+      /// Intensity of peak @p i
+      float getIntensity(Size i) const { return intensity_[i]; }
+      /// Peak @p i (by value)
+      Peak1D operator[](Size i) const { return Peak1D(mz_[i], intensity_[i]); }
+
+      /// Iterator to the first peak
+      ConstIterator begin() const { return ConstIterator(mz_, intensity_); }
+      /// Iterator past the last peak
+      ConstIterator end() const { return ConstIterator(mz_ + size_, intensity_ + size_); }
+
+      /// Pointer to the first m/z value (contiguous)
+      const double* mzBegin() const { return mz_; }
+      /// Pointer past the last m/z value
+      const double* mzEnd() const { return mz_ + size_; }
+      /// Pointer to the first intensity value (contiguous)
+      const float* intensityBegin() const { return intensity_; }
+      /// Pointer past the last intensity value
+      const float* intensityEnd() const { return intensity_ + size_; }
+
+      /// Retention time
+      double getRT() const { return meta_->rt; }
+      /// Drift time (negative if not available)
+      double getDriftTime() const { return meta_->drift_time; }
+      /// MS level
+      UInt getMSLevel() const { return meta_->ms_level; }
+      /// m/z of the first precursor (0 if there is none)
+      double getPrecursorMZ() const { return meta_->precursor_mz; }
+      /// Charge of the first precursor (0 if unknown)
+      Int getPrecursorCharge() const { return meta_->precursor_charge; }
+      /// Spectrum type (profile/centroid)
+      SpectrumSettings::SpectrumType getType() const { return meta_->type; }
+      /// Native ID
+      const String& getNativeID() const { return *native_id_; }
+
+protected:
+      const double* mz_;
+      const float* intensity_;
+      Size size_;
+      const SpectrumMeta* meta_;
+      const String* native_id_;
+    };
+
+    /// Default constructor
+    ColumnarMSExperiment();
+
+    /// Constructor from an MSExperiment (spectra only)
+    explicit ColumnarMSExperiment(const PeakMap& exp);
+
+    /// Copy constructor
+    ColumnarMSExperiment(const ColumnarMSExperiment& source) = default;
+
+    /// Move constructor
+    ColumnarMSExperiment(ColumnarMSExperiment&& source) = default;
+
+    /// Assignment operator
+    ColumnarMSExperiment& operator=(const ColumnarMSExperiment& source) = default;
+
+    /// Move assignment operator
+    ColumnarMSExperiment& operator=(ColumnarMSExperiment&& source) = default;
+
+    /// Destructor
+    ~ColumnarMSExperiment() = default;
+
+    /// Equality operator
+    bool operator==(const ColumnarMSExperiment& rhs) const;
+
+    /// Reserves space for @p nr_spectra spectra with @p nr_peaks peaks in total
+    void reserve(Size nr_spectra, Size nr_peaks);
+
+    /// Appends a spectrum (peaks and compact meta data are copied)
+    void addSpectrum(const MSSpectrum& spectrum);
+
+    /// Removes all spectra (and optionally frees the memory)
+    void clear(bool clear_memory = false);
+
+    /// Number of spectra
+    Size size() const { return meta_.size(); }
+
+    /// Returns whether there are no spectra
+    bool empty() const { return meta_.empty(); }
+
+    /// Total number of peaks of all spectra
+    Size getNrPeaks() const { return mz_.size(); }
+
+    /// View on spectrum @p index (no range check)
+    SpectrumView operator[](Size index) const
+    {
+      return SpectrumView(mz_.data() + offsets_[index], intensity_.data() + offsets_[index],
+                          offsets_[index + 1] - offsets_[index], meta_[index], native_ids_[index]);
+    }
+
+    /**
+      @brief View on spectrum @p index
+
+      @exception Exception::IndexOverflow is thrown if @p index is out of range
+    */
+    SpectrumView getSpectrumView(Size index) const;
+
+    /**
+      @brief Materializes spectrum @p index as MSSpectrum (the peaks and the compact meta data are copied)
+
+      @exception Exception::IndexOverflow is thrown if @p index is out of range
+    */
+    MSSpectrum getSpectrum(Size index) const;
+
+    /**
+      @brief Sets the compact meta data of spectrum @p index (RT, drift time, MS level, type, native ID and precursor) on @p spectrum
+
+      The peaks of @p spectrum are not modified.
+
+      @exception Exception::IndexOverflow is thrown if @p index is out of range
+    */
+    void copySpectrumMeta(Size index, MSSpectrum& spectrum) const;
+
+    /// Converts all spectra into @p exp (which is cleared first)
+    void toExperiment(PeakMap& exp) const;
+
+    /// Returns the index of the first spectrum with RT >= @p rt (spectra must be sorted by RT)
+    Size RTBegin(double rt) const;
+
+    /// Meta data of spectrum @p index
+    const SpectrumMeta& getSpectrumMeta(Size index) const { return meta_[index]; }
+
+    /// Offsets of the spectra into the peak arrays (size() + 1 entries, spectrum i covers [offsets[i], offsets[i + 1]))
+    const std::vector<Size>& getOffsets() const { return offsets_; }
+
+    /// All m/z values of the run (spectrum after spectrum)
+    const std::vector<double>& getMZArray() const { return mz_; }
+
+    /// All intensities of the run (spectrum after spectrum)
+    const std::vector<float>& getIntensityArray() const { return intensity_; }
+
+protected:
+    /// m/z values of all spectra
+    std::vector<double> mz_;
+    /// Intensities of all spectra
+    std::vector<float> intensity_;
+    /// Start of each spectrum in mz_ and intensity_ (plus the end of the last spectrum)
+    std::vector<Size> offsets_;
+    /// Per-spectrum meta data
+    std::vector<SpectrumMeta> meta_;
+    /// Per-spectrum native IDs
+    std::vector<String> native_ids_;
+  };
+
+} // namespace OpenMS
@@ -84,10 +84,12 @@ public:
       @brief Open a specific file on disk.
 
       This tries to read the indexed mzML by parsing the index and then reading
-      the meta information into memory.
+      the meta information into memory. If the file carries no valid index,
+      the offsets are reconstructed by scanning the file, thus non-indexed mzML
+      files can be accessed as well (see IndexedMzMLHandler).
 
       @return Whether the parsing of the file was successful (if false, the
-      file most likely was not an indexed mzML file)
+      file most likely was not an mzML file)
     */
     bool openFile(const String& filename, bool skipMetaData = false)
     {
@@ -122,17 +122,21 @@ public:
 
         int operator()(const Eigen::VectorXd &x, Eigen::VectorXd &fvec) const
         {
-          fvec(0) = 0.0;
-          double sigma = fabs(x(1));
-          double logsigma = log(sigma);
-          auto wit = m_weights.cbegin();
-          for (auto it = m_data.cbegin(); it != m_data.cend(); ++it, ++wit)
+          const double a = x(0);
+          const double sigma = fabs(x(1));
+          const double logsigma = log(sigma);
+          const SignedSize n = m_data.size();
+          double loglikelihood = 0.0;
+          // evaluated many times per fit by the numerical differentiation, so spread large data sets over threads
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+: loglikelihood) if (n > 10000)
+#endif
+          for (SignedSize i = 0; i < n; ++i)
           {
-            double diff = (*it - x(0)) / sigma;
-            fvec(0) += *wit * (-logsigma - diff - exp(-diff));
+            double diff = (m_data[i] - a) / sigma;
+            loglikelihood += m_weights[i] * (-logsigma - diff - exp(-diff));
           }
-          double foo = -fvec(0);
-          fvec(0) = foo;
+          fvec(0) = -loglikelihood;
           fvec(1) = 0.0;
           return 0;
         }
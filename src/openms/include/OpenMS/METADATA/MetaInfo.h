@@ -40,8 +40,6 @@
 #include <OpenMS/METADATA/MetaInfoRegistry.h>
 #include <OpenMS/DATASTRUCTURES/DataValue.h>
 
-#include <boost/container/flat_map.hpp>
-
 namespace OpenMS
 {
   class String;
@@ -63,6 +61,10 @@ namespace OpenMS
       member. MetaInfoInterface implements a full interface to a MetaInfo
       member and is more memory efficient if no meta info gets added.
 
+      Values are kept in a single vector sorted by index, so a MetaInfo is
+      not larger than a vector and needs at most one allocation for its
+      values.
+
       @ingroup Metadata
   */
   class OPENMS_DLLAPI MetaInfo
@@ -126,13 +128,21 @@ public:
     void clear();
 
 private:
-    using MapType = boost::container::flat_map<UInt, DataValue>;
+    /// An index with its value
+    struct Entry_
+    {
+      UInt index;
+      DataValue value;
+    };
+
+    /// Returns the entry with the given index, or nullptr
+    const Entry_* find_(UInt index) const;
 
     /// Static MetaInfoRegistry
     static MetaInfoRegistry registry_;
 
-    /// The actual mapping of indexes to values
-    MapType index_to_value_;
+    /// All values, sorted by index
+    std::vector<Entry_> entries_;
   };
 
 } // namespace OpenMS
@@ -34,8 +34,11 @@
 
 #pragma once
 
-#include <map>
+#include <atomic>
+#include <deque>
+#include <memory>
 #include <string>
+#include <vector>
 
 #include <OpenMS/CONCEPT/Exception.h>
 #include <OpenMS/CONCEPT/Types.h>
@@ -70,6 +73,15 @@ namespace OpenMS
       12 - low_quality<BR>
       13 - charge<BR>
 
+      Names can only be added, never removed, so the mapping between names and
+      indices is kept in append-only tables that are read without locking:
+      getIndex() and getName() never block, even while other threads register
+      new names. Registration and the description/unit accessors are
+      serialized. Tables replaced while growing are kept until the next
+      assignment; as they double in size, they take at most as much memory as
+      the current table. Assignment replaces all names and frees the previous
+      storage, so it must not run concurrently with any other access.
+
       @ingroup Metadata
   */
   class OPENMS_DLLAPI MetaInfoRegistry
@@ -161,15 +173,51 @@ public:
     String getUnit(const String& name) const;
 
 private:
+    /// A registered name and its index (never changed or freed while the registry exists)
+    struct Entry_
+    {
+      std::string name;
+      UInt index;
+    };
+
+    /// Slot array of a lock-free table; slots are set once and never cleared
+    struct Table_
+    {
+      explicit Table_(Size cap);
+
+      Size capacity;
+      std::unique_ptr<std::atomic<const Entry_*>[]> slots;
+    };
+
+    /// Adds a new entry to all tables (the caller must hold the registry lock)
+    void insert_(const std::string& name, UInt index, const std::string& description, const std::string& unit);
+
+    /// Puts @p entry into the open addressing hash table @p table
+    static void placeName_(Table_& table, const Entry_* entry);
+
+    /// Looks up a name without locking, returns nullptr if it is not registered
+    const Entry_* findName_(const std::string& name) const;
+
+    /// Looks up an index without locking, returns nullptr if it is not registered
+    const Entry_* findIndex_(UInt index) const;
+
+    /// Resets to an empty registry and frees all storage (the caller must hold the registry lock)
+    void reset_();
+
     /// internal counter, that stores the next index to assign
     UInt next_index_;
-    using MapString2IndexType = std::unordered_map<std::string, UInt>;
     using MapIndex2StringType = std::unordered_map<UInt, std::string>;
-    
-    /// map from name to index
-    MapString2IndexType name_to_index_;
-    /// map from index to name
-    MapIndex2StringType index_to_name_;
+
+    /// storage of all registered names (deque: entries never move)
+    std::deque<Entry_> entries_;
+    /// number of names in the hash table
+    Size name_count_;
+    /// current hash table from name to entry
+    std::atomic<Table_*> name_table_;
+    /// current table from index to entry
+    std::atomic<Table_*> index_table_;
+    /// all tables published since the last reset; tables replaced by growth are kept so that concurrent readers never see freed memory
+    std::vector<std::unique_ptr<Table_> > tables_;
     /// map from index to description
     MapIndex2StringType index_to_description_;
     /// map from index to unit
@@ -110,8 +110,9 @@ protected:
      @param feature The feature which should be simulated
      @param experiment The experiment to which the simulated signals should be added
      @param experiment_ct Ground truth for picked peaks
+     @param rng Random number stream of this feature
      */
-    void add1DSignal_(Feature& feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct);
+    void add1DSignal_(Feature& feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct, SimTypes::PhiloxRandomEngine& rng);
 
     /**
      @brief Add a 2D signal for a single feature
@@ -119,8 +120,9 @@ protected:
      @param feature The feature which should be simulated
      @param experiment The experiment to which the simulated signals should be added
      @param experiment_ct Ground truth for picked peaks
+     @param rng Random number stream of this feature
      */
-    void add2DSignal_(Feature& feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct);
+    void add2DSignal_(Feature& feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct, SimTypes::PhiloxRandomEngine& rng);
 
     /**
      @brief Samples signals for the given 1D model
@@ -131,13 +133,15 @@ protected:
      @param experiment Experiment to which the sampled signals will be added
      @param experiment_ct Experiment to which the centroided Ground Truth sampled signals will be added
      @param activeFeature The current feature that is simulated
+     @param rng Random number stream of the current feature
      */
     void samplePeptideModel1D_(const IsotopeModel& iso,
                                const SimTypes::SimCoordinateType mz_start,
                                const SimTypes::SimCoordinateType mz_end,
                                SimTypes::MSSimExperiment& experiment,
                                SimTypes::MSSimExperiment& experiment_ct,
-                               Feature& activeFeature);
+                               Feature& activeFeature,
+                               SimTypes::PhiloxRandomEngine& rng);
 
     /**
      @brief Samples signals for the given 2D model
@@ -150,6 +154,7 @@ protected:
      @param experiment Experiment to which the sampled signals will be added
      @param experiment_ct Experiment to which the centroided Ground Truth sampled signals will be added
      @param activeFeature The current feature that is simulated
+     @param rng Random number stream of the current feature
      */
     void samplePeptideModel2D_(const ProductModel<2>& pm,
                                const SimTypes::SimCoordinateType mz_start,
@@ -158,7 +163,8 @@ protected:
                                SimTypes::SimCoordinateType rt_end,
                                SimTypes::MSSimExperiment& experiment,
                                SimTypes::MSSimExperiment& experiment_ct,
-                               Feature& activeFeature);
+                               Feature& activeFeature,
+                               SimTypes::PhiloxRandomEngine& rng);
 
     /**
      @brief Add the correct Elution profile to the passed ProductModel
@@ -174,6 +180,14 @@ protected:
     */
     void createContaminants_(SimTypes::FeatureMapSim& contaminants, SimTypes::MSSimExperiment& exp, SimTypes::MSSimExperiment& exp_ct);
 
+    /**
+     @name Noise models
+
+     Each spectrum draws from its own random number stream (keyed by its
+     index), so spectra are processed in parallel and the result does not
+     depend on the number of threads.
+    */
+    //@{
     /// Add shot noise to the experiment
     void addShotNoise_(SimTypes::MSSimExperiment& experiment, SimTypes::SimCoordinateType minimal_mz_measurement_limit, SimTypes::SimCoordinateType maximal_mz_measurement_limit);
 
@@ -182,6 +196,7 @@ protected:
 
     /// Add detector noise to the experiment
     void addDetectorNoise_(SimTypes::MSSimExperiment& experiment);
+    //@}
 
     /// Add a base line to the experiment
     void addBaseLine_(SimTypes::MSSimExperiment& experiment, SimTypes::SimCoordinateType minimal_mz_measurement_limit);
@@ -208,11 +223,13 @@ protected:
      *
      * @param feature_intensity Intensity of the current feature.
      * @param natural_scaling_factor Additional scaling factor used by some of the sampling models.
+     * @param rng Random number stream of the current feature.
      *
      * @return Rescaled feature intensity.
      */
     SimTypes::SimIntensityType getFeatureScaledIntensity_(const SimTypes::SimIntensityType feature_intensity,
-                                                          const SimTypes::SimIntensityType natural_scaling_factor);
+                                                          const SimTypes::SimIntensityType natural_scaling_factor,
+                                                          SimTypes::PhiloxRandomEngine& rng);
 
 
     /**
@@ -261,19 +278,6 @@ protected:
 
     std::vector<ContaminantInfo> contaminants_;
 
-    /**
-    @p threaded_random_numbers keeps a set of random numbers for each thread simulating a feature.
-      */
-    std::vector<std::vector<double> > threaded_random_numbers_;
-
-    /**
-      Indicates which random numbers each thread has used already and if the random number pool
-      should be rebuild.
-      */
-    std::vector<Size> threaded_random_numbers_index_;
-
-    static const Size THREADED_RANDOM_NUMBER_POOL_SIZE_ = 500;
-
     bool contaminants_loaded_;
   };
 
@@ -101,6 +101,104 @@ namespace OpenMS
     /// Sim MSExperiment type
     typedef PeakMap MSSimExperiment;
 
+    /**
+      @brief Counter-based random number engine (Philox4x32-10)
+
+      The n-th random number of a stream is a pure function of the key, the
+      stream id and n (Salmon et al., "Parallel random numbers: as easy as
+      1, 2, 3", SC 2011). Parallel code can therefore give every work item
+      (feature, spectrum, ...) its own stream without any shared state and
+      obtains the same numbers regardless of the number of threads or the
+      order in which the work items are processed.
+
+      The class models a Boost.Random/STL uniform random number generator
+      and can be used with any distribution from Boost.Random.
+
+      @ingroup Simulation
+    */
+    class PhiloxRandomEngine
+    {
+public:
+      typedef UInt32 result_type;
+
+      /// Constructor for stream @p stream of the generator with key @p key
+      PhiloxRandomEngine(UInt64 key, UInt64 stream) :
+        key_(key),
+        stream_(stream),
+        block_(0),
+        index_(4)
+      {
+      }
+
+      static constexpr result_type min()
+      {
+        return 0;
+      }
+
+      static constexpr result_type max()
+      {
+        return 0xFFFFFFFFu;
+      }
+
+      /// Returns the next random number of the stream
+      result_type operator()()
+      {
+        if (index_ == 4)
+        {
+          generateBlock_(block_++);
+          index_ = 0;
+        }
+        return buffer_[index_++];
+      }
+
+      /// Skips the next @p n random numbers of the stream
+      void discard(UInt64 n)
+      {
+        for (; n > 0 && index_ < 4; --n) ++index_;
+        block_ += n / 4;
+        if (n % 4 != 0)
+        {
+          generateBlock_(block_++);
+          index_ = n % 4;
+        }
+      }
+
+      /// Philox4x32-10 block function (exposed for testing)
+      static void philox4x32(const UInt32 counter[4], const UInt32 key[2], UInt32 out[4])
+      {
+        UInt32 c[4] = {counter[0], counter[1], counter[2], counter[3]};
+        UInt32 k[2] = {key[0], key[1]};
+        for (int round = 0; round < 10; ++round)
+        {
+          const UInt64 p0 = UInt64(0xD2511F53u) * c[0];
+          const UInt64 p1 = UInt64(0xCD9E8D57u) * c[2];
+          const UInt32 hi0 = UInt32(p0 >> 32), lo0 = UInt32(p0);
+          const UInt32 hi1 = UInt32(p1 >> 32), lo1 = UInt32(p1);
+          c[0] = hi1 ^ c[1] ^ k[0];
+          c[1] = lo1;
+          c[2] = hi0 ^ c[3] ^ k[1];
+          c[3] = lo0;
+          k[0] += 0x9E3779B9u;
+          k[1] += 0xBB67AE85u;
+        }
+        out[0] = c[0]; out[1] = c[1]; out[2] = c[2]; out[3] = c[3];
+      }
+
+private:
+      void generateBlock_(UInt64 block)
+      {
+        const UInt32 counter[4] = {UInt32(block), UInt32(block >> 32), UInt32(stream_), UInt32(stream_ >> 32)};
+        const UInt32 key[2] = {UInt32(key_), UInt32(key_ >> 32)};
+        philox4x32(counter, key, buffer_);
+      }
+
+      UInt64 key_;
+      UInt64 stream_;
+      UInt64 block_; ///< next block (counter) to generate
+      Size index_; ///< position in buffer_ (4 means exhausted)
+      UInt32 buffer_[4];
+    };
+
     /**
       @brief Wrapper class for random number generators used by the simulation classes
 
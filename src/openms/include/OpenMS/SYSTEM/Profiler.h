@@ -0,0 +1,242 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/config.h>
+
+#include <OpenMS/CONCEPT/Types.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <atomic>
+#include <chrono>
+#include <iosfwd>
+#include <map>
+#include <vector>
+
+namespace OpenMS
+{
+  /**
+    @brief Lightweight, thread-safe instrumentation for hot paths (timers, counters, memory probes)
+
+    The profiler is a process-wide singleton which is disabled by default. While disabled,
+    all instrumentation (ScopedTimer, OPENMS_PROFILE_SCOPE, OPENMS_PROFILE_COUNT, ...) reduces
+    to a single relaxed atomic load, so it can stay in performance-critical code.
+
+    Once enabled (e.g. by the @em -profile option of TOPP tools), the profiler collects
+    - <b>trace events</b>: named, timed regions with start time, duration and thread number,
+    - <b>summaries</b>: number of calls, total and maximal duration per region name
+      (fine-grained regions can be accumulated without emitting individual trace events),
+    - <b>counters</b>: named integer counters, and
+    - <b>memory probes</b>: samples of the process memory consumption; the maximum is reported as peak memory.
+
+    The collected data can be written with writeTrace() or store() in the Chrome trace event
+    format (JSON), which can be opened with chrome://tracing or Perfetto. Summaries, counters
+    and peak memory are stored in the @em otherData section of the same file.
+
+    Regions which are started via ProgressLogger::startProgress() and finished via
+    ProgressLogger::endProgress() are recorded automatically (category "progress").
+
+    @code
+    void MyAlgorithm::run()
+    {
+      OPENMS_PROFILE_SCOPE("MyAlgorithm::run", "algorithm");
+      for (...)
+      {
+        OPENMS_PROFILE_ACCUMULATE("MyAlgorithm::inner", "algorithm"); // summary only
+        OPENMS_PROFILE_COUNT("MyAlgorithm::iterations", 1);
+      }
+    }
+    @endcode
+
+    @ingroup System
+  */
+  class OPENMS_DLLAPI Profiler
+  {
+public:
+    /// A timed region or a memory sample
+    struct OPENMS_DLLAPI Event
+    {
+      String name;
+      String category;
+      /// 'X' for timed regions, 'C' for (memory) samples
+      char phase;
+      /// start time in microseconds since the profiler epoch
+      double start_us;
+      /// duration in microseconds (timed regions only)
+      double duration_us;
+      /// value of a sample (memory in KB)
+      Int64 value;
+      /// OpenMP thread number which recorded the event
+      int thread;
+    };
+
+    /// Aggregated statistics of a region name
+    struct OPENMS_DLLAPI Summary
+    {
+      Size calls = 0;
+      double total_us = 0.0;
+      double max_us = 0.0;
+    };
+
+    /**
+      @brief RAII timer which reports the time between construction and destruction
+
+      If the profiler is disabled at construction time, the timer is inactive and neither
+      queries the clock nor reports anything. @p name and @p category must outlive the timer
+      (string literals are recommended).
+    */
+    class OPENMS_DLLAPI ScopedTimer
+    {
+public:
+      /**
+        @param name Name of the region
+        @param category Category of the region (e.g. "io", "decode", "scoring")
+        @param trace If false, only the summary is updated and no individual trace event is emitted (for very frequent regions)
+      */
+      ScopedTimer(const char* name, const char* category, bool trace = true) :
+        name_(name),
+        category_(category),
+        trace_(trace),
+        start_us_(Profiler::isEnabled() ? Profiler::getInstance().now() : -1.0)
+      {
+      }
+
+      ~ScopedTimer()
+      {
+        if (start_us_ >= 0.0) stop_();
+      }
+
+      ScopedTimer(const ScopedTimer&) = delete;
+      ScopedTimer& operator=(const ScopedTimer&) = delete;
+
+private:
+      void stop_();
+
+      const char* name_;
+      const char* category_;
+      bool trace_;
+      double start_us_;
+    };
+
+    /// Returns the process-wide profiler
+    static Profiler& getInstance();
+
+    /// Returns whether profiling is enabled (cheap; safe to call from hot paths)
+    static bool isEnabled()
+    {
+      return enabled_.load(std::memory_order_relaxed);
+    }
+
+    /// Enables or disables profiling. Data collected so far is kept.
+    void setEnabled(bool enabled);
+
+    /// Removes all collected data and resets the time epoch to now
+    void clear();
+
+    /// Microseconds elapsed since the profiler epoch (construction or last clear())
+    double now() const;
+
+    /// Records a finished region (trace event and summary)
+    void addEvent(const String& name, const String& category, double start_us, double duration_us);
+
+    /// Records a finished region in the summary only
+    void addSample(const String& name, double duration_us);
+
+    /// Adds @p delta to the counter @p name
+    void addCounter(const String& name, Int64 delta = 1);
+
+    /**
+      @brief Samples the memory consumption of the process and records it under @p label
+
+      The maximum over all samples (and the peak value reported by the operating system, if available)
+      is returned by getPeakMemory().
+    */
+    void recordMemory(const String& label);
+
+    /// Returns a copy of all trace events (in recording order)
+    std::vector<Event> getEvents() const;
+
+    /// Returns a copy of the summaries, by region name
+    std::map<String, Summary> getSummary() const;
+
+    /// Returns a copy of all counters
+    std::map<String, Int64> getCounters() const;
+
+    /// Peak memory consumption (in KB) observed by recordMemory(), 0 if never sampled
+    Size getPeakMemory() const;
+
+    /// Writes all data as Chrome trace event JSON to @p os
+    void writeTrace(std::ostream& os) const;
+
+    /**
+      @brief Writes all data as Chrome trace event JSON to @p filename
+
+      @exception Exception::UnableToCreateFile is thrown if the file cannot be created
+    */
+    void store(const String& filename) const;
+
+private:
+    Profiler();
+    Profiler(const Profiler&) = delete;
+    Profiler& operator=(const Profiler&) = delete;
+
+    static int currentThread_();
+
+    static std::atomic<bool> enabled_;
+
+    /// start of the time axis (ticks of std::chrono::steady_clock), atomic as now() does not lock
+    std::atomic<std::chrono::steady_clock::rep> epoch_;
+    std::vector<Event> events_;
+    std::map<String, Summary> summary_;
+    std::map<String, Int64> counters_;
+    Size peak_memory_kb_;
+  };
+
+} // namespace OpenMS
+
+#define OPENMS_PROFILE_CONCAT_IMPL_(a, b) a##b
+#define OPENMS_PROFILE_CONCAT_(a, b) OPENMS_PROFILE_CONCAT_IMPL_(a, b)
+
+/// Times the enclosing scope as a trace event (see Profiler)
+#define OPENMS_PROFILE_SCOPE(name, category) \
+  OpenMS::Profiler::ScopedTimer OPENMS_PROFILE_CONCAT_(openms_profile_scope_, __LINE__)(name, category)
+
+/// Times the enclosing scope in the summary only, for regions which are entered very often (see Profiler)
+#define OPENMS_PROFILE_ACCUMULATE(name, category) \
+  OpenMS::Profiler::ScopedTimer OPENMS_PROFILE_CONCAT_(openms_profile_scope_, __LINE__)(name, category, false)
+
+/// Adds @p delta to the profiler counter @p name (see Profiler)
+#define OPENMS_PROFILE_COUNT(name, delta) \
+  do { if (OpenMS::Profiler::isEnabled()) OpenMS::Profiler::getInstance().addCounter(name, delta); } while (false)
@@ -23,6 +23,7 @@ File.h
 FileWatcher.h
 JavaInfo.h
 NetworkGetRequest.h
+Profiler.h
 PythonInfo.h
 RWrapper.h
 StopWatch.h
@@ -168,8 +168,27 @@ protected:
     {
       FeatureFinderAlgorithmPickedHelperStructs::MassTraces* traces_ptr;
       bool weighted;
+
+      /// @name Peaks of all traces as contiguous arrays (structure of arrays), filled by fillModelData_()
+      //@{
+      std::vector<double> rts;
+      std::vector<double> intensities;
+      std::vector<double> theoretical_ints;
+      std::vector<double> weights;
+      //@}
+      double baseline;
     };
 
+    /**
+      @brief Prepares the data for the LM optimization
+
+      Copies RTs, intensities and trace weights of all peaks of @p traces into
+      contiguous arrays, so that the functors evaluate the model and its
+      Jacobian in tight loops instead of chasing peak pointers in every
+      iteration.
+    */
+    void fillModelData_(FeatureFinderAlgorithmPickedHelperStructs::MassTraces& traces, ModelData& data) const;
+
     void updateMembers_() override;
 
     /**
@@ -46,6 +46,7 @@ namespace OpenMS
 {
   class MSChromatogram;
   class OnDiscMSExperiment;
+  class ColumnarMSExperiment;
 
   /**
     @brief This class implements a fast peak-picking algorithm best suited for
@@ -166,11 +167,35 @@ public:
     */
     void pickExperiment(/* const */ OnDiscMSExperiment& input, PeakMap& output, const bool check_spectrum_type = true) const;
 
+    /**
+      @brief Applies the peak-picking algorithm to a map in columnar storage
+      (ColumnarMSExperiment). Spectra are picked in parallel and the resulting
+      picked peaks are written to the output map.
+
+      Only the compact meta data of ColumnarMSExperiment is carried over to the output spectra.
+      Peaks are picked directly from the shared m/z and intensity arrays (see
+      ColumnarMSExperiment::SpectrumView). Only spectra which are not sorted by m/z,
+      or when signal-to-noise estimation is enabled, are copied into an MSSpectrum first.
+
+      @param input  input map in profile mode
+      @param output  output map with picked peaks
+      @param check_spectrum_type  if set, checks spectrum type and throws an exception if a centroided spectrum is passed
+    */
+    void pickExperiment(const ColumnarMSExperiment& input, PeakMap& output, const bool check_spectrum_type = true) const;
+
 protected:
 
     template <typename ContainerType>
     void pick_(const ContainerType& input, ContainerType& output, std::vector<PeakBoundary>& boundaries, bool check_spacings = true) const;
 
+    /**
+      @brief Picks the peaks of @p input (any random access range of peaks, e.g. a spectrum or a ColumnarMSExperiment::SpectrumView) into @p output
+
+      @p snt is only queried if signal-to-noise estimation is enabled and must then be initialized with @p input.
+    */
+    template <typename InputType, typename OutputType, typename SignalToNoiseType>
+    void pickPeaks_(const InputType& input, OutputType& output, std::vector<PeakBoundary>& boundaries, bool check_spacings, SignalToNoiseType* snt) const;
+
     // signal-to-noise parameter
     double signal_to_noise_;
 
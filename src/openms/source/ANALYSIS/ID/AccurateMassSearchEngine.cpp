@@ -42,6 +42,8 @@
 #include <OpenMS/METADATA/ProteinIdentification.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 
+#include <algorithm>
+#include <exception>
 #include <numeric>
 
 namespace OpenMS
@@ -580,6 +582,9 @@ namespace OpenMS
       throw Exception::InvalidParameter(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Ion mode cannot be set to '") + ion_mode + "'. Must be 'positive' or 'negative'!");
     }
 
+    const std::vector<UInt64>& compatibility = (ion_mode == "positive") ? pos_adduct_compatibility_ : neg_adduct_compatibility_;
+    const Size adduct_count = it_e - it_s;
+
     std::pair<Size, Size> hit_idx;
     for (std::vector<AdductInfo>::const_iterator it = it_s; it != it_e; ++it)
     {
@@ -627,9 +632,13 @@ namespace OpenMS
       // store information from query hits in AccurateMassSearchResult objects
       for (Size i = hit_idx.first; i < hit_idx.second; ++i)
       {
-        // check if DB entry is compatible to the adduct
-        if (!it->isCompatible(EmpiricalFormula(mass_mappings_[i].formula)))
+        // check if DB entry is compatible to the adduct (precomputed in init())
+        if (!isCompatible_(compatibility, adduct_count, i, it - it_s))
         {
+          if (formula_parse_failed_[i])
+          { // throws the original parse error
+            EmpiricalFormula ef(mass_mappings_[i].formula);
+          }
           // only written if TOPP tool has --debug
           OPENMS_LOG_DEBUG << "'" << mass_mappings_[i].formula << "' cannot have adduct '" << it->getName() << "'. Omitting.\n";
           continue;
@@ -770,9 +779,82 @@ namespace OpenMS
     parseAdductsFile_(pos_adducts_fname_, pos_adducts_);
     parseAdductsFile_(neg_adducts_fname_, neg_adducts_);
 
+    computeAdductCompatibility_();
+
     is_initialized_ = true;
   }
 
+  void AccurateMassSearchEngine::queryByFeatures(const FeatureMap& fmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult> >& results) const
+  {
+    if (!is_initialized_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "AccurateMassSearchEngine::init() was not called!");
+    }
+
+    results.clear();
+    results.resize(fmap.size());
+
+    // neighboring queries hit neighboring DB entries
+    std::vector<Size> order(fmap.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&fmap](Size a, Size b) { return fmap[a].getMZ() < fmap[b].getMZ(); });
+
+    std::exception_ptr query_error;
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize k = 0; k < (SignedSize)order.size(); ++k)
+    {
+      try
+      {
+        queryByFeature(fmap[order[k]], order[k], ion_mode, results[order[k]]);
+      }
+      catch (...)
+      {
+#pragma omp critical (AccurateMassSearchEngine_error)
+        if (!query_error) query_error = std::current_exception();
+      }
+    }
+    if (query_error)
+    {
+      std::rethrow_exception(query_error);
+    }
+  }
+
+  void AccurateMassSearchEngine::queryByConsensusFeatures(const ConsensusMap& cmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult> >& results) const
+  {
+    if (!is_initialized_)
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "AccurateMassSearchEngine::init() was not called!");
+    }
+
+    const Size number_of_maps = cmap.getColumnHeaders().size();
+    results.clear();
+    results.resize(cmap.size());
+
+    // neighboring queries hit neighboring DB entries
+    std::vector<Size> order(cmap.size());
+    std::iota(order.begin(), order.end(), 0);
+    std::sort(order.begin(), order.end(), [&cmap](Size a, Size b) { return cmap[a].getMZ() < cmap[b].getMZ(); });
+
+    std::exception_ptr query_error;
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize k = 0; k < (SignedSize)order.size(); ++k)
+    {
+      try
+      {
+        queryByConsensusFeature(cmap[order[k]], order[k], number_of_maps, ion_mode, results[order[k]]);
+      }
+      catch (...)
+      {
+#pragma omp critical (AccurateMassSearchEngine_error)
+        if (!query_error) query_error = std::current_exception();
+      }
+    }
+    if (query_error)
+    {
+      std::rethrow_exception(query_error);
+    }
+  }
+
   void AccurateMassSearchEngine::run(FeatureMap& fmap, MzTab& mztab_out) const
   {
     if (!is_initialized_)
@@ -786,15 +868,16 @@ namespace OpenMS
       ion_mode_internal = resolveAutoMode_(fmap);
     }
 
+    // search all features at once
+    QueryResultsTable feature_results;
+    queryByFeatures(fmap, ion_mode_internal, feature_results);
+
     // map for storing overall results
     QueryResultsTable overall_results;
     Size dummy_count(0);
     for (Size i = 0; i < fmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results;
-
-      // std::cout << i << ": " << fmap[i].getMetaValue(3) << " mass: " << fmap[i].getMZ() << " num_traces: " << fmap[i].getMetaValue("num_of_masstraces") << " charge: " << fmap[i].getCharge() << std::endl;
-      queryByFeature(fmap[i], i, ion_mode_internal, query_results);
+      std::vector<AccurateMassSearchResult>& query_results = feature_results[i];
 
       if (query_results.size() == 0) continue; // cannot happen if a 'not-found' dummy was added
 
@@ -826,8 +909,8 @@ namespace OpenMS
       //        }
 
       // String feat_label(fmap[i].getMetaValue(3));
-      overall_results.push_back(query_results);
       annotate_(query_results, fmap[i]);
+      overall_results.push_back(std::move(query_results));
     }
     // add dummy protein identification which is required to keep peptidehits alive during store()
     fmap.getProteinIdentifications().resize(fmap.getProteinIdentifications().size() + 1);
@@ -902,14 +985,11 @@ namespace OpenMS
 
     // map for storing overall results
     QueryResultsTable overall_results;
+    queryByConsensusFeatures(cmap, ion_mode_internal, overall_results);
 
     for (Size i = 0; i < cmap.size(); ++i)
     {
-      std::vector<AccurateMassSearchResult> query_results;
-      // std::cout << i << ": " << cmap[i].getMetaValue(3) << " mass: " << cmap[i].getMZ() << " num_traces: " << cmap[i].getMetaValue("num_of_masstraces") << " charge: " << cmap[i].getCharge() << std::endl;
-      queryByConsensusFeature(cmap[i], i, num_of_maps, ion_mode_internal, query_results);
-      annotate_(query_results, cmap[i]);
-      overall_results.push_back(query_results);
+      annotate_(overall_results[i], cmap[i]);
     }
     // add dummy protein identification which is required to keep peptidehits alive during store()
     cmap.getProteinIdentifications().resize(cmap.getProteinIdentifications().size() + 1);
@@ -1455,6 +1535,50 @@ namespace OpenMS
     return;
   }
 
+  void AccurateMassSearchEngine::computeAdductCompatibility_()
+  {
+    const Size entry_count = mass_mappings_.size();
+    const Size pos_words = (pos_adducts_.size() + 63) / 64;
+    const Size neg_words = (neg_adducts_.size() + 63) / 64;
+
+    pos_adduct_compatibility_.assign(entry_count * pos_words, 0);
+    neg_adduct_compatibility_.assign(entry_count * neg_words, 0);
+    std::vector<char> parse_failed(entry_count, 0);
+
+    // each formula is parsed exactly once; entries are independent
+#pragma omp parallel for schedule(dynamic, 256)
+    for (SignedSize i = 0; i < (SignedSize)entry_count; ++i)
+    {
+      EmpiricalFormula ef;
+      try
+      {
+        ef = EmpiricalFormula(mass_mappings_[i].formula);
+      }
+      catch (Exception::BaseException&)
+      { // compatible with nothing; the error is raised once the entry is hit by a query
+        parse_failed[i] = 1;
+        continue;
+      }
+
+      for (Size a = 0; a < pos_adducts_.size(); ++a)
+      {
+        if (pos_adducts_[a].isCompatible(ef))
+        {
+          pos_adduct_compatibility_[i * pos_words + a / 64] |= UInt64(1) << (a % 64);
+        }
+      }
+      for (Size a = 0; a < neg_adducts_.size(); ++a)
+      {
+        if (neg_adducts_[a].isCompatible(ef))
+        {
+          neg_adduct_compatibility_[i * neg_words + a / 64] |= UInt64(1) << (a % 64);
+        }
+      }
+    }
+
+    formula_parse_failed_.assign(parse_failed.begin(), parse_failed.end());
+  }
+
   void AccurateMassSearchEngine::searchMass_(double neutral_query_mass, double diff_mass, std::pair<Size, Size>& hit_indices) const
   {
     //OPENMS_LOG_INFO << "searchMass: neutral_query_mass=" << neutral_query_mass << " diff_mz=" << diff_mz << " ppm allowed:" << mass_error_value_ << std::endl;
@@ -466,14 +466,18 @@ namespace OpenMS
     wm.filterPeakMap(msexp);
 
 
-    // container storing results
-    vector<SpectralMatch> matching_results;
+    // results per query spectrum (concatenated in spectrum order after the parallel search)
+    vector<vector<SpectralMatch> > spectrum_results(msexp.size());
 
     bool fragment_error_unit_ppm(true);
     if (mz_error_unit_ == "Da") { fragment_error_unit_ppm = false; }
 
-    for (Size spec_idx = 0; spec_idx < msexp.size(); ++spec_idx)
+    // query spectra are scored independently against the (read-only) database
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize spec_idx = 0; spec_idx < (SignedSize)msexp.size(); ++spec_idx)
     {
+      vector<SpectralMatch>& matching_results = spectrum_results[spec_idx];
+
       // cout << "merged spectrum no. " << spec_idx << " with #fragment ions: " << msexp[spec_idx].size() << endl;
 
       // iterate over all precursor masses
@@ -580,6 +584,13 @@ namespace OpenMS
       } // end precursor loop
     } // end spectra loop
 
+    // container storing results
+    vector<SpectralMatch> matching_results;
+    for (const vector<SpectralMatch>& results : spectrum_results)
+    {
+      matching_results.insert(matching_results.end(), results.begin(), results.end());
+    }
+
     // write final results to MzTab
     exportMzTab_(matching_results, mztab_out);
   }
@@ -184,6 +184,19 @@ namespace OpenMS
     // add last partition (a bit more since we use "smaller than" below)
     partition_boundaries.push_back(massrange.back() + 1.0);
 
+    // assign the features of all maps to their partitions (in one pass, instead of scanning all maps for every partition)
+    vector<vector<vector<Size> > > partition_features(partition_boundaries.size() - 1, vector<vector<Size> >(input_maps.size()));
+    for (Size k = 0; k < input_maps.size(); ++k)
+    {
+      for (Size m = 0; m < input_maps[k].size(); ++m)
+      {
+        // partition j covers [partition_boundaries[j], partition_boundaries[j+1])
+        Size j = std::upper_bound(partition_boundaries.begin(), partition_boundaries.end(), input_maps[k][m].getMZ()) - partition_boundaries.begin();
+        if (j == 0 || j == partition_boundaries.size()) continue;
+        partition_features[j - 1][k].push_back(m);
+      }
+    }
+
     // ------------ compute RT transformation models ------------
 
     MapAlignmentAlgorithmKD aligner(input_maps.size(), param_);
@@ -194,25 +207,8 @@ namespace OpenMS
       startProgress(0, partition_boundaries.size(), "computing RT transformations");
       for (size_t j = 0; j < partition_boundaries.size()-1; j++)
       {
-        double partition_start = partition_boundaries[j];
-        double partition_end = partition_boundaries[j+1];
-
-        std::vector<MapType> tmp_input_maps(input_maps.size());
-        for (size_t k = 0; k < input_maps.size(); k++)
-        {
-          // iterate over all features in the current input map and append
-          // matching features (within the current partition) to the temporary
-          // map
-          for (size_t m = 0; m < input_maps[k].size(); m++)
-          {
-            if (input_maps[k][m].getMZ() >= partition_start &&
-                input_maps[k][m].getMZ() < partition_end)
-            {
-              tmp_input_maps[k].push_back(input_maps[k][m]);
-            }
-          }
-          tmp_input_maps[k].updateRanges();
-        }
+        std::vector<MapType> tmp_input_maps;
+        extractPartition_(input_maps, partition_features[j], tmp_input_maps);
 
         // set up kd-tree
         KDTreeFeatureMaps kd_data(tmp_input_maps, param_);
@@ -235,29 +231,19 @@ namespace OpenMS
     }
 
     // ------------ run alignment + feature linking on individual partitions ------------
+    // The partitions are independent (see above), so they are linked in
+    // parallel. Results are collected per partition and appended to the
+    // output in partition order, which gives the same result as serial
+    // processing.
+    const SignedSize num_partitions = partition_boundaries.size() - 1;
+    vector<ConsensusMap> partition_results(num_partitions);
     Size progress = 0;
     startProgress(0, partition_boundaries.size(), "linking features");
-    for (size_t j = 0; j < partition_boundaries.size()-1; j++)
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize j = 0; j < num_partitions; j++)
     {
-      double partition_start = partition_boundaries[j];
-      double partition_end = partition_boundaries[j+1];
-
-      std::vector<MapType> tmp_input_maps(input_maps.size());
-      for (size_t k = 0; k < input_maps.size(); k++)
-      {
-        // iterate over all features in the current input map and append
-        // matching features (within the current partition) to the temporary
-        // map
-        for (size_t m = 0; m < input_maps[k].size(); m++)
-        {
-          if (input_maps[k][m].getMZ() >= partition_start &&
-              input_maps[k][m].getMZ() < partition_end)
-          {
-            tmp_input_maps[k].push_back(input_maps[k][m]);
-          }
-        }
-        tmp_input_maps[k].updateRanges();
-      }
+      std::vector<MapType> tmp_input_maps;
+      extractPartition_(input_maps, partition_features[j], tmp_input_maps);
 
       // set up kd-tree
       KDTreeFeatureMaps kd_data(tmp_input_maps, param_);
@@ -268,15 +254,45 @@ namespace OpenMS
         aligner.transform(kd_data);
       }
 
-      // link features
-      runClustering_(kd_data, out);
+      // link features (the distance functor caches m/z normalization, so each partition uses its own copy)
+      FeatureDistance feature_distance(feature_distance_);
+      runClustering_(kd_data, partition_results[j], feature_distance);
+
+#pragma omp critical (FeatureGroupingAlgorithmKD_progress)
       setProgress(progress++);
     }
     endProgress();
 
+    for (ConsensusMap& partition_result : partition_results)
+    {
+      for (ConsensusFeature& cf : partition_result)
+      {
+        out.push_back(std::move(cf));
+      }
+      partition_result.clear(true);
+    }
+
     postprocess_(input_maps, out);
   }
 
+  template <typename MapType>
+  void FeatureGroupingAlgorithmKD::extractPartition_(const vector<MapType>& input_maps,
+                                                     const vector<vector<Size> >& feature_indices,
+                                                     vector<MapType>& partition_maps) const
+  {
+    partition_maps.clear();
+    partition_maps.resize(input_maps.size());
+    for (Size k = 0; k < input_maps.size(); ++k)
+    {
+      partition_maps[k].reserve(feature_indices[k].size());
+      for (Size m : feature_indices[k])
+      {
+        partition_maps[k].push_back(input_maps[k][m]);
+      }
+      partition_maps[k].updateRanges();
+    }
+  }
+
   void FeatureGroupingAlgorithmKD::group(const std::vector<FeatureMap>& maps,
                                          ConsensusMap& out)
   {
@@ -289,7 +305,7 @@ namespace OpenMS
     group_(maps, out);
   }
 
-  void FeatureGroupingAlgorithmKD::runClustering_(const KDTreeFeatureMaps& kd_data, ConsensusMap& out)
+  void FeatureGroupingAlgorithmKD::runClustering_(const KDTreeFeatureMaps& kd_data, ConsensusMap& out, FeatureDistance& feature_distance) const
   {
     Size n = kd_data.size();
 
@@ -302,7 +318,7 @@ namespace OpenMS
     set<ClusterProxyKD> potential_clusters;
     vector<ClusterProxyKD> cluster_for_idx(n);
     vector<Int> assigned(n, false);
-    updateClusterProxies_(potential_clusters, cluster_for_idx, update_these, assigned, kd_data);
+    updateClusterProxies_(potential_clusters, cluster_for_idx, update_these, assigned, kd_data, feature_distance);
 
     // pass 2: construct consensus features until all points assigned.
     while (!potential_clusters.empty())
@@ -312,7 +328,7 @@ namespace OpenMS
 
       // compile the actual list of sub feature indices for cluster with center i
       vector<Size> cf_indices;
-      computeBestClusterForCenter_(i, cf_indices, assigned, kd_data);
+      computeBestClusterForCenter_(i, cf_indices, assigned, kd_data, feature_distance);
 
       // add consensus feature
       addConsensusFeature_(cf_indices, kd_data, out);
@@ -340,7 +356,7 @@ namespace OpenMS
       }
 
       // now that the points are marked assigned, update the neighborhoods of their neighbors
-      updateClusterProxies_(potential_clusters, cluster_for_idx, update_these, assigned, kd_data);
+      updateClusterProxies_(potential_clusters, cluster_for_idx, update_these, assigned, kd_data, feature_distance);
     }
   }
 
@@ -350,14 +366,15 @@ namespace OpenMS
                                                          vector<ClusterProxyKD>& cluster_for_idx,
                                                          const set<Size>& update_these,
                                                          const vector<Int>& assigned,
-                                                         const KDTreeFeatureMaps& kd_data)
+                                                         const KDTreeFeatureMaps& kd_data,
+                                                         FeatureDistance& feature_distance) const
   {
     for (set<Size>::const_iterator it = update_these.begin(); it != update_these.end(); ++it)
     {
       Size i = *it;
       const ClusterProxyKD& old_proxy = cluster_for_idx[i];
       vector<Size> unused;
-      ClusterProxyKD new_proxy = computeBestClusterForCenter_(i, unused, assigned, kd_data);
+      ClusterProxyKD new_proxy = computeBestClusterForCenter_(i, unused, assigned, kd_data, feature_distance);
 
       // only need to update if size and/or average distance have changed
       if (new_proxy != old_proxy)
@@ -369,7 +386,7 @@ namespace OpenMS
     }
   }
 
-  ClusterProxyKD FeatureGroupingAlgorithmKD::computeBestClusterForCenter_(Size i, vector<Size>& cf_indices, const vector<Int>& assigned, const KDTreeFeatureMaps& kd_data) const
+  ClusterProxyKD FeatureGroupingAlgorithmKD::computeBestClusterForCenter_(Size i, vector<Size>& cf_indices, const vector<Int>& assigned, const KDTreeFeatureMaps& kd_data, FeatureDistance& feature_distance) const
   {
     //Parameters how to use charge/adduct information
     String merge_charge(param_.getValue("link:charge_merging").toString());
@@ -471,8 +488,7 @@ namespace OpenMS
       Size best_index = numeric_limits<Size>::max();
       for (vector<Size>::const_iterator c_it = candidates.begin(); c_it != candidates.end(); ++c_it)
       {
-        double dist = const_cast<FeatureDistance&>(feature_distance_)(*(kd_data.feature(*c_it)),
-                                                                      *(kd_data.feature(i))).second;
+        double dist = feature_distance(*(kd_data.feature(*c_it)), *(kd_data.feature(i))).second;
 
         if (dist < min_dist)
         {
@@ -46,6 +46,8 @@
 
 #include <include/OpenMS/APPLICATIONS/MapAlignerBase.h>
 
+#include <exception>
+
 using namespace std;
 
 namespace OpenMS
@@ -163,13 +165,30 @@ namespace OpenMS
   void MapAlignmentAlgorithmTreeGuided::buildTree(std::vector<FeatureMap>& feature_maps, std::vector<BinaryTreeNode>& tree,
                                                   std::vector<std::vector<double>>& maps_ranges)
   {
+    if (feature_maps.empty())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No feature maps given. Cannot build an alignment tree!");
+    }
+
     vector<SeqAndRTList> maps_seq_and_rt(feature_maps.size());
     extractSeqAndRt_(feature_maps, maps_seq_and_rt, maps_ranges);
     PeptideIdentificationsPearsonDistance_ pep_dist;
     AverageLinkage al;
-    DistanceMatrix<float> dist_matrix; // will be filled
     ClusterHierarchical ch;
 
+    // fill the distance matrix in parallel (ClusterHierarchical::cluster() only computes it if the dimension does not fit)
+    const SignedSize num_maps = maps_seq_and_rt.size();
+    DistanceMatrix<float> dist_matrix(num_maps, 1);
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < num_maps; ++i)
+    {
+      for (SignedSize j = 0; j < i; ++j)
+      {
+        // distance value is 1-similarity value, since similarity is in range of [0,1]
+        dist_matrix.setValueQuick(i, j, 1 - pep_dist(maps_seq_and_rt[i], maps_seq_and_rt[j]));
+      }
+    }
+
     ch.cluster<SeqAndRTList, PeptideIdentificationsPearsonDistance_>(maps_seq_and_rt, pep_dist, al, tree, dist_matrix);
   }
 
@@ -180,9 +199,10 @@ namespace OpenMS
                                                             FeatureMap& map_transformed,
                                                             std::vector<Size>& trafo_order)
   {
-    Size last_trafo = 0;  // to get final transformation order from map_sets
-    vector<TransformationDescription> transformations_align;  // temporary for aligner output
-    vector<FeatureMap> to_align;
+    if (feature_maps_transformed.empty())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No feature maps given. Cannot align!");
+    }
 
     // helper to memorize rt transformation order
     vector<vector<Size>> map_sets(feature_maps_transformed.size());
@@ -191,9 +211,6 @@ namespace OpenMS
       map_sets[i].push_back(i);
     }
 
-    Size ref;
-    Size to_transform;
-
     // check RT ranges of IDs
     for (size_t i = 0; i < maps_ranges.size(); ++i)
     {
@@ -202,65 +219,102 @@ namespace OpenMS
       if (maps_ranges[i].empty()) throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "FeatureMap originating from '" + ListUtils::concatenate(p, "', '") + "' contains no Peptide Identifications. Cannot align!");
     }
 
-    for (const auto& node : tree)
+    // Group the tree nodes into rounds: a node can be aligned as soon as both of its clusters are complete.
+    // All nodes of one round combine disjoint clusters (i.e. independent subtrees) and are aligned concurrently.
+    vector<Size> next_round(feature_maps_transformed.size(), 0);
+    vector<vector<Size>> rounds;
+    for (Size n = 0; n < tree.size(); ++n)
     {
-      // ----------------
-      // prepare alignment
-      // ----------------
-      //  determine the map with larger RT range for 10/90 percentile (->reference)
-      double left_range = maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.9] - maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.1];
-      double right_range = maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.9] - maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.1];
-
-      if (left_range > right_range)
-      {
-        ref = node.left_child;
-        to_transform = node.right_child;
-      }
-      else
+      const Size round = std::max(next_round[tree[n].left_child], next_round[tree[n].right_child]);
+      if (round == rounds.size())
       {
-        ref = node.right_child;
-        to_transform = node.left_child;
+        rounds.emplace_back();
       }
+      rounds[round].push_back(n);
+      next_round[tree[n].left_child] = round + 1;
+      next_round[tree[n].right_child] = round + 1;
+    }
 
-      vector<double> tmp;
-      std::merge(maps_ranges[node.right_child].begin(), maps_ranges[node.right_child].end(), maps_ranges[node.left_child].begin(), maps_ranges[node.left_child].end(), std::back_inserter(tmp));
-
-      to_align.push_back(feature_maps_transformed[to_transform]);
-      to_align.push_back(feature_maps_transformed[ref]);
-
-      // ----------------
-      // perform alignment
-      // ----------------
-      align_algorithm_.align(to_align, transformations_align, 1);
-
-      // transform retention times of non-identity for next iteration
-      transformations_align[0].fitModel(model_type_, model_param_);
-      MapAlignmentTransformer::transformRetentionTimes(feature_maps_transformed[to_transform],
-              transformations_align[0], true);
-
-      // combine aligned maps, store at smaller index, because tree always calls smaller number
-      // clear feature map at larger index to save memory
-      feature_maps_transformed[ref] += feature_maps_transformed[to_transform];
-      feature_maps_transformed[ref].updateRanges();
-      if (ref < to_transform)
+    for (const vector<Size>& round_nodes : rounds)
+    {
+      std::exception_ptr alignment_error;
+#pragma omp parallel for schedule(dynamic)
+      for (SignedSize r = 0; r < (SignedSize)round_nodes.size(); ++r)
       {
-        feature_maps_transformed[to_transform].clear(true);
-        last_trafo = ref;
+        const BinaryTreeNode& node = tree[round_nodes[r]];
+        try
+        {
+          // ----------------
+          // prepare alignment
+          // ----------------
+          //  determine the map with larger RT range for 10/90 percentile (->reference)
+          double left_range = maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.9] - maps_ranges[node.left_child][maps_ranges[node.left_child].size()*0.1];
+          double right_range = maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.9] - maps_ranges[node.right_child][maps_ranges[node.right_child].size()*0.1];
+
+          Size ref = node.right_child;
+          Size to_transform = node.left_child;
+          if (left_range > right_range)
+          {
+            ref = node.left_child;
+            to_transform = node.right_child;
+          }
+
+          // hand the maps over to the aligner without copying them
+          vector<FeatureMap> to_align(2);
+          to_align[0].swap(feature_maps_transformed[to_transform]);
+          to_align[1].swap(feature_maps_transformed[ref]);
+
+          // ----------------
+          // perform alignment
+          // ----------------
+          // the aligner keeps state (reference, progress), so every node gets its own instance
+          MapAlignmentAlgorithmIdentification aligner;
+          aligner.setParameters(align_algorithm_.getParameters());
+          aligner.setLogType(getLogType());
+          vector<TransformationDescription> transformations_align;  // temporary for aligner output
+          aligner.align(to_align, transformations_align, 1);
+
+          to_align[0].swap(feature_maps_transformed[to_transform]);
+          to_align[1].swap(feature_maps_transformed[ref]);
+
+          // transform retention times of non-identity for next iteration
+          transformations_align[0].fitModel(model_type_, model_param_);
+          MapAlignmentTransformer::transformRetentionTimes(feature_maps_transformed[to_transform],
+                  transformations_align[0], true);
+
+          // combine aligned maps, store at smaller index, because tree always calls smaller number
+          // clear feature map at larger index to save memory
+          feature_maps_transformed[ref] += feature_maps_transformed[to_transform];
+          feature_maps_transformed[ref].updateRanges();
+          if (ref > to_transform)
+          {
+            feature_maps_transformed[to_transform].swap(feature_maps_transformed[ref]);
+          }
+          feature_maps_transformed[std::max(ref, to_transform)].clear(true);
+
+          // update order of alignment for both aligned maps
+          map_sets[ref].insert(map_sets[ref].end(), map_sets[to_transform].begin(), map_sets[to_transform].end());
+          map_sets[to_transform] = map_sets[ref];
+        }
+        catch (...)
+        {
+#pragma omp critical (MapAlignmentAlgorithmTreeGuided_error)
+          if (!alignment_error) alignment_error = std::current_exception();
+        }
       }
-      else
+      if (alignment_error)
       {
-        feature_maps_transformed[to_transform] = feature_maps_transformed[ref];
-        feature_maps_transformed[ref].clear(true);
-        last_trafo = to_transform;
+        std::rethrow_exception(alignment_error);
       }
+    }
 
-      // update order of alignment for both aligned maps
-      map_sets[ref].insert(map_sets[ref].end(), map_sets[to_transform].begin(), map_sets[to_transform].end());
-      map_sets[to_transform] = map_sets[ref];
-
-      transformations_align.clear();
-      to_align.clear();
+    // the last node holds the combination of all maps (at the smaller index of its clusters)
+    Size last_trafo = 0;  // to get final transformation order from map_sets
+    if (!tree.empty())
+    {
+      last_trafo = std::min(tree.back().left_child, tree.back().right_child);
     }
+
     // copy last transformed FeatureMap for reference return
     map_transformed = feature_maps_transformed[last_trafo];
     trafo_order = map_sets[last_trafo];
@@ -37,6 +37,10 @@
 #include <OpenMS/MATH/STATISTICS/BasicStatistics.h>
 #include <OpenMS/MATH/MISC/LinearInterpolation.h>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 
 // #define Debug_PoseClusteringAffineSuperimposer
 
@@ -145,6 +149,12 @@ namespace OpenMS
     round, only consider quadruplets where the scaling factor matches the
     estimated bounds of (scale_low_1,scale_high_1), discard all other data.
 
+    The m/z windows around each point are computed once up front, so that the
+    outer loop (i) has no loop-carried state and can be distributed over
+    threads. Each thread votes into its own copy of the histograms, which are
+    summed up in thread order afterwards (deterministic for a given number of
+    threads). Dumping pairs forces serial execution to keep the file ordered.
+
   */
   void affineTransformationHashing(const bool do_dump_pairs,
                                    const std::vector<Peak2D> & model_map,
@@ -164,6 +174,8 @@ namespace OpenMS
                                    const double scale_high_1,
                                    const double rt_low, const double rt_high)
   {
+    typedef Math::LinearInterpolation<double, double> LinearInterpolationType_;
+
     Size const model_map_size = model_map.size();   // i j
     Size const scene_map_size = scene_map.size();   // k l
 
@@ -176,37 +188,86 @@ namespace OpenMS
       dump_pairs_file << "#" << ' ' << "i" << ' ' << "j" << ' ' << "k" << ' ' << "l" << ' ' << std::endl;
     }
 
-    // first point in model map (i)
-    for (Size i = 0, i_low = 0, i_high = 0, k_low = 0, k_high = 0; i < model_map_size - 1; ++i)
+    // Precompute the m/z windows around each point of the model map (both
+    // maps are sorted by m/z, so two sweeping pointers suffice):
+    //   - model_winlength_factor[i]: weight of the window around i in the model map
+    //   - [scene_low[i], scene_high[i]): features of the scene map within the
+    //     m/z distance of item i from the model map, weight scene_winlength_factor[i]
+    // The weight is inverse proportional to the number of elements with similar
+    // m/z; a value <= 0 means that there are too many features in the window.
+    std::vector<double> model_winlength_factor(model_map_size);
+    std::vector<double> scene_winlength_factor(model_map_size);
+    std::vector<Size> scene_low(model_map_size);
+    std::vector<Size> scene_high(model_map_size);
+    for (Size i = 0, i_low = 0, i_high = 0, k_low = 0, k_high = 0; i < model_map_size; ++i)
     {
-      // Adjust window around i in model map (get all features in a m/z range of item i in the model map)
-      while (i_low < model_map_size && model_map[i_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
+      const double mz_min = model_map[i].getMZ() - mz_pair_max_distance;
+      const double mz_max = model_map[i].getMZ() + mz_pair_max_distance;
+      while (i_low < model_map_size && model_map[i_low].getMZ() < mz_min)
         ++i_low;
-      while (i_high < model_map_size && model_map[i_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
+      while (i_high < model_map_size && model_map[i_high].getMZ() <= mz_max)
         ++i_high;
+      while (k_low < scene_map_size && scene_map[k_low].getMZ() < mz_min)
+        ++k_low;
+      while (k_high < scene_map_size && scene_map[k_high].getMZ() <= mz_max)
+        ++k_high;
+      model_winlength_factor[i] = 1. / (i_high - i_low) - winlength_factor_baseline;
+      scene_winlength_factor[i] = (k_high > k_low) ? 1. / (k_high - k_low) - winlength_factor_baseline : 0.;
+      scene_low[i] = k_low;
+      scene_high[i] = k_high;
+    }
+
+    // per-thread histograms (flat copies of the shared ones, zeroed)
+    int num_threads = 1;
+#ifdef _OPENMP
+    if (!do_dump_pairs) num_threads = omp_get_max_threads();
+#endif
+    std::vector<LinearInterpolationType_*> hashes;
+    if (hashing_round == 1)
+    {
+      hashes.push_back(&scaling_hash_1);
+    }
+    else
+    {
+      hashes.push_back(&scaling_hash_2);
+      hashes.push_back(&rt_low_hash_);
+      hashes.push_back(&rt_high_hash_);
+    }
+    std::vector<std::vector<LinearInterpolationType_> > thread_hashes(num_threads);
+    for (std::vector<LinearInterpolationType_>& local : thread_hashes)
+    {
+      for (const LinearInterpolationType_* hash : hashes)
+      {
+        local.push_back(*hash);
+        std::fill(local.back().getData().begin(), local.back().getData().end(), 0.0);
+      }
+    }
+
+    // first point in model map (i)
+    const SignedSize num_i = SignedSize(model_map_size) - 1;
+#pragma omp parallel for num_threads(num_threads) schedule(static, 1)
+    for (SignedSize si = 0; si < num_i; ++si)
+    {
+      const Size i = Size(si);
       // stop if there are too many features are in our window
-      double i_winlength_factor = 1. / (i_high - i_low);
-      i_winlength_factor -= winlength_factor_baseline;
+      const double i_winlength_factor = model_winlength_factor[i];
       if (i_winlength_factor <= 0)
         continue;
 
-      // Adjust window around k in scene map (get all features in a m/z range of item i in the scene map)
-      while (k_low < scene_map_size && scene_map[k_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
-        ++k_low;
-      while (k_high < scene_map_size && scene_map[k_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
-        ++k_high;
+      int thread_num = 0;
+#ifdef _OPENMP
+      thread_num = omp_get_thread_num();
+#endif
+      std::vector<LinearInterpolationType_>& local_hashes = thread_hashes[thread_num];
 
       // Iterate through all matching features in the scene map that are
       // within the m/z distance of item i from the model map.
       // first point in scene map (k)
-      for (Size k = k_low; k < k_high; ++k)
+      const double k_winlength_factor = scene_winlength_factor[i];
+      if (k_winlength_factor <= 0)
+        continue;
+      for (Size k = scene_low[i]; k < scene_high[i]; ++k)
       {
-        // stop if there are too many features are in our window
-        double k_winlength_factor = 1. / (k_high - k_low);
-        k_winlength_factor -= winlength_factor_baseline;
-        if (k_winlength_factor <= 0)
-          continue;
-
         // compute similarity of intensities i k by taking the ratio of the two intensities
         double similarity_ik;
         {
@@ -219,39 +280,27 @@ namespace OpenMS
         }
 
         // second point in model map (j)
-        for (Size j = i + 1, j_low = i_low, j_high = i_low, l_low = k_low, l_high = k_high; j < model_map_size; ++j)
+        for (Size j = i + 1; j < model_map_size; ++j)
         {
           // diff in model map -> skip features that are too far away in RT
-          double diff_model = model_map[j].getRT() - model_map[i].getRT();
+          const double diff_model = model_map[j].getRT() - model_map[i].getRT();
           if (fabs(diff_model) < rt_pair_min_distance)
             continue;
 
-          // Adjust window around j in model map
-          while (j_low < model_map_size && model_map[j_low].getMZ() < model_map[i].getMZ() - mz_pair_max_distance)
-            ++j_low;
-          while (j_high < model_map_size && model_map[j_high].getMZ() <= model_map[i].getMZ() + mz_pair_max_distance)
-            ++j_high;
-          double j_winlength_factor = 1. / (j_high - j_low);
-          j_winlength_factor -= winlength_factor_baseline;
-          if (j_winlength_factor <= 0)
-            continue;
+          // the window for j is taken around the m/z of i (as i and j are
+          // weighted by the same window, its factor is the one of i)
+          const double j_winlength_factor = i_winlength_factor;
 
-          // Adjust window around l in scene map
-          while (l_low < scene_map_size && scene_map[l_low].getMZ() < model_map[j].getMZ() - mz_pair_max_distance)
-            ++l_low;
-          while (l_high < scene_map_size && scene_map[l_high].getMZ() <= model_map[j].getMZ() + mz_pair_max_distance)
-            ++l_high;
+          // window around l in scene map
+          const double l_winlength_factor = scene_winlength_factor[j];
+          if (l_winlength_factor <= 0)
+            continue;
 
           // second point in scene map (l)
-          for (Size l = l_low; l < l_high; ++l)
+          for (Size l = scene_low[j]; l < scene_high[j]; ++l)
           {
-            double l_winlength_factor = 1. / (l_high - l_low);
-            l_winlength_factor -= winlength_factor_baseline;
-            if (l_winlength_factor <= 0)
-              continue;
-
             // diff in scene map -> skip features that are too far away in RT
-            double diff_scene = scene_map[l].getRT() - scene_map[k].getRT();
+            const double diff_scene = scene_map[l].getRT() - scene_map[k].getRT();
 
             // avoid cross mappings (i,j) -> (k,l) (e.g. i_rt < j_rt and k_rt > l_rt)
             // and point pairs with equal retention times (e.g. i_rt == j_rt)
@@ -259,8 +308,14 @@ namespace OpenMS
               continue;
 
             // compute the transformation (i,j) -> (k,l)
-            double scaling = diff_model / diff_scene;
-            double shift = model_map[i].getRT() - scene_map[k].getRT() * scaling;
+            const double scaling = diff_model / diff_scene;
+
+            // hash the images of scaling, rt_low and rt_high into their respective hash tables
+            // store the scaling parameter and the (estimated) transformation of start/end of the maps in hashes
+            //   -> in round 2, discard values outside of scale_low_1 and
+            //   scale_high_1 (estimated before in scalingEstimate)
+            if (hashing_round != 1 && (scaling < scale_low_1 || scaling > scale_high_1))
+              continue;
 
             // compute similarity of intensities i k j l
             double similarity_ik_jl;
@@ -275,24 +330,21 @@ namespace OpenMS
               similarity_ik_jl = similarity_ik * similarity_jl;
             }
 
-            // hash the images of scaling, rt_low and rt_high into their respective hash tables
-            // store the scaling parameter and the (estimated) transformation of start/end of the maps in hashes
-            //   -> in round 2, discard values outside of scale_low_1 and
-            //   scale_high_1 (estimated before in scalingEstimate)
             if (hashing_round == 1)
             {
               // hashing round 1 (estimate the scaling only)
-              scaling_hash_1.addValue(log(scaling), similarity_ik_jl);
+              local_hashes[0].addValue(log(scaling), similarity_ik_jl);
             }
-            else if (scaling >= scale_low_1 && scaling <= scale_high_1)
+            else
             {
               // hashing round 2 (estimate scaling and shift)
-              scaling_hash_2.addValue(log(scaling), similarity_ik_jl);
+              local_hashes[0].addValue(log(scaling), similarity_ik_jl);
 
+              const double shift = model_map[i].getRT() - scene_map[k].getRT() * scaling;
               const double rt_low_image = shift + rt_low * scaling;
-              rt_low_hash_.addValue(rt_low_image, similarity_ik_jl);
+              local_hashes[1].addValue(rt_low_image, similarity_ik_jl);
               const double rt_high_image = shift + rt_high * scaling;
-              rt_high_hash_.addValue(rt_high_image, similarity_ik_jl);
+              local_hashes[2].addValue(rt_high_image, similarity_ik_jl);
 
               if (do_dump_pairs)
               {
@@ -305,6 +357,20 @@ namespace OpenMS
         }   // j
       }   // k
     }   // i
+
+    // reduce the per-thread histograms (in thread order)
+    for (const std::vector<LinearInterpolationType_>& local : thread_hashes)
+    {
+      for (Size h = 0; h < hashes.size(); ++h)
+      {
+        std::vector<double>& target = hashes[h]->getData();
+        const std::vector<double>& source = local[h].getData();
+        for (Size b = 0; b < target.size(); ++b)
+        {
+          target[b] += source[b];
+        }
+      }
+    }
   }
 
   /**
@@ -37,7 +37,16 @@
 #include <OpenMS/DATASTRUCTURES/String.h>
 
 #include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <exception>
 #include <iostream>
+#include <iterator>
+#include <limits>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 namespace OpenMS
 {
@@ -296,15 +305,151 @@ namespace OpenMS
         "Input to extractChromatogram needs to be sorted by m/z");
     }
 
-    //go through all spectra
+    // Sweep line over RT: coordinates with an RT window enter the active set
+    // once a spectrum reaches their rt_start and leave it after rt_end, while
+    // coordinates without RT window are always active. Only the active
+    // coordinates are extracted from each spectrum.
+    std::vector<Size> always_active, by_rt_start;
+    for (Size k = 0; k < extraction_coordinates.size(); ++k)
+    {
+      if (extraction_coordinates[k].rt_end - extraction_coordinates[k].rt_start > 0)
+      {
+        by_rt_start.push_back(k);
+      }
+      else
+      {
+        always_active.push_back(k);
+      }
+    }
+    std::sort(by_rt_start.begin(), by_rt_start.end(), [&extraction_coordinates](Size a, Size b)
+      {
+        return extraction_coordinates[a].rt_start < extraction_coordinates[b].rt_start;
+      });
+
+    // Blocks of consecutive spectra are extracted in parallel (each with its
+    // own sweep) and merged into the output in scan order after each round,
+    // which bounds the memory needed for the partial chromatograms.
+    const SignedSize block_size = 32;
+    const SignedSize nr_blocks = (SignedSize(input_size) + block_size - 1) / block_size;
+    SignedSize blocks_per_round = 1;
+#ifdef _OPENMP
+    if (!omp_in_parallel())
+    {
+      blocks_per_round = omp_get_max_threads();
+    }
+#endif
+    std::vector<ExtractionBlock_> blocks(blocks_per_round);
+
+    Size progress = 0;
+    std::exception_ptr err;
     startProgress(0, input_size, "Extracting chromatograms");
-    for (Size scan_idx = 0; scan_idx < input_size; ++scan_idx)
+#pragma omp parallel if (blocks_per_round > 1)
     {
-      setProgress(scan_idx);
+      // each thread needs its own data access (e.g. its own file stream)
+      OpenSwath::SpectrumAccessPtr thread_input = blocks_per_round > 1 ? input->lightClone() : input;
 
-      OpenSwath::SpectrumPtr sptr = input->getSpectrumById(scan_idx);
+      for (SignedSize round_start = 0; round_start < nr_blocks; round_start += blocks_per_round)
+      {
+        const SignedSize round_end = std::min(nr_blocks, round_start + blocks_per_round);
+
+#pragma omp for schedule(dynamic)
+        for (SignedSize b = round_start; b < round_end; ++b)
+        {
+          try
+          {
+            const Size scan_start = b * block_size;
+            const Size scan_end = std::min(input_size, Size(scan_start + block_size));
+            extractBlock_(thread_input, scan_start, scan_end, extraction_coordinates, always_active, by_rt_start,
+                          mz_extraction_window, ppm, im_extraction_window, used_filter, blocks[b - round_start]);
+
+#pragma omp atomic
+            progress += scan_end - scan_start;
+            IF_MASTERTHREAD setProgress(progress);
+          }
+          catch (...)
+          {
+#pragma omp critical (ChromatogramExtractorAlgorithm_error)
+            if (!err) err = std::current_exception();
+          }
+        }
+
+        // append the partial chromatograms in scan order
+#pragma omp single
+        {
+          for (SignedSize b = 0; b < round_end - round_start; ++b)
+          {
+            ExtractionBlock_& block = blocks[b];
+            Size hit_idx = 0;
+            for (const auto& scan : block.scans)
+            {
+              for (; hit_idx < scan.second; ++hit_idx)
+              {
+                const Size k = block.hits[hit_idx].first;
+                output[k]->getTimeArray()->data.push_back(scan.first);
+                output[k]->getIntensityArray()->data.push_back(block.hits[hit_idx].second);
+              }
+            }
+            block.hits.clear();
+            block.scans.clear();
+          }
+        }
+      }
+    }
+    endProgress();
+    if (err) std::rethrow_exception(err);
+  }
+
+  void ChromatogramExtractorAlgorithm::extractBlock_(const OpenSwath::SpectrumAccessPtr& input,
+      Size scan_start,
+      Size scan_end,
+      const std::vector<ExtractionCoordinates>& extraction_coordinates,
+      const std::vector<Size>& always_active,
+      const std::vector<Size>& by_rt_start,
+      double mz_extraction_window,
+      bool ppm,
+      double im_extraction_window,
+      int used_filter,
+      ExtractionBlock_& block)
+  {
+    // active coordinates, sorted by index (i.e. by m/z)
+    std::vector<Size> active(always_active), merged, entering;
+    Size next_start = 0;
+    double last_rt = -std::numeric_limits<double>::max();
+
+    for (Size scan_idx = scan_start; scan_idx < scan_end; ++scan_idx)
+    {
       OpenSwath::SpectrumMeta s_meta = input->getSpectrumMetaById(scan_idx);
+      const double current_rt = s_meta.RT;
+
+      // restart the sweep if the spectra are not sorted by RT
+      if (current_rt < last_rt)
+      {
+        active = always_active;
+        next_start = 0;
+      }
+      last_rt = current_rt;
+
+      // add the coordinates whose RT window started and remove those whose RT window ended
+      entering.clear();
+      while (next_start < by_rt_start.size() && extraction_coordinates[by_rt_start[next_start]].rt_start <= current_rt)
+      {
+        entering.push_back(by_rt_start[next_start++]);
+      }
+      std::sort(entering.begin(), entering.end());
+      merged.clear();
+      std::merge(active.begin(), active.end(), entering.begin(), entering.end(), std::back_inserter(merged));
+      active.clear();
+      for (Size k : merged)
+      {
+        const ExtractionCoordinates& coord = extraction_coordinates[k];
+        if (coord.rt_end - coord.rt_start > 0 && current_rt > coord.rt_end)
+        {
+          continue;
+        }
+        active.push_back(k);
+      }
 
+      OpenSwath::SpectrumPtr sptr = input->getSpectrumById(scan_idx);
       OpenSwath::BinaryDataArrayPtr mz_arr = sptr->getMZArray();
       OpenSwath::BinaryDataArrayPtr int_arr = sptr->getIntensityArray();
       std::vector<double>::const_iterator mz_start = mz_arr->data.begin();
@@ -313,7 +458,7 @@ namespace OpenMS
       std::vector<double>::const_iterator int_it = int_arr->data.begin();
       std::vector<double>::const_iterator im_it;
 
-      if (sptr->getMZArray()->data.size() == 0)
+      if (mz_arr->data.empty())
       {
         continue;
       }
@@ -334,21 +479,13 @@ namespace OpenMS
         }
       }
 
-      // go through all transitions / chromatograms which are sorted by
+      // go through all active transitions / chromatograms which are sorted by
       // ProductMZ. We can use this to step through the spectrum and at the
       // same time step through the transitions. We increase the peak counter
       // until we hit the next transition and then extract the signal.
-      for (Size k = 0; k < extraction_coordinates.size(); ++k)
+      for (Size k : active)
       {
         double integrated_intensity = 0;
-        double current_rt = s_meta.RT;
-        if (extraction_coordinates[k].rt_end - extraction_coordinates[k].rt_start > 0 &&
-             (current_rt < extraction_coordinates[k].rt_start ||
-              current_rt > extraction_coordinates[k].rt_end) )
-        {
-          continue;
-        }
-
         const bool use_im = (extraction_coordinates[k].ion_mobility >= 0.0 && has_im);
         if (!use_im && used_filter == 1)
         {
@@ -357,10 +494,6 @@ namespace OpenMS
         }
         else if (use_im && used_filter == 1)
         {
-          if (extraction_coordinates[k].ion_mobility < 0)
-          {
-            std::cerr << "WARNING : Drift time of ion is negative!" << std::endl;
-          }
           extract_value_tophat(mz_start, mz_it, mz_end, int_it, im_it,
                                extraction_coordinates[k].mz, extraction_coordinates[k].ion_mobility,
                                integrated_intensity, mz_extraction_window, im_extraction_window, ppm);
@@ -370,11 +503,10 @@ namespace OpenMS
           throw Exception::NotImplemented(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION);
         }
 
-        output[k]->getTimeArray()->data.push_back(current_rt);
-        output[k]->getIntensityArray()->data.push_back(integrated_intensity);
+        block.hits.emplace_back(k, integrated_intensity);
       }
+      block.scans.emplace_back(current_rt, block.hits.size());
     }
-    endProgress();
   }
 
   int ChromatogramExtractorAlgorithm::getFilterNr_(const String& filter)
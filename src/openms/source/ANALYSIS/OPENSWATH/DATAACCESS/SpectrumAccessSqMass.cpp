@@ -37,6 +37,36 @@
 namespace OpenMS
 {
 
+  namespace
+  {
+    OpenSwath::SpectrumPtr convertSpectrum(const MSSpectrum& spectrum)
+    {
+      OpenSwath::BinaryDataArrayPtr intensity_array(new OpenSwath::BinaryDataArray);
+      OpenSwath::BinaryDataArrayPtr mz_array(new OpenSwath::BinaryDataArray);
+      mz_array->data.reserve(spectrum.size());
+      intensity_array->data.reserve(spectrum.size());
+      for (MSSpectrum::const_iterator it = spectrum.begin(); it != spectrum.end(); ++it)
+      {
+        mz_array->data.push_back(it->getMZ());
+        intensity_array->data.push_back(it->getIntensity());
+      }
+
+      OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
+      sptr->setMZArray(mz_array);
+      sptr->setIntensityArray(intensity_array);
+      return sptr;
+    }
+
+    OpenSwath::SpectrumMeta convertSpectrumMeta(const MSSpectrum& spectrum)
+    {
+      OpenSwath::SpectrumMeta m;
+      m.id = spectrum.getNativeID();
+      m.RT = spectrum.getRT();
+      m.ms_level = spectrum.getMSLevel();
+      return m;
+    }
+  }
+
     /// Constructor
   SpectrumAccessSqMass::SpectrumAccessSqMass(const OpenMS::Internal::MzMLSqliteHandler& handler) :
       handler_(handler)
@@ -103,19 +133,7 @@ namespace OpenMS
       std::vector<MSSpectrum> tmp_spectra;
       handler_.readSpectra(tmp_spectra, indices, false);
 
-      const MSSpectrumType& spectrum = tmp_spectra[0];
-      OpenSwath::BinaryDataArrayPtr intensity_array(new OpenSwath::BinaryDataArray);
-      OpenSwath::BinaryDataArrayPtr mz_array(new OpenSwath::BinaryDataArray);
-      for (MSSpectrumType::const_iterator it = spectrum.begin(); it != spectrum.end(); ++it)
-      {
-        mz_array->data.push_back(it->getMZ());
-        intensity_array->data.push_back(it->getIntensity());
-      }
-
-      OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
-      sptr->setMZArray(mz_array);
-      sptr->setIntensityArray(intensity_array);
-      return sptr;
+      return convertSpectrum(tmp_spectra[0]);
     }
 
     OpenSwath::SpectrumMeta SpectrumAccessSqMass::getSpectrumMetaById(int id) const
@@ -130,16 +148,11 @@ namespace OpenMS
         indices.push_back(sidx_[id]);
       }
 
-      // read MSSpectra and prepare for conversion
+      // read meta data of MSSpectra only
       std::vector<MSSpectrum> tmp_spectra;
-      handler_.readSpectra(tmp_spectra, indices, false);
+      handler_.readSpectra(tmp_spectra, indices, true);
 
-      const MSSpectrumType& spectrum = tmp_spectra[0];
-      OpenSwath::SpectrumMeta m;
-      m.id = spectrum.getNativeID();
-      m.RT = spectrum.getRT();
-      m.ms_level = spectrum.getMSLevel();
-      return m;
+      return convertSpectrumMeta(tmp_spectra[0]);
     }
 
     void SpectrumAccessSqMass::getAllSpectra(std::vector< OpenSwath::SpectrumPtr > & spectra, std::vector< OpenSwath::SpectrumMeta > & spectra_meta) const
@@ -160,30 +173,68 @@ namespace OpenMS
       {
         handler_.readSpectra(tmp_spectra, sidx_, false);
       }
-      spectra.reserve(tmp_spectra.size());
-      spectra_meta.reserve(tmp_spectra.size());
-    
-      for (Size k = 0; k < tmp_spectra.size(); k++)
+      spectra.resize(tmp_spectra.size());
+      spectra_meta.resize(tmp_spectra.size());
+
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize k = 0; k < (SignedSize)tmp_spectra.size(); k++)
+      {
+        spectra[k] = convertSpectrum(tmp_spectra[k]);
+        spectra_meta[k] = convertSpectrumMeta(tmp_spectra[k]);
+      }
+    }
+
+    void SpectrumAccessSqMass::getSpectraById(const std::vector<int> & ids, std::vector< OpenSwath::SpectrumPtr > & spectra, std::vector< OpenSwath::SpectrumMeta > & spectra_meta) const
+    {
+      spectra.clear();
+      spectra_meta.clear();
+      if (ids.empty()) return;
+
+      // map to the indices in the sqMass file
+      const Size nr_spectra = getNrSpectra();
+      std::vector<int> sql_ids;
+      sql_ids.reserve(ids.size());
+      for (Size k = 0; k < ids.size(); k++)
       {
-        const MSSpectrumType& spectrum = tmp_spectra[k];
-        OpenSwath::BinaryDataArrayPtr intensity_array(new OpenSwath::BinaryDataArray);
-        OpenSwath::BinaryDataArrayPtr mz_array(new OpenSwath::BinaryDataArray);
-        for (MSSpectrumType::const_iterator it = spectrum.begin(); it != spectrum.end(); ++it)
+        if (ids[k] < 0 || (Size)ids[k] >= nr_spectra)
         {
-          mz_array->data.push_back(it->getMZ());
-          intensity_array->data.push_back(it->getIntensity());
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              String("Error accessing spectrum ") + ids[k] + " in SpectrumAccessSqMass of size " + getNrSpectra());
         }
+        sql_ids.push_back(sidx_.empty() ? ids[k] : sidx_[ids[k]]);
+      }
+
+      // the handler returns each spectrum once, in the order of increasing index
+      std::vector<int> unique_ids(sql_ids);
+      std::sort(unique_ids.begin(), unique_ids.end());
+      unique_ids.erase(std::unique(unique_ids.begin(), unique_ids.end()), unique_ids.end());
 
-        OpenSwath::SpectrumMeta m;
-        m.id = spectrum.getNativeID();
-        m.RT = spectrum.getRT();
-        m.ms_level = spectrum.getMSLevel();
-        spectra_meta.push_back(m);
+      std::vector<MSSpectrum> tmp_spectra;
+      handler_.readSpectra(tmp_spectra, unique_ids, false);
+      if (tmp_spectra.size() != unique_ids.size())
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            String("Could only read ") + tmp_spectra.size() + " of " + unique_ids.size() + " requested spectra in SpectrumAccessSqMass");
+      }
 
-        OpenSwath::SpectrumPtr sptr(new OpenSwath::Spectrum);
-        sptr->setMZArray(mz_array);
-        sptr->setIntensityArray(intensity_array);
-        spectra.push_back(sptr);
+      std::vector< OpenSwath::SpectrumPtr > loaded(tmp_spectra.size());
+#ifdef _OPENMP
+#pragma omp parallel for
+#endif
+      for (SignedSize k = 0; k < (SignedSize)tmp_spectra.size(); k++)
+      {
+        loaded[k] = convertSpectrum(tmp_spectra[k]);
+      }
+
+      spectra.reserve(sql_ids.size());
+      spectra_meta.reserve(sql_ids.size());
+      for (Size k = 0; k < sql_ids.size(); k++)
+      {
+        Size pos = std::lower_bound(unique_ids.begin(), unique_ids.end(), sql_ids[k]) - unique_ids.begin();
+        spectra.push_back(loaded[pos]);
+        spectra_meta.push_back(convertSpectrumMeta(tmp_spectra[pos]));
       }
     }
 
@@ -46,6 +46,7 @@
 // Helpers
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathHelper.h>
 #include <OpenMS/CHEMISTRY/ProteaseDigestion.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 
 #include <boost/range/adaptor/map.hpp>
 #include <boost/foreach.hpp>
@@ -157,6 +158,7 @@ namespace OpenMS
     defaultsToParam_();
 
     strict_ = true;
+    spectrum_cache_.reset(new OpenSwathScoring::SpectrumCache());
   }
 
   MRMFeatureFinderScoring::~MRMFeatureFinderScoring()
@@ -191,6 +193,8 @@ namespace OpenMS
                                                std::vector<OpenSwath::SwathMap> swath_maps,
                                                TransitionGroupMapType& transition_group_map)
   {
+    OPENMS_PROFILE_SCOPE("MRMFeatureFinderScoring::pickExperiment", "scoring");
+
     //
     // Step 1
     //
@@ -472,6 +476,7 @@ namespace OpenMS
                                                 FeatureMap& output, 
                                                 bool ms1only)
   {
+    OPENMS_PROFILE_ACCUMULATE("MRMFeatureFinderScoring::scorePeakgroups", "scoring");
     if (PeptideRefMap_.empty())
     {
       throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
@@ -544,6 +549,7 @@ namespace OpenMS
                       im_extra_drift_,
                       su_,
                       spectrum_addition_method_);
+    scorer.setSpectrumCache(spectrum_cache_);
 
     ProteaseDigestion pd;
     pd.setEnzyme("Trypsin");
@@ -48,6 +48,8 @@
 #include <OpenMS/MATH/STATISTICS/StatisticFunctions.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/SpectrumAddition.h>
 
+#include <tuple>
+
 // basic file operations
 
 namespace OpenMS
@@ -102,7 +104,8 @@ namespace OpenMS
     spacing_for_spectra_resampling_(0.005),
     add_up_spectra_(1),
     spectra_addition_method_("simple"),
-    im_drift_extra_pcnt_(0.0)
+    im_drift_extra_pcnt_(0.0),
+    spectrum_cache_(new SpectrumCache())
   {
   }
 
@@ -126,6 +129,86 @@ namespace OpenMS
     this->su_ = su;
   }
 
+  void OpenSwathScoring::setSpectrumCache(const SpectrumCachePtr& cache)
+  {
+    spectrum_cache_ = cache;
+  }
+
+  const OpenSwathScoring::SpectrumCachePtr& OpenSwathScoring::getSpectrumCache() const
+  {
+    return spectrum_cache_;
+  }
+
+  OpenSwathScoring::SpectrumCache::SpectrumCache(Size capacity) :
+    capacity_(capacity)
+  {
+  }
+
+  bool OpenSwathScoring::SpectrumCache::Key::operator<(const Key& rhs) const
+  {
+    return std::tie(map, drift_lower, drift_upper, resample, spacing, indices) <
+           std::tie(rhs.map, rhs.drift_lower, rhs.drift_upper, rhs.resample, rhs.spacing, rhs.indices);
+  }
+
+  OpenSwath::SpectrumPtr OpenSwathScoring::SpectrumCache::get(const OpenSwath::SpectrumAccessPtr& map,
+                                                              const std::vector<std::size_t>& indices,
+                                                              double drift_lower, double drift_upper,
+                                                              bool resample, double spacing)
+  {
+    if (capacity_ == 0) return OpenSwath::SpectrumPtr();
+
+    Key key = {map.get(), indices, drift_lower, drift_upper, resample, spacing};
+    auto it = lookup_.find(key);
+    if (it == lookup_.end()) return OpenSwath::SpectrumPtr();
+
+    // move entry to the front (most recently used)
+    entries_.splice(entries_.begin(), entries_, it->second);
+    return it->second->spectrum;
+  }
+
+  void OpenSwathScoring::SpectrumCache::put(const OpenSwath::SpectrumAccessPtr& map,
+                                            const std::vector<std::size_t>& indices,
+                                            double drift_lower, double drift_upper,
+                                            bool resample, double spacing,
+                                            const OpenSwath::SpectrumPtr& spectrum)
+  {
+    if (capacity_ == 0) return;
+
+    Key key = {map.get(), indices, drift_lower, drift_upper, resample, spacing};
+    auto it = lookup_.find(key);
+    if (it != lookup_.end())
+    {
+      it->second->spectrum = spectrum;
+      entries_.splice(entries_.begin(), entries_, it->second);
+      return;
+    }
+
+    if (entries_.size() >= capacity_)
+    {
+      lookup_.erase(entries_.back().key);
+      entries_.pop_back();
+    }
+    Entry entry = {key, map, spectrum};
+    entries_.push_front(std::move(entry));
+    lookup_.insert(std::make_pair(entries_.front().key, entries_.begin()));
+  }
+
+  void OpenSwathScoring::SpectrumCache::clear()
+  {
+    lookup_.clear();
+    entries_.clear();
+  }
+
+  Size OpenSwathScoring::SpectrumCache::size() const
+  {
+    return entries_.size();
+  }
+
+  Size OpenSwathScoring::SpectrumCache::getCapacity() const
+  {
+    return capacity_;
+  }
+
   void OpenSwathScoring::calculateDIAScores(OpenSwath::IMRMFeature* imrmfeature,
                                             const std::vector<TransitionType>& transitions,
                                             const std::vector<OpenSwath::SwathMap>& swath_maps,
@@ -502,7 +585,7 @@ namespace OpenMS
     return getAddedSpectra_(swath_map, RT, nr_spectra_to_add, drift_lower, drift_upper);
   }
 
-  OpenSwath::SpectrumPtr OpenSwathScoring::fetchSpectrumSwath(std::vector<OpenSwath::SwathMap> swath_maps,
+  OpenSwath::SpectrumPtr OpenSwathScoring::fetchSpectrumSwath(const std::vector<OpenSwath::SwathMap>& swath_maps,
                                                               double RT, int nr_spectra_to_add, const double drift_lower, const double drift_upper)
   {
     if (swath_maps.size() == 1)
@@ -591,6 +674,33 @@ namespace OpenMS
       closest_idx--;
     }
 
+    // always use the spectrum closest_idx, then add those right and left
+    std::vector<std::size_t> used_indices;
+    used_indices.push_back(closest_idx);
+    if (nr_spectra_to_add != 1)
+    {
+      for (int i = 1; i <= nr_spectra_to_add / 2; i++) // cast to int is intended!
+      {
+        if (closest_idx - i >= 0)
+        {
+          used_indices.push_back(closest_idx - i);
+        }
+        if (closest_idx + i < (int)swath_map->getNrSpectra())
+        {
+          used_indices.push_back(closest_idx + i);
+        }
+      }
+    }
+
+    // the same spectra are requested repeatedly for a peak group (and its neighbours)
+    const bool resample = (spectra_addition_method_ != "simple");
+    if (spectrum_cache_)
+    {
+      OpenSwath::SpectrumPtr cached = spectrum_cache_->get(swath_map, used_indices, drift_lower, drift_upper,
+                                                           resample, spacing_for_spectra_resampling_);
+      if (cached) return cached;
+    }
+
     if (nr_spectra_to_add == 1)
     {
       added_spec = swath_map->getSpectrumById(closest_idx);
@@ -602,18 +712,10 @@ namespace OpenMS
     else
     {
       std::vector<OpenSwath::SpectrumPtr> all_spectra;
-      // always add the spectrum 0, then add those right and left
-      all_spectra.push_back(swath_map->getSpectrumById(closest_idx));
-      for (int i = 1; i <= nr_spectra_to_add / 2; i++) // cast to int is intended!
+      all_spectra.reserve(used_indices.size());
+      for (std::size_t idx : used_indices)
       {
-        if (closest_idx - i >= 0)
-        {
-          all_spectra.push_back(swath_map->getSpectrumById(closest_idx - i));
-        }
-        if (closest_idx + i < (int)swath_map->getNrSpectra())
-        {
-          all_spectra.push_back(swath_map->getSpectrumById(closest_idx + i));
-        }
+        all_spectra.push_back(swath_map->getSpectrumById(boost::numeric_cast<int>(idx)));
       }
 
       // Filter all spectra by drift time before further processing
@@ -623,7 +725,7 @@ namespace OpenMS
       }
 
       // add up all spectra
-      if (spectra_addition_method_ == "simple")
+      if (!resample)
       {
         // Ensure that we have the same number of data arrays as in the input spectrum
         if (!all_spectra.empty() && all_spectra[0]->getDataArrays().size() > 2)
@@ -660,6 +762,11 @@ namespace OpenMS
            added_spec->getMZArray()->data.end(), std::greater<double>()) == added_spec->getMZArray()->data.end(),
            "Postcondition violated: m/z vector needs to be sorted!" )
 
+    if (spectrum_cache_)
+    {
+      spectrum_cache_->put(swath_map, used_indices, drift_lower, drift_upper,
+                           resample, spacing_for_spectra_resampling_, added_spec);
+    }
     return added_spec;
   }
 
@@ -41,7 +41,7 @@
 namespace OpenMS
 {
 
-  OpenSwath::SpectrumPtr SpectrumAddition::addUpSpectra(const std::vector<OpenSwath::SpectrumPtr> all_spectra,
+  OpenSwath::SpectrumPtr SpectrumAddition::addUpSpectra(const std::vector<OpenSwath::SpectrumPtr>& all_spectra,
       double sampling_rate, bool filter_zeros)
   {
     OPENMS_PRECONDITION(all_spectra.empty() || all_spectra[0]->getDataArrays().size() == 2, "Can only resample spectra with 2 data dimensions (no ion mobility spectra)")
@@ -143,7 +143,7 @@ namespace OpenMS
     }
   }
 
-  OpenMS::MSSpectrum SpectrumAddition::addUpSpectra(const std::vector<OpenMS::MSSpectrum> all_spectra, double sampling_rate, bool filter_zeros)
+  OpenMS::MSSpectrum SpectrumAddition::addUpSpectra(const std::vector<OpenMS::MSSpectrum>& all_spectra, double sampling_rate, bool filter_zeros)
   {
     OPENMS_PRECONDITION(all_spectra.empty() || all_spectra[0].getFloatDataArrays().empty(), "Can only resample spectra with 2 data dimensions (no ion mobility spectra)")
 
@@ -187,9 +187,9 @@ namespace OpenMS
 
     // generate the resampled peaks at positions origin+i*spacing_
     int number_resampled_points = (max - min) / sampling_rate + 1;
-    MSSpectrum resampled_peak_container;
-    resampled_peak_container.resize(number_resampled_points);
-    MSSpectrum::iterator it = resampled_peak_container.begin();
+    MSSpectrum master_spectrum;
+    master_spectrum.resize(number_resampled_points);
+    MSSpectrum::iterator it = master_spectrum.begin();
     for (int i = 0; i < number_resampled_points; ++i)
     {
       it->setMZ(min + i * sampling_rate);
@@ -197,21 +197,12 @@ namespace OpenMS
       ++it;
     }
 
-    // resample all spectra and add to master spectrum
+    // resample all spectra and add to master spectrum (raster() accumulates
+    // intensities, so no per-spectrum copy of the grid is needed)
     LinearResamplerAlign lresampler;
-    MSSpectrum master_spectrum = resampled_peak_container;
     for (Size curr_sp = 0; curr_sp < all_spectra.size(); curr_sp++)
     {
-      MSSpectrum input_spectrum;
-      MSSpectrum output_spectrum = resampled_peak_container;
-
-      lresampler.raster(all_spectra[curr_sp].begin(), all_spectra[curr_sp].end(), output_spectrum.begin(), output_spectrum.end());
-
-      // add to master spectrum
-      for (Size i = 0; i < output_spectrum.size(); ++i)
-      {
-        master_spectrum[i].setIntensity(master_spectrum[i].getIntensity() + output_spectrum[i].getIntensity());
-      }
+      lresampler.raster(all_spectra[curr_sp].begin(), all_spectra[curr_sp].end(), master_spectrum.begin(), master_spectrum.end());
     }
 
     if (!filter_zeros)
@@ -232,5 +223,12 @@ namespace OpenMS
     }
   }
 
+  OpenMS::MSSpectrum SpectrumAddition::addUpSpectra(std::vector<OpenMS::MSSpectrum>&& all_spectra, double sampling_rate, bool filter_zeros)
+  {
+    if (all_spectra.size() == 1) return std::move(all_spectra[0]);
+    const std::vector<OpenMS::MSSpectrum>& spectra = all_spectra;
+    return addUpSpectra(spectra, sampling_rate, filter_zeros);
+  }
+
 }
 
@@ -57,183 +57,179 @@ namespace OpenMS
     // initialize empty vector for the results
     vector<OPXLDataStructs::XLPrecursor> mass_to_candidates;
 
-    double max_precursor = spectrum_precursors[spectrum_precursors.size()-1];
+    if (spectrum_precursors.empty() || peptides.empty())
+    {
+      return mass_to_candidates;
+    }
 
-    Size peptides_size = peptides.size();
+    const Size peptides_size = peptides.size();
 
-    // compute a very conservative total upper bound, based on the heaviest possible linear peptide
-    // can be used instead of peptides.end() in all cases for this precursor mass
-    vector<OPXLDataStructs::AASeqWithMass>::const_iterator conservative_upper_bound = upper_bound(peptides.cbegin(), peptides.cend(), max_precursor, OPXLDataStructs::AASeqWithMassComparator());
+    // contiguous copy of the (sorted) peptide masses for the searches below
+    vector<double> masses(peptides_size);
+    for (Size p = 0; p < peptides_size; ++p)
+    {
+      masses[p] = peptides[p].peptide_mass;
+    }
 
-    // initialize additional iterators
-    // the upper bounds for a precursor mass can be used as the lower bounds
-    // for the next heavier precursor mass, narrowing down the search space for new bounds
-    vector<OPXLDataStructs::AASeqWithMass>::const_iterator first_loop = peptides.cbegin();
-    vector<OPXLDataStructs::AASeqWithMass>::const_iterator last_loop = peptides.cbegin();
+    // single residue specificities of the linker as lookup tables
+    // (terminal specificities are not relevant for loop-links and are handled in buildCandidates)
+    vector<bool> links_residue1(256, false);
+    vector<bool> links_residue2(256, false);
+    for (const String& res : cross_link_residue1)
+    {
+      if (res.size() == 1) { links_residue1[static_cast<unsigned char>(res[0])] = true; }
+    }
+    for (const String& res : cross_link_residue2)
+    {
+      if (res.size() == 1) { links_residue2[static_cast<unsigned char>(res[0])] = true; }
+    }
 
-    vector<OPXLDataStructs::AASeqWithMass>::const_iterator first_mono = peptides.cbegin();
-    vector<OPXLDataStructs::AASeqWithMass>::const_iterator last_mono = peptides.cbegin();
+    // compute a very conservative total upper bound, based on the heaviest possible linear peptide
+    // can be used instead of masses.end() in all cases
+    const double max_precursor = *max_element(spectrum_precursors.begin(), spectrum_precursors.end());
+    const vector<double>::const_iterator conservative_upper_bound = upper_bound(masses.cbegin(), masses.cend(), max_precursor);
 
-    vector<OPXLDataStructs::AASeqWithMass>::const_iterator last_alpha = peptides.cbegin();
+    int num_threads = 1;
+#ifdef _OPENMP
+    num_threads = omp_get_max_threads();
+#endif
 
-    for (Size pm = 0; pm < spectrum_precursors.size(); ++pm)
-    {
-      double precursor_mass = spectrum_precursors[pm];
-      // compute absolute tolerance from relative, if necessary
-      double allowed_error = 0;
-      if (precursor_mass_tolerance_unit_ppm) // ppm
-      {
-        allowed_error = precursor_mass * precursor_mass_tolerance * 1e-6;
-      }
-      else // Dalton
-      {
-        allowed_error = precursor_mass_tolerance;
-      }
+    // per-thread results, concatenated in thread order at the end
+    vector<vector<OPXLDataStructs::XLPrecursor> > thread_candidates(num_threads);
+    vector<vector<int> > thread_positions(num_threads);
 
-      // ################################ Enumerate Loop-Links #################
-      // The largest peptides given a fixed precursor mass are possible with loop links
-      double min_peptide_mass = precursor_mass - cross_link_mass - allowed_error;
-      double max_peptide_mass = precursor_mass - cross_link_mass + allowed_error;
+#pragma omp parallel num_threads(num_threads)
+    {
+      int thread = 0;
+      int threads = 1;
+#ifdef _OPENMP
+      thread = omp_get_thread_num();
+      threads = omp_get_num_threads();
+#endif
+      vector<OPXLDataStructs::XLPrecursor>& candidates = thread_candidates[thread];
+      vector<int>& positions = thread_positions[thread];
 
-      first_loop = lower_bound(first_loop, conservative_upper_bound, min_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
-      last_loop = upper_bound(last_loop, conservative_upper_bound, max_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
+      // the share of this thread of the index range [begin, end)
+      auto thread_share = [thread, threads](Size begin, Size end)
+      {
+        const Size n = end - begin;
+        return make_pair(begin + n * thread / threads, begin + n * (thread + 1) / threads);
+      };
 
-      int first_index = first_loop - peptides.cbegin();
-      int last_index = last_loop - peptides.cbegin();
+      auto add_candidate = [&candidates, &positions](double mass, Size alpha, Size beta, int pm)
+      {
+        OPXLDataStructs::XLPrecursor precursor;
+        precursor.precursor_mass = mass;
+        precursor.alpha_index = alpha;
+        precursor.beta_index = beta;
+        candidates.push_back(precursor);
+        positions.push_back(pm);
+      };
 
-#pragma omp parallel for
-      for (int p1 = first_index; p1 < last_index; ++p1)
+      for (Size pm = 0; pm < spectrum_precursors.size(); ++pm)
       {
-        const String& seq_first = peptides[p1].unmodified_seq;
-        // test if this peptide could have loop-links: one cross-link with both sides attached to the same peptide
-        bool first_res = false; // is there a residue the first side of the linker can attach to?
-        bool second_res = false; // is there a residue the second side of the linker can attach to?
-        for (Size k = 0; k < seq_first.size()-1; ++k)
+        const double precursor_mass = spectrum_precursors[pm];
+        // compute absolute tolerance from relative, if necessary
+        double allowed_error = 0;
+        if (precursor_mass_tolerance_unit_ppm) // ppm
         {
-         for (Size i = 0; i < cross_link_residue1.size(); ++i)
-         {
-           if (cross_link_residue1[i].size() == 1 && string(1, seq_first[k]) == cross_link_residue1[i])
-           {
-             first_res = true;
-           }
-         }
-         for (Size i = 0; i < cross_link_residue2.size(); ++i)
-         {
-           if (cross_link_residue2[i].size() == 1 && string(1, seq_first[k]) == cross_link_residue2[i])
-           {
-             second_res = true;
-           }
-         }
+          allowed_error = precursor_mass * precursor_mass_tolerance * 1e-6;
         }
-
-        // If both sides of a cross-linker can link to this peptide, generate the loop-link
-        if (first_res && second_res)
+        else // Dalton
         {
-         // Monoisotopic weight of the peptide + cross-linker
-         double cross_linked_peptide_mass = peptides[p1].peptide_mass + cross_link_mass;
-
-         // also only one peptide
-         OPXLDataStructs::XLPrecursor precursor;
-         precursor.precursor_mass = cross_linked_peptide_mass;
-         precursor.alpha_index = p1;
-         precursor.beta_index = peptides_size + 1; // an out-of-range index to represent an empty index
-         precursor.alpha_seq = seq_first;
-         precursor.beta_seq = "";
-
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
+          allowed_error = precursor_mass_tolerance;
         }
-      } // end of parallel loop over loop-link candidates
 
-      // ################################ Enumerate Mono-Links #################
-      for (Size i = 0; i < cross_link_mass_mono_link.size(); i++)
-      {
-        double mono_link_mass = cross_link_mass_mono_link[i];
+        // ################################ Enumerate Loop-Links #################
+        // The largest peptides given a fixed precursor mass are possible with loop links
+        Size first_index = lower_bound(masses.cbegin(), conservative_upper_bound, precursor_mass - cross_link_mass - allowed_error) - masses.cbegin();
+        Size last_index = upper_bound(masses.cbegin(), conservative_upper_bound, precursor_mass - cross_link_mass + allowed_error) - masses.cbegin();
 
-        min_peptide_mass = precursor_mass - mono_link_mass - allowed_error;
-        max_peptide_mass = precursor_mass - mono_link_mass + allowed_error;
-
-        // mono-link masses are sorted in descending order
-        // so we can use the results from the last search as a new lower bounds for both searches again
-        first_mono = lower_bound(first_mono, conservative_upper_bound, min_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
-        last_mono = upper_bound(last_mono, conservative_upper_bound, max_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
+        pair<Size, Size> share = thread_share(first_index, last_index);
+        for (Size p1 = share.first; p1 < share.second; ++p1)
+        {
+          const String& seq_first = peptides[p1].unmodified_seq;
+          // test if this peptide could have loop-links: one cross-link with both sides attached to the same peptide
+          bool first_res = false; // is there a residue the first side of the linker can attach to?
+          bool second_res = false; // is there a residue the second side of the linker can attach to?
+          for (Size k = 0; k + 1 < seq_first.size(); ++k)
+          {
+            const unsigned char residue = seq_first[k];
+            first_res = first_res || links_residue1[residue];
+            second_res = second_res || links_residue2[residue];
+          }
 
-        first_index = first_mono - peptides.cbegin();
-        last_index = last_mono - peptides.cbegin();
+          // If both sides of a cross-linker can link to this peptide, generate the loop-link
+          // (only one peptide: use an out-of-range index to represent an empty beta)
+          if (first_res && second_res)
+          {
+            add_candidate(masses[p1] + cross_link_mass, p1, peptides_size + 1, pm);
+          }
+        }
 
-#pragma omp parallel for
-        for (int p1 = first_index; p1 < last_index; ++p1)
+        // ################################ Enumerate Mono-Links #################
+        for (Size i = 0; i < cross_link_mass_mono_link.size(); i++)
         {
-          // Monoisotopic weight of the peptide + cross-linker
-          double cross_linked_peptide_mass = peptides[p1].peptide_mass + mono_link_mass;
-
-          // Make sure it is clear only one peptide is considered here. Use an out-of-range value for the second peptide.
-          OPXLDataStructs::XLPrecursor precursor;
-          precursor.precursor_mass = cross_linked_peptide_mass;
-          precursor.alpha_index = p1;
-          precursor.beta_index = peptides_size + 1; // an out-of-range index to represent an empty index
-          precursor.alpha_seq = peptides[p1].unmodified_seq;
-          precursor.beta_seq = "";
-
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
-        } // end of loop over candidates for a specific mono-link mass
-      } // end of loop over mono-link masses
-
-      // ################################ Enumerate Cross-Links #################
-      // constrain the conservative upper bound even more,
-      // because we have to fit in two peptides this time
-      // maximal mass: difference between precursor mass and the smallest peptide + cross-linker
-      max_peptide_mass = precursor_mass - cross_link_mass - peptides[0].peptide_mass + allowed_error;
-      last_alpha = upper_bound(last_alpha, conservative_upper_bound, max_peptide_mass, OPXLDataStructs::AASeqWithMassComparator());
-      int last_alpha_index = last_alpha - peptides.cbegin();
-
-#pragma omp parallel for
-      for (int p1 = 0; p1 < last_alpha_index; ++p1)
-      {
-        // Constrain search for beta
-        double min_peptide_mass_beta = precursor_mass - cross_link_mass - peptides[p1].peptide_mass - allowed_error;
-        double max_peptide_mass_beta = precursor_mass - cross_link_mass - peptides[p1].peptide_mass + allowed_error;
+          const double mono_link_mass = cross_link_mass_mono_link[i];
 
-        // the last_alpha upper bound is also a conservative upper bound here
-        vector<OPXLDataStructs::AASeqWithMass>::const_iterator first_beta = lower_bound(peptides.cbegin()+p1, last_alpha, min_peptide_mass_beta, OPXLDataStructs::AASeqWithMassComparator());
-        vector<OPXLDataStructs::AASeqWithMass>::const_iterator last_beta = upper_bound(peptides.cbegin()+p1, last_alpha, max_peptide_mass_beta, OPXLDataStructs::AASeqWithMassComparator());
+          first_index = lower_bound(masses.cbegin(), conservative_upper_bound, precursor_mass - mono_link_mass - allowed_error) - masses.cbegin();
+          last_index = upper_bound(masses.cbegin(), conservative_upper_bound, precursor_mass - mono_link_mass + allowed_error) - masses.cbegin();
 
-        if (first_beta == last_beta)
-        {
-          continue;
+          share = thread_share(first_index, last_index);
+          for (Size p1 = share.first; p1 < share.second; ++p1)
+          {
+            // Make sure it is clear only one peptide is considered here. Use an out-of-range value for the second peptide.
+            add_candidate(masses[p1] + mono_link_mass, p1, peptides_size + 1, pm);
+          }
         }
 
-        Size first_beta_index = first_beta - peptides.begin();
-        Size last_beta_index = last_beta - peptides.begin();
+        // ################################ Enumerate Cross-Links #################
+        // maximal mass of either peptide: difference between precursor mass and the smallest peptide + cross-linker
+        const double max_peptide_mass = precursor_mass - cross_link_mass - masses[0] + allowed_error;
+        const Size beta_end = upper_bound(masses.cbegin(), conservative_upper_bound, max_peptide_mass) - masses.cbegin();
 
-        for (Size p2 = first_beta_index; p2 < last_beta_index; ++p2)
+        // alpha is the lighter peptide of the pair (alpha index <= beta index), so it has at most half of the pair mass
+        const double max_alpha_mass = min(max_peptide_mass, (precursor_mass - cross_link_mass + allowed_error) / 2);
+        const Size alpha_end = upper_bound(masses.cbegin(), masses.cbegin() + beta_end, max_alpha_mass) - masses.cbegin();
+
+        // heavier alphas need lighter betas: the beta window [lo, hi) only moves towards lower indices
+        share = thread_share(0, alpha_end);
+        Size lo = 0;
+        Size hi = 0;
+        for (Size p1 = share.first; p1 < share.second; ++p1)
         {
-          // Monoisotopic weight of the first peptide + the second peptide + cross-linker
-          double cross_linked_pair_mass = peptides[p1].peptide_mass + peptides[p2].peptide_mass + cross_link_mass;
-
-          // this time both peptides have valid indices
-          OPXLDataStructs::XLPrecursor precursor;
-          precursor.precursor_mass = cross_linked_pair_mass;
-          precursor.alpha_index = p1;
-          precursor.beta_index = p2;
-          precursor.alpha_seq = peptides[p1].unmodified_seq;
-          precursor.beta_seq = peptides[p2].unmodified_seq;
-
-#pragma omp critical (mass_to_candidates_access)
-         {
-           mass_to_candidates.push_back(precursor);
-           precursor_correction_positions.push_back(pm);
-         }
-        } // end of loop over betas
-      } // end of parallel loop over alphas
-    } // end of loop over precursor masses
+          const double min_peptide_mass_beta = precursor_mass - cross_link_mass - masses[p1] - allowed_error;
+          const double max_peptide_mass_beta = precursor_mass - cross_link_mass - masses[p1] + allowed_error;
+
+          if (p1 == share.first)
+          {
+            lo = lower_bound(masses.cbegin(), masses.cbegin() + beta_end, min_peptide_mass_beta) - masses.cbegin();
+            hi = upper_bound(masses.cbegin(), masses.cbegin() + beta_end, max_peptide_mass_beta) - masses.cbegin();
+          }
+          else
+          {
+            while (lo > 0 && masses[lo - 1] >= min_peptide_mass_beta) { --lo; }
+            while (hi > 0 && masses[hi - 1] > max_peptide_mass_beta) { --hi; }
+          }
+
+          for (Size p2 = max(lo, p1); p2 < hi; ++p2)
+          {
+            // Monoisotopic weight of the first peptide + the second peptide + cross-linker
+            add_candidate(masses[p1] + masses[p2] + cross_link_mass, p1, p2, pm);
+          }
+        }
+      } // end of loop over precursor masses
+    } // end of parallel region
+
+    Size total = 0;
+    for (const auto& c : thread_candidates) { total += c.size(); }
+    mass_to_candidates.reserve(total);
+    precursor_correction_positions.reserve(precursor_correction_positions.size() + total);
+    for (int t = 0; t < num_threads; ++t)
+    {
+      mass_to_candidates.insert(mass_to_candidates.end(), thread_candidates[t].begin(), thread_candidates[t].end());
+      precursor_correction_positions.insert(precursor_correction_positions.end(), thread_positions[t].begin(), thread_positions[t].end());
+    }
     return mass_to_candidates;
   }
 
@@ -403,7 +399,7 @@ namespace OpenMS
 #pragma omp parallel for schedule(guided)
     for (int i = 0; i < static_cast<int>(candidates.size()); ++i)
     {
-      OPXLDataStructs::XLPrecursor candidate = candidates[i];
+      const OPXLDataStructs::XLPrecursor& candidate = candidates[i];
       vector <SignedSize> link_pos_first;
       vector <SignedSize> link_pos_second;
       const AASequence* peptide_first = &(peptide_masses[candidate.alpha_index].peptide_seq);
@@ -415,9 +411,8 @@ namespace OpenMS
         peptide_second = &(peptide_masses[candidate.beta_index].peptide_seq);
         peptide_pos_second = peptide_masses[candidate.beta_index].position;
       }
-      String seq_first = candidate.alpha_seq;
-      String seq_second;
-      if (peptide_second) { seq_second = candidate.beta_seq; }
+      const String& seq_first = peptide_masses[candidate.alpha_index].unmodified_seq;
+      const String& seq_second = peptide_second ? peptide_masses[candidate.beta_index].unmodified_seq : String::EMPTY;
 
       // mono-links and loop-links with different masses can be generated for the same precursor mass, but only one of them can be valid each time.
       // Find out which is the case. But it should not happen often enough to slow down the tool significantly.
@@ -1363,7 +1358,7 @@ namespace OpenMS
     if (use_sequence_tags)
     {
       Size candidates_size = candidates.size();
-      OPXLHelper::filterPrecursorsByTags(candidates, precursor_correction_positions, tags);
+      OPXLHelper::filterPrecursorsByTags(candidates, precursor_correction_positions, filtered_peptide_masses, tags);
 
 #pragma omp critical (LOG_DEBUG_access)
       {
@@ -1447,41 +1442,47 @@ namespace OpenMS
     }
   }
 
-  void OPXLHelper::filterPrecursorsByTags(std::vector <OPXLDataStructs::XLPrecursor>& candidates, std::vector< int >& precursor_correction_positions, const std::vector<std::string>& tags)
+  void OPXLHelper::filterPrecursorsByTags(std::vector <OPXLDataStructs::XLPrecursor>& candidates, std::vector< int >& precursor_correction_positions, const std::vector<OPXLDataStructs::AASeqWithMass>& peptide_masses, const std::vector<std::string>& tags)
   {
-    std::vector <OPXLDataStructs::XLPrecursor> filtered_candidates;
-    std::vector< int > filtered_precursor_correction_positions;
+    // the tags and their reverse, so that they can be matched in both directions
+    std::vector<std::string> both_tags;
+    both_tags.reserve(2 * tags.size());
+    for (const std::string& tag : tags)
+    {
+      both_tags.push_back(tag);
+      both_tags.emplace_back(tag.rbegin(), tag.rend());
+    }
+
+    // flag the candidates to keep, then compact in the original order
+    std::vector<char> keep(candidates.size(), 0);
 
     // brute force string comparisons for now, faster than Aho-Corasick for small tag sets
-#pragma omp parallel for
-    for (int i = 0; i < static_cast<int>(candidates.size()); ++i)
+#pragma omp parallel for schedule(dynamic, 1024)
+    for (SignedSize i = 0; i < static_cast<SignedSize>(candidates.size()); ++i)
     {
-      // iterate over copies, so that we can reverse them
-      for (std::string tag : tags)
+      const String& alpha_seq = peptide_masses[candidates[i].alpha_index].unmodified_seq;
+      const String& beta_seq = candidates[i].beta_index < peptide_masses.size() ? peptide_masses[candidates[i].beta_index].unmodified_seq : String::EMPTY;
+      for (const std::string& tag : both_tags)
       {
-        if (candidates[i].alpha_seq.hasSubstring(tag) || candidates[i].beta_seq.hasSubstring(tag))
+        if (alpha_seq.hasSubstring(tag) || beta_seq.hasSubstring(tag))
         {
- #pragma omp critical (filtered_candidates_access)
-          {
-            filtered_candidates.push_back(candidates[i]);
-            filtered_precursor_correction_positions.push_back(precursor_correction_positions[i]);
-          }
-          break;
-        }
-
-        std::reverse(tag.begin(), tag.end());
-        if (candidates[i].alpha_seq.hasSubstring(tag) || candidates[i].beta_seq.hasSubstring(tag))
-        {
- #pragma omp critical (filtered_candidates_access)
-          {
-            filtered_candidates.push_back(candidates[i]);
-            filtered_precursor_correction_positions.push_back(precursor_correction_positions[i]);
-          }
+          keep[i] = 1;
           break;
         }
       }
     } // end of parallel loop over candidates
-    candidates = filtered_candidates;
-    precursor_correction_positions = filtered_precursor_correction_positions;
+
+    Size n_kept = 0;
+    for (Size i = 0; i < candidates.size(); ++i)
+    {
+      if (keep[i])
+      {
+        candidates[n_kept] = candidates[i];
+        precursor_correction_positions[n_kept] = precursor_correction_positions[i];
+        ++n_kept;
+      }
+    }
+    candidates.resize(n_kept);
+    precursor_correction_positions.resize(n_kept);
   }
 }
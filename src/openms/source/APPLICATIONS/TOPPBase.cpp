@@ -35,6 +35,7 @@
 #include <OpenMS/APPLICATIONS/TOPPBase.h>
 
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/SYSTEM/StopWatch.h>
 #include <OpenMS/SYSTEM/SysInfo.h>
 #include <OpenMS/SYSTEM/UpdateCheck.h>
@@ -167,6 +168,7 @@ namespace OpenMS
       addText_("Common UTIL options:");
     registerStringOption_("ini", "<file>", "", "Use the given TOPP INI file", false);
     registerStringOption_("log", "<file>", "", "Name of log file (created only when specified)", false, true);
+    registerStringOption_("profile", "<file>", "", "Name of the profiling report (Chrome trace JSON with per-stage timings, counters and peak memory; profiling is enabled only when specified)", false, true);
     registerIntOption_("instance", "<n>", 1, "Instance number for the TOPP INI file", false, true);
     registerIntOption_("debug", "<n>", 0, "Sets the debug level", false, true);
     registerIntOption_("threads", "<n>", 1, "Sets the number of threads allowed to be used by the TOPP tool", false);
@@ -409,6 +411,42 @@ namespace OpenMS
       //----------------------------------------------------------
       TOPPBase::setMaxNumberOfThreads(getParamAsInt_("threads", 1));
 
+      //----------------------------------------------------------
+      //profiling
+      //----------------------------------------------------------
+      String profile_file = getParamAsString_("profile", "");
+      if (!profile_file.empty())
+      {
+        Profiler::getInstance().clear();
+        Profiler::getInstance().setEnabled(true);
+      }
+
+      // writes the profiling report when leaving this block, also if main_ throws
+      struct ProfileReportWriter
+      {
+        const TOPPBase& tool;
+        const String& filename;
+
+        ~ProfileReportWriter()
+        {
+          if (filename.empty()) return;
+
+          Profiler& profiler = Profiler::getInstance();
+          profiler.addEvent(tool.tool_name_, "tool", 0.0, profiler.now());
+          profiler.recordMemory(tool.tool_name_);
+          profiler.setEnabled(false);
+          try
+          {
+            profiler.store(filename);
+            tool.writeLog_("Profiling report written to '" + filename + "'.");
+          }
+          catch (BaseException& e)
+          {
+            tool.writeLog_(String("Error: Unable to write the profiling report (") + e.what() + ")");
+          }
+        }
+      } profile_report{*this, profile_file};
+
       //----------------------------------------------------------
       //main
       //----------------------------------------------------------
@@ -0,0 +1,530 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+//
+
+#include <OpenMS/COMPARISON/SPECTRA/BinnedSpectralLibrary.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+
+#include <algorithm>
+#include <cmath>
+#include <fstream>
+#include <limits>
+#include <numeric>
+
+using namespace std;
+
+namespace OpenMS
+{
+  namespace
+  {
+    // magic number at the start of a stored binned library (changed with the file layout)
+    const int BINNED_SPECTRAL_LIBRARY_IDENTIFIER = 7392;
+
+    template <typename T>
+    void writeArray_(std::ofstream& ofs, const T* data, Size n)
+    {
+      ofs.write((const char*)data, n * sizeof(T));
+    }
+
+    template <typename T>
+    void readArray_(std::ifstream& ifs, T* data, Size n)
+    {
+      ifs.read((char*)data, n * sizeof(T));
+    }
+
+    void writeString_(std::ofstream& ofs, const String& s)
+    {
+      const Size len = s.size();
+      ofs.write((const char*)&len, sizeof(len));
+      ofs.write(s.c_str(), len);
+    }
+
+    // reads a string written by writeString_, its length must not exceed the rest of the file
+    bool readString_(std::ifstream& ifs, Size file_size, String& s)
+    {
+      Size len = 0;
+      ifs.read((char*)&len, sizeof(len));
+      if (!ifs || len > file_size - Size(ifs.tellg()))
+      {
+        return false;
+      }
+      s.resize(len);
+      ifs.read(&s[0], len);
+      return static_cast<bool>(ifs);
+    }
+  }
+
+  BinnedSpectralLibrary::BinnedSpectralLibrary() :
+    BinnedSpectralLibrary(BinnedSpectrum::DEFAULT_BIN_WIDTH_HIRES, false, 0, BinnedSpectrum::DEFAULT_BIN_OFFSET_HIRES)
+  {
+  }
+
+  BinnedSpectralLibrary::BinnedSpectralLibrary(float bin_size, bool unit_ppm, UInt spread, float offset) :
+    ProgressLogger(),
+    bin_size_(bin_size),
+    unit_ppm_(unit_ppm),
+    bin_spread_(spread),
+    offset_(offset),
+    matrix_()
+  {
+  }
+
+  BinnedSpectralLibrary::~BinnedSpectralLibrary()
+  {
+  }
+
+  void BinnedSpectralLibrary::build(const vector<PeakSpectrum>& spectra, const vector<String>& identifiers)
+  {
+    if (spectra.size() != identifiers.size())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Number of identifiers does not match the number of library spectra.");
+    }
+
+    for (const PeakSpectrum& s : spectra)
+    {
+      if (s.getPrecursors().empty())
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Library spectrum without precursor information.");
+      }
+    }
+
+    // sort rows by precursor m/z so precursor windows map to contiguous row blocks
+    input_index_.resize(spectra.size());
+    iota(input_index_.begin(), input_index_.end(), 0);
+    stable_sort(input_index_.begin(), input_index_.end(), [&spectra](Size a, Size b)
+    {
+      return spectra[a].getPrecursors()[0].getMZ() < spectra[b].getPrecursors()[0].getMZ();
+    });
+
+    const Size n = spectra.size();
+    precursor_mz_.resize(n);
+    precursor_charge_.resize(n);
+    rt_.resize(n);
+    identifiers_.resize(n);
+
+    // bin all spectra independently
+    vector<BinnedSpectrum::SparseVectorType> rows(n);
+    Size progress = 0;
+    startProgress(0, n, "binning spectral library");
+#pragma omp parallel for schedule(dynamic, 64)
+    for (SignedSize r = 0; r < (SignedSize)n; ++r)
+    {
+      const PeakSpectrum& s = spectra[input_index_[r]];
+      rows[r] = binSpectrum(s).getBins();
+      precursor_mz_[r] = s.getPrecursors()[0].getMZ();
+      precursor_charge_[r] = s.getPrecursors()[0].getCharge();
+      rt_[r] = s.getRT();
+      identifiers_[r] = identifiers[input_index_[r]];
+#pragma omp critical (BinnedSpectralLibrary_progress)
+      setProgress(++progress);
+    }
+    endProgress();
+
+    // assemble the CSR matrix directly from the (sorted) sparse rows
+    Size nnz = 0;
+    SparseMatrixType::StorageIndex cols = 1;
+    for (const auto& row : rows)
+    {
+      nnz += row.nonZeros();
+      if (row.nonZeros() > 0)
+      {
+        cols = max(cols, static_cast<SparseMatrixType::StorageIndex>(row.innerIndexPtr()[row.nonZeros() - 1] + 1));
+      }
+    }
+
+    matrix_.resize(n, cols);
+    matrix_.resizeNonZeros(nnz);
+    Size pos = 0;
+    for (Size r = 0; r < n; ++r)
+    {
+      matrix_.outerIndexPtr()[r] = static_cast<SparseMatrixType::StorageIndex>(pos);
+      const auto& row = rows[r];
+      copy(row.innerIndexPtr(), row.innerIndexPtr() + row.nonZeros(), matrix_.innerIndexPtr() + pos);
+      copy(row.valuePtr(), row.valuePtr() + row.nonZeros(), matrix_.valuePtr() + pos);
+      pos += row.nonZeros();
+    }
+    matrix_.outerIndexPtr()[n] = static_cast<SparseMatrixType::StorageIndex>(pos);
+
+    updateRowNorms_();
+  }
+
+  BinnedSpectrum BinnedSpectralLibrary::binSpectrum(const PeakSpectrum& spectrum) const
+  {
+    return BinnedSpectrum(spectrum, bin_size_, unit_ppm_, bin_spread_, offset_);
+  }
+
+  BinnedSpectralLibrary::RowRange BinnedSpectralLibrary::getPrecursorRange(double mz_low, double mz_high) const
+  {
+    const Size first = lower_bound(precursor_mz_.begin(), precursor_mz_.end(), mz_low) - precursor_mz_.begin();
+    const Size last = upper_bound(precursor_mz_.begin(), precursor_mz_.end(), mz_high) - precursor_mz_.begin();
+    return RowRange(first, max(first, last));
+  }
+
+  void BinnedSpectralLibrary::score(const BinnedSpectrum& query, const RowRange& range, vector<double>& scores) const
+  {
+    vector<vector<double> > block_scores(1);
+    scoreBlock_(vector<BinnedSpectrum>(1, query), vector<RowRange>(1, range), vector<Size>(1, 0), block_scores);
+    scores.swap(block_scores[0]);
+  }
+
+  void BinnedSpectralLibrary::scoreBatch(const vector<BinnedSpectrum>& queries,
+                                         const vector<RowRange>& ranges,
+                                         vector<vector<double> >& scores,
+                                         Size block_size) const
+  {
+    if (queries.size() != ranges.size())
+    {
+      throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Number of queries and row ranges differ.");
+    }
+
+    scores.assign(queries.size(), vector<double>());
+    if (block_size == 0) { block_size = 1; }
+
+    // order queries by their library window so that neighbors share library rows
+    vector<Size> order(queries.size());
+    iota(order.begin(), order.end(), 0);
+    stable_sort(order.begin(), order.end(), [&ranges](Size a, Size b)
+    {
+      return ranges[a] < ranges[b];
+    });
+
+    // group into blocks of overlapping windows
+    vector<vector<Size> > blocks;
+    Size block_end = 0;
+    for (Size q : order)
+    {
+      if (ranges[q].first >= ranges[q].second) { continue; } // nothing to score
+
+      if (blocks.empty() || blocks.back().size() >= block_size || ranges[q].first >= block_end)
+      {
+        blocks.emplace_back();
+        block_end = 0;
+      }
+      blocks.back().push_back(q);
+      block_end = max(block_end, ranges[q].second);
+    }
+
+    // empty windows still get a (zero-sized) result
+    for (Size q = 0; q < queries.size(); ++q)
+    {
+      scores[q].assign(ranges[q].second > ranges[q].first ? ranges[q].second - ranges[q].first : 0, 0.0);
+    }
+
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize b = 0; b < (SignedSize)blocks.size(); ++b)
+    {
+      scoreBlock_(queries, ranges, blocks[b], scores);
+    }
+  }
+
+  void BinnedSpectralLibrary::scoreBlock_(const vector<BinnedSpectrum>& queries,
+                                          const vector<RowRange>& ranges,
+                                          const vector<Size>& block,
+                                          vector<vector<double> >& scores) const
+  {
+    // rows covered by the whole block
+    Size first = size();
+    Size last = 0;
+    for (Size q : block)
+    {
+      const Size q_last = min(ranges[q].second, size());
+      scores[q].assign(ranges[q].second > ranges[q].first ? ranges[q].second - ranges[q].first : 0, 0.0);
+      if (ranges[q].first >= q_last) { continue; }
+      first = min(first, ranges[q].first);
+      last = max(last, q_last);
+    }
+    if (first >= last) { return; }
+
+    // one column per query; bins beyond the library dimension cannot match and only contribute to the norm
+    vector<Eigen::Triplet<float> > triplets;
+    vector<double> query_norms(block.size(), 0.0);
+    for (Size c = 0; c < block.size(); ++c)
+    {
+      const BinnedSpectrum::SparseVectorType& bins = queries[block[c]].getBins();
+      for (BinnedSpectrum::SparseVectorIteratorType it(bins); it; ++it)
+      {
+        query_norms[c] += static_cast<double>(it.value()) * it.value();
+        if (it.index() < matrix_.cols())
+        {
+          triplets.emplace_back(it.index(), c, it.value());
+        }
+      }
+      query_norms[c] = sqrt(query_norms[c]);
+    }
+    Eigen::SparseMatrix<float> query_matrix(matrix_.cols(), block.size());
+    query_matrix.setFromTriplets(triplets.begin(), triplets.end());
+
+    // library rows x queries
+    const Eigen::SparseMatrix<float> dot_products = matrix_.middleRows(first, last - first) * query_matrix;
+
+    for (Size c = 0; c < block.size(); ++c)
+    {
+      const Size q = block[c];
+      if (query_norms[c] == 0.0) { continue; }
+      for (Eigen::SparseMatrix<float>::InnerIterator it(dot_products, c); it; ++it)
+      {
+        const Size row = first + it.row();
+        if (row < ranges[q].first || row >= ranges[q].second || row_norms_[row] == 0.0) { continue; }
+        scores[q][row - ranges[q].first] = it.value() / (row_norms_[row] * query_norms[c]);
+      }
+    }
+  }
+
+  void BinnedSpectralLibrary::updateRowNorms_()
+  {
+    row_norms_.assign(size(), 0.0);
+    for (Size r = 0; r < size(); ++r)
+    {
+      double sum = 0.0;
+      for (SparseMatrixType::InnerIterator it(matrix_, r); it; ++it)
+      {
+        sum += static_cast<double>(it.value()) * it.value();
+      }
+      row_norms_[r] = sqrt(sum);
+    }
+  }
+
+  void BinnedSpectralLibrary::store(const String& filename) const
+  {
+    std::ofstream ofs(filename.c_str(), std::ios::binary);
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    const int file_identifier = BINNED_SPECTRAL_LIBRARY_IDENTIFIER;
+    const char unit_ppm = unit_ppm_ ? 1 : 0;
+    const Size rows = matrix_.rows();
+    const Size cols = matrix_.cols();
+    const Size nnz = matrix_.nonZeros();
+
+    ofs.write((const char*)&file_identifier, sizeof(file_identifier));
+    ofs.write((const char*)&bin_size_, sizeof(bin_size_));
+    ofs.write(&unit_ppm, sizeof(unit_ppm));
+    ofs.write((const char*)&bin_spread_, sizeof(bin_spread_));
+    ofs.write((const char*)&offset_, sizeof(offset_));
+    ofs.write((const char*)&rows, sizeof(rows));
+    ofs.write((const char*)&cols, sizeof(cols));
+    ofs.write((const char*)&nnz, sizeof(nnz));
+    writeString_(ofs, source_fingerprint_);
+
+    if (rows > 0)
+    {
+      writeArray_(ofs, matrix_.outerIndexPtr(), rows + 1);
+      writeArray_(ofs, matrix_.innerIndexPtr(), nnz);
+      writeArray_(ofs, matrix_.valuePtr(), nnz);
+      writeArray_(ofs, precursor_mz_.data(), rows);
+      writeArray_(ofs, precursor_charge_.data(), rows);
+      writeArray_(ofs, rt_.data(), rows);
+    }
+
+    for (const String& id : identifiers_)
+    {
+      writeString_(ofs, id);
+    }
+
+    if (!ofs)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "Error while writing binned spectral library.");
+    }
+  }
+
+  void BinnedSpectralLibrary::load(const String& filename)
+  {
+    std::ifstream ifs(filename.c_str(), std::ios::binary | std::ios::ate);
+    if (ifs.fail())
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    const Size file_size = Size(ifs.tellg());
+    ifs.seekg(0);
+
+    int file_identifier = 0;
+    ifs.read((char*)&file_identifier, sizeof(file_identifier));
+    if (!ifs || file_identifier != BINNED_SPECTRAL_LIBRARY_IDENTIFIER)
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+        "File might not be a binned spectral library (wrong file magic number). Aborting!", filename);
+    }
+
+    char unit_ppm = 0;
+    Size rows = 0, cols = 0, nnz = 0;
+    ifs.read((char*)&bin_size_, sizeof(bin_size_));
+    ifs.read(&unit_ppm, sizeof(unit_ppm));
+    ifs.read((char*)&bin_spread_, sizeof(bin_spread_));
+    ifs.read((char*)&offset_, sizeof(offset_));
+    ifs.read((char*)&rows, sizeof(rows));
+    ifs.read((char*)&cols, sizeof(cols));
+    ifs.read((char*)&nnz, sizeof(nnz));
+    unit_ppm_ = unit_ppm != 0;
+    if (!ifs || !readString_(ifs, file_size, source_fingerprint_))
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Truncated binned spectral library header.", filename);
+    }
+
+    // check the sizes against the rest of the file before allocating anything
+    typedef SparseMatrixType::StorageIndex StorageIndex;
+    const Size remaining = file_size - Size(ifs.tellg());
+    const Size bytes_per_row = sizeof(StorageIndex) + sizeof(double) + sizeof(Int) + sizeof(double) + sizeof(Size);
+    const Size bytes_per_nonzero = sizeof(StorageIndex) + sizeof(float);
+    if (rows > remaining / bytes_per_row || nnz > remaining / bytes_per_nonzero ||
+        rows * bytes_per_row + nnz * bytes_per_nonzero > remaining || cols > Size(std::numeric_limits<StorageIndex>::max()))
+    {
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Truncated or corrupt binned spectral library.", filename);
+    }
+
+    matrix_.resize(rows, cols);
+    matrix_.resizeNonZeros(nnz);
+    precursor_mz_.resize(rows);
+    precursor_charge_.resize(rows);
+    rt_.resize(rows);
+    identifiers_.resize(rows);
+    input_index_.clear();
+
+    if (rows > 0)
+    {
+      readArray_(ifs, matrix_.outerIndexPtr(), rows + 1);
+      readArray_(ifs, matrix_.innerIndexPtr(), nnz);
+      readArray_(ifs, matrix_.valuePtr(), nnz);
+      readArray_(ifs, precursor_mz_.data(), rows);
+      readArray_(ifs, precursor_charge_.data(), rows);
+      readArray_(ifs, rt_.data(), rows);
+    }
+
+    bool valid = static_cast<bool>(ifs);
+    for (Size r = 0; valid && r < rows; ++r)
+    {
+      valid = readString_(ifs, file_size, identifiers_[r]);
+    }
+
+    // check consistency of the CSR structure before it is used
+    if (valid && rows > 0)
+    {
+      valid = matrix_.outerIndexPtr()[0] == 0 && static_cast<Size>(matrix_.outerIndexPtr()[rows]) == nnz;
+      for (Size r = 0; valid && r < rows; ++r)
+      {
+        valid = matrix_.outerIndexPtr()[r] <= matrix_.outerIndexPtr()[r + 1];
+      }
+      for (Size i = 0; valid && i < nnz; ++i)
+      {
+        valid = matrix_.innerIndexPtr()[i] >= 0 && static_cast<Size>(matrix_.innerIndexPtr()[i]) < cols;
+      }
+    }
+    if (!valid)
+    {
+      matrix_.resize(0, 0);
+      precursor_mz_.clear();
+      precursor_charge_.clear();
+      rt_.clear();
+      identifiers_.clear();
+      row_norms_.clear();
+      source_fingerprint_.clear();
+      throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Truncated or corrupt binned spectral library.", filename);
+    }
+
+    updateRowNorms_();
+  }
+
+  Size BinnedSpectralLibrary::size() const
+  {
+    return precursor_mz_.size();
+  }
+
+  bool BinnedSpectralLibrary::empty() const
+  {
+    return precursor_mz_.empty();
+  }
+
+  const BinnedSpectralLibrary::SparseMatrixType& BinnedSpectralLibrary::getMatrix() const
+  {
+    return matrix_;
+  }
+
+  const vector<double>& BinnedSpectralLibrary::getPrecursorMZs() const
+  {
+    return precursor_mz_;
+  }
+
+  const vector<Int>& BinnedSpectralLibrary::getPrecursorCharges() const
+  {
+    return precursor_charge_;
+  }
+
+  const vector<double>& BinnedSpectralLibrary::getRTs() const
+  {
+    return rt_;
+  }
+
+  const vector<String>& BinnedSpectralLibrary::getIdentifiers() const
+  {
+    return identifiers_;
+  }
+
+  const vector<Size>& BinnedSpectralLibrary::getInputIndices() const
+  {
+    return input_index_;
+  }
+
+  void BinnedSpectralLibrary::setSourceFingerprint(const String& fingerprint)
+  {
+    source_fingerprint_ = fingerprint;
+  }
+
+  const String& BinnedSpectralLibrary::getSourceFingerprint() const
+  {
+    return source_fingerprint_;
+  }
+
+  float BinnedSpectralLibrary::getBinSize() const
+  {
+    return bin_size_;
+  }
+
+  bool BinnedSpectralLibrary::isUnitPPM() const
+  {
+    return unit_ppm_;
+  }
+
+  UInt BinnedSpectralLibrary::getBinSpread() const
+  {
+    return bin_spread_;
+  }
+
+  float BinnedSpectralLibrary::getOffset() const
+  {
+    return offset_;
+  }
+
+}
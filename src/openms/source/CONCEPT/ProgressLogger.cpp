@@ -36,6 +36,7 @@
 #include <OpenMS/CONCEPT/Macros.h>
 #include <OpenMS/CONCEPT/Factory.h>
 
+#include <OpenMS/SYSTEM/Profiler.h>
 #include <OpenMS/SYSTEM/StopWatch.h>
 
 #include <QtCore/QString>
@@ -190,14 +191,16 @@ public:
 
   ProgressLogger::ProgressLogger() :
     type_(NONE),
-    last_invoke_()
+    last_invoke_(),
+    progress_depth_(0)
   {
     current_logger_ = Factory<ProgressLogger::ProgressLoggerImpl>::create(logTypeToFactoryName_(type_));
   }
 
   ProgressLogger::ProgressLogger(const ProgressLogger& other) :
     type_(other.type_),
-    last_invoke_(other.last_invoke_)
+    last_invoke_(other.last_invoke_),
+    progress_depth_(0)
   {
     // recreate our logger
     current_logger_ = Factory<ProgressLogger::ProgressLoggerImpl>::create(logTypeToFactoryName_(type_));
@@ -244,6 +247,13 @@ public:
     last_invoke_ = time(nullptr);
     current_logger_->startProgress(begin, end, label, recursion_depth_);
     ++recursion_depth_;
+    // regions are only pushed while profiling, their depth keeps them matched
+    // with endProgress even if the profiler is toggled in between
+    if (Profiler::isEnabled())
+    {
+      profile_regions_.push_back(ProfileRegion_{label, Profiler::getInstance().now(), progress_depth_});
+    }
+    ++progress_depth_;
   }
 
   void ProgressLogger::setProgress(SignedSize value) const
@@ -271,6 +281,22 @@ public:
       --recursion_depth_;
     }
     current_logger_->endProgress(recursion_depth_);
+    if (progress_depth_)
+    {
+      --progress_depth_;
+    }
+    if (!profile_regions_.empty() && profile_regions_.back().depth == progress_depth_)
+    {
+      if (Profiler::isEnabled())
+      {
+        Profiler& profiler = Profiler::getInstance();
+        const ProfileRegion_& region = profile_regions_.back();
+        const String label = region.label;
+        profiler.addEvent(label, "progress", region.start_us, profiler.now() - region.start_us);
+        profiler.recordMemory(label);
+      }
+      profile_regions_.pop_back();
+    }
   }
 
 
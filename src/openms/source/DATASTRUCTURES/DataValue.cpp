@@ -39,6 +39,7 @@
 
 #include <QtCore/QString>
 
+#include <atomic>
 #include <sstream>
 
 using namespace std;
@@ -46,6 +47,35 @@ using namespace std;
 namespace OpenMS
 {
 
+  struct DataValue::SharedString_
+  {
+    template <typename T>
+    explicit SharedString_(const T& s) :
+      refs(1),
+      value(s)
+    {
+    }
+
+    /// Adds a reference and returns this payload
+    SharedString_* acquire()
+    {
+      refs.fetch_add(1, std::memory_order_relaxed);
+      return this;
+    }
+
+    /// Drops a reference and deletes the payload if it was the last one
+    void release()
+    {
+      if (refs.fetch_sub(1, std::memory_order_acq_rel) == 1)
+      {
+        delete this;
+      }
+    }
+
+    std::atomic<Size> refs;
+    const String value;
+  };
+
   const DataValue DataValue::EMPTY;
 
   // default ctor
@@ -134,25 +164,25 @@ namespace OpenMS
   DataValue::DataValue(const char* p) :
     value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
   {
-    data_.str_ = new String(p);
+    data_.str_ = new SharedString_(p);
   }
 
   DataValue::DataValue(const string& p) :
     value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
   {
-    data_.str_ = new String(p);
+    data_.str_ = new SharedString_(p);
   }
 
   DataValue::DataValue(const QString& p) :
     value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
   {
-    data_.str_ = new String(p);
+    data_.str_ = new SharedString_(p);
   }
 
   DataValue::DataValue(const String& p) :
     value_type_(STRING_VALUE), unit_type_(OTHER), unit_(-1)
   {
-    data_.str_ = new String(p);
+    data_.str_ = new SharedString_(p);
   }
 
   DataValue::DataValue(const StringList& p) :
@@ -184,7 +214,7 @@ namespace OpenMS
   {
     if (value_type_ == STRING_VALUE)
     {
-      data_.str_ = new String(*(p.data_.str_));
+      data_.str_ = p.data_.str_->acquire();
     }
     else if (value_type_ == STRING_LIST)
     {
@@ -221,7 +251,7 @@ namespace OpenMS
     }
     else if (value_type_ == STRING_VALUE)
     {
-      delete(data_.str_);
+      data_.str_->release();
     }
     else if (value_type_ == INT_LIST)
     {
@@ -258,7 +288,7 @@ namespace OpenMS
     }
     else if (p.value_type_ == STRING_VALUE)
     {
-      data_.str_ = new String(*(p.data_.str_));
+      data_.str_ = p.data_.str_->acquire();
     }
     else if (p.value_type_ == INT_LIST)
     {
@@ -314,7 +344,7 @@ namespace OpenMS
   DataValue& DataValue::operator=(const char* arg)
   {
     clear_();
-    data_.str_ = new String(arg);
+    data_.str_ = new SharedString_(arg);
     value_type_ = STRING_VALUE;
     return *this;
   }
@@ -322,7 +352,7 @@ namespace OpenMS
   DataValue& DataValue::operator=(const std::string& arg)
   {
     clear_();
-    data_.str_ = new String(arg);
+    data_.str_ = new SharedString_(arg);
     value_type_ = STRING_VALUE;
     return *this;
   }
@@ -330,7 +360,7 @@ namespace OpenMS
   DataValue& DataValue::operator=(const String& arg)
   {
     clear_();
-    data_.str_ = new String(arg);
+    data_.str_ = new SharedString_(arg);
     value_type_ = STRING_VALUE;
     return *this;
   }
@@ -338,7 +368,7 @@ namespace OpenMS
   DataValue& DataValue::operator=(const QString& arg)
   {
     clear_();
-    data_.str_ = new String(arg);
+    data_.str_ = new SharedString_(arg);
     value_type_ = STRING_VALUE;
     return *this;
   }
@@ -591,7 +621,7 @@ namespace OpenMS
     {
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Could not convert non-string DataValue to string");
     }
-    return *(data_.str_);
+    return data_.str_->value;
   }
 
   DataValue::operator StringList() const
@@ -614,7 +644,7 @@ namespace OpenMS
   {
     switch (value_type_)
     {
-    case DataValue::STRING_VALUE: return const_cast<const char*>(data_.str_->c_str());
+    case DataValue::STRING_VALUE: return const_cast<const char*>(data_.str_->value.c_str());
 
     case DataValue::EMPTY_VALUE: return nullptr;
 
@@ -657,7 +687,7 @@ namespace OpenMS
     {
       case DataValue::EMPTY_VALUE: break;
 
-      case DataValue::STRING_VALUE: return *(data_.str_);
+      case DataValue::STRING_VALUE: return data_.str_->value;
 
       case DataValue::STRING_LIST: ss << *(data_.str_list_); break;
 
@@ -684,7 +714,7 @@ namespace OpenMS
     {
     case DataValue::EMPTY_VALUE: break;
 
-    case DataValue::STRING_VALUE: result = QString::fromStdString(*(data_.str_)); break;
+    case DataValue::STRING_VALUE: result = QString::fromStdString(data_.str_->value); break;
 
     case DataValue::STRING_LIST: result = QString::fromStdString(this->toString()); break;
 
@@ -707,12 +737,12 @@ namespace OpenMS
     {
       throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Could not convert non-string DataValue to bool.");
     }
-    else if (*(data_.str_) != "true" &&  *(data_.str_) != "false")
+    else if (data_.str_->value != "true" &&  data_.str_->value != "false")
     {
-      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Could not convert '") + *(data_.str_) + "' to bool. Valid stings are 'true' and 'false'.");
+      throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, String("Could not convert '") + data_.str_->value + "' to bool. Valid stings are 'true' and 'false'.");
     }
 
-    return *(data_.str_) == "true";
+    return data_.str_->value == "true";
   }
 
   // ----------------- Comparator ----------------------
@@ -725,7 +755,7 @@ namespace OpenMS
       {
       case DataValue::EMPTY_VALUE: return b.value_type_ == DataValue::EMPTY_VALUE;
 
-      case DataValue::STRING_VALUE: return *(a.data_.str_) == *(b.data_.str_);
+      case DataValue::STRING_VALUE: return a.data_.str_->value == b.data_.str_->value;
 
       case DataValue::STRING_LIST: return *(a.data_.str_list_) == *(b.data_.str_list_);
 
@@ -749,7 +779,7 @@ namespace OpenMS
       {
       case DataValue::EMPTY_VALUE: return false;
 
-      case DataValue::STRING_VALUE: return *(a.data_.str_) < *(b.data_.str_);
+      case DataValue::STRING_VALUE: return a.data_.str_->value < b.data_.str_->value;
 
       case DataValue::STRING_LIST: return a.data_.str_list_->size() < b.data_.str_list_->size();
 
@@ -773,7 +803,7 @@ namespace OpenMS
       {
       case DataValue::EMPTY_VALUE: return false;
 
-      case DataValue::STRING_VALUE: return *(a.data_.str_) > *(b.data_.str_);
+      case DataValue::STRING_VALUE: return a.data_.str_->value > b.data_.str_->value;
 
       case DataValue::STRING_LIST: return a.data_.str_list_->size() > b.data_.str_list_->size();
 
@@ -801,7 +831,7 @@ namespace OpenMS
   {
     switch (p.value_type_)
     {
-    case DataValue::STRING_VALUE: os << *(p.data_.str_); break;
+    case DataValue::STRING_VALUE: os << p.data_.str_->value; break;
 
     case DataValue::STRING_LIST: os << *(p.data_.str_list_); break;
 
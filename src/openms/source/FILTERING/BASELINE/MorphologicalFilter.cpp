@@ -33,7 +33,35 @@
 // --------------------------------------------------------------------------
 //
 
+#include <OpenMS/FILTERING/BASELINE/MorphologicalFilter.h>
+
+#include <exception>
+
 namespace OpenMS
 {
 
+  void MorphologicalFilter::filterExperiment(PeakMap& exp)
+  {
+    Size progress = 0;
+    std::exception_ptr err;
+    startProgress(0, exp.size(), "filtering baseline");
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < static_cast<SignedSize>(exp.size()); ++i)
+    {
+      try
+      {
+        filter(exp[i]);
+      }
+      catch (...)
+      {
+#pragma omp critical (MorphologicalFilter_error)
+        if (!err) err = std::current_exception();
+      }
+#pragma omp critical (MorphologicalFilter_progress)
+      setProgress(++progress);
+    }
+    endProgress();
+    if (err) std::rethrow_exception(err);
+  }
+
 }
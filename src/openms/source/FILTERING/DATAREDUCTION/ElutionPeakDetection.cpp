@@ -40,6 +40,8 @@
 
 #include <boost/dynamic_bitset.hpp>
 
+#include <iterator>
+
 #ifdef _OPENMP
 #include <omp.h>
 #endif
@@ -329,10 +331,14 @@ namespace OpenMS
     // make sure that single_mtraces is empty
     single_mtraces.clear();
 
+    // each input trace gets its own output buffer, so threads never share a
+    // vector and the merged result does not depend on the thread scheduling
+    std::vector<std::vector<MassTrace> > peaks_per_trace(mt_vec.size());
+
     this->startProgress(0, mt_vec.size(), "elution peak detection");
     Size progress(0);
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 16)
 #endif
     for (SignedSize i = 0; i < (SignedSize) mt_vec.size(); ++i)
     {
@@ -343,12 +349,23 @@ namespace OpenMS
 #endif
       ++progress;
 
-      // push_back to 'single_mtraces' is protected, so threading is ok
-      detectElutionPeaks_(mt_vec[i], single_mtraces);
+      detectElutionPeaks_(mt_vec[i], peaks_per_trace[i]);
     }
 
     this->endProgress();
 
+    Size total_peaks(0);
+    for (const std::vector<MassTrace>& peaks : peaks_per_trace)
+    {
+      total_peaks += peaks.size();
+    }
+    single_mtraces.reserve(total_peaks);
+    for (std::vector<MassTrace>& peaks : peaks_per_trace)
+    {
+      std::move(peaks.begin(), peaks.end(), std::back_inserter(single_mtraces));
+      std::vector<MassTrace>().swap(peaks);
+    }
+
     return;
   }
 
@@ -463,12 +480,7 @@ namespace OpenMS
           mt.estimateFWHM(true);
         }
 
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_ElutionPeakDetection_mtraces)
-#endif
-        {
-          single_mtraces.push_back(mt);
-        }
+        single_mtraces.push_back(mt);
 
       }
     }
@@ -544,12 +556,7 @@ namespace OpenMS
             new_mt.estimateFWHM(true);
           }
 
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_ElutionPeakDetection_mtraces)
-#endif
-          {
-            single_mtraces.push_back(new_mt);
-          }
+          single_mtraces.push_back(new_mt);
         }
       }
 
@@ -37,7 +37,9 @@
 #include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/OpenSwathHelper.h>
 
+#include <algorithm>
 #include <fstream>
+#include <iterator>
 
 #include <boost/dynamic_bitset.hpp>
 
@@ -287,7 +289,8 @@ namespace OpenMS
   }
 
   FeatureFindingMetabo::FeatureFindingMetabo() :
-    DefaultParamHandler("FeatureFindingMetabo"), ProgressLogger()
+    DefaultParamHandler("FeatureFindingMetabo"), ProgressLogger(),
+    averagine_cache_(0.0, 1.0)
   {
     defaults_.setValue("local_rt_range", 10.0, "RT range where to look for coeluting mass traces", ListUtils::create<String>("advanced")); // 5.0
     defaults_.setValue("local_mz_range", 6.5, "MZ range where to look for isotopic mass traces", ListUtils::create<String>("advanced")); // 6.5
@@ -371,11 +374,31 @@ namespace OpenMS
 
   double FeatureFindingMetabo::computeAveragineSimScore_(const std::vector<double>& hypo_ints, const double& mol_weight) const
   {
-    CoarseIsotopePatternGenerator solver(hypo_ints.size());
-    auto isodist = solver.estimateFromPeptideWeight(mol_weight);
-    // isodist.renormalize();
+    std::vector<double> averagine_ints;
+    const IsotopeDistributionCache::TheoreticalIsotopePattern* cached = nullptr;
+    try
+    {
+      cached = &averagine_cache_.getIsotopeDistribution(mol_weight);
+    }
+    catch (Exception::InvalidValue&)
+    {
+      // mass outside of the cached range
+    }
+
+    if (cached != nullptr && cached->trimmed_left == 0 && cached->intensity.size() >= hypo_ints.size())
+    {
+      averagine_ints.assign(cached->intensity.begin(), cached->intensity.begin() + hypo_ints.size());
+    }
+    else
+    {
+      CoarseIsotopePatternGenerator solver(hypo_ints.size());
+      auto isodist = solver.estimateFromPeptideWeight(mol_weight);
+      for (Size i = 0; i < hypo_ints.size(); ++i)
+      {
+        averagine_ints.push_back(isodist.getContainer()[i].getIntensity());
+      }
+    }
 
-    IsotopeDistribution::ContainerType averagine_dist = isodist.getContainer();
     double max_int(0.0), theo_max_int(0.0);
     for (Size i = 0; i < hypo_ints.size(); ++i)
     {
@@ -384,9 +407,9 @@ namespace OpenMS
         max_int = hypo_ints[i];
       }
 
-      if (averagine_dist[i].getIntensity() > theo_max_int)
+      if (averagine_ints[i] > theo_max_int)
       {
-        theo_max_int = averagine_dist[i].getIntensity();
+        theo_max_int = averagine_ints[i];
       }
     }
 
@@ -394,7 +417,7 @@ namespace OpenMS
     std::vector<double> averagine_ratios, hypo_isos;
     for (Size i = 0; i < hypo_ints.size(); ++i)
     {
-      averagine_ratios.push_back(averagine_dist[i].getIntensity() / theo_max_int);
+      averagine_ratios.push_back(averagine_ints[i] / theo_max_int);
       hypo_isos.push_back(hypo_ints[i] / max_int);
     }
 
@@ -763,13 +786,7 @@ namespace OpenMS
     tmp_hypo.addMassTrace(*candidates[0]);
     tmp_hypo.setScore((candidates[0]->getIntensity(use_smoothed_intensities_)) / total_intensity);
 
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_FFMetabo_output_hypos)
-#endif
-    {
-      // pushing back to shared vector needs to be synchronized
-      output_hypotheses.push_back(tmp_hypo);
-    }
+    output_hypotheses.push_back(tmp_hypo);
 
     for (Size charge = charge_lower_bound_; charge <= charge_upper_bound_; ++charge)
     {
@@ -785,8 +802,8 @@ namespace OpenMS
       Size iso_pos_max(static_cast<Size>(std::floor(charge * local_mz_range_)));
       for (Size iso_pos = 1; iso_pos <= iso_pos_max; ++iso_pos)
       {
-        //estimate expected m/z window for iso_pos
-        Range isotope_window = getTheoreticIsotopicMassWindow_(elements_, iso_pos);
+        // expected m/z window for iso_pos
+        const Range& isotope_window = isotope_windows_[iso_pos - 1];
         // Find mass trace that best agrees with current hypothesis of charge
         // and isotopic position
         double best_so_far(0.0);
@@ -846,13 +863,7 @@ namespace OpenMS
           fh_tmp.setCharge(charge);
           last_iso_idx = best_idx;
 
-#ifdef _OPENMP
-#pragma omp critical (OPENMS_FFMetabo_output_hypos)
-#endif
-          {
-            // pushing back to shared vector needs to be synchronized
-            output_hypotheses.push_back(fh_tmp);
-          }
+          output_hypotheses.push_back(fh_tmp);
         }
         else
         {
@@ -910,15 +921,41 @@ namespace OpenMS
       total_intensity += input_mtraces[i].getIntensity(use_smoothed_intensities_);
     }
 
+    // the expected isotope m/z windows and the averagine patterns only depend
+    // on the parameters, so compute them once instead of for every candidate
+    Size max_iso_pos(static_cast<Size>(std::floor(charge_upper_bound_ * local_mz_range_)));
+    isotope_windows_.clear();
+    for (Size iso_pos = 1; iso_pos <= max_iso_pos; ++iso_pos)
+    {
+      isotope_windows_.push_back(getTheoreticIsotopicMassWindow_(elements_, static_cast<int>(iso_pos)));
+    }
+    if (isotope_filtering_model_ == "peptides")
+    {
+      averagine_cache_ = IsotopeDistributionCache(input_mtraces.back().getCentroidMZ() * charge_upper_bound_ + 1.0, 1.0);
+    }
+
     // *********************************************************** //
     // Step 2 Iterate through all mass traces to find likely matches 
     // and generate isotopic / charge hypotheses
     // *********************************************************** //
 
-    std::vector<FeatureHypothesis> feat_hypos;
+    // centroids in contiguous arrays; as the traces are sorted by m/z, the
+    // candidates of a trace are the ones following it up to local_mz_range_
+    std::vector<double> trace_mzs, trace_rts;
+    trace_mzs.reserve(input_mtraces.size());
+    trace_rts.reserve(input_mtraces.size());
+    for (const MassTrace& mt : input_mtraces)
+    {
+      trace_mzs.push_back(mt.getCentroidMZ());
+      trace_rts.push_back(mt.getCentroidRT());
+    }
+
+    // each trace gets its own output buffer, so threads never share a vector
+    // and the merged hypotheses do not depend on the thread scheduling
+    std::vector<std::vector<FeatureHypothesis> > hypos_per_trace(input_mtraces.size());
     Size progress(0);
 #ifdef _OPENMP
-#pragma omp parallel for
+#pragma omp parallel for schedule(dynamic, 16)
 #endif
     for (SignedSize i = 0; i < (SignedSize)input_mtraces.size(); ++i)
     {
@@ -929,28 +966,37 @@ namespace OpenMS
       ++progress;
 
       std::vector<const MassTrace*> local_traces;
-      double ref_trace_mz(input_mtraces[i].getCentroidMZ());
-      double ref_trace_rt(input_mtraces[i].getCentroidRT());
+      double ref_trace_mz(trace_mzs[i]);
+      double ref_trace_rt(trace_rts[i]);
 
       local_traces.push_back(&input_mtraces[i]);
 
-      for (Size ext_idx = i + 1; ext_idx < input_mtraces.size(); ++ext_idx)
+      Size window_end = std::upper_bound(trace_mzs.begin() + i + 1, trace_mzs.end(), ref_trace_mz + local_mz_range_) - trace_mzs.begin();
+      for (Size ext_idx = i + 1; ext_idx < window_end; ++ext_idx)
       {
-        // traces are sorted by m/z, so we can break when we leave the allowed window
-        double diff_mz = std::fabs(input_mtraces[ext_idx].getCentroidMZ() - ref_trace_mz);
-        if (diff_mz > local_mz_range_) break;
-
-        double diff_rt = std::fabs(input_mtraces[ext_idx].getCentroidRT() - ref_trace_rt);
+        double diff_rt = std::fabs(trace_rts[ext_idx] - ref_trace_rt);
         if (diff_rt <= local_rt_range_)
         {
-          // std::cout << " accepted!" << std::endl;
           local_traces.push_back(&input_mtraces[ext_idx]);
         }
       }
-      findLocalFeatures_(local_traces, total_intensity, feat_hypos);
+      findLocalFeatures_(local_traces, total_intensity, hypos_per_trace[i]);
     }
     this->endProgress();
 
+    std::vector<FeatureHypothesis> feat_hypos;
+    Size total_hypos(0);
+    for (const std::vector<FeatureHypothesis>& hypos : hypos_per_trace)
+    {
+      total_hypos += hypos.size();
+    }
+    feat_hypos.reserve(total_hypos);
+    for (std::vector<FeatureHypothesis>& hypos : hypos_per_trace)
+    {
+      std::move(hypos.begin(), hypos.end(), std::back_inserter(feat_hypos));
+      std::vector<FeatureHypothesis>().swap(hypos);
+    }
+
     // sort feature candidates by their score
     std::sort(feat_hypos.begin(), feat_hypos.end(), CmpHypothesesByScore());
 
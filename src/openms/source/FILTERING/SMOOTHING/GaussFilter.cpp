@@ -34,6 +34,8 @@
 
 #include <OpenMS/FILTERING/SMOOTHING/GaussFilter.h>
 
+#include <exception>
+
 namespace OpenMS
 {
 
@@ -54,6 +56,46 @@ namespace OpenMS
   {
   }
 
+  void GaussFilter::filterExperiment(PeakMap& map)
+  {
+    const SignedSize n_spectra = static_cast<SignedSize>(map.size());
+    const SignedSize n_total = n_spectra + static_cast<SignedSize>(map.getChromatograms().size());
+
+    Size progress = 0;
+    std::exception_ptr err;
+    startProgress(0, n_total, "smoothing data");
+#pragma omp parallel
+    {
+      // the kernel is recomputed per data point if ppm tolerances are used, so each thread needs its own
+      GaussFilterAlgorithm algo(gauss_algo_);
+
+#pragma omp for schedule(dynamic)
+      for (SignedSize i = 0; i < n_total; ++i)
+      {
+        try
+        {
+          if (i < n_spectra)
+          {
+            filterSpectrum_(map[i], algo);
+          }
+          else
+          {
+            filterChromatogram_(map.getChromatogram(i - n_spectra), algo);
+          }
+        }
+        catch (...)
+        {
+#pragma omp critical (GaussFilter_error)
+          if (!err) err = std::current_exception();
+        }
+#pragma omp critical (GaussFilter_progress)
+        setProgress(++progress);
+      }
+    }
+    endProgress();
+    if (err) std::rethrow_exception(err);
+  }
+
   void GaussFilter::updateMembers_()
   {
     gauss_algo_.initialize((double)param_.getValue("gaussian_width"), spacing_,
@@ -37,12 +37,16 @@
 
 #include <OpenMS/MATH/STATISTICS/QuadraticRegression.h>
 
+#include <exception>
+
 namespace OpenMS
 {
   LowessSmoothing::LowessSmoothing() :
     DefaultParamHandler("LowessSmoothing")
   {
     defaults_.setValue("window_size", 10, "The number of peaks to be included for local fitting in one window.");
+    defaults_.setValue("delta", 0.0, "Points closer than this distance (in x) to the last fitted point are not fitted, but linearly interpolated between the neighboring fitted points. Larger values speed up the smoothing of dense data, 0 fits every point.", ListUtils::create<String>("advanced"));
+    defaults_.setMinFloat("delta", 0.0);
     defaultsToParam_();
   }
 
@@ -61,7 +65,7 @@ namespace OpenMS
     // unable to smooth over 2 or less data points (we need at least 3)
     if (input_x.size() <= 2)
     {
-      smoothed_output = input_y;
+      smoothed_output.insert(smoothed_output.end(), input_y.begin(), input_y.end());
       return;
     }
 
@@ -70,40 +74,114 @@ namespace OpenMS
     // const Size q = floor( input_size * alpha );
     const Size q = (window_size_ < input_size) ? static_cast<Size>(window_size_) : input_size - 1;
 
-    DoubleVector distances(input_size, 0.0);
-    DoubleVector sortedDistances(input_size, 0.0);
-
-    for (Size outer_idx = 0; outer_idx < input_size; ++outer_idx)
+    // the nearest neighbors of a point form a contiguous window in x, so work on x-sorted data
+    std::vector<Size> order;
+    DoubleVector sorted_x, sorted_y;
+    const bool is_sorted = std::is_sorted(input_x.begin(), input_x.end());
+    if (!is_sorted)
     {
-      // Compute distances.
-      // Size inner_idx = 0;
-      for (Size inner_idx = 0; inner_idx < input_size; ++inner_idx)
+      order.resize(input_size);
+      for (Size i = 0; i < input_size; ++i) order[i] = i;
+      std::stable_sort(order.begin(), order.end(), [&input_x](Size a, Size b) { return input_x[a] < input_x[b]; });
+      sorted_x.resize(input_size);
+      sorted_y.resize(input_size);
+      for (Size i = 0; i < input_size; ++i)
       {
-        distances[inner_idx] = std::fabs(input_x[outer_idx] - input_x[inner_idx]);
-        sortedDistances[inner_idx] = distances[inner_idx];
+        sorted_x[i] = input_x[order[i]];
+        sorted_y[i] = input_y[order[i]];
       }
+    }
+    const DoubleVector& x = is_sorted ? input_x : sorted_x;
+    const DoubleVector& y = is_sorted ? input_y : sorted_y;
+
+    // select the points at which the regression is computed, the others are interpolated linearly
+    std::vector<Size> fit_points;
+    fit_points.push_back(0);
+    for (Size i = 1; i < input_size - 1; ++i)
+    {
+      if (x[i] - x[fit_points.back()] >= delta_) fit_points.push_back(i);
+    }
+    fit_points.push_back(input_size - 1);
 
-      // Sort distances in order from smallest to largest.
-      std::sort(sortedDistances.begin(), sortedDistances.end());
+    DoubleVector fitted(input_size, 0.0);
+    std::exception_ptr err;
+
+#pragma omp parallel
+    {
+      std::vector<double> weights(q + 1, 0.0);
+      std::vector<double> centered_x(q + 1, 0.0);
 
-      // Compute weigths.
-      std::vector<double> weigths(input_size, 0);
-      for (Size inner_idx = 0; inner_idx < input_size; ++inner_idx)
+#pragma omp for schedule(dynamic, 64)
+      for (SignedSize f = 0; f < static_cast<SignedSize>(fit_points.size()); ++f)
       {
-        weigths.at(inner_idx) = tricube_(distances[inner_idx], sortedDistances[q]);
+        try
+        {
+          const Size i = fit_points[f];
+          const double current_x = x[i];
+
+          // window of the q + 1 points closest to the current one: start with the leftmost window
+          // containing the point and move right as long as the next point is closer than the first
+          Size left = (i > q) ? i - q : 0;
+          while (left + q + 1 < input_size && x[left + q + 1] - current_x < current_x - x[left])
+          {
+            ++left;
+          }
+          const Size right = left + q; // inclusive
+
+          // distance of the (q + 1)-th nearest point, all points outside the window have at least this distance
+          const double max_distance = std::max(current_x - x[left], x[right] - current_x);
+
+          // fit relative to the current point, which keeps the normal equations well-conditioned for large x
+          for (Size j = left; j <= right; ++j)
+          {
+            centered_x[j - left] = x[j] - current_x;
+            weights[j - left] = tricube_(std::fabs(centered_x[j - left]), max_distance);
+          }
+
+          //calculate regression, points outside the window would have zero weight
+          Math::QuadraticRegression qr;
+          std::vector<double>::const_iterator w_begin = weights.begin();
+          std::vector<double>::const_iterator x_begin = centered_x.begin();
+          qr.computeRegressionWeighted(x_begin, x_begin + (q + 1), y.begin() + left, w_begin);
+
+          //smooth y-values
+          fitted[i] = qr.eval(0.0);
+        }
+        catch (...)
+        {
+#pragma omp critical (LowessSmoothing_error)
+          if (!err) err = std::current_exception();
+        }
       }
+    }
+    if (err) std::rethrow_exception(err);
 
-      //calculate regression
-      Math::QuadraticRegression qr;
-      std::vector<double>::const_iterator w_begin = weigths.begin();
-      qr.computeRegressionWeighted(input_x.begin(), input_x.end(), input_y.begin(), w_begin);
-
-      //smooth y-values
-      double rt = input_x[outer_idx];
-      smoothed_output.push_back(qr.eval(rt));
+    // linear interpolation between the fitted points
+    for (Size f = 0; f + 1 < fit_points.size(); ++f)
+    {
+      const Size first = fit_points[f];
+      const Size last = fit_points[f + 1];
+      const double width = x[last] - x[first];
+      for (Size i = first + 1; i < last; ++i)
+      {
+        if (width > 0.0)
+        {
+          const double alpha = (x[i] - x[first]) / width;
+          fitted[i] = (1.0 - alpha) * fitted[first] + alpha * fitted[last];
+        }
+        else
+        {
+          fitted[i] = fitted[first];
+        }
+      }
     }
 
-    return;
+    const Size offset = smoothed_output.size();
+    smoothed_output.resize(offset + input_size);
+    for (Size i = 0; i < input_size; ++i)
+    {
+      smoothed_output[offset + (is_sorted ? i : order[i])] = fitted[i];
+    }
   }
 
   double LowessSmoothing::tricube_(double u, double t)
@@ -135,6 +213,7 @@ namespace OpenMS
   void LowessSmoothing::updateMembers_()
   {
     window_size_ = (Size)param_.getValue("window_size");
+    delta_ = param_.getValue("delta");
   }
 
 } //namespace OpenMS
@@ -55,6 +55,90 @@ namespace OpenMS
   {
   }
 
+  void SavitzkyGolayFilter::filterExperiment(PeakMap& map)
+  {
+    const SignedSize n_spectra = static_cast<SignedSize>(map.size());
+    const SignedSize n_total = n_spectra + static_cast<SignedSize>(map.getChromatograms().size());
+
+    Size progress = 0;
+    startProgress(0, n_total, "smoothing data");
+#pragma omp parallel for schedule(dynamic)
+    for (SignedSize i = 0; i < n_total; ++i)
+    {
+      if (i < n_spectra)
+      {
+        filter(map[i]);
+      }
+      else
+      {
+        filter(map.getChromatogram(i - n_spectra));
+      }
+#pragma omp critical (SavitzkyGolayFilter_progress)
+      setProgress(++progress);
+    }
+    endProgress();
+  }
+
+  void SavitzkyGolayFilter::filterIntensities_(const std::vector<double>& intensities, std::vector<double>& smoothed) const
+  {
+    const Size n = intensities.size();
+    const Size frame = frame_size_;
+    const Size mid = frame / 2;
+    smoothed.assign(n, 0.0);
+    if (frame > n) { return; }
+
+    const double* in = intensities.data();
+    double* out = smoothed.data();
+
+    // compute the transient on: the first mid + 1 points use the first frame points
+    for (Size i = 0; i <= mid; ++i)
+    {
+      const double* c = &coeffs_[(i + 1) * frame - 1];
+      double help = 0;
+      for (Size j = 0; j < frame; ++j)
+      {
+        help += in[j] * *(c - j);
+      }
+      out[i] = help;
+    }
+
+    // compute the steady state output in blocks that stay in cache, one pass over the block per coefficient
+    const double* c = &coeffs_[mid * frame];
+    const Size block_size = 1024;
+    for (Size block_begin = mid + 1; block_begin + mid < n; block_begin += block_size)
+    {
+      const Size block_length = std::min(block_size, n - mid - block_begin);
+      double* out_block = out + block_begin;
+      for (Size j = 0; j < frame; ++j)
+      {
+        const double cj = c[j];
+        const double* in_block = in + (block_begin - mid + j);
+        for (Size i = 0; i < block_length; ++i)
+        {
+          out_block[i] += cj * in_block[i];
+        }
+      }
+    }
+
+    // compute the transient off: the last mid points use the last frame points
+    for (Size i = 0; i < mid; ++i)
+    {
+      const double* c_off = &coeffs_[i * frame];
+      const double* in_off = in + n - frame;
+      double help = 0;
+      for (Size j = 0; j < frame; ++j)
+      {
+        help += in_off[j] * c_off[j];
+      }
+      out[n - 1 - i] = help;
+    }
+
+    for (Size i = 0; i < n; ++i)
+    {
+      out[i] = std::max(0.0, out[i]);
+    }
+  }
+
   void SavitzkyGolayFilter::updateMembers_()
   {
     frame_size_ = (UInt)param_.getValue("frame_length");
@@ -35,6 +35,9 @@
 
 #include <OpenMS/FILTERING/TRANSFORMERS/SpectraMerger.h>
 
+#include <algorithm>
+#include <numeric>
+
 using namespace std;
 namespace OpenMS
 {
@@ -112,4 +115,62 @@ namespace OpenMS
     return *this;
   }
 
+  void SpectraMerger::clusterPrecursors_(const std::vector<BaseFeature>& data, std::vector<std::vector<Size> >& clusters) const
+  {
+    clusters.clear();
+
+    SpectraDistance_ llc;
+    llc.setParameters(param_.copy("precursor_method:", true));
+    const double rt_max = param_.getValue("precursor_method:rt_tolerance");
+
+    // union-find over all elements
+    vector<Size> parent(data.size());
+    iota(parent.begin(), parent.end(), 0);
+    auto find_root = [&parent](Size i)
+    {
+      while (parent[i] != i)
+      {
+        parent[i] = parent[parent[i]]; // path halving
+        i = parent[i];
+      }
+      return i;
+    };
+
+    // sweep over elements sorted by RT: only pairs within the RT tolerance can have non-zero similarity
+    vector<Size> by_rt(data.size());
+    iota(by_rt.begin(), by_rt.end(), 0);
+    sort(by_rt.begin(), by_rt.end(), [&data](Size a, Size b) { return data[a].getRT() < data[b].getRT(); });
+
+    for (Size i = 0; i < by_rt.size(); ++i)
+    {
+      const BaseFeature& f_i = data[by_rt[i]];
+      for (Size j = i + 1; j < by_rt.size() && data[by_rt[j]].getRT() - f_i.getRT() <= rt_max; ++j)
+      {
+        // same criterion as the dense path: distances are stored as float and cut at 1.0
+        const float distance = 1 - llc(f_i, data[by_rt[j]]);
+        if (!(distance < 1.0f)) { continue; }
+
+        const Size root_i = find_root(by_rt[i]);
+        const Size root_j = find_root(by_rt[j]);
+        if (root_i != root_j)
+        {
+          parent[max(root_i, root_j)] = min(root_i, root_j);
+        }
+      }
+    }
+
+    // collect components (ascending element order; each root is its smallest element)
+    Map<Size, Size> root_to_cluster;
+    for (Size i = 0; i < data.size(); ++i)
+    {
+      const Size root = find_root(i);
+      if (root == i)
+      {
+        root_to_cluster[i] = clusters.size();
+        clusters.push_back(vector<Size>());
+      }
+      clusters[root_to_cluster[root]].push_back(i);
+    }
+  }
+
 }
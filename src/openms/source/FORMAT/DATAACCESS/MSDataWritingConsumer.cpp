@@ -33,11 +33,19 @@
 // --------------------------------------------------------------------------
 
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
+
+#include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/FORMAT/VALIDATORS/MzMLValidator.h>
 
 namespace OpenMS
 {
 
+  namespace
+  {
+    /// Number of spectra whose binary data arrays are encoded together
+    const Size SPECTRA_BATCH_SIZE = 64;
+  }
+
   MSDataWritingConsumer::MSDataWritingConsumer(String filename) :
     Internal::MzMLHandler(MapType(), filename, MzMLFile().getVersion(), ProgressLogger()),
     started_writing_(false),
@@ -111,11 +119,39 @@ namespace OpenMS
       ofs_ << "\t\t<spectrumList count=\"" << spectra_expected_ << "\" defaultDataProcessingRef=\"dp_sp_0\">\n";
       writing_spectra_ = true;
     }
+    // buffer the spectrum, its data arrays are encoded together with the
+    // following ones
+    spectra_buffer_.push_back(std::move(scpy));
+    ++spectra_written_;
+    if (spectra_buffer_.size() >= SPECTRA_BATCH_SIZE)
+    {
+      flushSpectra_();
+    }
+  }
+
+   void MSDataWritingConsumer::flushSpectra_()
+  {
+    if (spectra_buffer_.empty()) return;
+
+    std::vector<const SpectrumType*> batch;
+    batch.reserve(spectra_buffer_.size());
+    for (Size k = 0; k < spectra_buffer_.size(); ++k)
+    {
+      batch.push_back(&spectra_buffer_[k]);
+    }
+    std::vector<String> rendered;
+    Internal::MzMLHandler::renderSpectrumDataArrays_(batch, rendered);
+
     bool renew_native_ids = false;
+    Size first_idx = spectra_written_ - spectra_buffer_.size();
     // TODO writeSpectrum assumes that dps_ has at least one value -> assert
     // this here ...
-    Internal::MzMLHandler::writeSpectrum_(ofs_, scpy,
-            spectra_written_++, *validator_, renew_native_ids, dps_);
+    for (Size k = 0; k < spectra_buffer_.size(); ++k)
+    {
+      Internal::MzMLHandler::writeSpectrum_(ofs_, spectra_buffer_[k],
+              first_idx + k, *validator_, renew_native_ids, dps_, &rendered[k]);
+    }
+    spectra_buffer_.clear();
   }
 
    void MSDataWritingConsumer::consumeChromatogram(ChromatogramType & c)
@@ -123,6 +159,7 @@ namespace OpenMS
     // make sure to close an open List tag
     if (writing_spectra_)
     {
+      flushSpectra_();
       ofs_ << "\t\t</spectrumList>\n";
       writing_spectra_ = false;
     }
@@ -178,6 +215,19 @@ namespace OpenMS
     // make sure to close an open List tag
     if (writing_spectra_)
     {
+      try
+      {
+        flushSpectra_();
+      }
+      catch (Exception::BaseException& e)
+      {
+        // called from the destructor, so we must not throw
+        OPENMS_LOG_ERROR << "Error while writing spectra to '" << file_ << "': " << e.what() << std::endl;
+      }
+      catch (std::exception& e)
+      {
+        OPENMS_LOG_ERROR << "Error while writing spectra to '" << file_ << "': " << e.what() << std::endl;
+      }
       ofs_ << "\t\t</spectrumList>\n";
     }
     else if (writing_chromatograms_)
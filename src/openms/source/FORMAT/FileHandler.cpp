@@ -47,6 +47,7 @@
 #include <OpenMS/FORMAT/MsInspectFile.h>
 #include <OpenMS/FORMAT/SpecArrayFile.h>
 #include <OpenMS/FORMAT/KroenikFile.h>
+#include <OpenMS/FORMAT/OMSBinFile.h>
 
 #include <OpenMS/KERNEL/ChromatogramTools.h>
 
@@ -259,6 +260,10 @@ namespace OpenMS
     //std::cerr << "\n Line1:\n" << first_line << "\nLine2-5:\n" << two_five << "\nall:\n" << all_simple << "\n\n";
 
 
+    //binary container (magic number in the first line)
+    if (first_line.hasPrefix("OMSBIN"))
+      return FileTypes::OMSBIN;
+
     //mzXML (all lines)
     if (all_simple.hasSubstring("<mzXML"))
       return FileTypes::MZXML;
@@ -553,6 +558,10 @@ if (first_line.hasSubstring("File	First Scan	Last Scan	Num of Scans	Charge	Monoi
     {
       KroenikFile().load(filename, map);
     }
+    else if (type == FileTypes::OMSBIN)
+    {
+      OMSBinFile().load(filename, map);
+    }
     else
     {
       return false;
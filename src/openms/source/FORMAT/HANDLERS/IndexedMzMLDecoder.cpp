@@ -37,8 +37,13 @@
 #include <boost/regex.hpp>
 #include <boost/lexical_cast.hpp>
 
+#include <cstring>
 #include <fstream>
 #include <iostream>
+#include <unordered_set>
+
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
 
 #include <xercesc/framework/MemBufInputSource.hpp>
 #include <xercesc/parsers/XercesDOMParser.hpp>
@@ -87,6 +92,274 @@ namespace OpenMS
 
       return res;
     }
+
+    /// A <spectrum> or <chromatogram> start tag found while scanning
+    struct ScannedTag
+    {
+      std::streampos offset;
+      std::string id;
+      long long index; ///< value of the index attribute (-1 if absent)
+      bool is_spectrum;
+    };
+
+    /// replace the predefined XML entities in an attribute value
+    std::string unescapeXML(const std::string& s)
+    {
+      if (s.find('&') == std::string::npos) return s;
+      String r(s);
+      r.substitute("&lt;", "<").substitute("&gt;", ">").substitute("&quot;", "\"").substitute("&apos;", "'").substitute("&amp;", "&");
+      return r;
+    }
+
+    /// value of attribute @p name in the start tag @p tag (empty if absent)
+    std::string getAttribute(const std::string& tag, const std::string& name)
+    {
+      Size pos = 0;
+      while ((pos = tag.find(name, pos + 1)) != std::string::npos)
+      {
+        // must be a full attribute name, i.e. not 'spotID' when looking for 'id'
+        if (!isspace(static_cast<unsigned char>(tag[pos - 1]))) continue;
+        Size eq = pos + name.size();
+        while (eq < tag.size() && isspace(static_cast<unsigned char>(tag[eq]))) ++eq;
+        if (eq >= tag.size() || tag[eq] != '=') continue;
+        Size quote = eq + 1;
+        while (quote < tag.size() && isspace(static_cast<unsigned char>(tag[quote]))) ++quote;
+        if (quote >= tag.size() || (tag[quote] != '"' && tag[quote] != '\'')) continue;
+        Size end = tag.find(tag[quote], quote + 1);
+        if (end == std::string::npos) return "";
+        return unescapeXML(tag.substr(quote + 1, end - quote - 1));
+      }
+      return "";
+    }
+
+    inline bool isTagNameEnd(char c)
+    {
+      return c == ' ' || c == '\t' || c == '\n' || c == '\r' || c == '>';
+    }
+
+    /**
+      @brief Finds all <spectrum> and <chromatogram> start tags beginning in buffer[0, scan_end)
+
+      The buffer may extend beyond @p scan_end to complete tags starting close to the end.
+      Returns false if a start tag is not closed within the buffer.
+    */
+    bool scanChunk(const char* buffer, Size buffer_size, Size scan_end, std::streamoff base, std::vector<ScannedTag>& tags)
+    {
+      static const char spectrum_tag[] = "<spectrum";
+      static const char chromatogram_tag[] = "<chromatogram";
+      const Size spectrum_len = sizeof(spectrum_tag) - 1;
+      const Size chromatogram_len = sizeof(chromatogram_tag) - 1;
+
+      const char* p = buffer;
+      const char* end = buffer + scan_end;
+      const char* buffer_end = buffer + buffer_size;
+      while (p < end && (p = static_cast<const char*>(memchr(p, '<', end - p))) != nullptr)
+      {
+        const Size remaining = buffer_end - p;
+        bool is_spectrum = remaining > spectrum_len && memcmp(p, spectrum_tag, spectrum_len) == 0 && isTagNameEnd(p[spectrum_len]);
+        bool is_chromatogram = !is_spectrum && remaining > chromatogram_len && memcmp(p, chromatogram_tag, chromatogram_len) == 0 && isTagNameEnd(p[chromatogram_len]);
+        if (!is_spectrum && !is_chromatogram)
+        {
+          ++p;
+          continue;
+        }
+
+        const char* tag_end = static_cast<const char*>(memchr(p, '>', remaining));
+        if (tag_end == nullptr) return false;
+        const std::string tag(p, tag_end);
+        ScannedTag t;
+        t.offset = base + std::streamoff(p - buffer);
+        t.id = getAttribute(tag, "id");
+        const std::string index = getAttribute(tag, "index");
+        t.index = index.empty() ? -1 : atoll(index.c_str());
+        t.is_spectrum = is_spectrum;
+        tags.push_back(t);
+        p = tag_end;
+      }
+      return true;
+    }
+
+    /// offsets must have unique, non-empty ids and (if given) an index attribute matching their position
+    bool validateScannedTags(const std::vector<ScannedTag>& tags, bool spectra, const String& filename)
+    {
+      std::unordered_set<std::string> ids;
+      long long position = 0;
+      for (const ScannedTag& t : tags)
+      {
+        if (t.is_spectrum != spectra) continue;
+        const char* kind = spectra ? "spectrum" : "chromatogram";
+        if (t.id.empty() || !ids.insert(t.id).second)
+        {
+          std::cerr << "IndexedMzMLDecoder::scanOffsets Error: " << kind << " at offset " << t.offset << " in file '" << filename
+                    << "' has a missing or duplicate id ('" << t.id << "')." << std::endl;
+          return false;
+        }
+        if (t.index != -1 && t.index != position)
+        {
+          std::cerr << "IndexedMzMLDecoder::scanOffsets Error: " << kind << " '" << t.id << "' at offset " << t.offset << " in file '" << filename
+                    << "' has index " << t.index << " but is the " << position << ". " << kind << " in the file." << std::endl;
+          return false;
+        }
+        ++position;
+      }
+      return true;
+    }
+
+    /// size and modification time (ms since epoch) of a file
+    void getFileStamp(const String& filename, long long& size, long long& modified)
+    {
+      QFileInfo fi(filename.toQString());
+      size = fi.size();
+      modified = fi.lastModified().toMSecsSinceEpoch();
+    }
+  }
+
+  int IndexedMzMLDecoder::scanOffsets(String filename, OffsetVector& spectra_offsets, OffsetVector& chromatograms_offsets, Size chunk_size)
+  {
+    std::ifstream f(filename.c_str(), std::ios::binary);
+    if (!f.is_open())
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    f.seekg(0, f.end);
+    const std::streamoff length = f.tellg();
+    f.close();
+
+    // start tags are short; a chunk is extended by this many bytes to complete tags starting close to its end
+    const Size overlap = 64 * 1024;
+    chunk_size = std::max(chunk_size, Size(1));
+    const SignedSize n_chunks = SignedSize((length + chunk_size - 1) / chunk_size);
+    std::vector<std::vector<IndexedMzMLUtils::ScannedTag> > chunk_tags(n_chunks);
+    bool success = true;
+
+#pragma omp parallel
+    {
+      std::ifstream in(filename.c_str(), std::ios::binary);
+      std::vector<char> buffer;
+#pragma omp for schedule(dynamic)
+      for (SignedSize i = 0; i < n_chunks; ++i)
+      {
+        const std::streamoff start = std::streamoff(i) * chunk_size;
+        const Size scan_end = Size(std::min(std::streamoff(chunk_size), length - start));
+        const Size read_size = Size(std::min(std::streamoff(chunk_size + overlap), length - start));
+        buffer.resize(read_size);
+        in.clear();
+        in.seekg(start);
+        in.read(buffer.data(), read_size);
+        if (!in || !IndexedMzMLUtils::scanChunk(buffer.data(), read_size, scan_end, start, chunk_tags[i]))
+        {
+#pragma omp critical (IndexedMzMLDecoder_scan)
+          success = false;
+        }
+      }
+    }
+
+    if (!success)
+    {
+      std::cerr << "IndexedMzMLDecoder::scanOffsets Error: could not read or scan file '" << filename << "'." << std::endl;
+      return -1;
+    }
+
+    // chunks are ordered, so are the tags
+    std::vector<IndexedMzMLUtils::ScannedTag> tags;
+    for (const auto& t : chunk_tags) tags.insert(tags.end(), t.begin(), t.end());
+    if (!IndexedMzMLUtils::validateScannedTags(tags, true, filename) || !IndexedMzMLUtils::validateScannedTags(tags, false, filename))
+    {
+      return -1;
+    }
+
+    spectra_offsets.clear();
+    chromatograms_offsets.clear();
+    for (const auto& t : tags)
+    {
+      (t.is_spectrum ? spectra_offsets : chromatograms_offsets).push_back(std::make_pair(t.id, t.offset));
+    }
+    return 0;
+  }
+
+  bool IndexedMzMLDecoder::validateOffsets(String filename, const OffsetVector& spectra_offsets, const OffsetVector& chromatograms_offsets)
+  {
+    std::ifstream f(filename.c_str(), std::ios::binary);
+    if (!f.is_open())
+    {
+      throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    auto check = [&f](const OffsetVector& offsets, const std::string& tag)
+    {
+      if (offsets.empty()) return true;
+      for (Size i : {Size(0), offsets.size() / 2, offsets.size() - 1})
+      {
+        std::string buffer(tag.size() + 1, '\0');
+        f.clear();
+        f.seekg(offsets[i].second);
+        f.read(&buffer[0], buffer.size());
+        if (!f || buffer.compare(0, tag.size(), tag) != 0 || !IndexedMzMLUtils::isTagNameEnd(buffer.back()))
+        {
+          return false;
+        }
+      }
+      return true;
+    };
+    return check(spectra_offsets, "<spectrum") && check(chromatograms_offsets, "<chromatogram");
+  }
+
+  String IndexedMzMLDecoder::getSidecarFilename(const String& filename)
+  {
+    return filename + ".offsets";
+  }
+
+  bool IndexedMzMLDecoder::storeSidecarIndex(String filename, const OffsetVector& spectra_offsets, const OffsetVector& chromatograms_offsets)
+  {
+    long long size, modified;
+    IndexedMzMLUtils::getFileStamp(filename, size, modified);
+
+    // write to a temporary file first, so concurrent readers never see a partial index
+    const String sidecar = getSidecarFilename(filename);
+    const String tmp = sidecar + ".tmp";
+    {
+      std::ofstream os(tmp.c_str());
+      if (!os) return false;
+      os << "# OpenMS mzML offset index 1\n"
+         << "file_size\t" << size << "\n"
+         << "last_modified\t" << modified << "\n";
+      for (const auto& o : spectra_offsets) os << "S\t" << o.second << "\t" << o.first << "\n";
+      for (const auto& o : chromatograms_offsets) os << "C\t" << o.second << "\t" << o.first << "\n";
+      if (!os) return false;
+    }
+    std::remove(sidecar.c_str());
+    return std::rename(tmp.c_str(), sidecar.c_str()) == 0;
+  }
+
+  int IndexedMzMLDecoder::loadSidecarIndex(String filename, OffsetVector& spectra_offsets, OffsetVector& chromatograms_offsets)
+  {
+    std::ifstream is(getSidecarFilename(filename).c_str());
+    if (!is) return -1;
+
+    long long size, modified;
+    IndexedMzMLUtils::getFileStamp(filename, size, modified);
+
+    std::string line;
+    if (!std::getline(is, line) || line != "# OpenMS mzML offset index 1") return -1;
+    long long stored_size = -1, stored_modified = -1;
+    std::string key;
+    if (!(is >> key >> stored_size) || key != "file_size" || stored_size != size) return -1;
+    if (!(is >> key >> stored_modified) || key != "last_modified" || stored_modified != modified) return -1;
+    std::getline(is, line); // rest of the line
+
+    OffsetVector spectra, chromatograms;
+    while (std::getline(is, line))
+    {
+      // <S|C> \t <offset> \t <id> (the id may contain blanks)
+      const Size tab1 = line.find('\t');
+      const Size tab2 = tab1 == std::string::npos ? std::string::npos : line.find('\t', tab1 + 1);
+      if (tab1 != 1 || tab2 == std::string::npos || (line[0] != 'S' && line[0] != 'C')) return -1;
+      std::streampos offset = IndexedMzMLUtils::stringToStreampos(line.substr(tab1 + 1, tab2 - tab1 - 1));
+      (line[0] == 'S' ? spectra : chromatograms).push_back(std::make_pair(line.substr(tab2 + 1), offset));
+    }
+    spectra_offsets.swap(spectra);
+    chromatograms_offsets.swap(chromatograms);
+    return 0;
   }
 
   int IndexedMzMLDecoder::parseOffsets(String filename, std::streampos indexoffset, OffsetVector& spectra_offsets, OffsetVector& chromatograms_offsets)
@@ -47,21 +47,67 @@ namespace Internal
 
   void IndexedMzMLHandler::parseFooter_(String filename)
   {
+    spectra_offsets_.clear();
+    chromatograms_offsets_.clear();
+    spectra_native_ids_.clear();
+    chromatograms_native_ids_.clear();
+
     //-------------------------------------------------------------
     // Find offset
     //-------------------------------------------------------------
 
-    index_offset_ = IndexedMzMLDecoder().findIndexListOffset(filename);
-    if (index_offset_ == (std::streampos)-1)
+    IndexedMzMLDecoder decoder;
+    // typedef std::vector< std::pair<std::string, std::streampos> > OffsetVector;
+    IndexedMzMLDecoder::OffsetVector spectra_offsets, chromatograms_offsets;
+    int res = -1;
+
+    index_offset_ = decoder.findIndexListOffset(filename);
+    if (index_offset_ != (std::streampos)-1)
     {
-      parsing_success_ = false;
-      return;
+      res = decoder.parseOffsets(filename, index_offset_, spectra_offsets, chromatograms_offsets);
+      if (res == 0 && !decoder.validateOffsets(filename, spectra_offsets, chromatograms_offsets))
+      {
+        res = -1;
+      }
     }
 
+    //-------------------------------------------------------------
+    // Fall back to a sidecar index or reconstruct the offsets
+    //-------------------------------------------------------------
+
+    if (res != 0)
+    {
+      spectra_offsets.clear();
+      chromatograms_offsets.clear();
+      if (!reconstruct_index_)
+      {
+        parsing_success_ = false;
+        return;
+      }
+
+      res = decoder.loadSidecarIndex(filename, spectra_offsets, chromatograms_offsets);
+      if (res != 0 || !decoder.validateOffsets(filename, spectra_offsets, chromatograms_offsets))
+      {
+        spectra_offsets.clear();
+        chromatograms_offsets.clear();
+        res = decoder.scanOffsets(filename, spectra_offsets, chromatograms_offsets);
+        if (spectra_offsets.empty() && chromatograms_offsets.empty())
+        {
+          // not an mzML file (or a truncated one)
+          res = -1;
+        }
+        if (res == 0 && write_sidecar_index_)
+        {
+          decoder.storeSidecarIndex(filename, spectra_offsets, chromatograms_offsets);
+        }
+      }
+
+      // without an <indexList>, the last item extends to the end of the file
+      std::ifstream f(filename.c_str(), std::ios_base::in | std::ios_base::binary);
+      f.seekg(0, f.end);
+      index_offset_ = f.tellg();
+    }
 
-    // typedef std::vector< std::pair<std::string, std::streampos> > OffsetVector;
-    IndexedMzMLDecoder::OffsetVector spectra_offsets, chromatograms_offsets;
-    int res = IndexedMzMLDecoder().parseOffsets(filename, index_offset_, spectra_offsets, chromatograms_offsets);
     for (const auto& off : spectra_offsets)
     {
       spectra_native_ids_.emplace(off.first, spectra_offsets_.size());
@@ -86,14 +132,18 @@ namespace Internal
 
   IndexedMzMLHandler::IndexedMzMLHandler(const String& filename) :
     parsing_success_(false),
-    skip_xml_checks_(false) 
+    skip_xml_checks_(false),
+    reconstruct_index_(true),
+    write_sidecar_index_(false)
   {
     openFile(filename);
   }
 
   IndexedMzMLHandler::IndexedMzMLHandler() :
     parsing_success_(false),
-    skip_xml_checks_(false) 
+    skip_xml_checks_(false),
+    reconstruct_index_(true),
+    write_sidecar_index_(false)
   {}
 
   IndexedMzMLHandler::IndexedMzMLHandler(const IndexedMzMLHandler& source) :
@@ -106,7 +156,9 @@ namespace Internal
     // this is critical for parallel access to the same file!
     filestream_(source.filename_.c_str()),
     parsing_success_(source.parsing_success_),
-    skip_xml_checks_(source.skip_xml_checks_)
+    skip_xml_checks_(source.skip_xml_checks_),
+    reconstruct_index_(source.reconstruct_index_),
+    write_sidecar_index_(source.write_sidecar_index_)
   {
   }
 
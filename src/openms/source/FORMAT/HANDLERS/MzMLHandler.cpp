@@ -43,6 +43,9 @@
 #include <OpenMS/FORMAT/VALIDATORS/MzMLValidator.h>
 #include <OpenMS/INTERFACES/IMSDataConsumer.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/Profiler.h>
+
+#include <sstream>
 
 namespace OpenMS
 {
@@ -192,18 +195,7 @@ namespace OpenMS
       // Append all spectra to experiment / consumer
       for (Size i = 0; i < spectrum_data_.size(); i++)
       {
-        if (consumer_ != nullptr)
-        {
-          consumer_->consumeSpectrum(spectrum_data_[i].spectrum);
-          if (options_.getAlwaysAppendData())
-          {
-            exp_->addSpectrum(std::move(spectrum_data_[i].spectrum));
-          }
-        }
-        else
-        {
-          exp_->addSpectrum(std::move(spectrum_data_[i].spectrum));
-        }
+        appendSpectrum_(spectrum_data_[i].spectrum);
       }
 
       // Delete batch
@@ -261,22 +253,149 @@ namespace OpenMS
       // Append all chromatograms to experiment / consumer
       for (Size i = 0; i < chromatogram_data_.size(); i++)
       {
-        if (consumer_ != nullptr)
+        appendChromatogram_(chromatogram_data_[i].chromatogram);
+      }
+
+      // Delete batch
+      chromatogram_data_.clear();
+    }
+
+    void MzMLHandler::appendSpectrum_(SpectrumType& spectrum)
+    {
+      if (consumer_ != nullptr)
+      {
+        consumer_->consumeSpectrum(spectrum);
+        if (options_.getAlwaysAppendData())
+        {
+          exp_->addSpectrum(std::move(spectrum));
+        }
+      }
+      else
+      {
+        exp_->addSpectrum(std::move(spectrum));
+      }
+    }
+
+    void MzMLHandler::appendChromatogram_(ChromatogramType& chromatogram)
+    {
+      if (consumer_ != nullptr)
+      {
+        consumer_->consumeChromatogram(chromatogram);
+        if (options_.getAlwaysAppendData())
+        {
+          exp_->addChromatogram(std::move(chromatogram));
+        }
+      }
+      else
+      {
+        exp_->addChromatogram(std::move(chromatogram));
+      }
+    }
+
+    void MzMLHandler::setPipelined(bool pipelined)
+    {
+      pipelined_ = pipelined;
+    }
+
+    void MzMLHandler::schedulePipelineItem_(PipelineItem& item)
+    {
+      // estimate memory of the raw and the decoded data
+      const std::vector<BinaryData>& data = item.is_spectrum ? item.spectrum_data.data : item.chromatogram_data.data;
+      const Size length = item.is_spectrum ? item.spectrum_data.default_array_length : item.chromatogram_data.default_array_length;
+      for (const BinaryData& d : data)
+      {
+        item.memory += d.base64.size() + 2 * sizeof(double) * length;
+      }
+      pipeline_memory_ += item.memory;
+
+      if (options_.getFillData())
+      {
+        PipelineItem* pitem = &item;
+#ifdef _OPENMP
+#pragma omp task firstprivate(pitem)
+#endif
+        decodePipelineItem_(*pitem);
+      }
+      else
+      {
+        item.done.store(true, std::memory_order_release);
+      }
+    }
+
+    void MzMLHandler::decodePipelineItem_(PipelineItem& item)
+    {
+      // exceptions must not escape the task, they are re-thrown upon delivery
+      try
+      {
+        if (item.is_spectrum)
         {
-          consumer_->consumeChromatogram(chromatogram_data_[i].chromatogram);
-          if (options_.getAlwaysAppendData())
+          SpectrumData& sd = item.spectrum_data;
+          populateSpectraWithData_(sd.data, sd.default_array_length, options_, sd.spectrum);
+          if (options_.getSortSpectraByMZ() && !sd.spectrum.isSorted())
           {
-            exp_->addChromatogram(std::move(chromatogram_data_[i].chromatogram));
+            sd.spectrum.sortByPosition();
           }
+          std::vector<BinaryData>().swap(sd.data);
         }
         else
         {
-          exp_->addChromatogram(std::move(chromatogram_data_[i].chromatogram));
+          ChromatogramData& cd = item.chromatogram_data;
+          populateChromatogramsWithData_(cd.data, cd.default_array_length, options_, cd.chromatogram);
+          if (options_.getSortChromatogramsByRT() && !cd.chromatogram.isSorted())
+          {
+            cd.chromatogram.sortByPosition();
+          }
+          std::vector<BinaryData>().swap(cd.data);
         }
       }
+      catch (OpenMS::Exception::BaseException& e)
+      {
+        item.error = true;
+        item.error_message = e.what();
+      }
+      catch (...)
+      {
+        item.error = true;
+      }
+      item.done.store(true, std::memory_order_release);
+    }
 
-      // Delete batch
-      chromatogram_data_.clear();
+    bool MzMLHandler::pipelineFull() const
+    {
+      return pipeline_.size() >= options_.getPipelineQueueDepth() ||
+             pipeline_memory_ > options_.getPipelineMemoryCap();
+    }
+
+    void MzMLHandler::flushPipeline()
+    {
+      // usually called after the parallel region, when all tasks are finished already
+#ifdef _OPENMP
+#pragma omp taskwait
+#endif
+
+      while (!pipeline_.empty())
+      {
+        PipelineItem& item = pipeline_.front();
+        OPENMS_PRECONDITION(item.done.load(std::memory_order_acquire), "Decoding task of pipeline item not finished")
+
+        if (item.error)
+        {
+          std::cerr << "  Parsing error: '" << item.error_message  << "'" << std::endl;
+          std::cerr << "  You could try to disable sorting spectra while loading." << std::endl;
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, file_, "Error during parsing of binary data: '" + item.error_message + "'");
+        }
+
+        if (item.is_spectrum)
+        {
+          appendSpectrum_(item.spectrum_data.spectrum);
+        }
+        else
+        {
+          appendChromatogram_(item.chromatogram_data.chromatogram);
+        }
+        pipeline_memory_ -= item.memory;
+        pipeline_.pop_front();
+      }
     }
 
     void MzMLHandler::addSpectrumMetaData_(const std::vector<MzMLHandlerHelper::BinaryData>& input_data,
@@ -328,6 +447,8 @@ namespace OpenMS
                                                const PeakFileOptions& peak_file_options,
                                                SpectrumType& spectrum)
     {
+      OPENMS_PROFILE_ACCUMULATE("MzMLHandler::decodeSpectrum", "decode");
+      OPENMS_PROFILE_COUNT("MzMLHandler::decodedSpectra", 1);
       typedef SpectrumType::PeakType PeakType;
 
       // decode all base64 arrays
@@ -497,6 +618,8 @@ namespace OpenMS
                                                      const PeakFileOptions& peak_file_options,
                                                      ChromatogramType& inp_chromatogram)
     {
+      OPENMS_PROFILE_ACCUMULATE("MzMLHandler::decodeChromatogram", "decode");
+      OPENMS_PROFILE_COUNT("MzMLHandler::decodedChromatograms", 1);
       typedef ChromatogramType::PeakType ChromatogramPeakType;
 
       //decode all base64 arrays
@@ -1237,12 +1360,22 @@ namespace OpenMS
           {
             tmp.data = std::move(bin_data_);
           }
-          // append current spectral data to buffer
-          spectrum_data_.push_back(std::move(tmp));
-
-          if (spectrum_data_.size() >= options_.getMaxDataPoolSize())
+          if (pipelined_)
           {
-            populateSpectraWithData_();
+            pipeline_.emplace_back();
+            pipeline_.back().is_spectrum = true;
+            pipeline_.back().spectrum_data = std::move(tmp);
+            schedulePipelineItem_(pipeline_.back());
+          }
+          else
+          {
+            // append current spectral data to buffer
+            spectrum_data_.push_back(std::move(tmp));
+
+            if (spectrum_data_.size() >= options_.getMaxDataPoolSize())
+            {
+              populateSpectraWithData_();
+            }
           }
         }
 
@@ -1275,12 +1408,22 @@ namespace OpenMS
           {
             tmp.data = std::move(bin_data_);
           }
-          // append current spectral data to buffer
-          chromatogram_data_.push_back(std::move(tmp));
-
-          if (chromatogram_data_.size() >= options_.getMaxDataPoolSize())
+          if (pipelined_)
+          {
+            pipeline_.emplace_back();
+            pipeline_.back().is_spectrum = false;
+            pipeline_.back().chromatogram_data = std::move(tmp);
+            schedulePipelineItem_(pipeline_.back());
+          }
+          else
           {
-            populateChromatogramsWithData_();
+            // append current spectral data to buffer
+            chromatogram_data_.push_back(std::move(tmp));
+
+            if (chromatogram_data_.size() >= options_.getMaxDataPoolSize())
+            {
+              populateChromatogramsWithData_();
+            }
           }
         }
 
@@ -1321,7 +1464,7 @@ namespace OpenMS
         instruments_.clear();
         processing_.clear();
 
-        // Flush the remaining data
+        // Flush the remaining data (pipelined data is delivered by the caller, see flushPipeline())
         populateSpectraWithData_();
         populateChromatogramsWithData_();
       }
@@ -3970,12 +4113,27 @@ namespace OpenMS
           warning(STORE, String("Invalid native IDs detected. Using spectrum identifier nativeID format (spectrum=xsd:nonNegativeInteger) for all spectra."));
         }
 
-        // write actual data
-        for (Size s_idx = 0; s_idx < exp.size(); ++s_idx)
+        // write actual data: the binary arrays of a block of spectra are
+        // encoded in parallel, the spectra themselves are then written in order
+        const Size block_size = 256;
+        std::vector<const SpectrumType*> block;
+        std::vector<String> rendered;
+        for (Size block_start = 0; block_start < exp.size(); block_start += block_size)
         {
-          logger_.setProgress(progress++);
-          const SpectrumType& spec = exp[s_idx];
-          writeSpectrum_(os, spec, s_idx, validator, renew_native_ids, dps);
+          const Size block_end = std::min(exp.size(), block_start + block_size);
+          block.clear();
+          for (Size s_idx = block_start; s_idx < block_end; ++s_idx)
+          {
+            block.push_back(&exp[s_idx]);
+          }
+          renderSpectrumDataArrays_(block, rendered);
+
+          for (Size s_idx = block_start; s_idx < block_end; ++s_idx)
+          {
+            logger_.setProgress(progress++);
+            const SpectrumType& spec = exp[s_idx];
+            writeSpectrum_(os, spec, s_idx, validator, renew_native_ids, dps, &rendered[s_idx - block_start]);
+          }
         }
         os << "\t\t</spectrumList>\n";
       }
@@ -4941,7 +5099,8 @@ namespace OpenMS
                                      Size s,
                                      const Internal::MzMLValidator& validator,
                                      bool renew_native_ids,
-                                     std::vector<std::vector< ConstDataProcessingPtr > >& dps)
+                                     std::vector<std::vector< ConstDataProcessingPtr > >& dps,
+                                     const String* rendered_arrays)
     {
       //native id
       String native_id = spec.getNativeID();
@@ -5203,8 +5362,15 @@ namespace OpenMS
         String encoded_string;
         os << "\t\t\t\t<binaryDataArrayList count=\"" << (2 + spec.getFloatDataArrays().size() + spec.getStringDataArrays().size() + spec.getIntegerDataArrays().size()) << "\">\n";
 
-        writeContainerData_<SpectrumType>(os, options_, spec, "mz");
-        writeContainerData_<SpectrumType>(os, options_, spec, "intensity");
+        if (rendered_arrays != nullptr && !rendered_arrays->empty())
+        {
+          os << *rendered_arrays;
+        }
+        else
+        {
+          writeContainerData_<SpectrumType>(os, options_, spec, "mz");
+          writeContainerData_<SpectrumType>(os, options_, spec, "intensity");
+        }
 
         String compression_term = MzMLHandlerHelper::getCompressionTerm_(options_, options_.getNumpressConfigurationIntensity(), "\t\t\t\t\t\t", false);
         // write float data array
@@ -5273,6 +5439,34 @@ namespace OpenMS
       os << "\t\t\t</spectrum>\n";
     }
 
+    void MzMLHandler::renderSpectrumDataArrays_(const std::vector<const SpectrumType*>& spectra,
+                                                std::vector<String>& rendered)
+    {
+      rendered.assign(spectra.size(), String());
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic, 4)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)spectra.size(); ++i)
+      {
+        const SpectrumType& spec = *spectra[i];
+        if (spec.empty()) continue;
+
+        try
+        {
+          std::ostringstream arrays;
+          writeContainerData_<SpectrumType>(arrays, options_, spec, "mz");
+          writeContainerData_<SpectrumType>(arrays, options_, spec, "intensity");
+          rendered[i] = arrays.str();
+        }
+        catch (...)
+        {
+          // leave the entry empty: writeSpectrum_ encodes the spectrum again
+          // and reports the error from the writing thread
+          rendered[i].clear();
+        }
+      }
+    }
+
     template <typename ContainerT>
     void MzMLHandler::writeContainerData_(std::ostream& os, const PeakFileOptions& pf_options_, const ContainerT& container, String array_type)
     {
@@ -54,7 +54,9 @@
 #include <omp.h>
 #endif
 
+#include <algorithm>
 #include <cmath>
+#include <exception>
 
 namespace OpenMS
 {
@@ -84,108 +86,147 @@ namespace OpenMS
     }
 
     /*
+     * @brief Restrict a query to a set of SQL table ids
      *
-     * This function populates a set of empty data containers (MSSpectrum or
-     * MSChromatogram) with data which are read from an SQLite statement. It is
-     * used when reading sqMass files.  It parses all rows produced by an sql
-     * statement with the following columns:
-     *
-     * id (integer)
-     * native_id (string)
-     * compression (int)
-     * data_type (int)
-     * binary_Data (blob)
-     *
-     * It is designed to work with containers of type MSSpectrum and
-     * MSChromatogram to provide a single function for both use-cases.
+     * Returns a condition on @p column which selects exactly the given ids.
+     * A contiguous block of ids is expressed as a range, any other set of ids
+     * is stored in a temporary table through a bound insert statement (instead
+     * of pasting all ids into the SQL string).
      *
      */
-    template<class ContainerT>
-    void populateContainer_sub_(sqlite3_stmt *stmt, std::vector<ContainerT>& containers)
+    String indexConditionHelper(sqlite3* db, const String& column, const std::vector<int>& indices)
     {
-      // perform first step
-      sqlite3_step(stmt);
-
-      std::vector<int> cont_data; cont_data.resize(containers.size());
-      std::map<Size,Size> sql_container_map;
-      while (sqlite3_column_type( stmt, 0 ) != SQLITE_NULL)
+      std::vector<int> sorted(indices);
+      std::sort(sorted.begin(), sorted.end());
+      sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+      if (!sorted.empty() && Size(sorted.back() - sorted.front()) + 1 == sorted.size())
       {
-        Size id_orig = sqlite3_column_int( stmt, 0 );
-
-        // map the sql table id to the index in the "containers" vector
-        if (sql_container_map.find(id_orig) == sql_container_map.end())
-        {
-          Size tmp = sql_container_map.size();
-          sql_container_map[id_orig] = tmp;
-        }
-        Size curr_id = sql_container_map[id_orig];
-
-        const unsigned char * native_id_ = sqlite3_column_text(stmt, 1);
-        std::string native_id(reinterpret_cast<const char*>(native_id_), sqlite3_column_bytes(stmt, 1));
+        return column + " BETWEEN " + String(sorted.front()) + " AND " + String(sorted.back());
+      }
 
-        if (curr_id >= containers.size())
-        {
-          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
-              "Data for non-existent spectrum / chromatogram found");
-        }
-        if (native_id != containers[curr_id].getNativeID())
+      SqliteConnector::executeStatement(db, "CREATE TEMP TABLE IF NOT EXISTS SELECTED_ID (ID INTEGER PRIMARY KEY); "
+                                            "DELETE FROM SELECTED_ID; BEGIN TRANSACTION;");
+      sqlite3_stmt* stmt;
+      SqliteConnector::prepareStatement(db, &stmt, "INSERT INTO SELECTED_ID (ID) VALUES (?);");
+      for (Size k = 0; k < sorted.size(); ++k)
+      {
+        sqlite3_bind_int(stmt, 1, sorted[k]);
+        if (sqlite3_step(stmt) != SQLITE_DONE)
         {
-          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
-              String("Native id for spectrum / chromatogram doesnt match: ") + native_id + " != " +  containers[curr_id].getNativeID() );
+          String error = sqlite3_errmsg(db);
+          sqlite3_finalize(stmt);
+          SqliteConnector::executeStatement(db, "ROLLBACK TRANSACTION;");
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Could not store selected ids: " + error);
         }
+        sqlite3_reset(stmt);
+      }
+      sqlite3_finalize(stmt);
+      SqliteConnector::executeStatement(db, "END TRANSACTION;");
 
-        int compression = sqlite3_column_int( stmt, 2 );
-        int data_type = sqlite3_column_int( stmt, 3 );
+      return column + " IN (SELECT ID FROM SELECTED_ID)";
+    }
 
-        const void * raw_text = sqlite3_column_blob(stmt, 4);
-        size_t blob_bytes = sqlite3_column_bytes(stmt, 4);
+    /*
+     * @brief A single binary data array as read from the DATA table
+     *
+     */
+    struct RawDataArray
+    {
+      Size container_idx;
+      int compression;
+      int data_type;
+      std::string blob;
+      std::vector<double> data;
+    };
 
-        // data_type is one of 0 = mz, 1 = int, 2 = rt
-        // compression is one of 0 = no, 1 = zlib, 2 = np-linear, 3 = np-slof, 4 = np-pic, 5 = np-linear + zlib, 6 = np-slof + zlib, 7 = np-pic + zlib
-        std::vector<double> data;
-        if (compression == 1)
-        {
-          std::string uncompressed;
-          OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, uncompressed);
+    /*
+     * @brief Decodes the blob of a data array into its data vector (and releases the blob)
+     *
+     * compression is one of 0 = no, 1 = zlib, 2 = np-linear, 3 = np-slof, 4 = np-pic, 5 = np-linear + zlib, 6 = np-slof + zlib, 7 = np-pic + zlib
+     *
+     */
+    void decodeDataArray(RawDataArray& array)
+    {
+      std::vector<double>& data = array.data;
+      if (array.compression == 1)
+      {
+        std::string uncompressed;
+        OpenMS::ZlibCompression::uncompressString(array.blob.data(), array.blob.size(), uncompressed);
 
-          void* byte_buffer = reinterpret_cast<void *>(&uncompressed[0]);
-          Size buffer_size = uncompressed.size();
-          const double* float_buffer = reinterpret_cast<const double *>(byte_buffer);
-          if (buffer_size % sizeof(double) != 0)
-          {
-            throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
-          }
-          Size float_count = buffer_size / sizeof(double);
-          // copy values
-          data.assign(float_buffer, float_buffer + float_count);
-        }
-        else if (compression == 5)
+        void* byte_buffer = reinterpret_cast<void *>(&uncompressed[0]);
+        Size buffer_size = uncompressed.size();
+        const double* float_buffer = reinterpret_cast<const double *>(byte_buffer);
+        if (buffer_size % sizeof(double) != 0)
         {
-          std::string uncompressed;
-          OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, uncompressed);
-          MSNumpressCoder::NumpressConfig config;
-          config.setCompression("linear");
-          MSNumpressCoder().decodeNPRaw(uncompressed, data, config);
+          throw Exception::ConversionError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Bad BufferCount?");
         }
-        else if (compression == 6)
+        Size float_count = buffer_size / sizeof(double);
+        // copy values
+        data.assign(float_buffer, float_buffer + float_count);
+      }
+      else if (array.compression == 5)
+      {
+        std::string uncompressed;
+        OpenMS::ZlibCompression::uncompressString(array.blob.data(), array.blob.size(), uncompressed);
+        MSNumpressCoder::NumpressConfig config;
+        config.setCompression("linear");
+        MSNumpressCoder().decodeNPRaw(uncompressed, data, config);
+      }
+      else if (array.compression == 6)
+      {
+        std::string uncompressed;
+        OpenMS::ZlibCompression::uncompressString(array.blob.data(), array.blob.size(), uncompressed);
+        MSNumpressCoder::NumpressConfig config;
+        config.setCompression("slof");
+        MSNumpressCoder().decodeNPRaw(uncompressed, data, config);
+      }
+      else
+      {
+        throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+            "Compression not supported");
+      }
+      std::string().swap(array.blob);
+    }
+
+    /*
+     * @brief Decodes a batch of data arrays in parallel and moves the data into the containers
+     *
+     */
+    template<class ContainerT>
+    void populateContainerBatch_(std::vector<RawDataArray>& batch, std::vector<ContainerT>& containers, std::vector<int>& cont_data)
+    {
+      std::exception_ptr decode_exception;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+      for (SignedSize i = 0; i < (SignedSize)batch.size(); ++i)
+      {
+        try
         {
-          std::string uncompressed;
-          OpenMS::ZlibCompression::uncompressString(raw_text, blob_bytes, uncompressed);
-          MSNumpressCoder::NumpressConfig config;
-          config.setCompression("slof");
-          MSNumpressCoder().decodeNPRaw(uncompressed, data, config);
+          decodeDataArray(batch[i]);
         }
-        else
+        catch (...)
         {
-          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
-              "Compression not supported");
+#ifdef _OPENMP
+#pragma omp critical (MzMLSqliteHandler_decode)
+#endif
+          if (!decode_exception) { decode_exception = std::current_exception(); }
         }
+      }
+      if (decode_exception) { std::rethrow_exception(decode_exception); }
 
+      for (Size i = 0; i < batch.size(); ++i)
+      {
+        const Size curr_id = batch[i].container_idx;
+        const int data_type = batch[i].data_type;
+        const std::vector<double>& data = batch[i].data;
+
+        // data_type is one of 0 = mz, 1 = int, 2 = rt
         if (data_type == 1)
         {
           // intensity
           if (containers[curr_id].empty()) containers[curr_id].resize(data.size());
-          std::vector< double >::iterator data_it = data.begin();
+          std::vector< double >::const_iterator data_it = data.begin();
           for (auto it = containers[curr_id].begin(); it != containers[curr_id].end(); ++it, ++data_it)
           {
             it->setIntensity(*data_it);
@@ -202,7 +243,7 @@ namespace OpenMS
           }
 
           if (containers[curr_id].empty()) containers[curr_id].resize(data.size());
-          std::vector< double >::iterator data_it = data.begin();
+          std::vector< double >::const_iterator data_it = data.begin();
           for (auto it = containers[curr_id].begin(); it != containers[curr_id].end(); ++it, ++data_it)
           {
             it->setMZ(*data_it);
@@ -218,7 +259,7 @@ namespace OpenMS
                 "Found retention time data type for spectrum (instead of m/z)");
           }
           if (containers[curr_id].empty()) containers[curr_id].resize(data.size());
-          std::vector< double >::iterator data_it = data.begin();
+          std::vector< double >::const_iterator data_it = data.begin();
           for (auto it = containers[curr_id].begin(); it != containers[curr_id].end(); ++it, ++data_it)
           {
             it->setMZ(*data_it);
@@ -230,9 +271,86 @@ namespace OpenMS
           throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
               "Found data type other than RT/Intensity for spectra");
         }
+      }
+      batch.clear();
+    }
+
+    /*
+     *
+     * This function populates a set of empty data containers (MSSpectrum or
+     * MSChromatogram) with data which are read from an SQLite statement. It is
+     * used when reading sqMass files.  It parses all rows produced by an sql
+     * statement with the following columns:
+     *
+     * id (integer)
+     * native_id (string)
+     * compression (int)
+     * data_type (int)
+     * binary_Data (blob)
+     *
+     * It is designed to work with containers of type MSSpectrum and
+     * MSChromatogram to provide a single function for both use-cases.
+     *
+     * The statement is stepped through once, the blobs are collected in
+     * batches and decompressed / decoded in parallel.
+     *
+     */
+    template<class ContainerT>
+    void populateContainer_sub_(sqlite3_stmt *stmt, std::vector<ContainerT>& containers)
+    {
+      // number of data arrays which are decoded together
+      const Size batch_size = 1024;
+      std::vector<RawDataArray> batch;
+      batch.reserve(batch_size);
+
+      // perform first step
+      sqlite3_step(stmt);
+
+      std::vector<int> cont_data; cont_data.resize(containers.size());
+      std::map<Size,Size> sql_container_map;
+      while (sqlite3_column_type( stmt, 0 ) != SQLITE_NULL)
+      {
+        Size id_orig = sqlite3_column_int( stmt, 0 );
+
+        // map the sql table id to the index in the "containers" vector
+        if (sql_container_map.find(id_orig) == sql_container_map.end())
+        {
+          Size tmp = sql_container_map.size();
+          sql_container_map[id_orig] = tmp;
+        }
+        Size curr_id = sql_container_map[id_orig];
+
+        const unsigned char * native_id_ = sqlite3_column_text(stmt, 1);
+        std::string native_id(reinterpret_cast<const char*>(native_id_), sqlite3_column_bytes(stmt, 1));
+
+        if (curr_id >= containers.size())
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+              "Data for non-existent spectrum / chromatogram found");
+        }
+        if (native_id != containers[curr_id].getNativeID())
+        {
+          throw Exception::IllegalArgument(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, 
+              String("Native id for spectrum / chromatogram doesnt match: ") + native_id + " != " +  containers[curr_id].getNativeID() );
+        }
+
+        // the blob is only valid until the next step, thus copy it
+        batch.push_back(RawDataArray());
+        RawDataArray& array = batch.back();
+        array.container_idx = curr_id;
+        array.compression = sqlite3_column_int( stmt, 2 );
+        array.data_type = sqlite3_column_int( stmt, 3 );
+        const char * raw_text = reinterpret_cast<const char*>(sqlite3_column_blob(stmt, 4));
+        array.blob.assign(raw_text, raw_text + sqlite3_column_bytes(stmt, 4));
+
+        if (batch.size() >= batch_size)
+        {
+          populateContainerBatch_(batch, containers, cont_data);
+        }
 
         sqlite3_step( stmt );
       }
+      populateContainerBatch_(batch, containers, cont_data);
 
       // ensure that all spectra/chromatograms have their data: we expect two data arrays per container (int and mz/rt)
       for (Size k = 0; k < cont_data.size(); k++)
@@ -428,7 +546,7 @@ namespace OpenMS
       // restrict by a given set of indices
       if (!indices.empty())
       {
-        select_sql += " AND SPECTRUM.ID IN (" + integerConcatenateHelper(indices) + ")";
+        select_sql += " AND " + indexConditionHelper(conn.getDB(), "SPECTRUM.ID", indices);
       }
 
       if (deltaRT <= 0.0) {select_sql += " LIMIT 1";} // only take the first spectrum larger than RT
@@ -500,8 +618,8 @@ namespace OpenMS
                           "DATA.DATA as binary_data " \
                           "FROM CHROMATOGRAM " \
                           "INNER JOIN DATA ON CHROMATOGRAM.ID = DATA.CHROMATOGRAM_ID " \
-                          "WHERE CHROMATOGRAM.ID IN (";
-      select_sql += integerConcatenateHelper(indices) + ");";
+                          "WHERE ";
+      select_sql += indexConditionHelper(db, "CHROMATOGRAM.ID", indices) + " ORDER BY CHROMATOGRAM.ID;";
 
       // Execute SQL statement
       sqlite3_stmt* stmt;
@@ -545,8 +663,8 @@ namespace OpenMS
                           "DATA.DATA as binary_data " \
                           "FROM SPECTRUM " \
                           "INNER JOIN DATA ON SPECTRUM.ID = DATA.SPECTRUM_ID " \
-                          "WHERE SPECTRUM.ID IN (";
-      select_sql += integerConcatenateHelper(indices) + ");";
+                          "WHERE ";
+      select_sql += indexConditionHelper(db, "SPECTRUM.ID", indices) + " ORDER BY SPECTRUM.ID;";
 
       // Execute SQL statement
       sqlite3_stmt* stmt;
@@ -582,7 +700,7 @@ namespace OpenMS
 
       if (!indices.empty())
       {
-        select_sql += String("WHERE CHROMATOGRAM.ID IN (") + integerConcatenateHelper(indices) + ")";
+        select_sql += "WHERE " + indexConditionHelper(db, "CHROMATOGRAM.ID", indices) + " ORDER BY CHROMATOGRAM.ID";
       }
       select_sql += ";";
 
@@ -662,7 +780,7 @@ namespace OpenMS
 
       if (!indices.empty())
       {
-        select_sql += String("WHERE SPECTRUM.ID IN (") + integerConcatenateHelper(indices) + ")";
+        select_sql += "WHERE " + indexConditionHelper(db, "SPECTRUM.ID", indices) + " ORDER BY SPECTRUM.ID";
       }
       select_sql += ";";
 
@@ -41,9 +41,15 @@
 #include <OpenMS/FORMAT/TextFile.h>
 #include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
 #include <OpenMS/SYSTEM/File.h>
+#include <OpenMS/SYSTEM/Profiler.h>
 
+#include <exception>
 #include <sstream>
 
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 namespace OpenMS
 {
 
@@ -155,6 +161,68 @@ namespace OpenMS
     }
   }
 
+  void MzMLFile::safeParsePipelined_(const String& filename, Internal::MzMLHandler* handler)
+  {
+#ifdef _OPENMP
+    if (options_.getPipelineQueueDepth() > 0 && options_.getFillData() &&
+        omp_get_max_threads() > 1 && !omp_in_parallel())
+    {
+      // The file is parsed in chunks: within a chunk, the parser runs on a
+      // single thread and spawns one decoding task per spectrum/chromatogram
+      // which the remaining threads of the team execute. Once the pipeline is
+      // full, the parallel region is left and the decoded data is handed to
+      // the consumer from the calling thread (so the consumer may use OpenMP
+      // itself without running into nested parallelism).
+      handler->setPipelined(true);
+      try
+      {
+        parseProgressive_(filename, handler, [handler](const std::function<bool()>& parse_next)
+        {
+          bool more = true;
+          std::exception_ptr exception;
+#pragma omp parallel
+          {
+#pragma omp single
+            {
+              try
+              {
+                while (more && !handler->pipelineFull())
+                {
+                  more = parse_next();
+                }
+              }
+              catch (...)
+              {
+                exception = std::current_exception();
+              }
+            } // implicit barrier: all decoding tasks are finished
+          }
+          if (exception)
+          {
+            std::rethrow_exception(exception);
+          }
+          handler->flushPipeline();
+          return more;
+        });
+      }
+      catch (Exception::BaseException& e)
+      {
+        handler->setPipelined(false);
+        String expr;
+        expr += e.getFile();
+        expr += "@";
+        expr += e.getLine();
+        expr += "-";
+        expr += e.getFunction();
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, expr, String("- due to that error of type ") + e.getName());
+      }
+      handler->setPipelined(false);
+      return;
+    }
+#endif
+    safeParse_(filename, handler);
+  }
+
   void MzMLFile::loadBuffer(const std::string& buffer, PeakMap& map)
   {
     map.reset();
@@ -166,6 +234,7 @@ namespace OpenMS
 
   void MzMLFile::load(const String& filename, PeakMap& map)
   {
+    OPENMS_PROFILE_SCOPE("MzMLFile::load", "io");
     map.reset();
 
     //set DocumentIdentifier
@@ -179,6 +248,7 @@ namespace OpenMS
 
   void MzMLFile::store(const String& filename, const PeakMap& map) const
   {
+    OPENMS_PROFILE_SCOPE("MzMLFile::store", "io");
     Internal::MzMLHandler handler(map, filename, getVersion(), *this);
     handler.setOptions(options_);
     save_(filename, &handler);
@@ -202,6 +272,7 @@ namespace OpenMS
 
   void MzMLFile::transform(const String& filename_in, Interfaces::IMSDataConsumer* consumer, bool skip_full_count, bool skip_first_pass)
   {
+    OPENMS_PROFILE_SCOPE("MzMLFile::transform", "io");
     // First pass through the file -> get the meta-data and hand it to the consumer
     if (!skip_first_pass) transformFirstPass_(filename_in, consumer, skip_full_count);
 
@@ -211,12 +282,13 @@ namespace OpenMS
       Internal::MzMLHandler handler(dummy, filename_in, getVersion(), *this);
       handler.setOptions(options_);
       handler.setMSDataConsumer(consumer);
-      safeParse_(filename_in, &handler);
+      safeParsePipelined_(filename_in, &handler);
     }
   }
 
   void MzMLFile::transform(const String& filename_in, Interfaces::IMSDataConsumer* consumer, PeakMap& map, bool skip_full_count, bool skip_first_pass)
   {
+    OPENMS_PROFILE_SCOPE("MzMLFile::transform", "io");
     // First pass through the file -> get the meta-data and hand it to the consumer
     if (!skip_first_pass) transformFirstPass_(filename_in, consumer, skip_full_count);
 
@@ -228,7 +300,7 @@ namespace OpenMS
       handler.setOptions(tmp_options);
       handler.setMSDataConsumer(consumer);
 
-      safeParse_(filename_in, &handler);
+      safeParsePipelined_(filename_in, &handler);
     }
   }
 
@@ -3075,6 +3075,174 @@ namespace OpenMS
     tab_file.close();
   }
 
+  namespace
+  {
+    /// Add the optional columns of @p row to @p names (in order of first occurrence, like MzTab::getPSMOptionalColumnNames() etc.)
+    template <typename SectionRow>
+    void addOptionalColumnNames(const SectionRow& row, std::vector<String>& names)
+    {
+      for (const MzTabOptionalColumnEntry& entry : row.opt_)
+      {
+        if (std::find(names.begin(), names.end(), entry.first) == names.end())
+        {
+          names.push_back(entry.first);
+        }
+      }
+    }
+  }
+
+  template <typename MzTabStream, typename... StreamArgs>
+  void MzTabFile::storeStreamed_(const String& filename, const StreamArgs&... stream_args) const
+  {
+    if (!(FileHandler::hasValidExtension(filename, FileTypes::MZTAB) || FileHandler::hasValidExtension(filename, FileTypes::TSV)))
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename, "invalid file extension, expected '"
+      + FileTypes::typeToName(FileTypes::MZTAB) + "' or '" + FileTypes::typeToName(FileTypes::TSV) + "'");
+    }
+
+    // first pass: the optional columns (and the ms_run level scores of the
+    // PEP section) depend on all rows of a section
+    vector<String> prt_optional_columns, pep_optional_columns, psm_optional_columns;
+    bool has_ms_run_level_scores = false;
+    {
+      MzTabStream s(stream_args...);
+
+      MzTabProteinSectionRow prt_row;
+      while (s.nextPRTRow(prt_row))
+      {
+        addOptionalColumnNames(prt_row, prt_optional_columns);
+      }
+
+      MzTabPeptideSectionRow pep_row;
+      while (s.nextPEPRow(pep_row))
+      {
+        addOptionalColumnNames(pep_row, pep_optional_columns);
+        has_ms_run_level_scores |= !pep_row.search_engine_score_ms_run.empty();
+      }
+
+      MzTabPSMSectionRow psm_row;
+      while (s.nextPSMRow(psm_row))
+      {
+        addOptionalColumnNames(psm_row, psm_optional_columns);
+      }
+    }
+
+    // second pass: write the rows as they are generated
+    std::vector<char> buffer(1 << 20);
+    ofstream tab_file;
+    tab_file.rdbuf()->pubsetbuf(buffer.data(), buffer.size());
+    tab_file.open(filename, ios::out | ios::trunc);
+    if (!tab_file)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+
+    MzTabStream s(stream_args...);
+    const MzTabMetaData& meta_data = s.getMetaData();
+    {
+      StringList out;
+      generateMzTabMetaDataSection_(meta_data, out);
+      for (const String& line : out) { tab_file << line << "\n"; }
+    }
+
+    {
+      MzTabProteinSectionRow row;
+      bool first = true;
+      while (s.nextPRTRow(row))
+      {
+        if (first)
+        { // add header, the first row is the reference row for the columns
+          tab_file << "\n" << generateMzTabProteinHeader_(row, meta_data.protein_search_engine_score.size(), prt_optional_columns, meta_data) << "\n";
+          first = false;
+        }
+        tab_file << generateMzTabSectionRow_(row, prt_optional_columns, meta_data) << "\n";
+      }
+    }
+
+    {
+      // all ms_runs are mandatory in "Complete" mode, otherwise only report them if there are ms_run level scores
+      bool complete = (meta_data.mz_tab_mode.toCellString() == "Complete");
+      Size search_ms_runs = (complete || has_ms_run_level_scores) ? meta_data.ms_run.size() : 0;
+
+      MzTabPeptideSectionRow row;
+      bool first = true;
+      while (s.nextPEPRow(row))
+      {
+        if (first)
+        {
+          tab_file << "\n" << generateMzTabPeptideHeader_(search_ms_runs,
+                                                         row.best_search_engine_score.size(),
+                                                         row.search_engine_score_ms_run.size(),
+                                                         row.peptide_abundance_assay.size(),
+                                                         row.peptide_abundance_study_variable.size(),
+                                                         pep_optional_columns) << "\n";
+          first = false;
+        }
+        tab_file << generateMzTabSectionRow_(row, pep_optional_columns, meta_data) << "\n";
+      }
+    }
+
+    {
+      MzTabPSMSectionRow row;
+      bool first = true;
+      while (s.nextPSMRow(row))
+      {
+        if (first)
+        {
+          tab_file << "\n" << generateMzTabPSMHeader_(meta_data.psm_search_engine_score.size(), psm_optional_columns) << "\n";
+          first = false;
+        }
+        tab_file << generateMzTabSectionRow_(row, psm_optional_columns, meta_data) << "\n";
+      }
+    }
+
+    tab_file.close();
+  }
+
+  void MzTabFile::storeConsensusMap(
+    const String& filename,
+    const ConsensusMap& cmap,
+    const bool first_run_inference_only,
+    const bool export_unidentified_features,
+    const bool export_unassigned_ids,
+    const bool export_subfeatures,
+    const bool export_empty_pep_ids,
+    const String& title) const
+  {
+    storeStreamed_<MzTab::CMMzTabStream>(filename,
+      cmap,
+      filename,
+      first_run_inference_only,
+      export_unidentified_features,
+      export_unassigned_ids,
+      export_subfeatures,
+      export_empty_pep_ids,
+      title);
+  }
+
+  void MzTabFile::storeIdentifications(
+    const String& filename,
+    const std::vector<ProteinIdentification>& protein_identifications,
+    const std::vector<PeptideIdentification>& peptide_identifications,
+    const bool first_run_inference_only,
+    const bool export_empty_pep_ids,
+    const String& title) const
+  {
+    vector<const PeptideIdentification*> pep_ids_ptr;
+    for (const PeptideIdentification& pi : peptide_identifications) { pep_ids_ptr.push_back(&pi); }
+
+    vector<const ProteinIdentification*> prot_ids_ptr;
+    for (const ProteinIdentification& pi : protein_identifications) { prot_ids_ptr.push_back(&pi); }
+
+    storeStreamed_<MzTab::IDMzTabStream>(filename,
+      prot_ids_ptr,
+      pep_ids_ptr,
+      filename,
+      first_run_inference_only,
+      export_empty_pep_ids,
+      title);
+  }
+
   void MzTabFile::store(const String& filename, const MzTab& mz_tab) const
   {
     if (!(FileHandler::hasValidExtension(filename, FileTypes::MZTAB) || FileHandler::hasValidExtension(filename, FileTypes::TSV)))
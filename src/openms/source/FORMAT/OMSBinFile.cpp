@@ -0,0 +1,1025 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/FORMAT/OMSBinFile.h>
+
+#include <OpenMS/CHEMISTRY/ProteaseDB.h>
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+#include <OpenMS/METADATA/PeptideIdentification.h>
+#include <OpenMS/METADATA/ProteinIdentification.h>
+#include <OpenMS/SYSTEM/File.h>
+
+#include <boost/iostreams/device/mapped_file.hpp>
+
+#include <cstring>
+#include <fstream>
+#include <unordered_map>
+
+using namespace std;
+
+namespace OpenMS
+{
+  const UInt32 OMSBinFile::FORMAT_VERSION = 1;
+
+  namespace
+  {
+    const char FILE_MAGIC[8] = {'O', 'M', 'S', 'B', 'I', 'N', '\n', '\0'};
+    const UInt32 BYTE_ORDER_MARK = 0x01020304;
+    const char* const NO_DATE = "0000-00-00 00:00:00";
+
+    typedef unsigned char Byte;
+
+    /// Fixed size header at the beginning of every file
+    struct FileHeader
+    {
+      char magic[8];
+      UInt32 version;
+      UInt32 byte_order;
+      UInt32 content;
+      UInt32 reserved;
+      UInt64 string_table_offset;
+      UInt64 string_count;
+    };
+
+    /**
+      @brief Writes the body of a file and collects its strings
+
+      Numeric values are written in native byte order, strings are replaced
+      by their index into the string table written by finish().
+    */
+    class BinaryWriter
+    {
+  public:
+      BinaryWriter(const String& filename, OMSBinFile::ContentType content) :
+        filename_(filename),
+        os_(filename.c_str(), std::ios::binary | std::ios::trunc)
+      {
+        if (!os_)
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+        std::memcpy(header_.magic, FILE_MAGIC, sizeof(FILE_MAGIC));
+        header_.version = OMSBinFile::FORMAT_VERSION;
+        header_.byte_order = BYTE_ORDER_MARK;
+        header_.content = content;
+        header_.reserved = 0;
+        header_.string_table_offset = 0;
+        header_.string_count = 0;
+        // written again with the final offsets by finish()
+        put(header_);
+      }
+
+      template <typename T>
+      void put(const T& value)
+      {
+        os_.write(reinterpret_cast<const char*>(&value), sizeof(T));
+      }
+
+      /// Writes one numeric field of all elements of @p elements as a contiguous column
+      template <typename T, typename ContainerType, typename GetterType>
+      void putColumn(const ContainerType& elements, GetterType getter)
+      {
+        std::vector<T> column;
+        column.reserve(elements.size());
+        for (const auto& element : elements)
+        {
+          column.push_back(static_cast<T>(getter(element)));
+        }
+        if (!column.empty())
+        {
+          os_.write(reinterpret_cast<const char*>(&column[0]), column.size() * sizeof(T));
+        }
+      }
+
+      void putString(const std::string& s)
+      {
+        auto it = string_ids_.find(s);
+        if (it == string_ids_.end())
+        {
+          it = string_ids_.insert(std::make_pair(s, UInt32(strings_.size()))).first;
+          strings_.push_back(&it->first);
+        }
+        put<UInt32>(it->second);
+      }
+
+      void putStrings(const std::vector<String>& strings)
+      {
+        put<UInt32>(strings.size());
+        for (const String& s : strings) putString(s);
+      }
+
+      void putDataValue(const DataValue& value)
+      {
+        put<Byte>(value.valueType());
+        put<Byte>(value.getUnitType());
+        put<Int32>(value.getUnit());
+        switch (value.valueType())
+        {
+          case DataValue::STRING_VALUE: putString(value.toString()); break;
+          case DataValue::INT_VALUE: put<Int64>(static_cast<SignedSize>(value)); break;
+          case DataValue::DOUBLE_VALUE: put<double>(static_cast<double>(value)); break;
+          case DataValue::STRING_LIST: putStrings(value.toStringList()); break;
+          case DataValue::INT_LIST:
+          {
+            IntList list = value.toIntList();
+            put<UInt32>(list.size());
+            for (Int i : list) put<Int32>(i);
+            break;
+          }
+          case DataValue::DOUBLE_LIST:
+          {
+            DoubleList list = value.toDoubleList();
+            put<UInt32>(list.size());
+            for (double d : list) put<double>(d);
+            break;
+          }
+          default: break;
+        }
+      }
+
+      void putMetaInfo(const MetaInfoInterface& meta)
+      {
+        std::vector<UInt> keys;
+        meta.getKeys(keys);
+        put<UInt32>(keys.size());
+        for (UInt key : keys)
+        {
+          putString(MetaInfoInterface::metaRegistry().getName(key));
+          putDataValue(meta.getMetaValue(key));
+        }
+      }
+
+      void putPeptideIdentifications(const std::vector<PeptideIdentification>& ids)
+      {
+        put<UInt64>(ids.size());
+        for (const PeptideIdentification& id : ids)
+        {
+          putString(id.getIdentifier());
+          put<double>(id.getRT());
+          put<double>(id.getMZ());
+          putString(id.getScoreType());
+          put<Byte>(id.isHigherScoreBetter());
+          put<double>(id.getSignificanceThreshold());
+          putString(id.getBaseName());
+          put<UInt32>(id.getHits().size());
+          for (const PeptideHit& hit : id.getHits())
+          {
+            put<double>(hit.getScore());
+            put<UInt32>(hit.getRank());
+            put<Int32>(hit.getCharge());
+            putString(hit.getSequence().toString());
+            put<UInt32>(hit.getPeptideEvidences().size());
+            for (const PeptideEvidence& evidence : hit.getPeptideEvidences())
+            {
+              putString(evidence.getProteinAccession());
+              put<Int32>(evidence.getStart());
+              put<Int32>(evidence.getEnd());
+              put<char>(evidence.getAABefore());
+              put<char>(evidence.getAAAfter());
+            }
+            std::vector<PeptideHit::PeakAnnotation> annotations = hit.getPeakAnnotations();
+            put<UInt32>(annotations.size());
+            for (const PeptideHit::PeakAnnotation& annotation : annotations)
+            {
+              putString(annotation.annotation);
+              put<Int32>(annotation.charge);
+              put<double>(annotation.mz);
+              put<double>(annotation.intensity);
+            }
+            putMetaInfo(hit);
+          }
+          putMetaInfo(id);
+        }
+      }
+
+      void putProteinGroups(const std::vector<ProteinIdentification::ProteinGroup>& groups)
+      {
+        put<UInt32>(groups.size());
+        for (const ProteinIdentification::ProteinGroup& group : groups)
+        {
+          put<double>(group.probability);
+          putStrings(group.accessions);
+        }
+      }
+
+      void putProteinIdentifications(const std::vector<ProteinIdentification>& ids)
+      {
+        put<UInt64>(ids.size());
+        for (const ProteinIdentification& id : ids)
+        {
+          putString(id.getIdentifier());
+          putString(id.getSearchEngine());
+          putString(id.getSearchEngineVersion());
+          putString(id.getDateTime().get());
+          putString(id.getScoreType());
+          put<Byte>(id.isHigherScoreBetter());
+          put<double>(id.getSignificanceThreshold());
+
+          const ProteinIdentification::SearchParameters& params = id.getSearchParameters();
+          putString(params.db);
+          putString(params.db_version);
+          putString(params.taxonomy);
+          putString(params.charges);
+          put<Byte>(params.mass_type);
+          putStrings(params.fixed_modifications);
+          putStrings(params.variable_modifications);
+          put<UInt32>(params.missed_cleavages);
+          put<double>(params.fragment_mass_tolerance);
+          put<Byte>(params.fragment_mass_tolerance_ppm);
+          put<double>(params.precursor_mass_tolerance);
+          put<Byte>(params.precursor_mass_tolerance_ppm);
+          putString(params.digestion_enzyme.getName());
+          putMetaInfo(params);
+
+          put<UInt32>(id.getHits().size());
+          for (const ProteinHit& hit : id.getHits())
+          {
+            put<double>(hit.getScore());
+            put<UInt32>(hit.getRank());
+            putString(hit.getAccession());
+            putString(hit.getSequence());
+            put<double>(hit.getCoverage());
+            putMetaInfo(hit);
+          }
+          putProteinGroups(id.getProteinGroups());
+          putProteinGroups(id.getIndistinguishableProteins());
+          putMetaInfo(id);
+        }
+      }
+
+      void putDataProcessing(const std::vector<DataProcessing>& processing)
+      {
+        put<UInt32>(processing.size());
+        for (const DataProcessing& dp : processing)
+        {
+          putString(dp.getSoftware().getName());
+          putString(dp.getSoftware().getVersion());
+          putMetaInfo(dp.getSoftware());
+          put<UInt32>(dp.getProcessingActions().size());
+          for (DataProcessing::ProcessingAction action : dp.getProcessingActions())
+          {
+            put<UInt32>(action);
+          }
+          putString(dp.getCompletionTime().get());
+          putMetaInfo(dp);
+        }
+      }
+
+      /// Writes the parts common to feature and consensus maps
+      template <typename MapType>
+      void putMapHeader(const MapType& map)
+      {
+        put<UInt64>(map.getUniqueId());
+        putString(map.getIdentifier());
+        putDataProcessing(map.getDataProcessing());
+        putProteinIdentifications(map.getProteinIdentifications());
+        putPeptideIdentifications(map.getUnassignedPeptideIdentifications());
+        putMetaInfo(map);
+      }
+
+      template <typename FeatureContainer>
+      void putFeatures(const FeatureContainer& features)
+      {
+        put<UInt64>(features.size());
+        putColumn<double>(features, [](const Feature& f) { return f.getRT(); });
+        putColumn<double>(features, [](const Feature& f) { return f.getMZ(); });
+        putColumn<float>(features, [](const Feature& f) { return f.getIntensity(); });
+        putColumn<float>(features, [](const Feature& f) { return f.getOverallQuality(); });
+        putColumn<float>(features, [](const Feature& f) { return f.getQuality(0); });
+        putColumn<float>(features, [](const Feature& f) { return f.getQuality(1); });
+        putColumn<Int32>(features, [](const Feature& f) { return f.getCharge(); });
+        putColumn<float>(features, [](const Feature& f) { return f.getWidth(); });
+        putColumn<UInt64>(features, [](const Feature& f) { return f.getUniqueId(); });
+
+        for (const Feature& feature : features)
+        {
+          put<UInt32>(feature.getConvexHulls().size());
+          for (const ConvexHull2D& hull : feature.getConvexHulls())
+          {
+            const ConvexHull2D::PointArrayType& points = hull.getHullPoints();
+            put<UInt32>(points.size());
+            for (const ConvexHull2D::PointType& p : points)
+            {
+              put<double>(p[0]);
+              put<double>(p[1]);
+            }
+          }
+          putPeptideIdentifications(feature.getPeptideIdentifications());
+          putMetaInfo(feature);
+          putFeatures(feature.getSubordinates());
+        }
+      }
+
+      void putConsensusFeatures(const ConsensusMap& map)
+      {
+        put<UInt64>(map.size());
+        putColumn<double>(map, [](const ConsensusFeature& f) { return f.getRT(); });
+        putColumn<double>(map, [](const ConsensusFeature& f) { return f.getMZ(); });
+        putColumn<float>(map, [](const ConsensusFeature& f) { return f.getIntensity(); });
+        putColumn<float>(map, [](const ConsensusFeature& f) { return f.getQuality(); });
+        putColumn<Int32>(map, [](const ConsensusFeature& f) { return f.getCharge(); });
+        putColumn<float>(map, [](const ConsensusFeature& f) { return f.getWidth(); });
+        putColumn<UInt64>(map, [](const ConsensusFeature& f) { return f.getUniqueId(); });
+
+        for (const ConsensusFeature& feature : map)
+        {
+          put<UInt32>(feature.getFeatures().size());
+          for (const FeatureHandle& handle : feature.getFeatures())
+          {
+            put<UInt64>(handle.getMapIndex());
+            put<UInt64>(handle.getUniqueId());
+            put<double>(handle.getRT());
+            put<double>(handle.getMZ());
+            put<float>(handle.getIntensity());
+            put<Int32>(handle.getCharge());
+            put<float>(handle.getWidth());
+          }
+          const std::vector<ConsensusFeature::Ratio> ratios = feature.getRatios();
+          put<UInt32>(ratios.size());
+          for (const ConsensusFeature::Ratio& ratio : ratios)
+          {
+            put<double>(ratio.ratio_value_);
+            putString(ratio.denominator_ref_);
+            putString(ratio.numerator_ref_);
+            putStrings(ratio.description_);
+          }
+          putPeptideIdentifications(feature.getPeptideIdentifications());
+          putMetaInfo(feature);
+        }
+      }
+
+      /// Writes the string table and the final header
+      void finish()
+      {
+        header_.string_table_offset = static_cast<UInt64>(os_.tellp());
+        header_.string_count = strings_.size();
+        for (const std::string* s : strings_)
+        {
+          put<UInt32>(s->size());
+          os_.write(s->data(), s->size());
+        }
+        os_.seekp(0);
+        put(header_);
+        os_.close();
+        if (os_.fail())
+        {
+          throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "error while writing the file");
+        }
+      }
+
+  private:
+      String filename_;
+      std::ofstream os_;
+      FileHeader header_;
+      /// index of each distinct string in the string table
+      std::unordered_map<std::string, UInt32> string_ids_;
+      /// strings in table order (pointing to the keys of string_ids_, which never move)
+      std::vector<const std::string*> strings_;
+    };
+
+    /**
+      @brief Reads a file through a memory mapping
+
+      All reads are bounds checked; a truncated or corrupt file results in a
+      ParseError instead of reading past the mapping.
+    */
+    class BinaryReader
+    {
+  public:
+      explicit BinaryReader(const String& filename) :
+        filename_(filename)
+      {
+        if (!File::exists(filename))
+        {
+          throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+        }
+        if (std::ifstream(filename.c_str(), std::ios::binary | std::ios::ate).tellg() < std::streamoff(sizeof(FileHeader)))
+        {
+          fail_("file is too small");
+        }
+        try
+        {
+          file_.open(filename);
+        }
+        catch (std::exception& e)
+        {
+          throw Exception::FileNotReadable(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename + " (" + e.what() + ")");
+        }
+        begin_ = file_.data();
+        end_ = begin_ + file_.size();
+        pos_ = begin_;
+
+        std::memcpy(&header_, begin_, sizeof(FileHeader));
+        pos_ += sizeof(FileHeader);
+        if (std::memcmp(header_.magic, FILE_MAGIC, sizeof(FILE_MAGIC)) != 0)
+        {
+          fail_("wrong file magic number");
+        }
+        if (header_.byte_order != BYTE_ORDER_MARK)
+        {
+          fail_("file was written on a machine with a different byte order");
+        }
+        if (header_.version != OMSBinFile::FORMAT_VERSION)
+        {
+          fail_("unsupported format version " + String(header_.version));
+        }
+        if (header_.string_table_offset < sizeof(FileHeader) || header_.string_table_offset > file_.size())
+        {
+          fail_("invalid string table offset");
+        }
+
+        // index the string table; the strings themselves are decoded on first use
+        body_end_ = begin_ + header_.string_table_offset;
+        const char* p = body_end_;
+        if (header_.string_count > UInt64(end_ - p) / sizeof(UInt32))
+        {
+          fail_("invalid string count");
+        }
+        string_pos_.reserve(header_.string_count);
+        for (UInt64 i = 0; i < header_.string_count; ++i)
+        {
+          UInt32 length;
+          if (end_ - p < SignedSize(sizeof(length))) fail_("truncated string table");
+          std::memcpy(&length, p, sizeof(length));
+          p += sizeof(length);
+          if (UInt64(end_ - p) < length) fail_("truncated string table");
+          string_pos_.push_back(std::make_pair(p, length));
+          p += length;
+        }
+        strings_.resize(string_pos_.size());
+        decoded_.resize(string_pos_.size(), false);
+        meta_index_.resize(string_pos_.size(), UInt(-1));
+        end_ = body_end_;
+      }
+
+      OMSBinFile::ContentType getContentType() const
+      {
+        return OMSBinFile::ContentType(header_.content);
+      }
+
+      void expectContent(OMSBinFile::ContentType content)
+      {
+        if (header_.content != UInt32(content))
+        {
+          fail_("the file does not contain the requested type of data");
+        }
+      }
+
+      template <typename T>
+      T get()
+      {
+        require_(sizeof(T));
+        T value;
+        std::memcpy(&value, pos_, sizeof(T));
+        pos_ += sizeof(T);
+        return value;
+      }
+
+      /// Reads a column of @p n values written by BinaryWriter::putColumn()
+      template <typename T>
+      void getColumn(std::vector<T>& column, Size n)
+      {
+        requireElements_(n, sizeof(T));
+        column.resize(n);
+        if (n > 0)
+        {
+          std::memcpy(&column[0], pos_, n * sizeof(T));
+        }
+        pos_ += n * sizeof(T);
+      }
+
+      /// Reads a count and checks that at least @p min_element_size bytes per element remain
+      Size getCount64(Size min_element_size)
+      {
+        UInt64 n = get<UInt64>();
+        requireElements_(n, min_element_size);
+        return n;
+      }
+
+      Size getCount(Size min_element_size)
+      {
+        UInt32 n = get<UInt32>();
+        requireElements_(n, min_element_size);
+        return n;
+      }
+
+      const String& getString()
+      {
+        UInt32 id = get<UInt32>();
+        if (id >= strings_.size()) fail_("invalid string reference");
+        if (!decoded_[id])
+        {
+          strings_[id] = String(string_pos_[id].first, string_pos_[id].second);
+          decoded_[id] = true;
+        }
+        return strings_[id];
+      }
+
+      void getStrings(std::vector<String>& strings)
+      {
+        Size n = getCount(sizeof(UInt32));
+        strings.resize(n);
+        for (String& s : strings) s = getString();
+      }
+
+      DataValue getDataValue()
+      {
+        Byte type = get<Byte>();
+        Byte unit_type = get<Byte>();
+        Int32 unit = get<Int32>();
+        DataValue value;
+        switch (type)
+        {
+          case DataValue::STRING_VALUE: value = DataValue(getString()); break;
+          case DataValue::INT_VALUE: value = DataValue(static_cast<long long>(get<Int64>())); break;
+          case DataValue::DOUBLE_VALUE: value = DataValue(get<double>()); break;
+          case DataValue::STRING_LIST:
+          {
+            StringList list;
+            getStrings(list);
+            value = DataValue(list);
+            break;
+          }
+          case DataValue::INT_LIST:
+          {
+            IntList list(getCount(sizeof(Int32)));
+            for (Int& i : list) i = get<Int32>();
+            value = DataValue(list);
+            break;
+          }
+          case DataValue::DOUBLE_LIST:
+          {
+            DoubleList list(getCount(sizeof(double)));
+            for (double& d : list) d = get<double>();
+            value = DataValue(list);
+            break;
+          }
+          case DataValue::EMPTY_VALUE: break;
+          default: fail_("invalid meta value type");
+        }
+        if (unit != -1)
+        {
+          value.setUnitType(static_cast<DataValue::UnitType>(unit_type));
+          value.setUnit(unit);
+        }
+        return value;
+      }
+
+      void getMetaInfo(MetaInfoInterface& meta)
+      {
+        Size n = getCount(2 * sizeof(UInt32));
+        for (Size i = 0; i < n; ++i)
+        {
+          UInt32 key = get<UInt32>();
+          if (key >= meta_index_.size()) fail_("invalid string reference");
+          // resolve every key only once per file
+          if (meta_index_[key] == UInt(-1))
+          {
+            meta_index_[key] = MetaInfoInterface::metaRegistry().registerName(String(string_pos_[key].first, string_pos_[key].second));
+          }
+          meta.setMetaValue(meta_index_[key], getDataValue());
+        }
+      }
+
+      void getPeptideIdentifications(std::vector<PeptideIdentification>& ids)
+      {
+        ids.resize(getCount64(1));
+        for (PeptideIdentification& id : ids)
+        {
+          id.setIdentifier(getString());
+          id.setRT(get<double>());
+          id.setMZ(get<double>());
+          id.setScoreType(getString());
+          id.setHigherScoreBetter(get<Byte>() != 0);
+          id.setSignificanceThreshold(get<double>());
+          id.setBaseName(getString());
+          std::vector<PeptideHit> hits(getCount(1));
+          for (PeptideHit& hit : hits)
+          {
+            hit.setScore(get<double>());
+            hit.setRank(get<UInt32>());
+            hit.setCharge(get<Int32>());
+            const String& sequence = getString();
+            if (!sequence.empty())
+            {
+              hit.setSequence(AASequence::fromString(sequence));
+            }
+            std::vector<PeptideEvidence> evidences(getCount(1));
+            for (PeptideEvidence& evidence : evidences)
+            {
+              evidence.setProteinAccession(getString());
+              evidence.setStart(get<Int32>());
+              evidence.setEnd(get<Int32>());
+              evidence.setAABefore(get<char>());
+              evidence.setAAAfter(get<char>());
+            }
+            hit.setPeptideEvidences(std::move(evidences));
+            std::vector<PeptideHit::PeakAnnotation> annotations(getCount(1));
+            for (PeptideHit::PeakAnnotation& annotation : annotations)
+            {
+              annotation.annotation = getString();
+              annotation.charge = get<Int32>();
+              annotation.mz = get<double>();
+              annotation.intensity = get<double>();
+            }
+            hit.setPeakAnnotations(annotations);
+            getMetaInfo(hit);
+          }
+          id.setHits(hits);
+          getMetaInfo(id);
+        }
+      }
+
+      void getProteinGroups(std::vector<ProteinIdentification::ProteinGroup>& groups)
+      {
+        groups.resize(getCount(1));
+        for (ProteinIdentification::ProteinGroup& group : groups)
+        {
+          group.probability = get<double>();
+          getStrings(group.accessions);
+        }
+      }
+
+      void getDateTime(DateTime& date)
+      {
+        const String& s = getString();
+        if (s != NO_DATE)
+        {
+          date.set(s);
+        }
+      }
+
+      void getProteinIdentifications(std::vector<ProteinIdentification>& ids)
+      {
+        ids.resize(getCount64(1));
+        for (ProteinIdentification& id : ids)
+        {
+          id.setIdentifier(getString());
+          id.setSearchEngine(getString());
+          id.setSearchEngineVersion(getString());
+          DateTime date;
+          getDateTime(date);
+          id.setDateTime(date);
+          id.setScoreType(getString());
+          id.setHigherScoreBetter(get<Byte>() != 0);
+          id.setSignificanceThreshold(get<double>());
+
+          ProteinIdentification::SearchParameters params;
+          params.db = getString();
+          params.db_version = getString();
+          params.taxonomy = getString();
+          params.charges = getString();
+          params.mass_type = static_cast<ProteinIdentification::PeakMassType>(get<Byte>());
+          getStrings(params.fixed_modifications);
+          getStrings(params.variable_modifications);
+          params.missed_cleavages = get<UInt32>();
+          params.fragment_mass_tolerance = get<double>();
+          params.fragment_mass_tolerance_ppm = get<Byte>() != 0;
+          params.precursor_mass_tolerance = get<double>();
+          params.precursor_mass_tolerance_ppm = get<Byte>() != 0;
+          const String& enzyme = getString();
+          if (ProteaseDB::getInstance()->hasEnzyme(enzyme))
+          {
+            params.digestion_enzyme = *(ProteaseDB::getInstance()->getEnzyme(enzyme));
+          }
+          getMetaInfo(params);
+          id.setSearchParameters(std::move(params));
+
+          std::vector<ProteinHit> hits(getCount(1));
+          for (ProteinHit& hit : hits)
+          {
+            hit.setScore(get<double>());
+            hit.setRank(get<UInt32>());
+            hit.setAccession(getString());
+            hit.setSequence(getString());
+            hit.setCoverage(get<double>());
+            getMetaInfo(hit);
+          }
+          id.setHits(hits);
+          getProteinGroups(id.getProteinGroups());
+          getProteinGroups(id.getIndistinguishableProteins());
+          getMetaInfo(id);
+        }
+      }
+
+      void getDataProcessing(std::vector<DataProcessing>& processing)
+      {
+        processing.resize(getCount(1));
+        for (DataProcessing& dp : processing)
+        {
+          dp.getSoftware().setName(getString());
+          dp.getSoftware().setVersion(getString());
+          getMetaInfo(dp.getSoftware());
+          Size n = getCount(sizeof(UInt32));
+          for (Size i = 0; i < n; ++i)
+          {
+            dp.getProcessingActions().insert(static_cast<DataProcessing::ProcessingAction>(get<UInt32>()));
+          }
+          DateTime date;
+          getDateTime(date);
+          dp.setCompletionTime(date);
+          getMetaInfo(dp);
+        }
+      }
+
+      template <typename MapType>
+      void getMapHeader(MapType& map)
+      {
+        map.setUniqueId(get<UInt64>());
+        map.setIdentifier(getString());
+        getDataProcessing(map.getDataProcessing());
+        getProteinIdentifications(map.getProteinIdentifications());
+        getPeptideIdentifications(map.getUnassignedPeptideIdentifications());
+        getMetaInfo(map);
+      }
+
+      template <typename FeatureContainer>
+      void getFeatures(FeatureContainer& features)
+      {
+        // 9 columns with a total of 48 bytes per feature
+        Size n = getCount64(48);
+        std::vector<double> rt, mz;
+        std::vector<float> intensity, overall_quality, quality_rt, quality_mz, width;
+        std::vector<Int32> charge;
+        std::vector<UInt64> unique_id;
+        getColumn(rt, n);
+        getColumn(mz, n);
+        getColumn(intensity, n);
+        getColumn(overall_quality, n);
+        getColumn(quality_rt, n);
+        getColumn(quality_mz, n);
+        getColumn(charge, n);
+        getColumn(width, n);
+        getColumn(unique_id, n);
+
+        features.resize(n);
+        for (Size i = 0; i < n; ++i)
+        {
+          Feature& feature = features[i];
+          feature.setRT(rt[i]);
+          feature.setMZ(mz[i]);
+          feature.setIntensity(intensity[i]);
+          feature.setOverallQuality(overall_quality[i]);
+          feature.setQuality(0, quality_rt[i]);
+          feature.setQuality(1, quality_mz[i]);
+          feature.setCharge(charge[i]);
+          feature.setWidth(width[i]);
+          feature.setUniqueId(unique_id[i]);
+
+          std::vector<ConvexHull2D> hulls(getCount(sizeof(UInt32)));
+          for (ConvexHull2D& hull : hulls)
+          {
+            ConvexHull2D::PointArrayType points(getCount(2 * sizeof(double)));
+            for (ConvexHull2D::PointType& p : points)
+            {
+              p[0] = get<double>();
+              p[1] = get<double>();
+            }
+            hull.setHullPoints(points);
+          }
+          feature.setConvexHulls(hulls);
+          getPeptideIdentifications(feature.getPeptideIdentifications());
+          getMetaInfo(feature);
+          getFeatures(feature.getSubordinates());
+        }
+      }
+
+      void getConsensusFeatures(ConsensusMap& map)
+      {
+        // 7 columns with a total of 40 bytes per feature
+        Size n = getCount64(40);
+        std::vector<double> rt, mz;
+        std::vector<float> intensity, quality, width;
+        std::vector<Int32> charge;
+        std::vector<UInt64> unique_id;
+        getColumn(rt, n);
+        getColumn(mz, n);
+        getColumn(intensity, n);
+        getColumn(quality, n);
+        getColumn(charge, n);
+        getColumn(width, n);
+        getColumn(unique_id, n);
+
+        map.resize(n);
+        for (Size i = 0; i < n; ++i)
+        {
+          ConsensusFeature& feature = map[i];
+          feature.setRT(rt[i]);
+          feature.setMZ(mz[i]);
+          feature.setIntensity(intensity[i]);
+          feature.setQuality(quality[i]);
+          feature.setCharge(charge[i]);
+          feature.setWidth(width[i]);
+          feature.setUniqueId(unique_id[i]);
+
+          Size handles = getCount(sizeof(UInt64));
+          for (Size k = 0; k < handles; ++k)
+          {
+            FeatureHandle handle;
+            handle.setMapIndex(get<UInt64>());
+            handle.setUniqueId(get<UInt64>());
+            handle.setRT(get<double>());
+            handle.setMZ(get<double>());
+            handle.setIntensity(get<float>());
+            handle.setCharge(get<Int32>());
+            handle.setWidth(get<float>());
+            feature.insert(handle);
+          }
+          std::vector<ConsensusFeature::Ratio>& ratios = feature.getRatios();
+          ratios.resize(getCount(sizeof(double)));
+          for (ConsensusFeature::Ratio& ratio : ratios)
+          {
+            ratio.ratio_value_ = get<double>();
+            ratio.denominator_ref_ = getString();
+            ratio.numerator_ref_ = getString();
+            getStrings(ratio.description_);
+          }
+          getPeptideIdentifications(feature.getPeptideIdentifications());
+          getMetaInfo(feature);
+        }
+      }
+
+  private:
+      void require_(Size bytes) const
+      {
+        if (Size(end_ - pos_) < bytes)
+        {
+          fail_("unexpected end of data");
+        }
+      }
+
+      /// checks that @p n elements of @p element_size bytes remain (without overflowing the product)
+      void requireElements_(UInt64 n, Size element_size) const
+      {
+        if (element_size > 0 && n > UInt64(end_ - pos_) / element_size)
+        {
+          fail_("unexpected end of data");
+        }
+      }
+
+      void fail_(const String& message) const
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename_, "Not a valid binary container: " + message);
+      }
+
+      String filename_;
+      boost::iostreams::mapped_file_source file_;
+      FileHeader header_;
+      const char* begin_ = nullptr;
+      const char* end_ = nullptr;
+      const char* body_end_ = nullptr;
+      const char* pos_ = nullptr;
+      /// position and length of each string in the mapping
+      std::vector<std::pair<const char*, UInt32> > string_pos_;
+      /// strings decoded so far
+      std::vector<String> strings_;
+      std::vector<bool> decoded_;
+      /// MetaInfoRegistry index of strings used as meta value keys
+      std::vector<UInt> meta_index_;
+    };
+  }
+
+  OMSBinFile::OMSBinFile() :
+    ProgressLogger()
+  {
+  }
+
+  OMSBinFile::~OMSBinFile()
+  {
+  }
+
+  OMSBinFile::ContentType OMSBinFile::getContentType(const String& filename)
+  {
+    return BinaryReader(filename).getContentType();
+  }
+
+  void OMSBinFile::load(const String& filename, FeatureMap& map)
+  {
+    startProgress(0, 1, "loading binary feature map");
+    BinaryReader reader(filename);
+    reader.expectContent(FEATURES);
+
+    map.clear(true);
+    reader.getMapHeader(map);
+    reader.getFeatures(map);
+    map.setLoadedFileType(filename);
+    map.setLoadedFilePath(filename);
+    map.updateRanges();
+    endProgress();
+  }
+
+  void OMSBinFile::store(const String& filename, const FeatureMap& map)
+  {
+    startProgress(0, 1, "storing binary feature map");
+    BinaryWriter writer(filename, FEATURES);
+    writer.putMapHeader(map);
+    writer.putFeatures(map);
+    writer.finish();
+    endProgress();
+  }
+
+  void OMSBinFile::load(const String& filename, ConsensusMap& map)
+  {
+    startProgress(0, 1, "loading binary consensus map");
+    BinaryReader reader(filename);
+    reader.expectContent(CONSENSUS);
+
+    map.clear(true);
+    reader.getMapHeader(map);
+    map.setExperimentType(reader.getString());
+    Size headers = reader.getCount(sizeof(UInt64));
+    for (Size i = 0; i < headers; ++i)
+    {
+      UInt64 key = reader.get<UInt64>();
+      ConsensusMap::ColumnHeader& header = map.getColumnHeaders()[key];
+      header.filename = reader.getString();
+      header.label = reader.getString();
+      header.size = reader.get<UInt64>();
+      header.unique_id = reader.get<UInt64>();
+      reader.getMetaInfo(header);
+    }
+    reader.getConsensusFeatures(map);
+    map.setLoadedFileType(filename);
+    map.setLoadedFilePath(filename);
+    map.updateRanges();
+    endProgress();
+  }
+
+  void OMSBinFile::store(const String& filename, const ConsensusMap& map)
+  {
+    startProgress(0, 1, "storing binary consensus map");
+    BinaryWriter writer(filename, CONSENSUS);
+    writer.putMapHeader(map);
+    writer.putString(map.getExperimentType());
+    writer.put<UInt32>(map.getColumnHeaders().size());
+    for (const auto& column : map.getColumnHeaders())
+    {
+      writer.put<UInt64>(column.first);
+      writer.putString(column.second.filename);
+      writer.putString(column.second.label);
+      writer.put<UInt64>(column.second.size);
+      writer.put<UInt64>(column.second.unique_id);
+      writer.putMetaInfo(column.second);
+    }
+    writer.putConsensusFeatures(map);
+    writer.finish();
+    endProgress();
+  }
+
+  void OMSBinFile::load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids)
+  {
+    startProgress(0, 1, "loading binary identifications");
+    BinaryReader reader(filename);
+    reader.expectContent(IDENTIFICATIONS);
+
+    protein_ids.clear();
+    peptide_ids.clear();
+    reader.getProteinIdentifications(protein_ids);
+    reader.getPeptideIdentifications(peptide_ids);
+    endProgress();
+  }
+
+  void OMSBinFile::store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids)
+  {
+    startProgress(0, 1, "storing binary identifications");
+    BinaryWriter writer(filename, IDENTIFICATIONS);
+    writer.putProteinIdentifications(protein_ids);
+    writer.putPeptideIdentifications(peptide_ids);
+    writer.finish();
+    endProgress();
+  }
+
+} // namespace OpenMS
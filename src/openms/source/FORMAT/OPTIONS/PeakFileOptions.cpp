@@ -63,6 +63,8 @@ namespace OpenMS
     np_config_int_(),
     np_config_fda_(),
     maximal_data_pool_size_(100),
+    pipeline_queue_depth_(100),
+    pipeline_memory_cap_(256 * 1024 * 1024),
     precursor_mz_selected_ion_(true)
   {
   }
@@ -92,6 +94,8 @@ namespace OpenMS
     np_config_int_(options.np_config_int_),
     np_config_fda_(options.np_config_fda_),
     maximal_data_pool_size_(options.maximal_data_pool_size_),
+    pipeline_queue_depth_(options.pipeline_queue_depth_),
+    pipeline_memory_cap_(options.pipeline_memory_cap_),
     precursor_mz_selected_ion_(options.precursor_mz_selected_ion_)
   {
   }
@@ -352,6 +356,26 @@ namespace OpenMS
     maximal_data_pool_size_ = size;
   }
 
+  Size PeakFileOptions::getPipelineQueueDepth() const
+  {
+    return pipeline_queue_depth_;
+  }
+
+  void PeakFileOptions::setPipelineQueueDepth(Size depth)
+  {
+    pipeline_queue_depth_ = depth;
+  }
+
+  Size PeakFileOptions::getPipelineMemoryCap() const
+  {
+    return pipeline_memory_cap_;
+  }
+
+  void PeakFileOptions::setPipelineMemoryCap(Size bytes)
+  {
+    pipeline_memory_cap_ = bytes;
+  }
+
   bool PeakFileOptions::getPrecursorMZSelectedIon() const
   {
     return precursor_mz_selected_ion_;
@@ -42,6 +42,7 @@
 
 #include <OpenMS/FORMAT/CompressedInputSource.h>
 
+#include <xercesc/framework/XMLPScanToken.hpp>
 #include <xercesc/sax2/SAX2XMLReader.hpp>
 #include <xercesc/framework/LocalFileInputSource.hpp>
 #include <xercesc/framework/MemBufInputSource.hpp>
@@ -79,6 +80,47 @@ private:
       XMLHandler * p_;
     };
 
+    /// Input source for @p filename (bzip2 and gzip compressed files are supported)
+    static boost::shared_ptr< xercesc::InputSource > createInputSource_(const String & filename, const String & enforced_encoding)
+    {
+      StringManager sm;
+
+      // peak ahead into the file: is it bzip2 or gzip compressed?
+      String bz;
+      {
+        std::ifstream file(filename.c_str());
+        char tmp_bz[3];
+        file.read(tmp_bz, 2);
+        tmp_bz[2] = '\0';
+        bz = String(tmp_bz);
+      }
+
+      boost::shared_ptr< xercesc::InputSource > source;
+
+      char g1 = 0x1f;
+      char g2 = 0;
+      g2 |= 1 << 7;
+      g2 |= 1 << 3;
+      g2 |= 1 << 1;
+      g2 |= 1 << 0;
+      //g2 = static_cast<char>(0x8b); // can make troubles if it is casted to 0x7F which is the biggest number signed char can save
+      if ((bz[0] == 'B' && bz[1] == 'Z') || (bz[0] == g1 && bz[1] == g2))
+      {
+        source.reset(new CompressedInputSource(sm.convert(filename).c_str(), bz));
+      }
+      else
+      {
+        source.reset(new xercesc::LocalFileInputSource(sm.convert(filename).c_str()));
+      }
+      // what if no encoding given http://xerces.apache.org/xerces-c/apiDocs-3/classInputSource.html
+      if (!enforced_encoding.empty())
+      {
+        static const XMLCh* s_enc = xercesc::XMLString::transcode(enforced_encoding.c_str());
+        source->setEncoding(s_enc);
+      }
+      return source;
+    }
+
     XMLFile::XMLFile()
     {
     }
@@ -104,7 +146,6 @@ private:
       // reader, e.g. FeatureXMLFile, is used again)
       XMLCleaner_ clean(handler);
 
-      StringManager sm;
       //try to open file
       if (!File::exists(filename))
       {
@@ -129,39 +170,8 @@ private:
       parser->setContentHandler(handler);
       parser->setErrorHandler(handler);
 
-      // peak ahead into the file: is it bzip2 or gzip compressed?
-      String bz;
-      {
-        std::ifstream file(filename.c_str());
-        char tmp_bz[3];
-        file.read(tmp_bz, 2);
-        tmp_bz[2] = '\0';
-        bz = String(tmp_bz);
-      }
-
-      boost::shared_ptr< xercesc::InputSource > source;
+      boost::shared_ptr< xercesc::InputSource > source = createInputSource_(filename, enforced_encoding_);
 
-      char g1 = 0x1f;
-      char g2 = 0;
-      g2 |= 1 << 7;
-      g2 |= 1 << 3;
-      g2 |= 1 << 1;
-      g2 |= 1 << 0;
-      //g2 = static_cast<char>(0x8b); // can make troubles if it is casted to 0x7F which is the biggest number signed char can save
-      if ((bz[0] == 'B' && bz[1] == 'Z') || (bz[0] == g1 && bz[1] == g2))
-      {
-        source.reset(new CompressedInputSource(sm.convert(filename).c_str(), bz));
-      }
-      else
-      {
-        source.reset(new xercesc::LocalFileInputSource(sm.convert(filename).c_str()));
-      }
-      // what if no encoding given http://xerces.apache.org/xerces-c/apiDocs-3/classInputSource.html
-      if (!enforced_encoding_.empty())
-      {
-        static const XMLCh* s_enc = xercesc::XMLString::transcode(enforced_encoding_.c_str());
-        source->setEncoding(s_enc);
-      }
       // try to parse file
       try
       {
@@ -189,6 +199,86 @@ private:
       }
     }
 
+    void XMLFile::parseProgressive_(const String & filename, XMLHandler * handler, const std::function<bool(const std::function<bool()>&)>& step)
+    {
+      // ensure handler->reset() is called to save memory (in case the XMLFile
+      // reader, e.g. FeatureXMLFile, is used again)
+      XMLCleaner_ clean(handler);
+
+      //try to open file
+      if (!File::exists(filename))
+      {
+        throw Exception::FileNotFound(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+      }
+
+      // initialize parser
+      try
+      {
+        xercesc::XMLPlatformUtils::Initialize();
+      }
+      catch (const xercesc::XMLException & toCatch)
+      {
+        throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION,
+            "", String("Error during initialization: ") + StringManager().convert(toCatch.getMessage()));
+      }
+
+      boost::shared_ptr< xercesc::SAX2XMLReader > parser(xercesc::XMLReaderFactory::createXMLReader());
+      parser->setFeature(xercesc::XMLUni::fgSAX2CoreNameSpaces, false);
+      parser->setFeature(xercesc::XMLUni::fgSAX2CoreNameSpacePrefixes, false);
+
+      parser->setContentHandler(handler);
+      parser->setErrorHandler(handler);
+
+      boost::shared_ptr< xercesc::InputSource > source = createInputSource_(filename, enforced_encoding_);
+
+      xercesc::XMLPScanToken token;
+      bool started = false;
+      bool finished = false;
+      // parses the next token, returns false once the document is done
+      std::function<bool()> parse_next = [&]()
+      {
+        if (finished) return false;
+        try
+        {
+          if (!started)
+          {
+            started = true;
+            finished = !parser->parseFirst(*source, token);
+          }
+          else
+          {
+            finished = !parser->parseNext(token);
+          }
+        }
+        catch (const xercesc::XMLException & toCatch)
+        {
+          finished = true;
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "",
+              String("XMLException: ") + StringManager().convert(toCatch.getMessage()));
+        }
+        catch (const xercesc::SAXException & toCatch)
+        {
+          finished = true;
+          throw Exception::ParseError(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "",
+              String("SAXException: ") + StringManager().convert(toCatch.getMessage()));
+        }
+        catch (const XMLHandler::EndParsingSoftly & /*toCatch*/)
+        {
+          // parsing was softly aborted by the handler
+          finished = true;
+        }
+        return !finished;
+      };
+
+      while (step(parse_next)) {}
+
+      // the caller stopped early: release the scanner for the next parse
+      if (started && !finished)
+      {
+        parser->parseReset(token);
+      }
+    }
+
     void XMLFile::parseBuffer_(const std::string & buffer, XMLHandler * handler)
     {
       // ensure handler->reset() is called to save memory (in case the XMLFile
@@ -52,6 +52,7 @@ MzQuantMLFile.cpp
 MzTab.cpp
 MzTabFile.cpp
 MzXMLFile.cpp
+OMSBinFile.cpp
 OMSSACSVFile.cpp
 OMSSAXMLFile.cpp
 OSWFile.cpp
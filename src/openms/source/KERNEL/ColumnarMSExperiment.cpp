@@ -0,0 +1,189 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/KERNEL/ColumnarMSExperiment.h>
+
+#include <algorithm>
+
+namespace OpenMS
+{
+
+  ColumnarMSExperiment::ColumnarMSExperiment() :
+    offsets_(1, 0)
+  {
+  }
+
+  ColumnarMSExperiment::ColumnarMSExperiment(const PeakMap& exp) :
+    offsets_(1, 0)
+  {
+    Size nr_peaks = 0;
+    for (const MSSpectrum& spectrum : exp)
+    {
+      nr_peaks += spectrum.size();
+    }
+    reserve(exp.size(), nr_peaks);
+    for (const MSSpectrum& spectrum : exp)
+    {
+      addSpectrum(spectrum);
+    }
+  }
+
+  bool ColumnarMSExperiment::operator==(const ColumnarMSExperiment& rhs) const
+  {
+    if (size() != rhs.size() || mz_ != rhs.mz_ || intensity_ != rhs.intensity_ ||
+        offsets_ != rhs.offsets_ || native_ids_ != rhs.native_ids_)
+    {
+      return false;
+    }
+    for (Size i = 0; i < meta_.size(); ++i)
+    {
+      const SpectrumMeta& a = meta_[i];
+      const SpectrumMeta& b = rhs.meta_[i];
+      if (a.rt != b.rt || a.drift_time != b.drift_time || a.precursor_mz != b.precursor_mz ||
+          a.precursor_charge != b.precursor_charge || a.ms_level != b.ms_level || a.type != b.type)
+      {
+        return false;
+      }
+    }
+    return true;
+  }
+
+  void ColumnarMSExperiment::reserve(Size nr_spectra, Size nr_peaks)
+  {
+    mz_.reserve(nr_peaks);
+    intensity_.reserve(nr_peaks);
+    offsets_.reserve(nr_spectra + 1);
+    meta_.reserve(nr_spectra);
+    native_ids_.reserve(nr_spectra);
+  }
+
+  void ColumnarMSExperiment::addSpectrum(const MSSpectrum& spectrum)
+  {
+    for (const Peak1D& peak : spectrum)
+    {
+      mz_.push_back(peak.getMZ());
+      intensity_.push_back(peak.getIntensity());
+    }
+    offsets_.push_back(mz_.size());
+
+    SpectrumMeta meta;
+    meta.rt = spectrum.getRT();
+    meta.drift_time = spectrum.getDriftTime();
+    meta.ms_level = spectrum.getMSLevel();
+    meta.type = spectrum.getType();
+    if (!spectrum.getPrecursors().empty())
+    {
+      meta.precursor_mz = spectrum.getPrecursors()[0].getMZ();
+      meta.precursor_charge = spectrum.getPrecursors()[0].getCharge();
+    }
+    meta_.push_back(meta);
+    native_ids_.push_back(spectrum.getNativeID());
+  }
+
+  void ColumnarMSExperiment::clear(bool clear_memory)
+  {
+    if (clear_memory)
+    {
+      ColumnarMSExperiment empty;
+      std::swap(*this, empty);
+      return;
+    }
+    mz_.clear();
+    intensity_.clear();
+    offsets_.assign(1, 0);
+    meta_.clear();
+    native_ids_.clear();
+  }
+
+  ColumnarMSExperiment::SpectrumView ColumnarMSExperiment::getSpectrumView(Size index) const
+  {
+    if (index >= size())
+    {
+      throw Exception::IndexOverflow(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, index, size());
+    }
+    return (*this)[index];
+  }
+
+  MSSpectrum ColumnarMSExperiment::getSpectrum(Size index) const
+  {
+    const SpectrumView view = getSpectrumView(index);
+
+    MSSpectrum spectrum;
+    spectrum.reserve(view.size());
+    for (Size i = 0; i < view.size(); ++i)
+    {
+      spectrum.emplace_back(view.getMZ(i), view.getIntensity(i));
+    }
+    copySpectrumMeta(index, spectrum);
+    return spectrum;
+  }
+
+  void ColumnarMSExperiment::copySpectrumMeta(Size index, MSSpectrum& spectrum) const
+  {
+    const SpectrumView view = getSpectrumView(index);
+
+    spectrum.setRT(view.getRT());
+    spectrum.setDriftTime(view.getDriftTime());
+    spectrum.setMSLevel(view.getMSLevel());
+    spectrum.setType(view.getType());
+    spectrum.setNativeID(view.getNativeID());
+    std::vector<Precursor> precursors;
+    if (view.getMSLevel() > 1 || view.getPrecursorMZ() != 0.0)
+    {
+      Precursor precursor;
+      precursor.setMZ(view.getPrecursorMZ());
+      precursor.setCharge(view.getPrecursorCharge());
+      precursors.push_back(precursor);
+    }
+    spectrum.setPrecursors(precursors);
+  }
+
+  void ColumnarMSExperiment::toExperiment(PeakMap& exp) const
+  {
+    exp.clear(true);
+    exp.reserveSpaceSpectra(size());
+    for (Size i = 0; i < size(); ++i)
+    {
+      exp.addSpectrum(getSpectrum(i));
+    }
+    exp.updateRanges();
+  }
+
+  Size ColumnarMSExperiment::RTBegin(double rt) const
+  {
+    return std::lower_bound(meta_.begin(), meta_.end(), rt,
+                            [](const SpectrumMeta& meta, double value) { return meta.rt < value; }) - meta_.begin();
+  }
+
+} // namespace OpenMS
@@ -27,6 +27,7 @@ StandardTypes.cpp
 ChromatogramPeak.cpp
 MSChromatogram.cpp
 ChromatogramTools.cpp
+ColumnarMSExperiment.cpp
 SpectrumHelper.cpp
 )
 
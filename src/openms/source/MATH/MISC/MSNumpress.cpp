@@ -34,6 +34,7 @@
 #include <climits>
 #include <cmath>
 #include <iostream>
+#include <vector>
 #include <OpenMS/MATH/MISC/MSNumpress.h>
 
 
@@ -151,58 +152,61 @@ static void encodeInt(
 
 
 /**
- * Decodes an int from the half bytes in bp. Lossless reverse of encodeInt 
+ * Splits the bytes in data into half bytes, high half byte first. The 
+ * decoders then address half byte i as halfBytes[i] instead of tracking 
+ * which half of the current byte comes next, and the split itself is a 
+ * branch-free loop the compiler can vectorize.
  */
-static void decodeInt(
+static void unpackHalfBytes(
 		const unsigned char *data,
-		size_t *di,
-		size_t max_di,
-		size_t *half,
-		unsigned int *res
+		size_t dataSize,
+		std::vector<unsigned char> &halfBytes
 ) {
-    size_t n, i;
-    unsigned int mask, m;
-    unsigned char head;
-    unsigned char hb;
-
-	if (*half == 0) {
-		head = data[*di] >> 4;
-	} else {
-		head = data[*di] & 0xf;
-		(*di)++;
+	halfBytes.resize(dataSize * 2);
+	unsigned char *hb = halfBytes.data();
+	for (size_t i=0; i<dataSize; i++) {
+		hb[2*i]   = data[i] >> 4;
+		hb[2*i+1] = data[i] & 0xf;
 	}
+}
+
+
+
+/**
+ * Decodes an int from the unpacked half bytes hb (see unpackHalfBytes), 
+ * starting at *hi, which is advanced past the int. Lossless reverse of 
+ * encodeInt.
+ */
+static void decodeInt(
+		const unsigned char *hb,
+		size_t *hi,
+		size_t max_hi,
+		unsigned int *res
+) {
+	size_t n, i;
+	unsigned char head = hb[(*hi)++];
 
-	*half = 1-(*half);
 	*res = 0;
-	
+
 	if (head <= 8) {
 		n = head;
 	} else { // leading ones, fill n half bytes in res
 		n = head - 8;
-		mask = 0xf0000000;
 		for (i=0; i<n; i++) {
-			m = mask >> (4*i);
-			*res = *res | m;
+			*res = *res | (0xf0000000 >> (4*i));
 		}
 	}
-	
+
 	if (n == 8) {
 		return;
 	}
-	
-	if (*di + ((8 - n) - (1 - *half)) / 2 >= max_di) {
+
+	if (*hi + (8 - n) > max_hi) {
 		throw "[MSNumpress::decodeInt] Corrupt input data! ";
 	}
-	
+
 	for (i=n; i<8; i++) {
-		if (*half == 0) {
-			hb = data[*di] >> 4;
-		} else {
-			hb = data[*di] & 0xf;
-			(*di)++;
-		}
-		*res = *res | ( static_cast<unsigned int>(hb) << ((i-n)*4));
-		*half = 1 - (*half);
+		*res = *res | ( static_cast<unsigned int>(hb[(*hi)++]) << ((i-n)*4));
 	}
 }
 
@@ -370,8 +374,8 @@ size_t decodeLinear(
 	int diff;
 	long long ints[3];
 	//double d;
-	size_t di;
-	size_t half;
+	std::vector<unsigned char> halfBytes;
+	size_t hi, hbSize;
 	long long extrapol;
 	long long y;
 	double fixedPoint;
@@ -405,23 +409,23 @@ size_t decodeLinear(
 	}
 	result[1] = ints[2] / fixedPoint;
 		
-	half = 0;
+	unpackHalfBytes(&data[16], dataSize - 16, halfBytes);
+	hbSize = halfBytes.size();
 	ri = 2;
-	di = 16;
+	hi = 0;
 	
-	//printf("   di     ri      half    int[0]    int[1]    extrapol   diff\n");
+	//printf("   hi     ri    int[0]    int[1]    extrapol   diff\n");
 	
-	while (di < dataSize) {
-		if (di == (dataSize - 1) && half == 1) {
-			if ((data[di] & 0xf) == 0x0) {
-				break;
-			}
+	while (hi < hbSize) {
+		// a zero in the very last half byte is padding
+		if (hi == (hbSize - 1) && halfBytes[hi] == 0x0) {
+			break;
 		}
-		//printf("%7d %7d %7d %lu %lu %ld", di, ri, half, ints[0], ints[1], extrapol);
+		//printf("%7d %7d %lu %lu %ld", hi, ri, ints[0], ints[1], extrapol);
 		
 		ints[0] = ints[1];
 		ints[1] = ints[2];
-		decodeInt(data, &di, dataSize, &half, &buff);
+		decodeInt(halfBytes.data(), &hi, hbSize, &buff);
 		diff = static_cast<int>(buff);
 
 		extrapol = ints[1] + (ints[1] - ints[0]);
@@ -622,25 +626,25 @@ size_t decodePic(
 ) {
 	size_t ri;
 	unsigned int x;
-	size_t di;
-	size_t half;
+	std::vector<unsigned char> halfBytes;
+	size_t hi, hbSize;
 
-	//printf("ri      di      half    dSize   count\n");
+	//printf("ri      hi      hbSize   count\n");
 	
-	half = 0;
+	unpackHalfBytes(data, dataSize, halfBytes);
+	hbSize = halfBytes.size();
 	ri = 0;
-	di = 0;
+	hi = 0;
 	
-	while (di < dataSize) {
-		if (di == (dataSize - 1) && half == 1) {
-			if ((data[di] & 0xf) == 0x0) {
-				break;
-			}
+	while (hi < hbSize) {
+		// a zero in the very last half byte is padding
+		if (hi == (hbSize - 1) && halfBytes[hi] == 0x0) {
+			break;
 		}
 		
-		decodeInt(&data[0], &di, dataSize, &half, &x);
+		decodeInt(halfBytes.data(), &hi, hbSize, &x);
 		
-		//printf("%7d %7d %7d %7d %7d\n", ri, di, half, dataSize, count);
+		//printf("%7d %7d %7d %7d\n", ri, hi, hbSize, count);
 		
 		//printf("count: %d \n", count);
 		result[ri++] = static_cast<double>(x);
@@ -737,21 +741,25 @@ size_t decodeSlof(
 		const size_t dataSize, 
 		double *result
 ) {
-	size_t i, ri;
+	size_t ri, valueCount;
 	unsigned short x;
 	double fixedPoint;
+	const unsigned char *values;
 
 	if (dataSize < 8) 
 		throw "[MSNumpress::decodeSlof] Corrupt input data: not enough bytes to read fixed point! ";
 	
-	ri = 0;
 	fixedPoint = decodeFixedPoint(data);
 
-	for (i=8; i<dataSize; i+=2) {
-		x = static_cast<unsigned short>(data[i] | (data[i+1] << 8));
-		result[ri++] = exp(x / fixedPoint) - 1;
+	// indexed loop over complete 2-byte values only (a trailing odd byte 
+	// used to be read past the end of the input)
+	values = data + 8;
+	valueCount = (dataSize - 8) / 2;
+	for (ri=0; ri<valueCount; ri++) {
+		x = static_cast<unsigned short>(values[2*ri] | (values[2*ri+1] << 8));
+		result[ri] = exp(x / fixedPoint) - 1;
 	}
-	return ri;
+	return valueCount;
 }
 
 
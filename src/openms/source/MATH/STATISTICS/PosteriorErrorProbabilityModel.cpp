@@ -49,14 +49,35 @@
 
 #include <algorithm>
 
-
-
 using namespace std;
 
 namespace OpenMS
 {
   namespace Math
   {
+    namespace
+    {
+      /// below this number of scores, the per-score loops of the EM algorithm are not worth a parallel region
+      const SignedSize MIN_PARALLEL_SCORES = 10000;
+
+      /**
+        @brief Picks every k-th score of the sorted @p x_scores such that at most @p max_size scores remain
+
+        Sorted input is kept sorted and the quantiles of the subsample follow the ones of the input,
+        which makes it a deterministic stand-in for the full data in the first EM rounds.
+      */
+      void stridedSubsample_(const vector<double>& x_scores, Size max_size, vector<double>& subsample)
+      {
+        const double stride = static_cast<double>(x_scores.size()) / max_size;
+        subsample.clear();
+        subsample.reserve(max_size);
+        for (Size i = 0; i < max_size; ++i)
+        {
+          subsample.push_back(x_scores[static_cast<Size>(i * stride)]);
+        }
+      }
+    }
+
     PosteriorErrorProbabilityModel::PosteriorErrorProbabilityModel() :
       DefaultParamHandler("PosteriorErrorProbabilityModel"),
       incorrectly_assigned_fit_param_(GaussFitter::GaussFitResult(-1, -1, -1)),
@@ -76,6 +97,8 @@ namespace OpenMS
                                                                    "- ignore_extreme_percentiles: ignore everything outside 99th and 1st percentile (also removes equal values like potential censored max values in XTandem)\n"
                                                                    "- none: do nothing");
       defaults_.setValidStrings("outlier_handling", {"ignore_iqr_outliers","set_iqr_to_closest_valid","ignore_extreme_percentiles","none"});
+      defaults_.setValue("max_subsample_size", 0, "If more scores than this are given, the EM algorithm is first run on an evenly spaced subsample of the sorted scores of this size and then continued on all scores until the convergence criterion is met. Speeds up fitting of very large data sets (0 = always use all scores).", ListUtils::create<String>("advanced"));
+      defaults_.setMinInt("max_subsample_size", 0);
       defaultsToParam_();
       getNegativeGnuplotFormula_ = &PosteriorErrorProbabilityModel::getGumbelGnuplotFormula;
       getPositiveGnuplotFormula_ = &PosteriorErrorProbabilityModel::getGaussGnuplotFormula;
@@ -146,99 +169,122 @@ namespace OpenMS
       int delta = param_.getValue("neg_log_delta");
       int itns = 0;
 
-      vector<double> incorrect_log_density, correct_log_density;
-      fillLogDensitiesGumbel(x_scores, incorrect_log_density, correct_log_density);
-      vector<double> bins;
-      vector<double> incorrect_posteriors;
-      double maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-      double sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
-      double sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
+      // with subsampling enabled, the EM starts on a subsample and is then refined on all scores
+      vector<double> subsample;
+      vector<const vector<double>*> em_rounds;
+      Size max_subsample_size = (Int)param_.getValue("max_subsample_size");
+      if (max_subsample_size > 0 && x_scores.size() > max_subsample_size)
+      {
+        stridedSubsample_(x_scores, max_subsample_size, subsample);
+        em_rounds.push_back(&subsample);
+      }
+      em_rounds.push_back(&x_scores);
 
       OpenMS::Math::GumbelMaxLikelihoodFitter gmlf{incorrectly_assigned_fit_gumbel_param_};
 
-      do
+      for (const vector<double>* em_scores : em_rounds)
       {
-        //-------------------------------------------------------------
-        // E-STEP (gauss)
-        double newGaussMean = 0.0;
-        auto the_x = x_scores.cbegin();
-
-        for (auto incorrect = incorrect_posteriors.cbegin(); incorrect != incorrect_posteriors.cend(); ++incorrect, ++the_x)
-        {
-          newGaussMean += (1.-*incorrect) * *the_x;
-        }
-        newGaussMean /= sumCorrectPosteriors;
-
-        double newGaussSigma = 0.0;
-        the_x = x_scores.cbegin();
-
-        for (auto incorrect = incorrect_posteriors.cbegin(); incorrect != incorrect_posteriors.cend(); ++incorrect, ++the_x)
+        const vector<double>& scores = *em_scores;
+        const SignedSize n = scores.size();
+        // plot only the iterations on the full data
+        const bool plot_iterations = output_plots && em_scores == &x_scores;
+        stop_em_init = false;
+        itns = 0;
+
+        vector<double> incorrect_log_density, correct_log_density;
+        fillLogDensitiesGumbel(scores, incorrect_log_density, correct_log_density);
+        vector<double> incorrect_posteriors;
+        double maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
+        double sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
+        double sumCorrectPosteriors = scores.size() - sumIncorrectPosteriors;
+
+        do
         {
-          newGaussSigma += (1. - *incorrect) * pow((*the_x) - newGaussMean, 2);
-        }
-        newGaussSigma = sqrt(newGaussSigma/sumCorrectPosteriors);
+          //-------------------------------------------------------------
+          // E-STEP (gauss)
+          double newGaussMean = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+: newGaussMean) if (n > MIN_PARALLEL_SCORES)
+#endif
+          for (SignedSize i = 0; i < n; ++i)
+          {
+            newGaussMean += (1. - incorrect_posteriors[i]) * scores[i];
+          }
+          newGaussMean /= sumCorrectPosteriors;
 
-        GumbelMaxLikelihoodFitter::GumbelDistributionFitResult newGumbelParams = gmlf.fitWeighted(x_scores, incorrect_posteriors);
+          double newGaussSigma = 0.0;
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+: newGaussSigma) if (n > MIN_PARALLEL_SCORES)
+#endif
+          for (SignedSize i = 0; i < n; ++i)
+          {
+            const double diff = scores[i] - newGaussMean;
+            newGaussSigma += (1. - incorrect_posteriors[i]) * diff * diff;
+          }
+          newGaussSigma = sqrt(newGaussSigma/sumCorrectPosteriors);
 
-        if (newGumbelParams.b <= 0 || std::isnan(newGumbelParams.b))
-        {
-          OPENMS_LOG_WARN << "Warning: encountered impossible standard deviations. Aborting fit." << std::endl;
-          break;
-        }
+          GumbelMaxLikelihoodFitter::GumbelDistributionFitResult newGumbelParams = gmlf.fitWeighted(scores, incorrect_posteriors);
 
-        // update parameters
-        correctly_assigned_fit_param_.x0 = newGaussMean;
-        correctly_assigned_fit_param_.sigma = newGaussSigma;
-        correctly_assigned_fit_param_.A = 1 / sqrt(2 * Constants::PI * pow(newGaussSigma, 2));
+          if (newGumbelParams.b <= 0 || std::isnan(newGumbelParams.b))
+          {
+            OPENMS_LOG_WARN << "Warning: encountered impossible standard deviations. Aborting fit." << std::endl;
+            break;
+          }
 
-        incorrectly_assigned_fit_gumbel_param_ = newGumbelParams;
+          // update parameters
+          correctly_assigned_fit_param_.x0 = newGaussMean;
+          correctly_assigned_fit_param_.sigma = newGaussSigma;
+          correctly_assigned_fit_param_.A = 1 / sqrt(2 * Constants::PI * pow(newGaussSigma, 2));
 
+          incorrectly_assigned_fit_gumbel_param_ = newGumbelParams;
 
-        // compute new prior probabilities negative peptides
-        fillLogDensitiesGumbel(x_scores, incorrect_log_density, correct_log_density);
-        double new_maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-        sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
-        sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
-        negative_prior_ = sumIncorrectPosteriors / x_scores.size();
 
-        if (std::isnan(new_maxlike - maxlike))
-        {
-          OPENMS_LOG_WARN << "Numerical instabilities. Aborting." << endl;
-          return false;
-        }
+          // compute new prior probabilities negative peptides
+          fillLogDensitiesGumbel(scores, incorrect_log_density, correct_log_density);
+          double new_maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
+          sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
+          sumCorrectPosteriors = scores.size() - sumIncorrectPosteriors;
+          negative_prior_ = sumIncorrectPosteriors / scores.size();
 
-        // check termination criterium
-        if ((new_maxlike - maxlike) < pow(10.0, -delta) || itns >= max_itns)
-        {
-          if (itns >= max_itns)
+          if (std::isnan(new_maxlike - maxlike))
           {
-            OPENMS_LOG_WARN << "Number of iterations exceeded. Convergence criterion not met. Last log likelihood increase: " << (new_maxlike - maxlike) << endl;
-            OPENMS_LOG_WARN << "Algorithm returns probabilities for suboptimal fit. You might want to try raising the max. number of iterations and have a look at the distribution." << endl;
+            OPENMS_LOG_WARN << "Numerical instabilities. Aborting." << endl;
+            return false;
           }
-          stop_em_init = true;
-          good_fit = true;
-        }
-        else if (new_maxlike < maxlike)
+
+          // check termination criterium
+          if ((new_maxlike - maxlike) < pow(10.0, -delta) || itns >= max_itns)
           {
-            OPENMS_LOG_WARN << "Log Likelihood of fit decreased: " << (new_maxlike - maxlike) << ". Abort fitting. Please check"
-                                                                                                 " the gnuplot scripts and adapt search engine settings or outlier settings of IDPEP."<< endl;
+            if (itns >= max_itns)
+            {
+              OPENMS_LOG_WARN << "Number of iterations exceeded. Convergence criterion not met. Last log likelihood increase: " << (new_maxlike - maxlike) << endl;
+              OPENMS_LOG_WARN << "Algorithm returns probabilities for suboptimal fit. You might want to try raising the max. number of iterations and have a look at the distribution." << endl;
+            }
             stop_em_init = true;
-            good_fit = false;
+            good_fit = true;
           }
+          else if (new_maxlike < maxlike)
+            {
+              OPENMS_LOG_WARN << "Log Likelihood of fit decreased: " << (new_maxlike - maxlike) << ". Abort fitting. Please check"
+                                                                                                   " the gnuplot scripts and adapt search engine settings or outlier settings of IDPEP."<< endl;
+              stop_em_init = true;
+              good_fit = false;
+            }
 
-        if (output_plots)
-        {
-          String formula1, formula2, formula3;
-          formula1 = ((this)->*(getNegativeGnuplotFormula_))(incorrectly_assigned_fit_param_) + "* " + String(negative_prior_); //String(incorrectly_assigned_fit_param_.A) +" * exp(-(x - " + String(incorrectly_assigned_fit_param_.x0) + ") ** 2 / 2 / (" + String(incorrectly_assigned_fit_param_.sigma) + ") ** 2)"+ "*" + String(negative_prior_);
-          formula2 = ((this)->*(getPositiveGnuplotFormula_))(correctly_assigned_fit_param_) + "* (1 - " + String(negative_prior_) + ")"; //String(correctly_assigned_fit_param_.A) +" * exp(-(x - " + String(correctly_assigned_fit_param_.x0) + ") ** 2 / 2 / (" + String(correctly_assigned_fit_param_.sigma) + ") ** 2)"+ "* (1 - " + String(negative_prior_) + ")";
-          formula3 = getBothGnuplotFormula(incorrectly_assigned_fit_param_, correctly_assigned_fit_param_);
-          // important: use single quotes for paths, since otherwise backslashes will not be accepted on Windows!
-          file.addLine("plot '" + (String)param_.getValue("out_plot") + "_scores.txt' with boxes, " + formula1 + " , " + formula2 + " , " + formula3);
-        }
-        //update maximum likelihood
-        maxlike = new_maxlike;
-        ++itns;
-      } while (!stop_em_init);
+          if (plot_iterations)
+          {
+            String formula1, formula2, formula3;
+            formula1 = ((this)->*(getNegativeGnuplotFormula_))(incorrectly_assigned_fit_param_) + "* " + String(negative_prior_); //String(incorrectly_assigned_fit_param_.A) +" * exp(-(x - " + String(incorrectly_assigned_fit_param_.x0) + ") ** 2 / 2 / (" + String(incorrectly_assigned_fit_param_.sigma) + ") ** 2)"+ "*" + String(negative_prior_);
+            formula2 = ((this)->*(getPositiveGnuplotFormula_))(correctly_assigned_fit_param_) + "* (1 - " + String(negative_prior_) + ")"; //String(correctly_assigned_fit_param_.A) +" * exp(-(x - " + String(correctly_assigned_fit_param_.x0) + ") ** 2 / 2 / (" + String(correctly_assigned_fit_param_.sigma) + ") ** 2)"+ "* (1 - " + String(negative_prior_) + ")";
+            formula3 = getBothGnuplotFormula(incorrectly_assigned_fit_param_, correctly_assigned_fit_param_);
+            // important: use single quotes for paths, since otherwise backslashes will not be accepted on Windows!
+            file.addLine("plot '" + (String)param_.getValue("out_plot") + "_scores.txt' with boxes, " + formula1 + " , " + formula2 + " , " + formula3);
+          }
+          //update maximum likelihood
+          maxlike = new_maxlike;
+          ++itns;
+        } while (!stop_em_init);
+      }
 
       //-------------------------------------------------------------
       // Finished fitting
@@ -333,88 +379,108 @@ namespace OpenMS
       int delta = param_.getValue("neg_log_delta");
       int itns = 0;
 
-      vector<double> incorrect_log_density, correct_log_density;
-      fillLogDensities(x_scores, incorrect_log_density, correct_log_density);
-      vector<double> incorrect_posteriors;
-      double maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-      double sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
-      double sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
+      // with subsampling enabled, the EM starts on a subsample and is then refined on all scores
+      vector<double> subsample;
+      vector<const vector<double>*> em_rounds;
+      Size max_subsample_size = (Int)param_.getValue("max_subsample_size");
+      if (max_subsample_size > 0 && x_scores.size() > max_subsample_size)
+      {
+        stridedSubsample_(x_scores, max_subsample_size, subsample);
+        em_rounds.push_back(&subsample);
+      }
+      em_rounds.push_back(&x_scores);
 
-      do
+      for (const vector<double>* em_scores : em_rounds)
       {
-        //-------------------------------------------------------------
-        // E-STEP
-        std::pair<double,double> newMeans = pos_neg_mean_weighted_posteriors(x_scores, incorrect_posteriors);
-        newMeans.first /= sumCorrectPosteriors;
-        newMeans.second /= sumIncorrectPosteriors;
-
-        //new standard deviation
-        std::pair<double,double> newSigmas = pos_neg_sigma_weighted_posteriors(x_scores, incorrect_posteriors, newMeans);
-        newSigmas.first = sqrt(newSigmas.first/sumCorrectPosteriors);
-        newSigmas.second = sqrt(newSigmas.second/sumIncorrectPosteriors);
-
-        if (newSigmas.first <= 0 || newSigmas.second <= 0 || std::isnan(newSigmas.first) || std::isnan(newSigmas.second) )
+        const vector<double>& scores = *em_scores;
+        // plot only the iterations on the full data
+        const bool plot_iterations = output_plots && em_scores == &x_scores;
+        stop_em_init = false;
+        itns = 0;
+
+        vector<double> incorrect_log_density, correct_log_density;
+        fillLogDensities(scores, incorrect_log_density, correct_log_density);
+        vector<double> incorrect_posteriors;
+        double maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
+        double sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
+        double sumCorrectPosteriors = scores.size() - sumIncorrectPosteriors;
+
+        do
         {
-          OPENMS_LOG_WARN << "Warning: encountered impossible standard deviations. Aborting fit." << std::endl;
-          break;
-        }
+          //-------------------------------------------------------------
+          // E-STEP
+          std::pair<double,double> newMeans = pos_neg_mean_weighted_posteriors(scores, incorrect_posteriors);
+          newMeans.first /= sumCorrectPosteriors;
+          newMeans.second /= sumIncorrectPosteriors;
+
+          //new standard deviation
+          std::pair<double,double> newSigmas = pos_neg_sigma_weighted_posteriors(scores, incorrect_posteriors, newMeans);
+          newSigmas.first = sqrt(newSigmas.first/sumCorrectPosteriors);
+          newSigmas.second = sqrt(newSigmas.second/sumIncorrectPosteriors);
+
+          if (newSigmas.first <= 0 || newSigmas.second <= 0 || std::isnan(newSigmas.first) || std::isnan(newSigmas.second) )
+          {
+            OPENMS_LOG_WARN << "Warning: encountered impossible standard deviations. Aborting fit." << std::endl;
+            break;
+          }
 
-        // update parameters
-        correctly_assigned_fit_param_.x0 = newMeans.first;
-        incorrectly_assigned_fit_param_.x0 = newMeans.second;
+          // update parameters
+          correctly_assigned_fit_param_.x0 = newMeans.first;
+          incorrectly_assigned_fit_param_.x0 = newMeans.second;
 
-        correctly_assigned_fit_param_.sigma = newSigmas.first;
-        correctly_assigned_fit_param_.A = 1 / sqrt(2 * Constants::PI * pow(correctly_assigned_fit_param_.sigma, 2));
+          correctly_assigned_fit_param_.sigma = newSigmas.first;
+          correctly_assigned_fit_param_.A = 1 / sqrt(2 * Constants::PI * pow(correctly_assigned_fit_param_.sigma, 2));
 
-        incorrectly_assigned_fit_param_.sigma = newSigmas.second;
-        incorrectly_assigned_fit_param_.A = 1 / sqrt(2 * Constants::PI * pow(incorrectly_assigned_fit_param_.sigma, 2));
+          incorrectly_assigned_fit_param_.sigma = newSigmas.second;
+          incorrectly_assigned_fit_param_.A = 1 / sqrt(2 * Constants::PI * pow(incorrectly_assigned_fit_param_.sigma, 2));
 
 
-        // compute new prior probabilities negative peptides
-        fillLogDensities(x_scores, incorrect_log_density, correct_log_density);
-        double new_maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
-        sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
-        sumCorrectPosteriors = x_scores.size() - sumIncorrectPosteriors;
-        negative_prior_ = sumIncorrectPosteriors / x_scores.size();
+          // compute new prior probabilities negative peptides
+          fillLogDensities(scores, incorrect_log_density, correct_log_density);
+          double new_maxlike = computeLLAndIncorrectPosteriorsFromLogDensities(incorrect_log_density, correct_log_density, incorrect_posteriors);
+          sumIncorrectPosteriors = Math::sum(incorrect_posteriors.begin(),incorrect_posteriors.end());
+          sumCorrectPosteriors = scores.size() - sumIncorrectPosteriors;
+          negative_prior_ = sumIncorrectPosteriors / scores.size();
 
-        if (std::isnan(new_maxlike - maxlike))
-        {
-          OPENMS_LOG_WARN << "Numerical instabilities. Aborting." << endl;
-          return false;
-        }
+          if (std::isnan(new_maxlike - maxlike))
+          {
+            OPENMS_LOG_WARN << "Numerical instabilities. Aborting." << endl;
+            return false;
+          }
 
-        // check termination criterium
-        if ((new_maxlike - maxlike) < pow(10.0, -delta) || itns >= max_itns)
-        {
-          if (itns >= max_itns)
+          // check termination criterium
+          if ((new_maxlike - maxlike) < pow(10.0, -delta) || itns >= max_itns)
           {
-            OPENMS_LOG_WARN << "Number of iterations exceeded. Convergence criterion not met. Last log likelihood increase: " << (new_maxlike - maxlike) << endl;
-            OPENMS_LOG_WARN << "Algorithm returns probabilities for suboptimal fit. You might want to try raising the max. number of iterations and have a look at the distribution." << endl;
+            if (itns >= max_itns)
+            {
+              OPENMS_LOG_WARN << "Number of iterations exceeded. Convergence criterion not met. Last log likelihood increase: " << (new_maxlike - maxlike) << endl;
+              OPENMS_LOG_WARN << "Algorithm returns probabilities for suboptimal fit. You might want to try raising the max. number of iterations and have a look at the distribution." << endl;
+            }
+            stop_em_init = true;
+            good_fit = true;
+          }
+          else if (new_maxlike < maxlike)
+          {
+            OPENMS_LOG_WARN << "Log Likelihood of fit decreased: " << (new_maxlike - maxlike) << ". Abort fitting. Please check"
+                               " the gnuplot scripts and adapt search engine settings or outlier settings of IDPEP."<< endl;
+            stop_em_init = true;
+            good_fit = false;
           }
-          stop_em_init = true;
-          good_fit = true;
-        }
-        else if (new_maxlike < maxlike)
-        {
-          OPENMS_LOG_WARN << "Log Likelihood of fit decreased: " << (new_maxlike - maxlike) << ". Abort fitting. Please check"
-                             " the gnuplot scripts and adapt search engine settings or outlier settings of IDPEP."<< endl;
-          stop_em_init = true;
-          good_fit = false;
-        }
 
-        if (output_plots)
-        {
-          String formula1, formula2, formula3;
-          formula1 = ((this)->*(getNegativeGnuplotFormula_))(incorrectly_assigned_fit_param_) + "* " + String(negative_prior_); //String(incorrectly_assigned_fit_param_.A) +" * exp(-(x - " + String(incorrectly_assigned_fit_param_.x0) + ") ** 2 / 2 / (" + String(incorrectly_assigned_fit_param_.sigma) + ") ** 2)"+ "*" + String(negative_prior_);
-          formula2 = ((this)->*(getPositiveGnuplotFormula_))(correctly_assigned_fit_param_) + "* (1 - " + String(negative_prior_) + ")"; //String(correctly_assigned_fit_param_.A) +" * exp(-(x - " + String(correctly_assigned_fit_param_.x0) + ") ** 2 / 2 / (" + String(correctly_assigned_fit_param_.sigma) + ") ** 2)"+ "* (1 - " + String(negative_prior_) + ")";
-          formula3 = getBothGnuplotFormula(incorrectly_assigned_fit_param_, correctly_assigned_fit_param_);
-          // important: use single quotes for paths, since otherwise backslashes will not be accepted on Windows!
-          file.addLine("plot '" + (String)param_.getValue("out_plot") + "_scores.txt' with boxes, " + formula1 + " , " + formula2 + " , " + formula3);
-        }
-        //update maximum likelihood
-        maxlike = new_maxlike;
-        ++itns;
-      } while (!stop_em_init);
+          if (plot_iterations)
+          {
+            String formula1, formula2, formula3;
+            formula1 = ((this)->*(getNegativeGnuplotFormula_))(incorrectly_assigned_fit_param_) + "* " + String(negative_prior_); //String(incorrectly_assigned_fit_param_.A) +" * exp(-(x - " + String(incorrectly_assigned_fit_param_.x0) + ") ** 2 / 2 / (" + String(incorrectly_assigned_fit_param_.sigma) + ") ** 2)"+ "*" + String(negative_prior_);
+            formula2 = ((this)->*(getPositiveGnuplotFormula_))(correctly_assigned_fit_param_) + "* (1 - " + String(negative_prior_) + ")"; //String(correctly_assigned_fit_param_.A) +" * exp(-(x - " + String(correctly_assigned_fit_param_.x0) + ") ** 2 / 2 / (" + String(correctly_assigned_fit_param_.sigma) + ") ** 2)"+ "* (1 - " + String(negative_prior_) + ")";
+            formula3 = getBothGnuplotFormula(incorrectly_assigned_fit_param_, correctly_assigned_fit_param_);
+            // important: use single quotes for paths, since otherwise backslashes will not be accepted on Windows!
+            file.addLine("plot '" + (String)param_.getValue("out_plot") + "_scores.txt' with boxes, " + formula1 + " , " + formula2 + " , " + formula3);
+          }
+          //update maximum likelihood
+          maxlike = new_maxlike;
+          ++itns;
+        } while (!stop_em_init);
+      }
 
       //-------------------------------------------------------------
       // Finished fitting
@@ -461,15 +527,15 @@ namespace OpenMS
         incorrect_density.resize(x_scores.size());
         correct_density.resize(x_scores.size());
       }
-      auto incorrect(incorrect_density.begin());
-      auto correct(correct_density.begin());
-      for (double const & score : x_scores)
+      const SignedSize n = x_scores.size();
+#ifdef _OPENMP
+#pragma omp parallel for if (n > MIN_PARALLEL_SCORES)
+#endif
+      for (SignedSize i = 0; i < n; ++i)
       {
         // TODO: incorrect is currently filled with gauss as fitting gumble is not supported
-        *incorrect = incorrectly_assigned_fit_param_.eval(score);
-        *correct = correctly_assigned_fit_param_.eval(score);
-        ++incorrect;
-        ++correct;
+        incorrect_density[i] = incorrectly_assigned_fit_param_.eval(x_scores[i]);
+        correct_density[i] = correctly_assigned_fit_param_.eval(x_scores[i]);
       }
     }
 
@@ -480,14 +546,14 @@ namespace OpenMS
         incorrect_density.resize(x_scores.size());
         correct_density.resize(x_scores.size());
       }
-      auto incorrect(incorrect_density.begin());
-      auto correct(correct_density.begin());
-      for (double const & score : x_scores)
+      const SignedSize n = x_scores.size();
+#ifdef _OPENMP
+#pragma omp parallel for if (n > MIN_PARALLEL_SCORES)
+#endif
+      for (SignedSize i = 0; i < n; ++i)
       {
-        *incorrect = incorrectly_assigned_fit_gumbel_param_.log_eval_no_normalize(score);
-        *correct = correctly_assigned_fit_param_.log_eval_no_normalize(score);
-        ++incorrect;
-        ++correct;
+        incorrect_density[i] = incorrectly_assigned_fit_gumbel_param_.log_eval_no_normalize(x_scores[i]);
+        correct_density[i] = correctly_assigned_fit_param_.log_eval_no_normalize(x_scores[i]);
       }
     }
 
@@ -498,25 +564,28 @@ namespace OpenMS
         incorrect_density.resize(x_scores.size());
         correct_density.resize(x_scores.size());
       }
-      auto incorrect(incorrect_density.begin());
-      auto correct(correct_density.begin());
-      for (double const & score : x_scores)
+      const SignedSize n = x_scores.size();
+#ifdef _OPENMP
+#pragma omp parallel for if (n > MIN_PARALLEL_SCORES)
+#endif
+      for (SignedSize i = 0; i < n; ++i)
       {
         // TODO: incorrect is currently filled with gauss as fitting gumble is not supported
-        *incorrect = incorrectly_assigned_fit_param_.log_eval_no_normalize(score);
-        *correct = correctly_assigned_fit_param_.log_eval_no_normalize(score);
-        ++incorrect;
-        ++correct;
+        incorrect_density[i] = incorrectly_assigned_fit_param_.log_eval_no_normalize(x_scores[i]);
+        correct_density[i] = correctly_assigned_fit_param_.log_eval_no_normalize(x_scores[i]);
       }
     }
 
     double PosteriorErrorProbabilityModel::computeLogLikelihood(const vector<double>& incorrect_density, const vector<double>& correct_density)
     {
       double maxlike(0);
-      auto incorrect = incorrect_density.cbegin();
-      for (auto correct = correct_density.cbegin(); correct < correct_density.cend(); ++correct, ++incorrect)
+      const SignedSize n = correct_density.size();
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+: maxlike) if (n > MIN_PARALLEL_SCORES)
+#endif
+      for (SignedSize i = 0; i < n; ++i)
       {
-        maxlike += log10(negative_prior_ * (*incorrect) + (1 - negative_prior_) * (*correct));
+        maxlike += log10(negative_prior_ * incorrect_density[i] + (1 - negative_prior_) * correct_density[i]);
       }
       return maxlike;
     }
@@ -528,17 +597,19 @@ namespace OpenMS
       double loglikelihood = 0.0;
       double log_prior_pos = log(1. - negative_prior_);
       double log_prior_neg = log(negative_prior_);
-      auto incorrect = incorrect_log_density.cbegin();
       if (incorrect_posterior.size() != incorrect_log_density.size())
       {
         incorrect_posterior.resize(incorrect_log_density.size());
       }
-      auto incorrect_posterior_it = incorrect_posterior.begin();
 
-      for (auto correct = correct_log_density.cbegin(); correct < correct_log_density.cend(); ++correct, ++incorrect, ++incorrect_posterior_it)
+      const SignedSize n = correct_log_density.size();
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+: loglikelihood) if (n > MIN_PARALLEL_SCORES)
+#endif
+      for (SignedSize i = 0; i < n; ++i)
       {
-        double log_resp_correct = log_prior_pos + *correct;
-        double log_resp_incorrect = log_prior_neg + *incorrect;
+        double log_resp_correct = log_prior_pos + correct_log_density[i];
+        double log_resp_incorrect = log_prior_neg + incorrect_log_density[i];
         double max_log_resp = std::max(log_resp_correct,log_resp_incorrect);
         log_resp_correct -= max_log_resp;
         log_resp_incorrect -= max_log_resp;
@@ -546,7 +617,7 @@ namespace OpenMS
         double resp_incorrect = exp(log_resp_incorrect);
         double sum = resp_correct + resp_incorrect;
         // normalize
-        *incorrect_posterior_it = resp_incorrect / sum; //TODO can we somehow stay in log space (i.e. fill as log posteriors?)
+        incorrect_posterior[i] = resp_incorrect / sum; //TODO can we somehow stay in log space (i.e. fill as log posteriors?)
         loglikelihood += max_log_resp + log(sum);
       }
       return loglikelihood;
@@ -556,12 +627,14 @@ namespace OpenMS
     {
       double pos_x0(0);
       double neg_x0(0);
-      auto the_x = x_scores.cbegin();
-
-      for (auto incorrect = incorrect_posteriors.cbegin(); incorrect < incorrect_posteriors.end(); ++incorrect, ++the_x)
+      const SignedSize n = incorrect_posteriors.size();
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+: pos_x0, neg_x0) if (n > MIN_PARALLEL_SCORES)
+#endif
+      for (SignedSize i = 0; i < n; ++i)
       {
-        pos_x0 += (1. - *incorrect) * (*the_x);
-        neg_x0 += (*incorrect) * (*the_x);
+        pos_x0 += (1. - incorrect_posteriors[i]) * x_scores[i];
+        neg_x0 += incorrect_posteriors[i] * x_scores[i];
       }
       return {pos_x0,neg_x0};
     }
@@ -575,12 +648,16 @@ namespace OpenMS
     {
       double pos_sigma(0);
       double neg_sigma(0);
-      auto the_x = x_scores.cbegin();
-
-      for (auto incorrect = incorrect_posteriors.cbegin(); incorrect < incorrect_posteriors.end(); ++incorrect, ++the_x)
+      const SignedSize n = incorrect_posteriors.size();
+#ifdef _OPENMP
+#pragma omp parallel for reduction(+: pos_sigma, neg_sigma) if (n > MIN_PARALLEL_SCORES)
+#endif
+      for (SignedSize i = 0; i < n; ++i)
       {
-        pos_sigma += (1. - *incorrect) * pow((*the_x) - pos_neg_mean.first, 2);
-        neg_sigma += (*incorrect) * pow((*the_x) - pos_neg_mean.second, 2);
+        const double pos_diff = x_scores[i] - pos_neg_mean.first;
+        const double neg_diff = x_scores[i] - pos_neg_mean.second;
+        pos_sigma += (1. - incorrect_posteriors[i]) * pos_diff * pos_diff;
+        neg_sigma += incorrect_posteriors[i] * neg_diff * neg_diff;
       }
       return {pos_sigma, neg_sigma};
     }
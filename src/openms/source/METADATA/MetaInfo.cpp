@@ -34,6 +34,8 @@
 
 #include <OpenMS/METADATA/MetaInfo.h>
 
+#include <algorithm>
+
 using namespace std;
 
 namespace OpenMS
@@ -47,7 +49,13 @@ namespace OpenMS
 
   bool MetaInfo::operator==(const MetaInfo& rhs) const
   {
-    return index_to_value_ == rhs.index_to_value_;
+    if (entries_.size() != rhs.entries_.size()) return false;
+
+    for (Size i = 0; i < entries_.size(); ++i)
+    {
+      if (entries_[i].index != rhs.entries_[i].index || entries_[i].value != rhs.entries_[i].value) return false;
+    }
+    return true;
   }
 
   bool MetaInfo::operator!=(const MetaInfo& rhs) const
@@ -55,24 +63,25 @@ namespace OpenMS
     return !(operator==(rhs));
   }
 
-  const DataValue& MetaInfo::getValue(const String& name, const DataValue& default_value) const
+  const MetaInfo::Entry_* MetaInfo::find_(UInt index) const
   {
-    MapType::const_iterator it = index_to_value_.find(registry_.getIndex(name));
-    if (it != index_to_value_.end())
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), index, [](const Entry_& e, UInt i) { return e.index < i; });
+    if (it != entries_.end() && it->index == index)
     {
-      return it->second;
+      return &(*it);
     }
-    return default_value;
+    return nullptr;
+  }
+
+  const DataValue& MetaInfo::getValue(const String& name, const DataValue& default_value) const
+  {
+    return getValue(registry_.getIndex(name), default_value);
   }
 
   const DataValue& MetaInfo::getValue(UInt index, const DataValue& default_value) const
   {
-    MapType::const_iterator it = index_to_value_.find(index);
-    if (it != index_to_value_.end())
-    {
-      return it->second;
-    }
-    return default_value;
+    const Entry_* entry = find_(index);
+    return entry != nullptr ? entry->value : default_value;
   }
 
   void MetaInfo::setValue(const String& name, const DataValue& value)
@@ -84,19 +93,24 @@ namespace OpenMS
   void MetaInfo::setValue(UInt index, const DataValue& value)
   {
     // @TODO: check if that index is registered in MetaInfoRegistry?
-    auto it = index_to_value_.find(index);
-    if (it != index_to_value_.end())
+    auto it = std::lower_bound(entries_.begin(), entries_.end(), index, [](const Entry_& e, UInt i) { return e.index < i; });
+    if (it != entries_.end() && it->index == index)
     {
-      it->second = value;
+      it->value = value;
+      return;
     }
-    else
+
+    // Note: we need to create a copy of the data value here and can't use the const &,
+    // inserting shifts or relocates the entries and would invalidate a reference
+    // to one of our own values (e.g. in constructs like: m.setValue(1, m.getValue(2)))
+    DataValue tmp = value;
+    if (entries_.capacity() == 0)
     {
-      // Note; we need to create a copy of data value here and can't use the const &
-      // The underlying flat_map invalidates references to it if inserting
-      // an element leads to relocation (e.g, in constructs like: m.insert(1, m[2]));)
-      DataValue tmp = value;
-      index_to_value_.insert(std::make_pair(index, tmp));
+      // most annotated objects carry only a few values: avoid the first reallocations
+      entries_.reserve(4);
+      it = entries_.begin();
     }
+    entries_.insert(it, Entry_{index, std::move(tmp)});
   }
 
   MetaInfoRegistry& MetaInfo::registry()
@@ -109,63 +123,55 @@ namespace OpenMS
     UInt index = registry_.getIndex(name);
     if (index != UInt(-1))
     {
-      return (index_to_value_.find(index) != index_to_value_.end());
+      return find_(index) != nullptr;
     }
     return false;
   }
 
   bool MetaInfo::exists(UInt index) const
   {
-    return (index_to_value_.find(index) != index_to_value_.end());
+    return find_(index) != nullptr;
   }
 
   void MetaInfo::removeValue(const String& name)
   {
-    MapType::iterator it = index_to_value_.find(registry_.getIndex(name));
-    if (it != index_to_value_.end())
-    {
-      index_to_value_.erase(it);
-    }
+    removeValue(registry_.getIndex(name));
   }
 
   void MetaInfo::removeValue(UInt index)
   {
-    MapType::iterator it = index_to_value_.find(index);
-    if (it != index_to_value_.end())
-    {
-      index_to_value_.erase(it);
-    }
+    const Entry_* entry = find_(index);
+    if (entry == nullptr) return;
+
+    entries_.erase(entries_.begin() + (entry - entries_.data()));
   }
 
   void MetaInfo::getKeys(vector<String>& keys) const
   {
-    keys.resize(index_to_value_.size());
-    UInt i = 0;
-    for (MapType::const_iterator it = index_to_value_.begin(); it != index_to_value_.end(); ++it)
+    keys.resize(entries_.size());
+    for (Size i = 0; i < keys.size(); ++i)
     {
-      keys[i++] = registry_.getName(it->first);
+      keys[i] = registry_.getName(entries_[i].index);
     }
   }
 
   void MetaInfo::getKeys(vector<UInt>& keys) const
   {
-    keys.resize(index_to_value_.size());
-    UInt i = 0;
-    for (MapType::const_iterator it = index_to_value_.begin(); it != index_to_value_.end(); ++it)
+    keys.resize(entries_.size());
+    for (Size i = 0; i < keys.size(); ++i)
     {
-      keys[i++] = it->first;
+      keys[i] = entries_[i].index;
     }
   }
 
   bool MetaInfo::empty() const
   {
-    return index_to_value_.empty();
+    return entries_.empty();
   }
 
   void MetaInfo::clear()
   {
-    index_to_value_.clear();
+    entries_.clear();
   }
 
 } //namespace
-
@@ -41,80 +41,51 @@ using namespace std;
 namespace OpenMS
 {
 
+  MetaInfoRegistry::Table_::Table_(Size cap) :
+    capacity(cap),
+    slots(new std::atomic<const Entry_*>[cap])
+  {
+    for (Size i = 0; i < capacity; ++i)
+    {
+      slots[i].store(nullptr, std::memory_order_relaxed);
+    }
+  }
+
   MetaInfoRegistry::MetaInfoRegistry() :
-    next_index_(1024), 
-    name_to_index_(), 
-    index_to_name_(), 
-    index_to_description_(), 
+    next_index_(1024),
+    entries_(),
+    name_count_(0),
+    name_table_(nullptr),
+    index_table_(nullptr),
+    tables_(),
+    index_to_description_(),
     index_to_unit_()
   {
-    name_to_index_["isotopic_range"] = 1;
-    index_to_name_[1] = "isotopic_range";
-    index_to_description_[1] = "consecutive numbering of the peaks in an isotope pattern. 0 is the monoisotopic peak";
-    index_to_unit_[1] = "";
-
-    name_to_index_["cluster_id"] = 2;
-    index_to_name_[2] = "cluster_id";
-    index_to_description_[2] = "consecutive numbering of isotope clusters in a spectrum";
-    index_to_unit_[2] = "";
-
-    name_to_index_["label"] = 3;
-    index_to_name_[3] = "label";
-    index_to_description_[3] = "label e.g. shown in visualization";
-    index_to_unit_[3] = "";
-
-    name_to_index_["icon"] = 4;
-    index_to_name_[4] = "icon";
-    index_to_description_[4] = "icon shown in visualization";
-    index_to_unit_[4] = "";
-
-    name_to_index_["color"] = 5;
-    index_to_name_[5] = "color";
-    index_to_description_[5] = "color used for visualization e.g. #FF00FF for purple";
-    index_to_unit_[5] = "";
-
-    name_to_index_["RT"] = 6;
-    index_to_name_[6] = "RT";
-    index_to_description_[6] = "the retention time of an identification";
-    index_to_unit_[6] = "";
-
-    name_to_index_["MZ"] = 7;
-    index_to_name_[7] = "MZ";
-    index_to_description_[7] = "the MZ of an identification";
-    index_to_unit_[7] = "";
-
-    name_to_index_["predicted_RT"] = 8;
-    index_to_name_[8] = "predicted_RT";
-    index_to_description_[8] = "the predicted retention time of a peptide hit";
-    index_to_unit_[8] = "";
-
-    name_to_index_["predicted_RT_p_value"] = 9;
-    index_to_name_[9] = "predicted_RT_p_value";
-    index_to_description_[9] = "the predicted RT p-value of a peptide hit";
-    index_to_unit_[9] = "";
-
-    name_to_index_["spectrum_reference"] = 10;
-    index_to_name_[10] = "spectrum_reference";
-    index_to_description_[10] = "Reference to a spectrum or feature number";
-    index_to_unit_[10] = "";
-
-    name_to_index_["ID"] = 11;
-    index_to_name_[11] = "ID";
-    index_to_description_[11] = "Some type of identifier";
-    index_to_unit_[11] = "";
-
-    name_to_index_["low_quality"] = 12;
-    index_to_name_[12] = "low_quality";
-    index_to_description_[12] = "Flag which indicates that some entity has a low quality (e.g. a feature pair)";
-    index_to_unit_[12] = "";
-
-    name_to_index_["charge"] = 13;
-    index_to_name_[13] = "charge";
-    index_to_description_[13] = "Charge of a feature or peak";
-    index_to_unit_[13] = "";
+    reset_();
+    insert_("isotopic_range", 1, "consecutive numbering of the peaks in an isotope pattern. 0 is the monoisotopic peak", "");
+    insert_("cluster_id", 2, "consecutive numbering of isotope clusters in a spectrum", "");
+    insert_("label", 3, "label e.g. shown in visualization", "");
+    insert_("icon", 4, "icon shown in visualization", "");
+    insert_("color", 5, "color used for visualization e.g. #FF00FF for purple", "");
+    insert_("RT", 6, "the retention time of an identification", "");
+    insert_("MZ", 7, "the MZ of an identification", "");
+    insert_("predicted_RT", 8, "the predicted retention time of a peptide hit", "");
+    insert_("predicted_RT_p_value", 9, "the predicted RT p-value of a peptide hit", "");
+    insert_("spectrum_reference", 10, "Reference to a spectrum or feature number", "");
+    insert_("ID", 11, "Some type of identifier", "");
+    insert_("low_quality", 12, "Flag which indicates that some entity has a low quality (e.g. a feature pair)", "");
+    insert_("charge", 13, "Charge of a feature or peak", "");
   }
 
-  MetaInfoRegistry::MetaInfoRegistry(const MetaInfoRegistry& rhs)
+  MetaInfoRegistry::MetaInfoRegistry(const MetaInfoRegistry& rhs) :
+    next_index_(1024),
+    entries_(),
+    name_count_(0),
+    name_table_(nullptr),
+    index_table_(nullptr),
+    tables_(),
+    index_to_description_(),
+    index_to_unit_()
   {
     *this = rhs;
   }
@@ -129,32 +100,133 @@ namespace OpenMS
 
 #pragma omp critical (MetaInfoRegistry)
     {
+      reset_();
+      for (const Entry_& entry : rhs.entries_)
+      {
+        insert_(entry.name, entry.index, rhs.index_to_description_.at(entry.index), rhs.index_to_unit_.at(entry.index));
+      }
       next_index_ = rhs.next_index_;
-      name_to_index_ = rhs.name_to_index_;
-      index_to_name_ = rhs.index_to_name_;
-      index_to_description_ = rhs.index_to_description_;
-      index_to_unit_ = rhs.index_to_unit_;
     }
     return *this;
   }
 
+  void MetaInfoRegistry::reset_()
+  {
+    next_index_ = 1024;
+    index_to_description_.clear();
+    index_to_unit_.clear();
+    name_count_ = 0;
+    // publish the new (empty) tables before freeing the old storage
+    std::vector<std::unique_ptr<Table_> > old_tables;
+    old_tables.swap(tables_);
+    tables_.emplace_back(new Table_(64));
+    name_table_.store(tables_.back().get(), std::memory_order_release);
+    tables_.emplace_back(new Table_(2048));
+    index_table_.store(tables_.back().get(), std::memory_order_release);
+    entries_.clear();
+  }
+
+  void MetaInfoRegistry::placeName_(Table_& table, const Entry_* entry)
+  {
+    const Size mask = table.capacity - 1;
+    Size pos = std::hash<std::string>()(entry->name) & mask;
+    while (table.slots[pos].load(std::memory_order_relaxed) != nullptr)
+    {
+      pos = (pos + 1) & mask;
+    }
+    table.slots[pos].store(entry, std::memory_order_release);
+  }
+
+  void MetaInfoRegistry::insert_(const std::string& name, UInt index, const std::string& description, const std::string& unit)
+  {
+    entries_.push_back(Entry_{name, index});
+    const Entry_* entry = &entries_.back();
+
+    // keep the hash table at most half full, so probing stays short and always terminates
+    Table_* names = name_table_.load(std::memory_order_relaxed);
+    if (2 * (name_count_ + 1) > names->capacity)
+    {
+      tables_.emplace_back(new Table_(2 * names->capacity));
+      Table_* grown = tables_.back().get();
+      for (Size i = 0; i < names->capacity; ++i)
+      {
+        const Entry_* e = names->slots[i].load(std::memory_order_relaxed);
+        if (e != nullptr) placeName_(*grown, e);
+      }
+      name_table_.store(grown, std::memory_order_release);
+      names = grown;
+    }
+    placeName_(*names, entry);
+    ++name_count_;
+
+    Table_* indices = index_table_.load(std::memory_order_relaxed);
+    if (index >= indices->capacity)
+    {
+      Size capacity = indices->capacity;
+      while (index >= capacity) capacity *= 2;
+      tables_.emplace_back(new Table_(capacity));
+      Table_* grown = tables_.back().get();
+      for (Size i = 0; i < indices->capacity; ++i)
+      {
+        grown->slots[i].store(indices->slots[i].load(std::memory_order_relaxed), std::memory_order_relaxed);
+      }
+      index_table_.store(grown, std::memory_order_release);
+      indices = grown;
+    }
+    indices->slots[index].store(entry, std::memory_order_release);
+
+    index_to_description_[index] = description;
+    index_to_unit_[index] = unit;
+  }
+
+  const MetaInfoRegistry::Entry_* MetaInfoRegistry::findName_(const std::string& name) const
+  {
+    const Table_* names = name_table_.load(std::memory_order_acquire);
+    const Size mask = names->capacity - 1;
+    Size pos = std::hash<std::string>()(name) & mask;
+    while (true)
+    {
+      const Entry_* entry = names->slots[pos].load(std::memory_order_acquire);
+      if (entry == nullptr || entry->name == name)
+      {
+        return entry;
+      }
+      pos = (pos + 1) & mask;
+    }
+  }
+
+  const MetaInfoRegistry::Entry_* MetaInfoRegistry::findIndex_(UInt index) const
+  {
+    const Table_* indices = index_table_.load(std::memory_order_acquire);
+    if (index >= indices->capacity)
+    {
+      return nullptr;
+    }
+    return indices->slots[index].load(std::memory_order_acquire);
+  }
+
   UInt MetaInfoRegistry::registerName(const String& name, const String& description, const String& unit)
   {
+    // fast path: most calls are for names that are already registered
+    const Entry_* entry = findName_(name);
+    if (entry != nullptr)
+    {
+      return entry->index;
+    }
+
     UInt rv;
 #pragma omp critical (MetaInfoRegistry)
     {
-      MapString2IndexType::iterator it = name_to_index_.find(name);
-      if (it == name_to_index_.end())
+      // re-check, another thread may have registered the name in the meantime
+      entry = findName_(name);
+      if (entry == nullptr)
       {
-        name_to_index_[name] = next_index_;
-        index_to_name_[next_index_] = name;
-        index_to_description_[next_index_] = description;
-        index_to_unit_[next_index_] = unit;
+        insert_(name, next_index_, description, unit);
         rv = next_index_++;
       }
       else
       {
-        rv = it->second;
+        rv = entry->index;
       }
     }
     return rv;
@@ -179,18 +251,14 @@ namespace OpenMS
 
   void MetaInfoRegistry::setDescription(const String& name, const String& description)
   {
-    MapString2IndexType::iterator pos;
+    const Entry_* entry = findName_(name);
+    if (entry == nullptr)
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered name!", name);
+    }
 #pragma omp critical (MetaInfoRegistry)
     {
-      pos = name_to_index_.find(name);
-      if (pos != name_to_index_.end())
-      {
-        index_to_description_[pos->second] = description;
-      }
-      else
-      {
-        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered name!", name);
-      }
+      index_to_description_[entry->index] = description;
     }
   }
 
@@ -213,33 +281,21 @@ namespace OpenMS
 
   void MetaInfoRegistry::setUnit(const String& name, const String& unit)
   {
-    MapString2IndexType::iterator pos;
+    const Entry_* entry = findName_(name);
+    if (entry == nullptr)
+    {
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered name!", name);
+    }
 #pragma omp critical (MetaInfoRegistry)
     {
-      pos = name_to_index_.find(name);
-      if (pos != name_to_index_.end())
-      {
-        index_to_unit_[pos->second] = unit;
-      }
-      else
-      {
-        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered name!", name);
-      }
+      index_to_unit_[entry->index] = unit;
     }
   }
 
   UInt MetaInfoRegistry::getIndex(const String& name) const
   {
-    UInt rv = UInt(-1);
-#pragma omp critical (MetaInfoRegistry)
-    {
-      MapString2IndexType::const_iterator it = name_to_index_.find(name);
-      if (it != name_to_index_.end())
-      {
-        rv = it->second;
-      }
-    }
-    return rv;
+    const Entry_* entry = findName_(name);
+    return entry != nullptr ? entry->index : UInt(-1);
   }
 
   String MetaInfoRegistry::getDescription(UInt index) const
@@ -260,7 +316,7 @@ namespace OpenMS
   String MetaInfoRegistry::getDescription(const String& name) const
   {
     String rv;
-    UInt index = getIndex(name); // this has to be outside the OpenMP "critical" block!
+    UInt index = getIndex(name);
     if (index == UInt(-1)) // not found
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered Name!", name);
@@ -293,7 +349,7 @@ namespace OpenMS
   String MetaInfoRegistry::getUnit(const String& name) const
   {
     String rv;
-    UInt index = getIndex(name); // this has to be outside the OpenMP "critical" block!
+    UInt index = getIndex(name);
     if (index == UInt(-1)) // not found
     {
       throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered Name!", name);
@@ -310,20 +366,12 @@ namespace OpenMS
 
   String MetaInfoRegistry::getName(UInt index) const
   {
-    String rv;
-#pragma omp critical (MetaInfoRegistry)
+    const Entry_* entry = findIndex_(index);
+    if (entry == nullptr)
     {
-      MapIndex2StringType::const_iterator it = index_to_name_.find(index);
-      if (it != index_to_name_.end())
-      {
-        rv = it->second;
-      }
-      else
-      {
-        throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered index!", String(index));
-      }
+      throw Exception::InvalidValue(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "Unregistered index!", String(index));
     }
-    return rv;
+    return entry->name;
   }
 
 } //namespace
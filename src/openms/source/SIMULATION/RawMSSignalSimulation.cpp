@@ -55,6 +55,22 @@
 namespace OpenMS
 {
 
+  namespace
+  {
+    /// sort peaks of each spectrum by m/z and intensity, giving a unique order independent of how the peaks were collected
+    void sortPeaksCanonically(SimTypes::MSSimExperiment& experiment)
+    {
+      for (Size i = 0; i < experiment.size(); ++i)
+      {
+        std::sort(experiment[i].begin(), experiment[i].end(),
+                  [](const SimTypes::SimPointType& a, const SimTypes::SimPointType& b)
+                  {
+                    return a.getMZ() < b.getMZ() || (a.getMZ() == b.getMZ() && a.getIntensity() < b.getIntensity());
+                  });
+      }
+    }
+  }
+
   /**
    * TODO: review baseline and noise code
    */
@@ -371,16 +387,19 @@ namespace OpenMS
 
     this->startProgress(0, features.size(), "RawMSSignal");
 
+    // every feature draws from its own random number stream (keyed by its
+    // index), so the simulated signal does not depend on the number of threads
+    const UInt64 feature_rng_key = rnd_gen_->getTechnicalRng()();
+
     Size progress(0);
     // we have a bit of code duplication here but this eases the
     // parallelization step
     if (experiment.size() == 1) // MS only
     {
-      for (FeatureMap::iterator feature_it = features.begin();
-           feature_it != features.end();
-           ++feature_it, ++progress)
+      for (Size f = 0; f < features.size(); ++f, ++progress)
       {
-        add1DSignal_(*feature_it, experiment, experiment_ct);
+        SimTypes::PhiloxRandomEngine rng(feature_rng_key, f);
+        add1DSignal_(features[f], experiment, experiment_ct, rng);
         this->setProgress(progress);
       }
     }
@@ -394,24 +413,13 @@ namespace OpenMS
 
 
 #ifdef _OPENMP
-      // prepare random numbers for the different threads
-      // each possible thread gets his own set of random
-      // numbers
       Size thread_count = omp_get_max_threads();
 
-      threaded_random_numbers_.resize(thread_count);
-      threaded_random_numbers_index_.resize(thread_count);
       experiments.reserve(thread_count); // !reserve!
       experiments_ct.reserve(thread_count); // !reserve!
       std::vector<SimTypes::MSSimExperiment> experiments_tmp(thread_count - 1); // holds MSExperiments for slave threads
       std::vector<SimTypes::MSSimExperiment> experiments_ct_tmp(thread_count - 1); // holds MSExperiments (centroided) for slave threads
 
-      for (Size i = 0; i < thread_count; ++i)
-      {
-        threaded_random_numbers_[i].resize(THREADED_RANDOM_NUMBER_POOL_SIZE_);
-        threaded_random_numbers_index_[i] = THREADED_RANDOM_NUMBER_POOL_SIZE_;
-      }
-
       if (thread_count > 1)
       {
         // prepare a temporary experiment to store the results
@@ -433,63 +441,68 @@ namespace OpenMS
           experiments_ct.push_back(&(experiments_ct_tmp[i - 1]));
         }
       }
-#else
-      Size thread_count = 1;
 #endif
 
-      Size compress_size_intermediate = 20000 / thread_count; // compress map every X features, (10.000 feature are ~ 2 GB at 0.002 sampling rate)
-      Size compress_count = 0; // feature count (for each thread)
+      // Features are simulated in blocks of fixed size. After each block, the
+      // results of all threads are merged and the map is compressed to avoid
+      // memory problems (10.000 features are ~ 2 GB at 0.002 sampling rate).
+      // Block boundaries do not depend on the number of threads, and merged
+      // peaks are brought into a canonical order before compressing, hence
+      // the result is the same for any number of threads.
+      const Size block_size = 20000;
+      for (Size block_start = 0; block_start < features.size(); block_start += block_size)
+      {
+        const Size block_end = std::min(features.size(), block_start + block_size);
 
 #ifdef _OPENMP
-#pragma omp parallel for firstprivate(compress_count)
+#pragma omp parallel for schedule(dynamic)
 #endif
-      for (SignedSize f = 0; f < (SignedSize)features.size(); ++f)
-      {
+        for (SignedSize f = (SignedSize)block_start; f < (SignedSize)block_end; ++f)
+        {
 #ifdef _OPENMP // update experiment index if necessary
-        const int current_thread = omp_get_thread_num();
+          const int current_thread = omp_get_thread_num();
 #else
-        const int current_thread(0);
+          const int current_thread(0);
 #endif
-        add2DSignal_(features[f], *(experiments[current_thread]), *(experiments_ct[current_thread]));
+          SimTypes::PhiloxRandomEngine rng(feature_rng_key, f);
+          add2DSignal_(features[f], *(experiments[current_thread]), *(experiments_ct[current_thread]), rng);
 
-        // progresslogger, only master thread sets progress (no barrier here)
+          // progresslogger, only master thread sets progress (no barrier here)
 #ifdef _OPENMP
 #pragma omp atomic
 #endif
-        ++progress;
-        if (current_thread == 0)
-        {
-          this->setProgress(progress);
-        }
+          ++progress;
+          if (current_thread == 0)
+          {
+            this->setProgress(progress);
+          }
+        } // ! raw signal sim
 
-        // intermediate compress to avoid memory problems
-        ++compress_count;
-        if (compress_count > compress_size_intermediate)
+        // merge back other experiments
+        for (Size i = 1; i < experiments.size(); ++i)
         {
-          compress_count = 0;
-          compressSignals_(*(experiments[current_thread]));
+          // copy peak data from temporal experiment
+          for (Size scan = 0; scan < experiment.size(); ++scan)
+          {
+            // append all points from temp to org
+            experiment[scan].insert(experiment[scan].end(), (*experiments[i])[scan].begin(), (*experiments[i])[scan].end());
+            // delete from child experiment to save memory (otherwise the merge would double it!)
+            (*experiments[i])[scan].clear(false);
+
+            // peak GT ( small, so no need to compress)
+            experiment_ct[scan].insert(experiment_ct[scan].end(), (*experiments_ct[i])[scan].begin(), (*experiments_ct[i])[scan].end());
+            (*experiments_ct[i])[scan].clear(false);
+          }
         }
-      } // ! raw signal sim
+        sortPeaksCanonically(experiment);
 
-#ifdef _OPENMP // merge back other experiments
-      for (Size i = 1; i < experiments.size(); ++i)
-      {
-        // copy peak data from temporal experiment
-        for (Size scan = 0; scan < experiment.size(); ++scan)
+        // intermediate compress (the final one follows after adding noise)
+        if (block_end < features.size())
         {
-          if ((*experiments[i])[scan].empty())
-            continue; // we do not care if the spectrum wasn't touched at all
-          // append all points from temp to org
-          experiment[scan].insert(experiment[scan].end(), (*experiments[i])[scan].begin(), (*experiments[i])[scan].end());
-          // delete from child experiment to save memory (otherwise the merge would double it!)
-          (*experiments[i])[scan].clear(false);
-
-          // peak GT ( small, so no need to compress)
-          experiment_ct[scan].insert(experiment_ct[scan].end(), (*experiments_ct[i])[scan].begin(), (*experiments_ct[i])[scan].end());
-
+          compressSignals_(experiment);
         }
       }
-#endif
+      sortPeaksCanonically(experiment_ct);
 
     } // ! 1D or 2D
 
@@ -535,9 +548,9 @@ namespace OpenMS
     return fwhm;
   }
 
-  void RawMSSignalSimulation::add1DSignal_(Feature& active_feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct)
+  void RawMSSignalSimulation::add1DSignal_(Feature& active_feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct, SimTypes::PhiloxRandomEngine& rng)
   {
-    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 100.0);
+    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 100.0, rng);
 
     SimTypes::SimChargeType q = active_feature.getCharge();
     EmpiricalFormula ef = active_feature.getPeptideIdentifications()[0].getHits()[0].getSequence().getFormula();
@@ -570,12 +583,12 @@ namespace OpenMS
     SimTypes::SimCoordinateType mz_start = isomodel.getInterpolation().supportMin();
     SimTypes::SimCoordinateType mz_end = isomodel.getInterpolation().supportMax();
 
-    samplePeptideModel1D_(isomodel, mz_start, mz_end, experiment, experiment_ct, active_feature);
+    samplePeptideModel1D_(isomodel, mz_start, mz_end, experiment, experiment_ct, active_feature, rng);
   }
 
-  void RawMSSignalSimulation::add2DSignal_(Feature& active_feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct)
+  void RawMSSignalSimulation::add2DSignal_(Feature& active_feature, SimTypes::MSSimExperiment& experiment, SimTypes::MSSimExperiment& experiment_ct, SimTypes::PhiloxRandomEngine& rng)
   {
-    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 1.0);
+    SimTypes::SimIntensityType scale = getFeatureScaledIntensity_(active_feature.getIntensity(), 1.0, rng);
 
     SimTypes::SimChargeType q = active_feature.getCharge();
     EmpiricalFormula ef;
@@ -638,7 +651,7 @@ namespace OpenMS
 
     // add peptide to GLOBAL MS map
     // add CH and new intensity to feature
-    samplePeptideModel2D_(pm, mz_start, mz_end, rt_start, rt_end, experiment, experiment_ct, active_feature);
+    samplePeptideModel2D_(pm, mz_start, mz_end, rt_start, rt_end, experiment, experiment_ct, active_feature, rng);
   }
 
   void RawMSSignalSimulation::samplePeptideModel1D_(const IsotopeModel& pm,
@@ -646,7 +659,8 @@ namespace OpenMS
                                                     const SimTypes::SimCoordinateType mz_end,
                                                     SimTypes::MSSimExperiment& experiment,
                                                     SimTypes::MSSimExperiment& experiment_ct,
-                                                    Feature& active_feature)
+                                                    Feature& active_feature,
+                                                    SimTypes::PhiloxRandomEngine& rng)
   {
     SimTypes::SimIntensityType intensity_sum = 0.0;
 
@@ -678,7 +692,7 @@ namespace OpenMS
         continue;
 
       // add Gaussian distributed m/z error
-      double mz_err = ndist(rnd_gen_->getTechnicalRng());
+      double mz_err = ndist(rng);
       point.setMZ(fabs(point.getMZ() + mz_err));
 
       intensity_sum += point.getIntensity();
@@ -694,7 +708,8 @@ namespace OpenMS
                                                     SimTypes::SimCoordinateType rt_end,
                                                     SimTypes::MSSimExperiment& experiment,
                                                     SimTypes::MSSimExperiment& experiment_ct,
-                                                    Feature& active_feature)
+                                                    Feature& active_feature,
+                                                    SimTypes::PhiloxRandomEngine& rng)
   {
     if (rt_start <= 0)
       rt_start = 0;
@@ -719,6 +734,8 @@ namespace OpenMS
     SimTypes::SimCoordinateType iso_peakdist = isomodel->getParameters().getValue("isotope:distance");
     Int q = active_feature.getCharge();
 
+    boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
+
     ////////////////////////////////////////////////////////////////////////////////////////////////////////////////////////
     // Sample the model ...
     SimTypes::SimCoordinateType rt(0);
@@ -758,37 +775,7 @@ namespace OpenMS
         //OPENMS_LOG_ERROR << "Sampling " << rt << " , " << mz << " -> " << point.getIntensity() << std::endl;
 
         // add Gaussian distributed m/z error
-#ifdef _OPENMP
-        int CURRENT_THREAD = omp_get_thread_num();
-        // check if we need to refill the random number pool for this thread
-        if (threaded_random_numbers_index_[CURRENT_THREAD] == THREADED_RANDOM_NUMBER_POOL_SIZE_)
-        {
-          if (mz_error_stddev_ != 0.0)
-          {
-#pragma omp critical(generate_random_number_for_thread)
-            {
-              boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
-              for (Size i = 0; i < THREADED_RANDOM_NUMBER_POOL_SIZE_; ++i)
-              {
-                threaded_random_numbers_[CURRENT_THREAD][i] = ndist(rnd_gen_->getTechnicalRng());
-              }
-            }
-          }
-          else
-          {
-            // we do not need to care about concurrency here
-            fill(threaded_random_numbers_[CURRENT_THREAD].begin(), threaded_random_numbers_[CURRENT_THREAD].end(), mz_error_mean_);
-          }
-          // reset index for this thread to first position
-          threaded_random_numbers_index_[CURRENT_THREAD] = 0;
-        }
-
-        const double mz_err = threaded_random_numbers_[CURRENT_THREAD][threaded_random_numbers_index_[CURRENT_THREAD]++];
-#else
-        // we can use the normal Gaussian ran-gen if we do not use OPENMP
-        boost::normal_distribution<double> ndist(mz_error_mean_, mz_error_stddev_);
-        const double mz_err = ndist(rnd_gen_->getTechnicalRng());
-#endif
+        const double mz_err = (mz_error_stddev_ != 0.0) ? ndist(rng) : mz_error_mean_;
         point.setMZ(std::fabs(point.getMZ() + mz_err));
         exp_iter->push_back(point);
 
@@ -944,6 +931,9 @@ namespace OpenMS
     SimTypes::SimCoordinateType minimal_mz_measurement_limit = exp[0].getInstrumentSettings().getScanWindows()[0].begin;
     SimTypes::SimCoordinateType maximal_mz_measurement_limit = exp[0].getInstrumentSettings().getScanWindows()[0].end;
 
+    // one random number stream per contaminant
+    const UInt64 rng_key = rnd_gen_->getTechnicalRng()();
+
     for (Size i = 0; i < contaminants_.size(); ++i)
     {
       if (contaminants_[i].im != IM_ALL && contaminants_[i].im != this_im)
@@ -977,7 +967,8 @@ namespace OpenMS
       feature.setMetaValue("sum_formula", contaminants_[i].sf.toString()); // formula without adducts or charges
       feature.setCharge(contaminants_[i].q);
       feature.setMetaValue("charge_adducts", "H" + String(contaminants_[i].q)); // adducts separately
-      add2DSignal_(feature, exp, exp_ct);
+      SimTypes::PhiloxRandomEngine rng(rng_key, i);
+      add2DSignal_(feature, exp, exp_ct, rng);
       c_map.push_back(feature);
     }
 
@@ -1000,41 +991,46 @@ namespace OpenMS
       return;
 
     const SimTypes::SimCoordinateType window_size = 100.0;
-    SimTypes::SimCoordinateType mz_lw = minimal_mz_measurement_limit;
-    SimTypes::SimCoordinateType mz_up = window_size + minimal_mz_measurement_limit;
 
     // we distribute the rate in 100 Th windows
     double scaled_rate = rate * window_size;
-    SimTypes::SimPointType shot_noise_peak;
-
-    //distributions to sample from
-    boost::random::poisson_distribution<UInt, double> pdist(scaled_rate);
-    boost::uniform_real<SimTypes::SimCoordinateType> udist(mz_lw, mz_up);
-    boost::random::exponential_distribution<SimTypes::SimCoordinateType> edist(intensity_mean);
 
     OPENMS_LOG_INFO << "Adding shot noise to spectra ..." << std::endl;
     Size num_intervals = std::ceil((maximal_mz_measurement_limit - minimal_mz_measurement_limit) / window_size);
 
-    for (SimTypes::MSSimExperiment::Iterator spectrum_it = experiment.begin(); spectrum_it != experiment.end(); ++spectrum_it)
+    const UInt64 rng_key = rnd_gen_->getTechnicalRng()();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)experiment.size(); ++i)
     {
+      SimTypes::PhiloxRandomEngine rng(rng_key, i);
+      SimTypes::SimPointType shot_noise_peak;
+
+      //distributions to sample from
+      boost::random::poisson_distribution<UInt, double> pdist(scaled_rate);
+      boost::random::exponential_distribution<SimTypes::SimCoordinateType> edist(intensity_mean);
+
       for (Size j = 0; j < num_intervals; ++j)
       {
-        UInt counts = pdist(rnd_gen_->getTechnicalRng());
+        SimTypes::SimCoordinateType mz_lw = minimal_mz_measurement_limit + j * window_size;
+        boost::uniform_real<SimTypes::SimCoordinateType> udist(mz_lw, mz_lw + window_size);
+
+        UInt counts = pdist(rng);
         for (UInt c = 0; c < counts; ++c)
         {
-          SimTypes::SimCoordinateType mz = udist(rnd_gen_->getTechnicalRng());
-          SimTypes::SimCoordinateType intensity = edist(rnd_gen_->getTechnicalRng());
+          SimTypes::SimCoordinateType mz = udist(rng);
+          SimTypes::SimCoordinateType intensity = edist(rng);
 
           // we only add points if they have an intensity>0 and are inside of the measurement range
           if (mz < maximal_mz_measurement_limit)
           {
             shot_noise_peak.setIntensity(intensity);
             shot_noise_peak.setMZ(mz);
-            spectrum_it->push_back(shot_noise_peak);
+            experiment[i].push_back(shot_noise_peak);
           }
         }
-
-        mz_up += window_size;
       }
     } // end of each scan
 
@@ -1079,16 +1075,23 @@ namespace OpenMS
       return;
     }
 
-    boost::normal_distribution<SimTypes::SimIntensityType> ndist(white_noise_mean, white_noise_stddev);
+    const UInt64 rng_key = rnd_gen_->getTechnicalRng()();
 
-    for (SimTypes::MSSimExperiment::iterator spectrum_it = experiment.begin(); spectrum_it != experiment.end(); ++spectrum_it)
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)experiment.size(); ++i)
     {
+      SimTypes::MSSimExperiment::iterator spectrum_it = experiment.begin() + i;
+      SimTypes::PhiloxRandomEngine rng(rng_key, i);
+      boost::normal_distribution<SimTypes::SimIntensityType> ndist(white_noise_mean, white_noise_stddev);
+
       SimTypes::MSSimExperiment::SpectrumType new_spec = (*spectrum_it);
       new_spec.clear(false);
 
       for (SimTypes::MSSimExperiment::SpectrumType::iterator peak_it = (*spectrum_it).begin(); peak_it != (*spectrum_it).end(); ++peak_it)
       {
-        SimTypes::SimIntensityType intensity = peak_it->getIntensity() + ndist(rnd_gen_->getTechnicalRng());
+        SimTypes::SimIntensityType intensity = peak_it->getIntensity() + ndist(rng);
         if (intensity > 0.0)
         {
           peak_it->setIntensity(intensity);
@@ -1114,9 +1117,17 @@ namespace OpenMS
       return;
     }
 
-    boost::normal_distribution<SimTypes::SimIntensityType> ndist(detector_noise_mean, detector_noise_stddev);
-    for (SimTypes::MSSimExperiment::iterator spectrum_it = experiment.begin(); spectrum_it != experiment.end(); ++spectrum_it)
+    const UInt64 rng_key = rnd_gen_->getTechnicalRng()();
+
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic)
+#endif
+    for (SignedSize i = 0; i < (SignedSize)experiment.size(); ++i)
     {
+      SimTypes::MSSimExperiment::iterator spectrum_it = experiment.begin() + i;
+      SimTypes::PhiloxRandomEngine rng(rng_key, i);
+      boost::normal_distribution<SimTypes::SimIntensityType> ndist(detector_noise_mean, detector_noise_stddev);
+
       SimTypes::MSSimExperiment::SpectrumType new_spec = (*spectrum_it);
       new_spec.clear(false);
 
@@ -1127,7 +1138,7 @@ namespace OpenMS
         // if peak is in grid
         if (peak_it != spectrum_it->end() && *grid_it == peak_it->getMZ())
         {
-          SimTypes::SimIntensityType intensity = peak_it->getIntensity() + ndist(rnd_gen_->getTechnicalRng());
+          SimTypes::SimIntensityType intensity = peak_it->getIntensity() + ndist(rng);
           if (intensity > 0.0)
           {
             peak_it->setIntensity(intensity);
@@ -1137,7 +1148,7 @@ namespace OpenMS
         }
         else // we have no point here, generate one if noise is above 0
         {
-          SimTypes::SimIntensityType intensity = ndist(rnd_gen_->getTechnicalRng());
+          SimTypes::SimIntensityType intensity = ndist(rng);
           if (intensity > 0.0)
           {
             SimTypes::MSSimExperiment::SpectrumType::PeakType noise_peak;
@@ -1288,7 +1299,7 @@ namespace OpenMS
     return;
   }
 
-  SimTypes::SimIntensityType RawMSSignalSimulation::getFeatureScaledIntensity_(const SimTypes::SimIntensityType feature_intensity, const SimTypes::SimIntensityType natural_scaling_factor)
+  SimTypes::SimIntensityType RawMSSignalSimulation::getFeatureScaledIntensity_(const SimTypes::SimIntensityType feature_intensity, const SimTypes::SimIntensityType natural_scaling_factor, SimTypes::PhiloxRandomEngine& rng)
   {
     SimTypes::SimIntensityType intensity = feature_intensity * natural_scaling_factor * intensity_scale_;
 
@@ -1297,7 +1308,7 @@ namespace OpenMS
     // TODO: variables model f??r den intensit??ts-einfluss
     // e.g. sqrt(intensity) || ln(intensity)
     boost::normal_distribution<SimTypes::SimIntensityType> ndist(0, intensity_scale_stddev_ * intensity);
-    intensity += ndist(rnd_gen_->getTechnicalRng());
+    intensity += ndist(rng);
 
     return intensity;
   }
@@ -0,0 +1,280 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/SYSTEM/Profiler.h>
+
+#include <OpenMS/CONCEPT/Exception.h>
+#include <OpenMS/SYSTEM/SysInfo.h>
+
+#include <algorithm>
+#include <fstream>
+#include <iomanip>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+namespace OpenMS
+{
+  namespace
+  {
+    // write @p s as quoted JSON string
+    void writeJSONString_(std::ostream& os, const String& s)
+    {
+      os << '"';
+      for (const char c : s)
+      {
+        switch (c)
+        {
+          case '"': os << "\\\""; break;
+          case '\\': os << "\\\\"; break;
+          case '\n': os << "\\n"; break;
+          case '\r': os << "\\r"; break;
+          case '\t': os << "\\t"; break;
+          default:
+            if (static_cast<unsigned char>(c) < 0x20)
+            {
+              os << "\\u" << std::hex << std::setw(4) << std::setfill('0') << int(c) << std::dec << std::setfill(' ');
+            }
+            else
+            {
+              os << c;
+            }
+        }
+      }
+      os << '"';
+    }
+  }
+
+  std::atomic<bool> Profiler::enabled_(false);
+
+  Profiler::Profiler() :
+    epoch_(std::chrono::steady_clock::now().time_since_epoch().count()),
+    peak_memory_kb_(0)
+  {
+  }
+
+  Profiler& Profiler::getInstance()
+  {
+    static Profiler instance;
+    return instance;
+  }
+
+  void Profiler::setEnabled(bool enabled)
+  {
+    enabled_.store(enabled, std::memory_order_relaxed);
+  }
+
+  void Profiler::clear()
+  {
+#pragma omp critical (OpenMS_Profiler)
+    {
+      events_.clear();
+      summary_.clear();
+      counters_.clear();
+      peak_memory_kb_ = 0;
+      epoch_.store(std::chrono::steady_clock::now().time_since_epoch().count(), std::memory_order_relaxed);
+    }
+  }
+
+  double Profiler::now() const
+  {
+    const std::chrono::steady_clock::duration epoch(epoch_.load(std::memory_order_relaxed));
+    return std::chrono::duration<double, std::micro>(std::chrono::steady_clock::now().time_since_epoch() - epoch).count();
+  }
+
+  int Profiler::currentThread_()
+  {
+#ifdef _OPENMP
+    return omp_get_thread_num();
+#else
+    return 0;
+#endif
+  }
+
+  void Profiler::addEvent(const String& name, const String& category, double start_us, double duration_us)
+  {
+    Event e{name, category, 'X', start_us, duration_us, 0, currentThread_()};
+#pragma omp critical (OpenMS_Profiler)
+    {
+      events_.push_back(std::move(e));
+      Summary& s = summary_[name];
+      ++s.calls;
+      s.total_us += duration_us;
+      s.max_us = std::max(s.max_us, duration_us);
+    }
+  }
+
+  void Profiler::addSample(const String& name, double duration_us)
+  {
+#pragma omp critical (OpenMS_Profiler)
+    {
+      Summary& s = summary_[name];
+      ++s.calls;
+      s.total_us += duration_us;
+      s.max_us = std::max(s.max_us, duration_us);
+    }
+  }
+
+  void Profiler::addCounter(const String& name, Int64 delta)
+  {
+#pragma omp critical (OpenMS_Profiler)
+    counters_[name] += delta;
+  }
+
+  void Profiler::recordMemory(const String& label)
+  {
+    size_t mem(0), mem_peak(0);
+    SysInfo::getProcessMemoryConsumption(mem);
+    SysInfo::getProcessPeakMemoryConsumption(mem_peak);
+    Event e{label, "memory", 'C', now(), 0.0, Int64(mem), currentThread_()};
+#pragma omp critical (OpenMS_Profiler)
+    {
+      events_.push_back(std::move(e));
+      peak_memory_kb_ = std::max(peak_memory_kb_, std::max(Size(mem), Size(mem_peak)));
+    }
+  }
+
+  std::vector<Profiler::Event> Profiler::getEvents() const
+  {
+    std::vector<Event> result;
+#pragma omp critical (OpenMS_Profiler)
+    result = events_;
+    return result;
+  }
+
+  std::map<String, Profiler::Summary> Profiler::getSummary() const
+  {
+    std::map<String, Summary> result;
+#pragma omp critical (OpenMS_Profiler)
+    result = summary_;
+    return result;
+  }
+
+  std::map<String, Int64> Profiler::getCounters() const
+  {
+    std::map<String, Int64> result;
+#pragma omp critical (OpenMS_Profiler)
+    result = counters_;
+    return result;
+  }
+
+  Size Profiler::getPeakMemory() const
+  {
+    Size result(0);
+#pragma omp critical (OpenMS_Profiler)
+    result = peak_memory_kb_;
+    return result;
+  }
+
+  void Profiler::writeTrace(std::ostream& os) const
+  {
+    // take a consistent snapshot, writing may take a while
+    const std::vector<Event> events = getEvents();
+    const std::map<String, Summary> summary = getSummary();
+    const std::map<String, Int64> counters = getCounters();
+    const Size peak_memory = getPeakMemory();
+
+    const std::ios_base::fmtflags flags = os.flags();
+    const std::streamsize precision = os.precision();
+    os << std::fixed << std::setprecision(3);
+
+    os << "{\n\"traceEvents\": [";
+    for (Size i = 0; i < events.size(); ++i)
+    {
+      const Event& e = events[i];
+      os << (i == 0 ? "\n" : ",\n") << "  {\"name\": ";
+      writeJSONString_(os, e.name);
+      os << ", \"cat\": ";
+      writeJSONString_(os, e.category);
+      os << ", \"ph\": \"" << e.phase << "\", \"ts\": " << e.start_us;
+      if (e.phase == 'X')
+      {
+        os << ", \"dur\": " << e.duration_us << ", \"pid\": 1, \"tid\": " << e.thread << "}";
+      }
+      else
+      {
+        os << ", \"pid\": 1, \"tid\": " << e.thread << ", \"args\": {\"memory_kb\": " << e.value << "}}";
+      }
+    }
+    os << "\n],\n\"displayTimeUnit\": \"ms\",\n\"otherData\": {\n  \"summary\": {";
+    bool first = true;
+    for (const auto& s : summary)
+    {
+      os << (first ? "\n" : ",\n") << "    ";
+      writeJSONString_(os, s.first);
+      os << ": {\"calls\": " << s.second.calls << ", \"total_us\": " << s.second.total_us
+         << ", \"mean_us\": " << s.second.total_us / double(s.second.calls) << ", \"max_us\": " << s.second.max_us << "}";
+      first = false;
+    }
+    os << "\n  },\n  \"counters\": {";
+    first = true;
+    for (const auto& c : counters)
+    {
+      os << (first ? "\n" : ",\n") << "    ";
+      writeJSONString_(os, c.first);
+      os << ": " << c.second;
+      first = false;
+    }
+    os << "\n  },\n  \"peak_memory_kb\": " << peak_memory << "\n}\n}\n";
+
+    os.flags(flags);
+    os.precision(precision);
+  }
+
+  void Profiler::store(const String& filename) const
+  {
+    std::ofstream os(filename.c_str());
+    if (!os)
+    {
+      throw Exception::UnableToCreateFile(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, filename);
+    }
+    writeTrace(os);
+  }
+
+  void Profiler::ScopedTimer::stop_()
+  {
+    Profiler& p = Profiler::getInstance();
+    const double duration = p.now() - start_us_;
+    if (trace_)
+    {
+      p.addEvent(name_, category_, start_us_, duration);
+    }
+    else
+    {
+      p.addSample(name_, duration);
+    }
+  }
+
+} // namespace OpenMS
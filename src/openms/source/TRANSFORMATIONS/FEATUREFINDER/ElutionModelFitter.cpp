@@ -39,6 +39,8 @@
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/EGHTraceFitter.h>
 #include <OpenMS/TRANSFORMATIONS/FEATUREFINDER/GaussTraceFitter.h>
 
+#include <exception>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -128,6 +130,7 @@ void ElutionModelFitter::fitAndValidateModel_(
   }
   catch (Exception::UnableToFit& except)
   {
+#pragma omp critical (LOG_ERROR_access)
     OPENMS_LOG_ERROR << "Error fitting model to feature '"
                      << feature.getUniqueId() << "': " << except.getName()
                      << " - " << except.getMessage() << endl;
@@ -209,117 +212,131 @@ void ElutionModelFitter::fitElutionModels(FeatureMap& features)
   double asym_limit = (asymmetric ?
                        double(param_.getValue("check:asymmetry")) : 0.0);
 
-  TraceFitter* fitter;
-  if (asymmetric)
-  {
-    fitter = new EGHTraceFitter();
-  }
-  else fitter = new GaussTraceFitter();
-  if (weighted)
-  {
-    Param params = fitter->getDefaults();
-    params.setValue("weighted", "true");
-    fitter->setParameters(params);
-  }
-
-  // collect peaks that constitute mass traces:
+  // collect peaks that constitute mass traces and fit the models; features
+  // are independent, so they are processed in parallel with one fitter
+  // (and its optimization workspace) per thread:
   OPENMS_LOG_DEBUG << "Fitting elution models to features:" << endl;
-  Size index = 0;
-  for (FeatureMap::Iterator feat_it = features.begin();
-       feat_it != features.end(); ++feat_it, ++index)
+  std::exception_ptr err;
+#pragma omp parallel
   {
-    // OPENMS_LOG_DEBUG << String(feat_it->getMetaValue("PeptideRef")) << endl;
-    double region_start = double(feat_it->getMetaValue("leftWidth"));
-    double region_end = double(feat_it->getMetaValue("rightWidth"));
-
-    if (feat_it->getSubordinates().empty())
+    TraceFitter* fitter;
+    if (asymmetric)
     {
-      throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No subordinate features for mass traces available.");
+      fitter = new EGHTraceFitter();
     }
-    const Feature& sub = feat_it->getSubordinates()[0];
-    if (sub.getConvexHulls().empty())
+    else fitter = new GaussTraceFitter();
+    if (weighted)
     {
-      throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No hull points for mass trace in subordinate feature available.");
+      Param params = fitter->getDefaults();
+      params.setValue("weighted", "true");
+      fitter->setParameters(params);
     }
 
-    vector<Peak1D> peaks;
-    // reserve space once, to avoid copying and invalidating pointers:
-    Size points_per_hull = sub.getConvexHulls()[0].getHullPoints().size();
-    peaks.reserve(feat_it->getSubordinates().size() * points_per_hull +
-                  (add_zeros > 0.0)); // don't forget additional zero point
-    MassTraces traces;
-    traces.max_trace = 0;
-    // need a mass trace for every transition, plus maybe one for add. zeros:
-    traces.reserve(feat_it->getSubordinates().size() + (add_zeros > 0.0));
-    for (vector<Feature>::iterator sub_it = feat_it->getSubordinates().begin();
-         sub_it != feat_it->getSubordinates().end(); ++sub_it)
+#pragma omp for schedule(dynamic, 16)
+    for (SignedSize index = 0; index < static_cast<SignedSize>(features.size()); ++index)
     {
-      MassTrace trace;
-      trace.peaks.reserve(points_per_hull);
-      const ConvexHull2D& hull = sub_it->getConvexHulls()[0];
-      for (ConvexHull2D::PointArrayTypeConstIterator point_it =
-             hull.getHullPoints().begin(); point_it !=
-             hull.getHullPoints().end(); ++point_it)
+      try
       {
-        double intensity = point_it->getY();
-        if (intensity > 0.0) // only use non-zero intensities for fitting
+        FeatureMap::Iterator feat_it = features.begin() + index;
+        double region_start = double(feat_it->getMetaValue("leftWidth"));
+        double region_end = double(feat_it->getMetaValue("rightWidth"));
+
+        if (feat_it->getSubordinates().empty())
+        {
+          throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No subordinate features for mass traces available.");
+        }
+        const Feature& sub = feat_it->getSubordinates()[0];
+        if (sub.getConvexHulls().empty())
         {
+          throw Exception::MissingInformation(__FILE__, __LINE__, OPENMS_PRETTY_FUNCTION, "No hull points for mass trace in subordinate feature available.");
+        }
+
+        vector<Peak1D> peaks;
+        // reserve space once, to avoid copying and invalidating pointers:
+        Size points_per_hull = sub.getConvexHulls()[0].getHullPoints().size();
+        peaks.reserve(feat_it->getSubordinates().size() * points_per_hull +
+                      (add_zeros > 0.0)); // don't forget additional zero point
+        MassTraces traces;
+        traces.max_trace = 0;
+        // need a mass trace for every transition, plus maybe one for add. zeros:
+        traces.reserve(feat_it->getSubordinates().size() + (add_zeros > 0.0));
+        for (vector<Feature>::iterator sub_it = feat_it->getSubordinates().begin();
+             sub_it != feat_it->getSubordinates().end(); ++sub_it)
+        {
+          MassTrace trace;
+          trace.peaks.reserve(points_per_hull);
+          const ConvexHull2D& hull = sub_it->getConvexHulls()[0];
+          for (ConvexHull2D::PointArrayTypeConstIterator point_it =
+                 hull.getHullPoints().begin(); point_it !=
+                 hull.getHullPoints().end(); ++point_it)
+          {
+            double intensity = point_it->getY();
+            if (intensity > 0.0) // only use non-zero intensities for fitting
+            {
+              Peak1D peak;
+              peak.setMZ(sub_it->getMZ());
+              peak.setIntensity(intensity);
+              peaks.push_back(peak);
+              trace.peaks.push_back(make_pair(point_it->getX(), &peaks.back()));
+            }
+          }
+          trace.updateMaximum();
+          if (trace.peaks.empty()) continue;
+          if (each_trace)
+          {
+            MassTraces temp;
+            trace.theoretical_int = 1.0;
+            temp.push_back(trace);
+            temp.max_trace = 0;
+            fitAndValidateModel_(fitter, temp, *sub_it, region_start, region_end,
+                                 asymmetric, area_limit, check_boundaries);
+          }
+          trace.theoretical_int = sub_it->getMetaValue("isotope_probability");
+          traces.push_back(trace);
+        }
+
+        // find the trace with maximal intensity:
+        Size max_trace = 0;
+        double max_intensity = 0;
+        for (Size i = 0; i < traces.size(); ++i)
+        {
+          if (traces[i].max_peak->getIntensity() > max_intensity)
+          {
+            max_trace = i;
+            max_intensity = traces[i].max_peak->getIntensity();
+          }
+        }
+        traces.max_trace = max_trace;
+        traces.baseline = 0.0;
+
+        if (add_zeros > 0.0)
+        {
+          MassTrace trace;
+          trace.peaks.reserve(2);
+          trace.theoretical_int = add_zeros;
           Peak1D peak;
-          peak.setMZ(sub_it->getMZ());
-          peak.setIntensity(intensity);
+          peak.setMZ(feat_it->getSubordinates()[0].getMZ());
+          peak.setIntensity(0.0);
           peaks.push_back(peak);
-          trace.peaks.push_back(make_pair(point_it->getX(), &peaks.back()));
+          double offset = 0.2 * (region_start - region_end);
+          trace.peaks.push_back(make_pair(region_start - offset, &peaks.back()));
+          trace.peaks.push_back(make_pair(region_end + offset, &peaks.back()));
+          traces.push_back(trace);
         }
-      }
-      trace.updateMaximum();
-      if (trace.peaks.empty()) continue;
-      if (each_trace)
-      {
-        MassTraces temp;
-        trace.theoretical_int = 1.0;
-        temp.push_back(trace);
-        temp.max_trace = 0;
-        fitAndValidateModel_(fitter, temp, *sub_it, region_start, region_end,
+
+        // fit the model:
+        fitAndValidateModel_(fitter, traces, *feat_it, region_start, region_end,
                              asymmetric, area_limit, check_boundaries);
       }
-      trace.theoretical_int = sub_it->getMetaValue("isotope_probability");
-      traces.push_back(trace);
-    }
-
-    // find the trace with maximal intensity:
-    Size max_trace = 0;
-    double max_intensity = 0;
-    for (Size i = 0; i < traces.size(); ++i)
-    {
-      if (traces[i].max_peak->getIntensity() > max_intensity)
+      catch (...)
       {
-        max_trace = i;
-        max_intensity = traces[i].max_peak->getIntensity();
+#pragma omp critical (ElutionModelFitter_error)
+        if (!err) err = std::current_exception();
       }
     }
-    traces.max_trace = max_trace;
-    traces.baseline = 0.0;
-
-    if (add_zeros > 0.0)
-    {
-      MassTrace trace;
-      trace.peaks.reserve(2);
-      trace.theoretical_int = add_zeros;
-      Peak1D peak;
-      peak.setMZ(feat_it->getSubordinates()[0].getMZ());
-      peak.setIntensity(0.0);
-      peaks.push_back(peak);
-      double offset = 0.2 * (region_start - region_end);
-      trace.peaks.push_back(make_pair(region_start - offset, &peaks.back()));
-      trace.peaks.push_back(make_pair(region_end + offset, &peaks.back()));
-      traces.push_back(trace);
-    }
-
-    // fit the model:
-    fitAndValidateModel_(fitter, traces, *feat_it, region_start, region_end,
-                         asymmetric, area_limit, check_boundaries);
+    delete fitter;
   }
-  delete fitter;
+  if (err) std::rethrow_exception(err);
 
   // find outliers in model parameters:
   if (width_limit > 0)
@@ -404,7 +421,7 @@ void ElutionModelFitter::fitElutionModels(FeatureMap& features)
   Size model_successes = 0, model_failures = 0;
 
   for (FeatureMap::Iterator feat_it = features.begin();
-       feat_it != features.end(); ++feat_it, ++index)
+       feat_it != features.end(); ++feat_it)
   {
     feat_it->setMetaValue("raw_intensity", feat_it->getIntensity());
     if (String(feat_it->getMetaValue("model_status"))[0] != '0')
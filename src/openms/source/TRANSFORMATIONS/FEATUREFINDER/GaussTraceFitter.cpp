@@ -85,8 +85,7 @@ namespace OpenMS
     x_init(2) = sigma_;
 
     TraceFitter::ModelData data;
-    data.traces_ptr = &traces;
-    data.weighted = this->weighted_;
+    fillModelData_(traces, data);
     GaussTraceFunctor functor(NUM_PARAMS_, &data);
 
     TraceFitter::optimize_(x_init, functor);
@@ -161,7 +160,7 @@ namespace OpenMS
   GaussTraceFitter::GaussTraceFunctor::GaussTraceFunctor(int dimensions,
                                                          const TraceFitter::ModelData* data) :
     TraceFitter::GenericFunctor(dimensions,
-                                static_cast<int>(data->traces_ptr->getPeakCount())),
+                                static_cast<int>(data->rts.size())),
     m_data(data)
   {
   }
@@ -173,17 +172,18 @@ namespace OpenMS
     double sig = x(2);
     double c_fac = -0.5 / pow(sig, 2);
 
-    Size count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    const double baseline = m_data->baseline;
+    const double* rts = m_data->rts.data();
+    const double* intensities = m_data->intensities.data();
+    const double* theoretical_ints = m_data->theoretical_ints.data();
+    const double* weights = m_data->weights.data();
+    double* out = fvec.data();
+    const Size n = m_data->rts.size();
+    for (Size k = 0; k < n; ++k)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = (*m_data->traces_ptr)[t];
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
-      {
-        fvec(count) = (m_data->traces_ptr->baseline + trace.theoretical_int * height
-                       * exp(c_fac * pow(trace.peaks[i].first - x0, 2)) - trace.peaks[i].second->getIntensity()) * weight;
-        ++count;
-      }
+      const double diff = rts[k] - x0;
+      out[k] = (baseline + theoretical_ints[k] * height
+                * exp(c_fac * (diff * diff)) - intensities[k]) * weights[k];
     }
 
     return 0;
@@ -199,20 +199,22 @@ namespace OpenMS
     double sig_3 = pow(sig, 3);
     double c_fac = -0.5 / sig_sq;
 
-    Size count = 0;
-    for (Size t = 0; t < m_data->traces_ptr->size(); ++t)
+    // J is column-major, so each parameter column is a contiguous array
+    const double* rts = m_data->rts.data();
+    const double* theoretical_ints = m_data->theoretical_ints.data();
+    const double* weights = m_data->weights.data();
+    const Size n = m_data->rts.size();
+    double* d_height = J.col(0).data();
+    double* d_x0 = J.col(1).data();
+    double* d_sigma = J.col(2).data();
+    for (Size k = 0; k < n; ++k)
     {
-      const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace = (*m_data->traces_ptr)[t];
-      double weight = m_data->weighted ? trace.theoretical_int : 1.0;
-      for (Size i = 0; i < trace.peaks.size(); ++i)
-      {
-        double rt = trace.peaks[i].first;
-        double e = exp(c_fac * pow(rt - x0, 2));
-        J(count, 0) = trace.theoretical_int * e * weight;
-        J(count, 1) = trace.theoretical_int * height * e * (rt - x0) / sig_sq * weight;
-        J(count, 2) = 0.125* trace.theoretical_int* height* e* pow(rt - x0, 2) / sig_3 * weight;
-        ++count;
-      }
+      const double diff = rts[k] - x0;
+      const double diff2 = diff * diff;
+      const double e = exp(c_fac * diff2);
+      d_height[k] = theoretical_ints[k] * e * weights[k];
+      d_x0[k] = theoretical_ints[k] * height * e * diff / sig_sq * weights[k];
+      d_sigma[k] = 0.125 * theoretical_ints[k] * height * e * diff2 / sig_3 * weights[k];
     }
     return 0;
   }
@@ -96,6 +96,34 @@ namespace OpenMS
     return trace.theoretical_int * getValue(rt);
   }
 
+  void TraceFitter::fillModelData_(FeatureFinderAlgorithmPickedHelperStructs::MassTraces& traces, ModelData& data) const
+  {
+    data.traces_ptr = &traces;
+    data.weighted = weighted_;
+    data.baseline = traces.baseline;
+
+    const Size n = traces.getPeakCount();
+    data.rts.clear();
+    data.intensities.clear();
+    data.theoretical_ints.clear();
+    data.weights.clear();
+    data.rts.reserve(n);
+    data.intensities.reserve(n);
+    data.theoretical_ints.reserve(n);
+    data.weights.reserve(n);
+    for (const FeatureFinderAlgorithmPickedHelperStructs::MassTrace& trace : traces)
+    {
+      const double weight = weighted_ ? trace.theoretical_int : 1.0;
+      for (const std::pair<double, const Peak1D*>& peak : trace.peaks)
+      {
+        data.rts.push_back(peak.first);
+        data.intensities.push_back(peak.second->getIntensity());
+        data.theoretical_ints.push_back(trace.theoretical_int);
+        data.weights.push_back(weight);
+      }
+    }
+  }
+
   void TraceFitter::updateMembers_()
   {
     max_iterations_ = this->param_.getValue("max_iteration");
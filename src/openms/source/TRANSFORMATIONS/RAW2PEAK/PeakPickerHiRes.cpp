@@ -36,10 +36,15 @@
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
 
 #include <OpenMS/FILTERING/NOISEESTIMATION/SignalToNoiseEstimatorMedian.h>
+#include <OpenMS/FORMAT/PeakTypeEstimator.h>
 #include <OpenMS/KERNEL/OnDiscMSExperiment.h>
+#include <OpenMS/KERNEL/ColumnarMSExperiment.h>
 #include <OpenMS/KERNEL/MSChromatogram.h>
 #include <OpenMS/MATH/MISC/SplineBisection.h>
 #include <OpenMS/MATH/MISC/CubicSpline2d.h>
+#include <OpenMS/SYSTEM/Profiler.h>
+
+#include <algorithm>
 
 
 using namespace std;
@@ -122,6 +127,21 @@ namespace OpenMS
   template <typename ContainerType>
   void PeakPickerHiRes::pick_(const ContainerType& input, ContainerType& output, std::vector<PeakBoundary>& boundaries, bool check_spacings) const
   {
+    // signal-to-noise estimation
+    SignalToNoiseEstimatorMedian< ContainerType > snt;
+    if (signal_to_noise_ > 0.0 && input.size() >= 5)
+    {
+      snt.setParameters(param_.copy("SignalToNoise:", true));
+      snt.init(input);
+    }
+
+    pickPeaks_(input, output, boundaries, check_spacings, &snt);
+  }
+
+  template <typename InputType, typename OutputType, typename SignalToNoiseType>
+  void PeakPickerHiRes::pickPeaks_(const InputType& input, OutputType& output, std::vector<PeakBoundary>& boundaries, bool check_spacings, SignalToNoiseType* snt) const
+  {
+    OPENMS_PROFILE_ACCUMULATE("PeakPickerHiRes::pick", "peak picking");
     if (report_FWHM_)
     {
       output.getFloatDataArrays().resize(1);
@@ -138,15 +158,6 @@ namespace OpenMS
       check_spacings = false;
     }
 
-    // signal-to-noise estimation
-    SignalToNoiseEstimatorMedian< ContainerType > snt;
-    snt.setParameters(param_.copy("SignalToNoise:", true));
-
-    if (signal_to_noise_ > 0.0)
-    {
-      snt.init(input);
-    }
-
     // find local maxima in profile data
     for (Size i = 2; i < input.size() - 2; ++i)
     {
@@ -170,9 +181,9 @@ namespace OpenMS
       double act_snt = 0.0, act_snt_l1 = 0.0, act_snt_r1 = 0.0;
       if (signal_to_noise_ > 0.0)
       {
-        act_snt = snt.getSignalToNoise(input[i]);
-        act_snt_l1 = snt.getSignalToNoise(input[i - 1]);
-        act_snt_r1 = snt.getSignalToNoise(input[i + 1]);
+        act_snt = snt->getSignalToNoise(input[i]);
+        act_snt_l1 = snt->getSignalToNoise(input[i - 1]);
+        act_snt_r1 = snt->getSignalToNoise(input[i + 1]);
       }
 
       // look for peak cores meeting MZ and intensity/SNT criteria
@@ -193,8 +204,8 @@ namespace OpenMS
 
         if (signal_to_noise_ > 0.0)
         {
-          act_snt_l2 = snt.getSignalToNoise(input[i - 2]);
-          act_snt_r2 = snt.getSignalToNoise(input[i + 2]);
+          act_snt_l2 = snt->getSignalToNoise(input[i - 2]);
+          act_snt_r2 = snt->getSignalToNoise(input[i + 2]);
         }
 
         // checking signal-to-noise?
@@ -238,7 +249,7 @@ namespace OpenMS
 
           if (signal_to_noise_ > 0.0)
           {
-            act_snt_lk = snt.getSignalToNoise(input[i - k]);
+            act_snt_lk = snt->getSignalToNoise(input[i - k]);
           }
 
           if ((act_snt_lk >= signal_to_noise_) && 
@@ -279,7 +290,7 @@ namespace OpenMS
 
           if (signal_to_noise_ > 0.0)
           {
-            act_snt_rk = snt.getSignalToNoise(input[i + k]);
+            act_snt_rk = snt->getSignalToNoise(input[i + k]);
           }
 
           if ((act_snt_rk >= signal_to_noise_) && 
@@ -377,7 +388,7 @@ namespace OpenMS
         } // FWHM
 
         // save picked peak into output spectrum
-        typename ContainerType::PeakType peak;
+        typename OutputType::PeakType peak;
         PeakBoundary peak_boundary;
         peak.setMZ(max_peak_mz);
         peak.setIntensity(max_peak_int);
@@ -414,6 +425,8 @@ namespace OpenMS
                                        std::vector<std::vector<PeakBoundary> >& boundaries_chrom,
                                        const bool check_spectrum_type) const
   {
+    OPENMS_PROFILE_SCOPE("PeakPickerHiRes::pickExperiment", "peak picking");
+
     // make sure that output is clear
     output.clear(true);
 
@@ -564,6 +577,74 @@ namespace OpenMS
     return;
   }
 
+  void PeakPickerHiRes::pickExperiment(const ColumnarMSExperiment& input, PeakMap& output, const bool check_spectrum_type) const
+  {
+    // make sure that output is clear
+    output.clear(true);
+
+    // decide up front which spectra are picked (and fail before starting in parallel)
+    std::vector<bool> do_pick(input.size(), true);
+    for (Size scan_idx = 0; scan_idx != input.size(); ++scan_idx)
+    {
+      const ColumnarMSExperiment::SpectrumMeta& meta = input.getSpectrumMeta(scan_idx);
+      SpectrumSettings::SpectrumType spectrum_type = meta.type;
+      if (spectrum_type == SpectrumSettings::UNKNOWN)
+      {
+        // inspect the data (as MSSpectrum::getType(true) does), without copying the peaks
+        const ColumnarMSExperiment::SpectrumView view = input[scan_idx];
+        spectrum_type = PeakTypeEstimator::estimateType(view.begin(), view.end());
+      }
+
+      if (ms_levels_.empty()) //auto mode
+      {
+        do_pick[scan_idx] = spectrum_type != SpectrumSettings::CENTROID;
+      }
+      else if (!ListUtils::contains(ms_levels_, Int(meta.ms_level))) // manual mode
+      {
+        do_pick[scan_idx] = false;
+      }
+      else if (spectrum_type == SpectrumSettings::CENTROID && check_spectrum_type)
+      {
+        throw OpenMS::Exception::IllegalArgument(__FILE__, __LINE__, __FUNCTION__, "Error: Centroided data provided but profile spectra expected.");
+      }
+    }
+
+    Size progress = 0;
+    startProgress(0, input.size(), "picking peaks");
+
+    // resize output with respect to input
+    output.resize(input.size());
+
+#pragma omp parallel for schedule(dynamic, 16)
+    for (SignedSize scan_idx = 0; scan_idx < (SignedSize)input.size(); ++scan_idx)
+    {
+      const ColumnarMSExperiment::SpectrumView view = input[scan_idx];
+      if (!do_pick[scan_idx])
+      {
+        output[scan_idx] = input.getSpectrum(scan_idx);
+      }
+      else if (signal_to_noise_ > 0.0 || !std::is_sorted(view.mzBegin(), view.mzEnd()))
+      {
+        // the S/N estimator and sorting need an MSSpectrum
+        MSSpectrum s = input.getSpectrum(scan_idx);
+        s.sortByPosition();
+        pick(s, output[scan_idx]);
+      }
+      else
+      {
+        // pick directly from the shared peak arrays
+        MSSpectrum& picked = output[scan_idx];
+        input.copySpectrumMeta(scan_idx, picked);
+        picked.setType(SpectrumSettings::CENTROID);
+        std::vector<PeakBoundary> boundaries;
+        pickPeaks_(view, picked, boundaries, true, (SignalToNoiseEstimatorMedian<MSSpectrum>*)nullptr);
+      }
+#pragma omp critical (PeakPickerHiRes_progress)
+      setProgress(++progress);
+    }
+    endProgress();
+  }
+
   void PeakPickerHiRes::updateMembers_()
   {
     signal_to_noise_ = param_.getValue("signal_to_noise");
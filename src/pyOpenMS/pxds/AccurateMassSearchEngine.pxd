@@ -29,6 +29,12 @@ cdef extern from "<OpenMS/ANALYSIS/ID/AccurateMassSearchEngine.h>" namespace "Op
         void queryByConsensusFeature(ConsensusFeature cfeat, Size cf_index, Size number_of_maps, String ion_mode,
                                      libcpp_vector[AccurateMassSearchResult]& results) nogil except +
 
+        void queryByFeatures(FeatureMap & fmap, String ion_mode,
+                             libcpp_vector[ libcpp_vector[ AccurateMassSearchResult ] ] & results) nogil except +
+
+        void queryByConsensusFeatures(ConsensusMap & cmap, String ion_mode,
+                                      libcpp_vector[ libcpp_vector[ AccurateMassSearchResult ] ] & results) nogil except +
+
         void run(FeatureMap & , MzTab & ) nogil except +
         void run(ConsensusMap&, MzTab&) nogil except +
 
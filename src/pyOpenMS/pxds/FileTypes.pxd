@@ -65,5 +65,6 @@ cdef extern from "<OpenMS/FORMAT/FileTypes.h>" namespace "OpenMS::FileTypes":
           OSW,                # < OpenSWATH OpenSWATH report (OSW) SQLite DB
           PSMS,               # < Percolator tab-delimited output (PSM level)
           PARAMXML,           # < internal format for writing and reading parameters (also used as part of CTD)
+          OMSBIN,             # < OpenMS binary container for features, consensus features and identifications (.omsbin)
           SIZE_OF_TYPE        # < No file type. Simply stores the number of types
 
@@ -30,4 +30,6 @@ cdef extern from "<OpenMS/FORMAT/HANDLERS/IndexedMzMLHandler.h>" namespace "Open
         void getMSChromatogramByNativeId(libcpp_string id_, MSChromatogram& chrom) nogil except +
 
         void setSkipXMLChecks(bool skip) nogil except +
+        void setIndexReconstruction(bool reconstruct) nogil except +
+        void setWriteSidecarIndex(bool write) nogil except +
 
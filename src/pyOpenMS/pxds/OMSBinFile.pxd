@@ -0,0 +1,45 @@
+from Types cimport *
+from String cimport *
+from ProgressLogger cimport *
+from FeatureMap cimport *
+from ConsensusMap cimport *
+from ProteinIdentification cimport *
+from PeptideIdentification cimport *
+
+cdef extern from "<OpenMS/FORMAT/OMSBinFile.h>" namespace "OpenMS":
+
+    cdef cppclass OMSBinFile(ProgressLogger):
+        # wrap-inherits:
+        #   ProgressLogger
+
+        OMSBinFile() nogil except +
+        OMSBinFile(OMSBinFile) nogil except + #wrap-ignore
+
+        void load(const String& filename, FeatureMap & map) nogil except +
+        void store(const String& filename, FeatureMap & map) nogil except +
+
+        void load(const String& filename, ConsensusMap & map) nogil except +
+        void store(const String& filename, ConsensusMap & map) nogil except +
+
+        void load(const String& filename,
+                  libcpp_vector[ProteinIdentification] & protein_ids,
+                  libcpp_vector[PeptideIdentification] & peptide_ids) nogil except +
+
+        void store(const String& filename,
+                   libcpp_vector[ProteinIdentification] & protein_ids,
+                   libcpp_vector[PeptideIdentification] & peptide_ids) nogil except +
+
+cdef extern from "<OpenMS/FORMAT/OMSBinFile.h>" namespace "OpenMS::OMSBinFile":
+    cdef enum OMSBinFile_ContentType "OpenMS::OMSBinFile::ContentType":
+        #wrap-attach:
+        #    OMSBinFile
+        FEATURES
+        CONSENSUS
+        IDENTIFICATIONS
+
+#
+# wrap static method:
+#
+cdef extern from "<OpenMS/FORMAT/OMSBinFile.h>" namespace "OpenMS::OMSBinFile":
+
+    OMSBinFile_ContentType getContentType(const String& filename) nogil except + # wrap-attach:OMSBinFile
@@ -45,6 +45,11 @@ cdef extern from "<OpenMS/FORMAT/OPTIONS/PeakFileOptions.h>" namespace "OpenMS":
         Size getMaxDataPoolSize() nogil except +
         void setMaxDataPoolSize(Size s) nogil except +
 
+        Size getPipelineQueueDepth() nogil except +
+        void setPipelineQueueDepth(Size depth) nogil except +
+        Size getPipelineMemoryCap() nogil except +
+        void setPipelineMemoryCap(Size bytes) nogil except +
+
         void setSortSpectraByMZ(bool doSort) nogil except +
         bool getSortSpectraByMZ() nogil except +
         void setSortChromatogramsByRT(bool doSort) nogil except +
@@ -17,6 +17,7 @@ cdef extern from "<OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SpectrumAccessSqMass.h>"
         SpectrumAccessSqMass(MzMLSqliteHandler, libcpp_vector[int] indices) nogil except +
 
         # void getAllSpectra(libcpp_vector[ OpenSwath::SpectrumPtr ] & spectra, libcpp_vector< OpenSwath::SpectrumMeta > & spectra_meta) const;
+        # void getSpectraById(libcpp_vector[int] ids, libcpp_vector[ OpenSwath::SpectrumPtr ] & spectra, libcpp_vector< OpenSwath::SpectrumMeta > & spectra_meta) const;
         # SpectrumAccessSqMass(OpenMS::Internal::MzMLSqliteHandler handler);
         # SpectrumAccessSqMass(SpectrumAccessSqMass sp, std::vector<int> indices);
         # SpectrumAccessSqMass(OpenMS::Internal::MzMLSqliteHandler handler, std::vector<int> indices);
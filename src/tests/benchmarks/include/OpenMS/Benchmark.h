@@ -0,0 +1,223 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/CONCEPT/Types.h>
+
+#include <chrono>
+#include <cstdint>
+#include <functional>
+#include <string>
+#include <vector>
+
+/**
+  @brief Minimal micro-benchmark harness for OpenMS kernels
+
+  Benchmarks are registered with OPENMS_BENCHMARK and run by the @em OpenMS_benchmarks
+  executable (see Benchmark_main.cpp). Each benchmark receives a State and times the body
+  of its <tt>while (state.keepRunning())</tt> loop; set-up code before the loop is not timed.
+
+  The runner calibrates the number of iterations per repetition to reach a minimal run time,
+  repeats the measurement several times and reports min/median/mean/stddev per iteration
+  as a table and, optionally, as JSON (for regression tracking).
+
+  @code
+  OPENMS_BENCHMARK(Base64_decode_1M)
+  {
+    String encoded = ...;            // not timed
+    std::vector<double> decoded;
+    while (state.keepRunning())
+    {
+      Base64::decode(encoded, Base64::BYTEORDER_LITTLEENDIAN, decoded);
+      Benchmark::doNotOptimize(decoded);
+    }
+    state.setItemsProcessed(decoded.size());
+  }
+  @endcode
+*/
+namespace OpenMS
+{
+  namespace Benchmark
+  {
+    /// Timing state passed to a benchmark body
+    class State
+    {
+public:
+      explicit State(Size iterations) :
+        iterations_(iterations)
+      {
+      }
+
+      /// Returns true as long as the timed loop should continue; starts and stops the clock
+      bool keepRunning()
+      {
+        if (done_ == 0 && !running_)
+        {
+          running_ = true;
+          start_ = std::chrono::steady_clock::now();
+        }
+        if (done_ < iterations_)
+        {
+          ++done_;
+          return true;
+        }
+        pauseTiming();
+        return false;
+      }
+
+      /// Stops the clock (e.g. to reset input data between iterations)
+      void pauseTiming()
+      {
+        if (!running_) return;
+        elapsed_ += std::chrono::steady_clock::now() - start_;
+        running_ = false;
+      }
+
+      /// Restarts the clock after pauseTiming()
+      void resumeTiming()
+      {
+        if (running_) return;
+        start_ = std::chrono::steady_clock::now();
+        running_ = true;
+      }
+
+      /// Number of items (peaks, spectra, queries, ...) processed per iteration
+      void setItemsProcessed(Size items) { items_ = items; }
+
+      /// Number of bytes processed per iteration
+      void setBytesProcessed(Size bytes) { bytes_ = bytes; }
+
+      Size iterations() const { return iterations_; }
+      Size itemsProcessed() const { return items_; }
+      Size bytesProcessed() const { return bytes_; }
+
+      /// Timed duration in nanoseconds
+      double elapsedNanoseconds() const
+      {
+        return std::chrono::duration<double, std::nano>(elapsed_).count();
+      }
+
+private:
+      Size iterations_;
+      Size done_ = 0;
+      Size items_ = 0;
+      Size bytes_ = 0;
+      bool running_ = false;
+      std::chrono::steady_clock::time_point start_;
+      std::chrono::steady_clock::duration elapsed_{0};
+    };
+
+    /// A registered benchmark
+    struct Entry
+    {
+      std::string name;
+      std::function<void(State&)> function;
+    };
+
+    /// All registered benchmarks (in registration order)
+    inline std::vector<Entry>& registry()
+    {
+      static std::vector<Entry> entries;
+      return entries;
+    }
+
+    /// Registers a benchmark at static initialization time
+    struct Registrar
+    {
+      Registrar(const char* name, std::function<void(State&)> function)
+      {
+        registry().push_back(Entry{name, std::move(function)});
+      }
+    };
+
+    /// Prevents the compiler from optimizing away the computation of @p value
+    template <typename T>
+    inline void doNotOptimize(const T& value)
+    {
+#if defined(__GNUC__) || defined(__clang__)
+      asm volatile("" : : "r,m"(value) : "memory");
+#else
+      static volatile const void* sink;
+      sink = &value;
+#endif
+    }
+
+    /**
+      @brief Deterministic pseudo random numbers (SplitMix64) for reproducible synthetic inputs
+
+      Unlike the standard library distributions, the generated sequence is identical on all platforms.
+    */
+    class Random
+    {
+public:
+      explicit Random(uint64_t seed = 42) :
+        state_(seed)
+      {
+      }
+
+      uint64_t next()
+      {
+        uint64_t z = (state_ += 0x9E3779B97F4A7C15ULL);
+        z = (z ^ (z >> 30)) * 0xBF58476D1CE4E5B9ULL;
+        z = (z ^ (z >> 27)) * 0x94D049BB133111EBULL;
+        return z ^ (z >> 31);
+      }
+
+      /// uniform in [low, high)
+      double uniform(double low, double high)
+      {
+        return low + (high - low) * (double(next() >> 11) * (1.0 / 9007199254740992.0));
+      }
+
+      /// uniform integer in [0, n)
+      Size index(Size n)
+      {
+        return Size(next() % n);
+      }
+
+private:
+      uint64_t state_;
+    };
+
+    /// Runs all benchmarks matching the command line filter; returns the process exit code
+    int runAll(int argc, const char** argv);
+
+  } // namespace Benchmark
+} // namespace OpenMS
+
+#define OPENMS_BENCHMARK(name) \
+  static void OpenMSBenchmark_##name(OpenMS::Benchmark::State& state); \
+  static OpenMS::Benchmark::Registrar OpenMSBenchmarkRegistrar_##name(#name, &OpenMSBenchmark_##name); \
+  static void OpenMSBenchmark_##name(OpenMS::Benchmark::State& state)
@@ -0,0 +1,134 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#pragma once
+
+#include <OpenMS/Benchmark.h>
+
+#include <OpenMS/DATASTRUCTURES/String.h>
+#include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/KERNEL/MSSpectrum.h>
+
+#include <cmath>
+
+/**
+  @brief Reproducible synthetic inputs shared by several benchmarks
+
+  All generators are deterministic for a given Benchmark::Random seed.
+*/
+namespace OpenMS
+{
+  namespace Benchmark
+  {
+    /**
+      @brief Profile spectrum with @p n_peaks Gaussian peaks on a regular m/z grid plus low-level noise
+
+      Peaks are sampled every @p spacing Th with a FWHM of about 6 data points.
+    */
+    inline MSSpectrum profileSpectrum(Random& rng, Size n_peaks, double mz_min = 400.0, double mz_max = 1600.0, double spacing = 0.002)
+    {
+      const Size n_points = Size((mz_max - mz_min) / spacing);
+      std::vector<double> intensities(n_points, 0.0);
+      const double sigma = 2.5 * spacing;
+      for (Size p = 0; p < n_peaks; ++p)
+      {
+        const double apex = rng.uniform(mz_min, mz_max);
+        const double height = std::exp(rng.uniform(std::log(1e2), std::log(1e6)));
+        const SignedSize center = SignedSize((apex - mz_min) / spacing);
+        for (SignedSize i = std::max(SignedSize(0), center - 10); i < std::min(SignedSize(n_points), center + 11); ++i)
+        {
+          const double d = (mz_min + i * spacing - apex) / sigma;
+          intensities[i] += height * std::exp(-0.5 * d * d);
+        }
+      }
+
+      MSSpectrum spectrum;
+      spectrum.setMSLevel(1);
+      spectrum.setType(SpectrumSettings::PROFILE);
+      spectrum.reserve(n_points);
+      for (Size i = 0; i < n_points; ++i)
+      {
+        const double intensity = intensities[i] + rng.uniform(0.0, 20.0);
+        // drop flat noise regions like most instruments do (zero-intensity points are not stored)
+        if (intensity < 10.0) continue;
+        spectrum.emplace_back(mz_min + i * spacing, intensity);
+      }
+      return spectrum;
+    }
+
+    /// Centroided spectrum with @p n_peaks random peaks (sorted by m/z)
+    inline MSSpectrum centroidSpectrum(Random& rng, Size n_peaks, double mz_min = 100.0, double mz_max = 2000.0)
+    {
+      MSSpectrum spectrum;
+      spectrum.setMSLevel(2);
+      spectrum.setType(SpectrumSettings::CENTROID);
+      spectrum.reserve(n_peaks);
+      for (Size i = 0; i < n_peaks; ++i)
+      {
+        spectrum.emplace_back(rng.uniform(mz_min, mz_max), rng.uniform(1.0, 1e5));
+      }
+      spectrum.sortByPosition();
+      return spectrum;
+    }
+
+    /// Experiment of @p n_spectra profile MS1 spectra, 2 s apart
+    inline PeakMap profileExperiment(Random& rng, Size n_spectra, Size n_peaks)
+    {
+      PeakMap exp;
+      for (Size s = 0; s < n_spectra; ++s)
+      {
+        MSSpectrum spectrum = profileSpectrum(rng, n_peaks);
+        spectrum.setRT(2.0 * s);
+        spectrum.setNativeID(String("scan=") + (s + 1));
+        exp.addSpectrum(std::move(spectrum));
+      }
+      exp.updateRanges();
+      return exp;
+    }
+
+    /// Random tryptic peptide sequence (unambiguous amino acids, C-terminal K or R)
+    inline String randomPeptide(Random& rng, Size length)
+    {
+      static const char amino_acids[] = "ACDEFGHILMNPQSTVWY";
+      String peptide;
+      for (Size i = 0; i + 1 < length; ++i)
+      {
+        peptide += amino_acids[rng.index(sizeof(amino_acids) - 1)];
+      }
+      peptide += rng.index(2) ? 'K' : 'R';
+      return peptide;
+    }
+
+  } // namespace Benchmark
+} // namespace OpenMS
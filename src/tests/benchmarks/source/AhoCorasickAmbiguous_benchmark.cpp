@@ -0,0 +1,103 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/ANALYSIS/ID/AhoCorasickAmbiguous.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  /// search @p n_peptides random peptides (partly sampled from the proteins) in 200 random proteins
+  void searchBenchmark(Benchmark::State& state, Size n_peptides, int aaa_max)
+  {
+    Benchmark::Random rng;
+    static const char amino_acids[] = "ACDEFGHIKLMNPQRSTVWY";
+    std::vector<String> proteins;
+    for (Size i = 0; i < 200; ++i)
+    {
+      String protein;
+      for (Size j = 0; j < 400; ++j)
+      {
+        // a few ambiguous amino acids to exercise the ambiguity handling
+        protein += rng.index(200) == 0 ? 'X' : amino_acids[rng.index(sizeof(amino_acids) - 1)];
+      }
+      proteins.push_back(protein);
+    }
+
+    AhoCorasickAmbiguous::PeptideDB pep_db;
+    for (Size i = 0; i < n_peptides; ++i)
+    {
+      String peptide;
+      if (i % 2 == 0)
+      {
+        const String& protein = proteins[rng.index(proteins.size())];
+        peptide = protein.substr(rng.index(protein.size() - 20), 6 + rng.index(14));
+        peptide.substitute('X', 'A');
+      }
+      else
+      {
+        peptide = Benchmark::randomPeptide(rng, 6 + rng.index(14));
+      }
+      seqan::appendValue(pep_db, peptide.c_str());
+    }
+    AhoCorasickAmbiguous::FuzzyACPattern pattern;
+    AhoCorasickAmbiguous::initPattern(pep_db, aaa_max, 0, pattern);
+
+    Size hits = 0;
+    AhoCorasickAmbiguous fuzzyAC;
+    while (state.keepRunning())
+    {
+      for (const String& protein : proteins)
+      {
+        fuzzyAC.setProtein(protein);
+        while (fuzzyAC.findNext(pattern)) ++hits;
+      }
+      Benchmark::doNotOptimize(hits);
+    }
+    state.setItemsProcessed(proteins.size());
+  }
+}
+
+OPENMS_BENCHMARK(AhoCorasickAmbiguous_search_10k)
+{
+  searchBenchmark(state, 10000, 0);
+}
+
+OPENMS_BENCHMARK(AhoCorasickAmbiguous_search_10k_aaa3)
+{
+  searchBenchmark(state, 10000, 3);
+}
@@ -0,0 +1,93 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+
+#include <OpenMS/FORMAT/Base64.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  std::vector<double> randomDoubles(Size n)
+  {
+    Benchmark::Random rng;
+    std::vector<double> values(n);
+    for (double& v : values) v = rng.uniform(100.0, 2000.0);
+    return values;
+  }
+}
+
+OPENMS_BENCHMARK(Base64_encode_double_1M)
+{
+  std::vector<double> values = randomDoubles(1000000);
+  String encoded;
+  while (state.keepRunning())
+  {
+    Base64::encode(values, Base64::BYTEORDER_LITTLEENDIAN, encoded);
+    Benchmark::doNotOptimize(encoded);
+  }
+  state.setItemsProcessed(values.size());
+  state.setBytesProcessed(values.size() * sizeof(double));
+}
+
+OPENMS_BENCHMARK(Base64_decode_double_1M)
+{
+  std::vector<double> values = randomDoubles(1000000);
+  String encoded;
+  Base64::encode(values, Base64::BYTEORDER_LITTLEENDIAN, encoded);
+  std::vector<double> decoded;
+  while (state.keepRunning())
+  {
+    Base64::decode(encoded, Base64::BYTEORDER_LITTLEENDIAN, decoded);
+    Benchmark::doNotOptimize(decoded);
+  }
+  state.setItemsProcessed(values.size());
+  state.setBytesProcessed(encoded.size());
+}
+
+OPENMS_BENCHMARK(Base64_decode_double_zlib_1M)
+{
+  std::vector<double> values = randomDoubles(1000000);
+  String encoded;
+  Base64::encode(values, Base64::BYTEORDER_LITTLEENDIAN, encoded, true);
+  std::vector<double> decoded;
+  while (state.keepRunning())
+  {
+    Base64::decode(encoded, Base64::BYTEORDER_LITTLEENDIAN, decoded, true);
+    Benchmark::doNotOptimize(decoded);
+  }
+  state.setItemsProcessed(values.size());
+  state.setBytesProcessed(encoded.size());
+}
@@ -0,0 +1,236 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+
+#include <OpenMS/CONCEPT/VersionInfo.h>
+#include <OpenMS/DATASTRUCTURES/String.h>
+
+#include <algorithm>
+#include <cmath>
+#include <cstdlib>
+#include <ctime>
+#include <fstream>
+#include <iomanip>
+#include <iostream>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
+using namespace OpenMS;
+
+namespace
+{
+  struct Result
+  {
+    std::string name;
+    Size iterations = 0;
+    std::vector<double> ns_per_iteration; // one entry per repetition
+    Size items = 0;
+    Size bytes = 0;
+    std::string error;
+
+    double min() const { return *std::min_element(ns_per_iteration.begin(), ns_per_iteration.end()); }
+    double mean() const
+    {
+      double sum = 0.0;
+      for (double t : ns_per_iteration) sum += t;
+      return sum / ns_per_iteration.size();
+    }
+    double median() const
+    {
+      std::vector<double> t = ns_per_iteration;
+      std::sort(t.begin(), t.end());
+      return t.size() % 2 ? t[t.size() / 2] : 0.5 * (t[t.size() / 2 - 1] + t[t.size() / 2]);
+    }
+    double stddev() const
+    {
+      if (ns_per_iteration.size() < 2) return 0.0;
+      double m = mean(), sum = 0.0;
+      for (double t : ns_per_iteration) sum += (t - m) * (t - m);
+      return std::sqrt(sum / (ns_per_iteration.size() - 1));
+    }
+  };
+
+  void printUsage(const char* exe)
+  {
+    std::cerr << "Usage: " << exe << " [options]\n"
+              << "  --list                 list all benchmarks and exit\n"
+              << "  --filter <text>        only run benchmarks whose name contains <text>\n"
+              << "  --min_time <seconds>   minimal run time per repetition (default: 0.1)\n"
+              << "  --repetitions <n>      number of timed repetitions (default: 5)\n"
+              << "  --out <file>           write results as JSON to <file>\n";
+  }
+
+  Result run(const Benchmark::Entry& entry, double min_time, Size repetitions)
+  {
+    Result r;
+    r.name = entry.name;
+    try
+    {
+      // calibrate the number of iterations to reach the minimal run time
+      Size iterations = 1;
+      while (true)
+      {
+        Benchmark::State state(iterations);
+        entry.function(state);
+        const double seconds = state.elapsedNanoseconds() * 1e-9;
+        if (seconds >= min_time || iterations >= (Size(1) << 30)) break;
+        const double factor = seconds > 0.0 ? 1.4 * min_time / seconds : 10.0;
+        iterations = std::max(iterations + 1, Size(double(iterations) * std::min(factor, 10.0)));
+      }
+      r.iterations = iterations;
+
+      for (Size rep = 0; rep < repetitions; ++rep)
+      {
+        Benchmark::State state(iterations);
+        entry.function(state);
+        r.ns_per_iteration.push_back(state.elapsedNanoseconds() / double(iterations));
+        r.items = state.itemsProcessed();
+        r.bytes = state.bytesProcessed();
+      }
+    }
+    catch (std::exception& e)
+    {
+      r.error = e.what();
+    }
+    return r;
+  }
+
+  void writeJSON(std::ostream& os, const std::vector<Result>& results, double min_time, Size repetitions)
+  {
+    int threads = 1;
+#ifdef _OPENMP
+    threads = omp_get_max_threads();
+#endif
+    char date[32];
+    std::time_t now = std::time(nullptr);
+    std::strftime(date, sizeof(date), "%Y-%m-%dT%H:%M:%S", std::localtime(&now));
+
+    os << std::setprecision(6) << std::fixed;
+    os << "{\n  \"context\": {\"date\": \"" << date << "\", \"openms_version\": \"" << VersionInfo::getVersion()
+       << "\", \"max_threads\": " << threads << ", \"min_time_s\": " << min_time << ", \"repetitions\": " << repetitions << "},\n"
+       << "  \"benchmarks\": [";
+    for (Size i = 0; i < results.size(); ++i)
+    {
+      const Result& r = results[i];
+      os << (i == 0 ? "\n" : ",\n") << "    {\"name\": \"" << r.name << "\"";
+      if (!r.error.empty())
+      {
+        os << ", \"error\": \"" << String(r.error).substitute("\\", "\\\\").substitute("\"", "\\\"") << "\"}";
+        continue;
+      }
+      os << ", \"iterations\": " << r.iterations
+         << ", \"ns_per_iteration\": {\"min\": " << r.min() << ", \"median\": " << r.median()
+         << ", \"mean\": " << r.mean() << ", \"stddev\": " << r.stddev() << "}";
+      if (r.items > 0) os << ", \"items_per_second\": " << double(r.items) * 1e9 / r.median();
+      if (r.bytes > 0) os << ", \"bytes_per_second\": " << double(r.bytes) * 1e9 / r.median();
+      os << "}";
+    }
+    os << "\n  ]\n}\n";
+  }
+}
+
+int OpenMS::Benchmark::runAll(int argc, const char** argv)
+{
+  std::string filter;
+  std::string out;
+  double min_time = 0.1;
+  Size repetitions = 5;
+  bool list = false;
+  for (int i = 1; i < argc; ++i)
+  {
+    const std::string arg = argv[i];
+    const bool has_value = i + 1 < argc;
+    if (arg == "--list") list = true;
+    else if (arg == "--filter" && has_value) filter = argv[++i];
+    else if (arg == "--out" && has_value) out = argv[++i];
+    else if (arg == "--min_time" && has_value) min_time = std::atof(argv[++i]);
+    else if (arg == "--repetitions" && has_value) repetitions = std::max(1, std::atoi(argv[++i]));
+    else
+    {
+      printUsage(argv[0]);
+      return 1;
+    }
+  }
+
+  // registration order depends on the static initialization order of the translation units
+  std::vector<Entry> entries = registry();
+  std::sort(entries.begin(), entries.end(), [](const Entry& a, const Entry& b) { return a.name < b.name; });
+
+  if (list)
+  {
+    for (const Entry& e : entries) std::cout << e.name << "\n";
+    return 0;
+  }
+
+  std::vector<Result> results;
+  std::cout << std::left << std::setw(48) << "Benchmark" << std::right << std::setw(14) << "median [ns]"
+            << std::setw(14) << "min [ns]" << std::setw(10) << "rsd [%]" << std::setw(12) << "iterations" << "\n"
+            << std::string(98, '-') << std::endl;
+  bool failed = false;
+  for (const Entry& e : entries)
+  {
+    if (!filter.empty() && e.name.find(filter) == std::string::npos) continue;
+    results.push_back(run(e, min_time, repetitions));
+    const Result& r = results.back();
+    std::cout << std::left << std::setw(48) << r.name << std::right;
+    if (!r.error.empty())
+    {
+      std::cout << "  ERROR: " << r.error << std::endl;
+      failed = true;
+      continue;
+    }
+    std::cout << std::fixed << std::setprecision(0) << std::setw(14) << r.median() << std::setw(14) << r.min()
+              << std::setprecision(2) << std::setw(10) << 100.0 * r.stddev() / r.mean() << std::setw(12) << r.iterations << std::endl;
+  }
+
+  if (!out.empty())
+  {
+    std::ofstream os(out.c_str());
+    if (!os)
+    {
+      std::cerr << "Error: unable to write '" << out << "'." << std::endl;
+      return 1;
+    }
+    writeJSON(os, results, min_time, repetitions);
+  }
+  return failed ? 1 : 0;
+}
+
+int main(int argc, const char** argv)
+{
+  return OpenMS::Benchmark::runAll(argc, argv);
+}
@@ -0,0 +1,92 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/ANALYSIS/OPENSWATH/ChromatogramExtractorAlgorithm.h>
+#include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  void extractBenchmark(Benchmark::State& state, double rt_window)
+  {
+    Benchmark::Random rng;
+    boost::shared_ptr<PeakMap> exp(new PeakMap(Benchmark::profileExperiment(rng, 300, 300)));
+    OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(exp);
+
+    std::vector<ChromatogramExtractorAlgorithm::ExtractionCoordinates> coordinates(2000);
+    for (Size i = 0; i < coordinates.size(); ++i)
+    {
+      coordinates[i].mz = rng.uniform(400.0, 1600.0);
+      if (rt_window > 0.0)
+      {
+        coordinates[i].rt_start = rng.uniform(0.0, 600.0 - rt_window);
+        coordinates[i].rt_end = coordinates[i].rt_start + rt_window;
+      }
+      else
+      {
+        coordinates[i].rt_start = 0.0;
+        coordinates[i].rt_end = -1.0; // full RT range
+      }
+      coordinates[i].id = String("tr") + i;
+    }
+    std::sort(coordinates.begin(), coordinates.end(), ChromatogramExtractorAlgorithm::ExtractionCoordinates::SortExtractionCoordinatesByMZ);
+
+    ChromatogramExtractorAlgorithm extractor;
+    std::vector<OpenSwath::ChromatogramPtr> output;
+    while (state.keepRunning())
+    {
+      state.pauseTiming();
+      output.clear();
+      for (Size i = 0; i < coordinates.size(); ++i) output.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+      state.resumeTiming();
+      extractor.extractChromatograms(expptr, output, coordinates, 0.05, false, -1, "tophat");
+      Benchmark::doNotOptimize(output);
+    }
+    state.setItemsProcessed(coordinates.size());
+  }
+}
+
+OPENMS_BENCHMARK(ChromatogramExtractorAlgorithm_extract_full_rt)
+{
+  extractBenchmark(state, -1.0);
+}
+
+OPENMS_BENCHMARK(ChromatogramExtractorAlgorithm_extract_rt_window)
+{
+  extractBenchmark(state, 60.0);
+}
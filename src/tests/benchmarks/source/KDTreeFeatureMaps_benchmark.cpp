@@ -0,0 +1,126 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+
+#include <OpenMS/ANALYSIS/QUANTITATION/KDTreeFeatureMaps.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  std::vector<FeatureMap> randomFeatureMaps(Size n_maps, Size n_features)
+  {
+    Benchmark::Random rng;
+    std::vector<FeatureMap> maps(n_maps);
+    for (FeatureMap& map : maps)
+    {
+      for (Size i = 0; i < n_features; ++i)
+      {
+        Feature f;
+        f.setRT(rng.uniform(0.0, 3600.0));
+        f.setMZ(rng.uniform(300.0, 1500.0));
+        f.setIntensity(rng.uniform(1e3, 1e7));
+        f.setCharge(1 + Int(rng.index(4)));
+        map.push_back(f);
+      }
+    }
+    return maps;
+  }
+
+  Param kdTreeParam()
+  {
+    Param p;
+    p.setValue("rt_tol", 30.0);
+    p.setValue("mz_tol", 10.0);
+    p.setValue("mz_unit", "ppm");
+    return p;
+  }
+}
+
+OPENMS_BENCHMARK(KDTreeFeatureMaps_build)
+{
+  const std::vector<FeatureMap> maps = randomFeatureMaps(10, 10000);
+  while (state.keepRunning())
+  {
+    KDTreeFeatureMaps kd_data(maps, kdTreeParam());
+    kd_data.optimizeTree();
+    Benchmark::doNotOptimize(kd_data);
+  }
+  state.setItemsProcessed(10 * 10000);
+}
+
+OPENMS_BENCHMARK(KDTreeFeatureMaps_getNeighborhood)
+{
+  const std::vector<FeatureMap> maps = randomFeatureMaps(10, 10000);
+  KDTreeFeatureMaps kd_data(maps, kdTreeParam());
+  kd_data.optimizeTree();
+  std::vector<Size> result;
+  Size found = 0;
+  while (state.keepRunning())
+  {
+    for (Size i = 0; i < kd_data.size(); i += 10)
+    {
+      result.clear();
+      kd_data.getNeighborhood(i, result, 30.0, 10.0, true);
+      found += result.size();
+    }
+    Benchmark::doNotOptimize(found);
+  }
+  state.setItemsProcessed(kd_data.size() / 10);
+}
+
+OPENMS_BENCHMARK(KDTreeFeatureMaps_queryRegion)
+{
+  const std::vector<FeatureMap> maps = randomFeatureMaps(10, 10000);
+  KDTreeFeatureMaps kd_data(maps, kdTreeParam());
+  kd_data.optimizeTree();
+  Benchmark::Random rng(7);
+  std::vector<std::pair<double, double> > queries(10000);
+  for (auto& q : queries) q = std::make_pair(rng.uniform(0.0, 3600.0), rng.uniform(300.0, 1500.0));
+  std::vector<Size> result;
+  Size found = 0;
+  while (state.keepRunning())
+  {
+    for (const auto& q : queries)
+    {
+      result.clear();
+      kd_data.queryRegion(q.first - 30.0, q.first + 30.0, q.second - 0.01, q.second + 0.01, result);
+      found += result.size();
+    }
+    Benchmark::doNotOptimize(found);
+  }
+  state.setItemsProcessed(queries.size());
+}
@@ -0,0 +1,122 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/FORMAT/MSNumpressCoder.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  /// m/z and intensity arrays of a realistic profile spectrum
+  void profileArrays(std::vector<double>& mz, std::vector<double>& intensity)
+  {
+    Benchmark::Random rng;
+    const MSSpectrum spectrum = Benchmark::profileSpectrum(rng, 2000);
+    mz.clear();
+    intensity.clear();
+    for (const Peak1D& p : spectrum)
+    {
+      mz.push_back(p.getMZ());
+      intensity.push_back(p.getIntensity());
+    }
+  }
+
+  void encodeBenchmark(Benchmark::State& state, MSNumpressCoder::NumpressCompression compression, bool use_mz)
+  {
+    std::vector<double> mz, intensity;
+    profileArrays(mz, intensity);
+    const std::vector<double>& data = use_mz ? mz : intensity;
+    MSNumpressCoder::NumpressConfig config;
+    config.np_compression = compression;
+    config.numpressErrorTolerance = 0.0; // no round-trip check
+    MSNumpressCoder coder;
+    String encoded;
+    while (state.keepRunning())
+    {
+      coder.encodeNP(data, encoded, false, config);
+      Benchmark::doNotOptimize(encoded);
+    }
+    state.setItemsProcessed(data.size());
+    state.setBytesProcessed(data.size() * sizeof(double));
+  }
+
+  void decodeBenchmark(Benchmark::State& state, MSNumpressCoder::NumpressCompression compression, bool use_mz)
+  {
+    std::vector<double> mz, intensity;
+    profileArrays(mz, intensity);
+    const std::vector<double>& data = use_mz ? mz : intensity;
+    MSNumpressCoder::NumpressConfig config;
+    config.np_compression = compression;
+    config.numpressErrorTolerance = 0.0;
+    MSNumpressCoder coder;
+    String encoded;
+    coder.encodeNP(data, encoded, false, config);
+    std::vector<double> decoded;
+    while (state.keepRunning())
+    {
+      coder.decodeNP(encoded, decoded, false, config);
+      Benchmark::doNotOptimize(decoded);
+    }
+    state.setItemsProcessed(data.size());
+    state.setBytesProcessed(encoded.size());
+  }
+}
+
+OPENMS_BENCHMARK(MSNumpressCoder_encode_linear_mz)
+{
+  encodeBenchmark(state, MSNumpressCoder::LINEAR, true);
+}
+
+OPENMS_BENCHMARK(MSNumpressCoder_decode_linear_mz)
+{
+  decodeBenchmark(state, MSNumpressCoder::LINEAR, true);
+}
+
+OPENMS_BENCHMARK(MSNumpressCoder_encode_slof_intensity)
+{
+  encodeBenchmark(state, MSNumpressCoder::SLOF, false);
+}
+
+OPENMS_BENCHMARK(MSNumpressCoder_decode_slof_intensity)
+{
+  decodeBenchmark(state, MSNumpressCoder::SLOF, false);
+}
+
+OPENMS_BENCHMARK(MSNumpressCoder_decode_pic_intensity)
+{
+  decodeBenchmark(state, MSNumpressCoder::PIC, false);
+}
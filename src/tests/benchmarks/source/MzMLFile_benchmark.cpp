@@ -0,0 +1,100 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/FORMAT/DATAACCESS/MSDataTransformingConsumer.h>
+#include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/SYSTEM/File.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  /// synthetic mzML file (written once, removed on exit)
+  const String& syntheticMzML(bool zlib)
+  {
+    static String files[2];
+    String& filename = files[zlib ? 1 : 0];
+    if (filename.empty())
+    {
+      Benchmark::Random rng;
+      PeakMap exp = Benchmark::profileExperiment(rng, 100, 500);
+      filename = File::getTemporaryFile();
+      MzMLFile f;
+      f.getOptions().setCompression(zlib);
+      f.store(filename, exp);
+    }
+    return filename;
+  }
+}
+
+OPENMS_BENCHMARK(MzMLFile_load)
+{
+  const String& filename = syntheticMzML(false);
+  PeakMap exp;
+  while (state.keepRunning())
+  {
+    MzMLFile().load(filename, exp);
+    Benchmark::doNotOptimize(exp);
+  }
+  state.setItemsProcessed(exp.size());
+}
+
+OPENMS_BENCHMARK(MzMLFile_load_zlib)
+{
+  const String& filename = syntheticMzML(true);
+  PeakMap exp;
+  while (state.keepRunning())
+  {
+    MzMLFile().load(filename, exp);
+    Benchmark::doNotOptimize(exp);
+  }
+  state.setItemsProcessed(exp.size());
+}
+
+OPENMS_BENCHMARK(MzMLFile_transform)
+{
+  const String& filename = syntheticMzML(false);
+  Size peaks = 0;
+  MSDataTransformingConsumer consumer;
+  consumer.setSpectraProcessingFunc([&peaks](MSSpectrum& s) { peaks += s.size(); });
+  while (state.keepRunning())
+  {
+    MzMLFile().transform(filename, &consumer, true);
+    Benchmark::doNotOptimize(peaks);
+  }
+  state.setItemsProcessed(100);
+}
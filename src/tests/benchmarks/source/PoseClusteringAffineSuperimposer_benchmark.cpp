@@ -0,0 +1,76 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+
+#include <OpenMS/ANALYSIS/MAPMATCHING/PoseClusteringAffineSuperimposer.h>
+#include <OpenMS/ANALYSIS/MAPMATCHING/TransformationDescription.h>
+#include <OpenMS/KERNEL/Peak2D.h>
+
+using namespace OpenMS;
+
+OPENMS_BENCHMARK(PoseClusteringAffineSuperimposer_run)
+{
+  // scene = model shifted and scaled in RT, with jitter, missing and additional points
+  Benchmark::Random rng;
+  std::vector<Peak2D> model, scene;
+  for (Size i = 0; i < 2000; ++i)
+  {
+    Peak2D p;
+    p.setRT(rng.uniform(0.0, 3600.0));
+    p.setMZ(rng.uniform(300.0, 1500.0));
+    p.setIntensity(std::exp(rng.uniform(std::log(1e3), std::log(1e7))));
+    model.push_back(p);
+    if (rng.index(10) == 0) continue;
+    p.setRT(1.02 * p.getRT() + 15.0 + rng.uniform(-2.0, 2.0));
+    scene.push_back(p);
+  }
+  for (Size i = 0; i < 200; ++i)
+  {
+    scene.push_back(Peak2D({rng.uniform(0.0, 3600.0), rng.uniform(300.0, 1500.0)}, float(rng.uniform(1e3, 1e7))));
+  }
+
+  PoseClusteringAffineSuperimposer superimposer;
+  Param p = superimposer.getParameters();
+  p.setValue("num_used_points", 1000);
+  superimposer.setParameters(p);
+  superimposer.setLogType(ProgressLogger::NONE);
+  while (state.keepRunning())
+  {
+    TransformationDescription trafo;
+    superimposer.run(model, scene, trafo);
+    Benchmark::doNotOptimize(trafo);
+  }
+  state.setItemsProcessed(model.size());
+}
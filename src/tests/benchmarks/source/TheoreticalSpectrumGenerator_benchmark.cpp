@@ -0,0 +1,95 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/Benchmark.h>
+#include <OpenMS/BenchmarkData.h>
+
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CHEMISTRY/TheoreticalSpectrumGenerator.h>
+
+using namespace OpenMS;
+
+namespace
+{
+  std::vector<AASequence> randomPeptides(Size n)
+  {
+    Benchmark::Random rng;
+    std::vector<AASequence> peptides;
+    for (Size i = 0; i < n; ++i)
+    {
+      peptides.push_back(AASequence::fromString(Benchmark::randomPeptide(rng, 8 + rng.index(17))));
+    }
+    return peptides;
+  }
+}
+
+OPENMS_BENCHMARK(TheoreticalSpectrumGenerator_getSpectrum_by)
+{
+  const std::vector<AASequence> peptides = randomPeptides(100);
+  TheoreticalSpectrumGenerator tsg;
+  PeakSpectrum spectrum;
+  while (state.keepRunning())
+  {
+    for (const AASequence& peptide : peptides)
+    {
+      spectrum.clear(true);
+      tsg.getSpectrum(spectrum, peptide, 1, 2);
+      Benchmark::doNotOptimize(spectrum);
+    }
+  }
+  state.setItemsProcessed(peptides.size());
+}
+
+OPENMS_BENCHMARK(TheoreticalSpectrumGenerator_getSpectrum_full)
+{
+  const std::vector<AASequence> peptides = randomPeptides(100);
+  TheoreticalSpectrumGenerator tsg;
+  Param p = tsg.getParameters();
+  p.setValue("add_a_ions", "true");
+  p.setValue("add_losses", "true");
+  p.setValue("add_precursor_peaks", "true");
+  p.setValue("add_metainfo", "true");
+  tsg.setParameters(p);
+  PeakSpectrum spectrum;
+  while (state.keepRunning())
+  {
+    for (const AASequence& peptide : peptides)
+    {
+      spectrum.clear(true);
+      tsg.getSpectrum(spectrum, peptide, 1, 3);
+      Benchmark::doNotOptimize(spectrum);
+    }
+  }
+  state.setItemsProcessed(peptides.size());
+}
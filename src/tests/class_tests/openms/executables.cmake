@@ -128,6 +128,7 @@ set(system_executables_list
   File_test
   FileWatcher_test
   JavaInfo_test
+  Profiler_test
   PythonInfo_test
   StopWatch_test
   SysInfo_test
@@ -138,6 +139,7 @@ set(kernel_executables_list
   BaseFeature_test
   ChromatogramPeak_test
   ChromatogramTools_test
+  ColumnarMSExperiment_test
   ComparatorUtils_test
   ConsensusFeature_test
   ConsensusMap_test
@@ -202,7 +204,7 @@ set(format_executables_list
   MascotInfile_test
   MascotRemoteQuery_test
   MascotXMLFile_test
-  #MSDataWritingConsumer_test
+  MSDataWritingConsumer_test
   MRMFeaturePickerFile_test
   MsInspectFile_test
   MzDataFile_test
@@ -222,6 +224,7 @@ set(format_executables_list
   MzXMLFile_test
   NoopMSDataConsumer_test
   TraMLValidator_test
+  OMSBinFile_test
   OMSSACSVFile_test
   OMSSAXMLFile_test
   PTMXMLFile_test
@@ -361,6 +364,7 @@ set(comparison_executables_list
   AverageLinkage_test
   BinnedSharedPeakCount_test
   BinnedSpectralContrastAngle_test
+  BinnedSpectralLibrary_test
   BinnedSpectrumCompareFunctor_test
   BinnedSpectrum_test
   BinnedSumAgreeingIntensities_test
@@ -632,6 +636,7 @@ set(simulation_executables_list
   EGHFitter1D_test
   IonizationSimulation_test
   MSSim_test
+  PhiloxRandomEngine_test
   RTSimulation_test
   RawMSSignalSimulation_test
   RawTandemMSSignalSimulation_test
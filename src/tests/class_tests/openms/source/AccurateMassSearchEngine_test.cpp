@@ -296,6 +296,72 @@ START_SECTION((void queryByConsensusFeature(const ConsensusFeature& cfeat, const
 }
 END_SECTION
 
+START_SECTION((void queryByFeatures(const FeatureMap& fmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult> >& results) const))
+{
+  // batch search must agree with searching feature by feature
+  FeatureMap fmap;
+  const double mzs[] = {500.0, 399.33486, 100.0, 399.33486};
+  for (Size i = 0; i < 4; ++i)
+  {
+    Feature f;
+    f.setRT(100.0 * i);
+    f.setMZ(mzs[i]);
+    f.setCharge(1);
+    fmap.push_back(f);
+  }
+
+  std::vector<std::vector<AccurateMassSearchResult> > results;
+  ams_feat_test.queryByFeatures(fmap, "positive", results);
+  TEST_EQUAL(results.size(), fmap.size())
+
+  for (Size i = 0; i < fmap.size(); ++i)
+  {
+    std::vector<AccurateMassSearchResult> single;
+    ams_feat_test.queryByFeature(fmap[i], i, "positive", single);
+    TEST_EQUAL(results[i].size(), single.size())
+    ABORT_IF(results[i].size() != single.size())
+    for (Size j = 0; j < single.size(); ++j)
+    {
+      TEST_STRING_EQUAL(results[i][j].getFormulaString(), single[j].getFormulaString())
+      TEST_EQUAL(results[i][j].getSourceFeatureIndex(), i)
+      TEST_REAL_SIMILAR(results[i][j].getObservedRT(), 100.0 * i)
+    }
+  }
+  TEST_EQUAL(results[1].size(), 3)
+
+  TEST_EXCEPTION(Exception::InvalidParameter, ams_feat_test.queryByFeatures(fmap, "blabla", results))
+}
+END_SECTION
+
+START_SECTION((void queryByConsensusFeatures(const ConsensusMap& cmap, const String& ion_mode, std::vector<std::vector<AccurateMassSearchResult> >& results) const))
+{
+  ConsensusMap cmap;
+  cmap.getColumnHeaders()[0].size = 1;
+  cmap.getColumnHeaders()[1].size = 1;
+  const double mzs[] = {500.0, 399.33486};
+  for (Size i = 0; i < 2; ++i)
+  {
+    ConsensusFeature cf;
+    cf.setRT(300.0);
+    cf.setMZ(mzs[i]);
+    cf.setCharge(1);
+    cmap.push_back(cf);
+  }
+
+  std::vector<std::vector<AccurateMassSearchResult> > results;
+  ams_feat_test.queryByConsensusFeatures(cmap, "positive", results);
+  TEST_EQUAL(results.size(), 2)
+  ABORT_IF(results.size() != 2)
+  TEST_EQUAL(results[1].size(), 3)
+  for (Size i = 0; i < results[1].size(); ++i)
+  {
+    TEST_STRING_EQUAL(results[1][i].getFormulaString(), feat_query_pos[i])
+    TEST_EQUAL(results[1][i].getSourceFeatureIndex(), 1)
+    TEST_EQUAL(results[1][i].getIndividualIntensities().size(), 2)
+  }
+}
+END_SECTION
+
 FuzzyStringComparator fsc;
 // fsc.setAcceptableAbsolute((3.04011223650013 - 3.04011223637974)*1.1); // 1.3242891228060217e-10
 // also Linux may give slightly different results depending on optimization level (O0 vs O1) 
@@ -0,0 +1,220 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/COMPARISON/SPECTRA/BinnedSpectralLibrary.h>
+#include <OpenMS/COMPARISON/SPECTRA/BinnedSpectralContrastAngle.h>
+#include <OpenMS/FORMAT/DTAFile.h>
+///////////////////////////
+
+#include <fstream>
+#include <iterator>
+#include <limits>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(BinnedSpectralLibrary, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+BinnedSpectralLibrary* ptr = nullptr;
+BinnedSpectralLibrary* nullPointer = nullptr;
+START_SECTION(BinnedSpectralLibrary())
+{
+  ptr = new BinnedSpectralLibrary();
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  TEST_EQUAL(ptr->empty(), true)
+}
+END_SECTION
+
+START_SECTION(virtual ~BinnedSpectralLibrary())
+{
+  delete ptr;
+}
+END_SECTION
+
+// three library spectra derived from the same test spectrum, deliberately not sorted by precursor m/z
+PeakSpectrum s1;
+DTAFile().load(OPENMS_GET_TEST_DATA_PATH("PILISSequenceDB_DFPIANGER_1.dta"), s1);
+s1.getPrecursors().resize(1);
+s1.getPrecursors()[0].setMZ(500.0);
+s1.getPrecursors()[0].setCharge(2);
+PeakSpectrum s2(s1);
+s2.pop_back();
+s2.getPrecursors()[0].setMZ(400.0);
+PeakSpectrum s3(s1);
+s3.erase(s3.begin(), s3.begin() + s3.size() / 2);
+s3.getPrecursors()[0].setMZ(500.5);
+s3.getPrecursors()[0].setCharge(3);
+vector<PeakSpectrum> spectra = {s1, s2, s3};
+vector<String> identifiers = {"first", "second", "third"};
+
+BinnedSpectralLibrary lib(1.5, false, 2, BinnedSpectrum::DEFAULT_BIN_OFFSET_LOWRES);
+
+START_SECTION((void build(const std::vector<PeakSpectrum>& spectra, const std::vector<String>& identifiers)))
+{
+  lib.build(spectra, identifiers);
+  TEST_EQUAL(lib.size(), 3)
+  TEST_EQUAL(lib.getMatrix().rows(), 3)
+  TEST_EQUAL(lib.getIdentifiers()[0], "second")
+  TEST_EQUAL(lib.getIdentifiers()[1], "first")
+  TEST_EQUAL(lib.getIdentifiers()[2], "third")
+  TEST_EQUAL(lib.getInputIndices()[0], 1)
+  TEST_REAL_SIMILAR(lib.getPrecursorMZs()[2], 500.5)
+  TEST_EQUAL(lib.getPrecursorCharges()[2], 3)
+
+  TEST_EXCEPTION(Exception::IllegalArgument, lib.build(spectra, vector<String>(1, "x")))
+}
+END_SECTION
+
+START_SECTION((RowRange getPrecursorRange(double mz_low, double mz_high) const))
+{
+  BinnedSpectralLibrary::RowRange r = lib.getPrecursorRange(450.0, 501.0);
+  TEST_EQUAL(r.first, 1)
+  TEST_EQUAL(r.second, 3)
+  r = lib.getPrecursorRange(600.0, 700.0);
+  TEST_EQUAL(r.first, r.second)
+}
+END_SECTION
+
+START_SECTION((void score(const BinnedSpectrum& query, const RowRange& range, std::vector<double>& scores) const))
+{
+  // must agree with the pairwise contrast angle
+  BinnedSpectralContrastAngle bsca;
+  BinnedSpectrum query = lib.binSpectrum(s1);
+  vector<double> scores;
+  lib.score(query, BinnedSpectralLibrary::RowRange(0, 3), scores);
+  TEST_EQUAL(scores.size(), 3)
+  TEST_REAL_SIMILAR(scores[0], bsca(query, lib.binSpectrum(s2)))
+  TEST_REAL_SIMILAR(scores[1], 1.0)
+  TEST_REAL_SIMILAR(scores[2], bsca(query, lib.binSpectrum(s3)))
+}
+END_SECTION
+
+START_SECTION((void scoreBatch(const std::vector<BinnedSpectrum>& queries, const std::vector<RowRange>& ranges, std::vector<std::vector<double> >& scores, Size block_size = 64) const))
+{
+  vector<BinnedSpectrum> queries = {lib.binSpectrum(s3), lib.binSpectrum(s1), lib.binSpectrum(s2)};
+  vector<BinnedSpectralLibrary::RowRange> ranges = {{1, 3}, {0, 3}, {3, 3}};
+  vector<vector<double> > scores;
+  lib.scoreBatch(queries, ranges, scores, 2);
+  TEST_EQUAL(scores.size(), 3)
+  TEST_EQUAL(scores[0].size(), 2)
+  TEST_EQUAL(scores[1].size(), 3)
+  TEST_EQUAL(scores[2].size(), 0)
+  TEST_REAL_SIMILAR(scores[0][1], 1.0)
+
+  vector<double> single;
+  lib.score(queries[1], ranges[1], single);
+  for (Size i = 0; i < single.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(scores[1][i], single[i])
+  }
+
+  TEST_EXCEPTION(Exception::IllegalArgument, lib.scoreBatch(queries, vector<BinnedSpectralLibrary::RowRange>(1), scores))
+}
+END_SECTION
+
+START_SECTION((void store(const String& filename) const))
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  lib.store(filename);
+
+  BinnedSpectralLibrary loaded;
+  loaded.load(filename);
+  TEST_EQUAL(loaded.size(), lib.size())
+  TEST_REAL_SIMILAR(loaded.getBinSize(), 1.5)
+  TEST_EQUAL(loaded.getBinSpread(), 2)
+  TEST_EQUAL(loaded.isUnitPPM(), false)
+  TEST_EQUAL(loaded.getIdentifiers() == lib.getIdentifiers(), true)
+  TEST_EQUAL(loaded.getPrecursorCharges() == lib.getPrecursorCharges(), true)
+  TEST_EQUAL(loaded.getMatrix().nonZeros(), lib.getMatrix().nonZeros())
+  TEST_EQUAL(loaded.getInputIndices().empty(), true)
+  TEST_EQUAL(loaded.getSourceFingerprint(), "")
+
+  // the fingerprint of the source is stored with the library
+  BinnedSpectralLibrary lib_with_source(lib);
+  lib_with_source.setSourceFingerprint("library.msp|12345");
+  lib_with_source.store(filename);
+  loaded.load(filename);
+  TEST_EQUAL(loaded.getSourceFingerprint(), "library.msp|12345")
+  TEST_EQUAL(loaded.getIdentifiers() == lib.getIdentifiers(), true)
+
+  vector<double> scores;
+  loaded.score(loaded.binSpectrum(s1), BinnedSpectralLibrary::RowRange(0, 3), scores);
+  TEST_REAL_SIMILAR(scores[1], 1.0)
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename)))
+{
+  BinnedSpectralLibrary loaded;
+  TEST_EXCEPTION(Exception::FileNotFound, loaded.load("this_file_does_not_exist.bin"))
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(OPENMS_GET_TEST_DATA_PATH("PILISSequenceDB_DFPIANGER_1.dta")))
+
+  String filename;
+  NEW_TMP_FILE(filename)
+  lib.store(filename);
+  std::string content;
+  {
+    std::ifstream ifs(filename.c_str(), std::ios::binary);
+    content.assign(std::istreambuf_iterator<char>(ifs), std::istreambuf_iterator<char>());
+  }
+
+  // truncated file (last identifier incomplete)
+  String truncated;
+  NEW_TMP_FILE(truncated)
+  std::ofstream(truncated.c_str(), std::ios::binary).write(content.data(), content.size() - 1);
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(truncated))
+  TEST_EQUAL(loaded.empty(), true)
+
+  // string length (of the source fingerprint, right after the 41 byte header) beyond the end of the file
+  String corrupt;
+  NEW_TMP_FILE(corrupt)
+  std::string corrupt_content(content);
+  const Size huge_length = std::numeric_limits<Size>::max() - 4;
+  corrupt_content.replace(41, sizeof(Size), (const char*)&huge_length, sizeof(Size));
+  std::ofstream(corrupt.c_str(), std::ios::binary).write(corrupt_content.data(), corrupt_content.size());
+  TEST_EXCEPTION(Exception::ParseError, loaded.load(corrupt))
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -39,6 +39,8 @@
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/ANALYSIS/OPENSWATH/DATAACCESS/SimpleOpenMSSpectraAccessFactory.h>
 
+#include <algorithm>
+
 using namespace OpenMS;
 using namespace std;
 
@@ -136,6 +138,68 @@ START_SECTION(void extractChromatograms(const OpenSwath::SpectrumAccessPtr input
 }
 END_SECTION
 
+START_SECTION([EXTRA] extractChromatograms with RT windows (sweep over RT))
+{
+  double extract_window = 0.05;
+  boost::shared_ptr<PeakMap > exp(new PeakMap);
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("ChromatogramExtractor_input.mzML"), *exp);
+
+  // same spectra in reverse RT order (restarts the sweep for every spectrum)
+  boost::shared_ptr<PeakMap > reversed(new PeakMap(*exp));
+  std::reverse(reversed->begin(), reversed->end());
+
+  // many coordinates with overlapping, empty and unbounded RT windows
+  std::vector< ChromatogramExtractorAlgorithm::ExtractionCoordinates > coordinates;
+  for (Size i = 0; i < 200; ++i)
+  {
+    ChromatogramExtractorAlgorithm::ExtractionCoordinates coord;
+    coord.mz = 600.0 + 0.37 * i;
+    coord.rt_start = 3000.0 + (i * 7) % 150;
+    coord.rt_end = i % 5 == 0 ? -1 : coord.rt_start + (i * 13) % 120;
+    coord.id = String(i);
+    coordinates.push_back(coord);
+  }
+
+  for (const auto& map : {exp, reversed})
+  {
+    OpenSwath::SpectrumAccessPtr expptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(map);
+    std::vector< OpenSwath::ChromatogramPtr > out_exp;
+    for (Size i = 0; i < coordinates.size(); i++)
+    {
+      out_exp.push_back(OpenSwath::ChromatogramPtr(new OpenSwath::Chromatogram));
+    }
+    ChromatogramExtractorAlgorithm extractor;
+    extractor.extractChromatograms(expptr, out_exp, coordinates, extract_window, false, -1, "tophat");
+
+    // compare to extracting each coordinate from each spectrum separately
+    Size nr_points = 0;
+    for (Size k = 0; k < coordinates.size(); ++k)
+    {
+      std::vector<double> rts, intensities;
+      for (Size s = 0; s < expptr->getNrSpectra(); ++s)
+      {
+        double rt = expptr->getSpectrumMetaById(s).RT;
+        OpenSwath::SpectrumPtr sptr = expptr->getSpectrumById(s);
+        const std::vector<double>& mz = sptr->getMZArray()->data;
+        if (mz.empty()) continue;
+        if (coordinates[k].rt_end - coordinates[k].rt_start > 0 &&
+            (rt < coordinates[k].rt_start || rt > coordinates[k].rt_end)) continue;
+        std::vector<double>::const_iterator mz_it = mz.begin();
+        std::vector<double>::const_iterator int_it = sptr->getIntensityArray()->data.begin();
+        double intensity = 0;
+        extractor.extract_value_tophat(mz.begin(), mz_it, mz.end(), int_it, coordinates[k].mz, intensity, extract_window, false);
+        rts.push_back(rt);
+        intensities.push_back(intensity);
+      }
+      TEST_EQUAL(out_exp[k]->getTimeArray()->data == rts, true)
+      TEST_EQUAL(out_exp[k]->getIntensityArray()->data == intensities, true)
+      nr_points += rts.size();
+    }
+    TEST_EQUAL(nr_points > 0, true)
+  }
+}
+END_SECTION
+
 START_SECTION([EXTRA] void extractChromatograms(const OpenSwath::SpectrumAccessPtr input, std::vector< OpenSwath::ChromatogramPtr > &output, std::vector< ExtractionCoordinates >& extraction_coordinates, double mz_extraction_window, bool ppm, String filter))
 {
   typedef OpenMS::DataArrays::FloatDataArray FloatDataArray;
@@ -0,0 +1,274 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/KERNEL/ColumnarMSExperiment.h>
+///////////////////////////
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(ColumnarMSExperiment, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+PeakMap exp;
+{
+  MSSpectrum s1;
+  s1.setRT(10.0);
+  s1.setMSLevel(1);
+  s1.setNativeID("scan=1");
+  s1.setType(SpectrumSettings::PROFILE);
+  s1.emplace_back(100.0, 1.0f);
+  s1.emplace_back(200.0, 2.0f);
+  s1.emplace_back(300.0, 3.0f);
+  exp.addSpectrum(s1);
+
+  MSSpectrum s2;
+  s2.setRT(20.0);
+  s2.setMSLevel(2);
+  s2.setNativeID("scan=2");
+  Precursor prec;
+  prec.setMZ(500.5);
+  prec.setCharge(2);
+  s2.getPrecursors().push_back(prec);
+  s2.emplace_back(150.0, 5.0f);
+  exp.addSpectrum(s2);
+
+  MSSpectrum s3; // empty
+  s3.setRT(30.0);
+  s3.setNativeID("scan=3");
+  exp.addSpectrum(s3);
+}
+
+ColumnarMSExperiment* ptr = nullptr;
+ColumnarMSExperiment* null_ptr = nullptr;
+START_SECTION(ColumnarMSExperiment())
+{
+  ptr = new ColumnarMSExperiment();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+  TEST_EQUAL(ptr->size(), 0)
+  TEST_EQUAL(ptr->empty(), true)
+  TEST_EQUAL(ptr->getNrPeaks(), 0)
+  TEST_EQUAL(ptr->getOffsets().size(), 1)
+}
+END_SECTION
+
+START_SECTION(~ColumnarMSExperiment())
+{
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION(explicit ColumnarMSExperiment(const PeakMap& exp))
+{
+  ColumnarMSExperiment col(exp);
+  TEST_EQUAL(col.size(), 3)
+  TEST_EQUAL(col.getNrPeaks(), 4)
+  TEST_EQUAL(col.getOffsets().size(), 4)
+  TEST_EQUAL(col.getOffsets()[1], 3)
+  TEST_EQUAL(col.getOffsets()[2], 4)
+  TEST_EQUAL(col.getOffsets()[3], 4)
+  TEST_EQUAL(col.getMZArray().size(), 4)
+  TEST_EQUAL(col.getIntensityArray().size(), 4)
+  TEST_REAL_SIMILAR(col.getMZArray()[3], 150.0)
+}
+END_SECTION
+
+START_SECTION(void addSpectrum(const MSSpectrum& spectrum))
+{
+  ColumnarMSExperiment col;
+  col.addSpectrum(exp[1]);
+  TEST_EQUAL(col.size(), 1)
+  TEST_EQUAL(col.getNrPeaks(), 1)
+  TEST_REAL_SIMILAR(col.getSpectrumMeta(0).precursor_mz, 500.5)
+  TEST_EQUAL(col.getSpectrumMeta(0).precursor_charge, 2)
+  TEST_EQUAL(col.getSpectrumMeta(0).ms_level, 2)
+}
+END_SECTION
+
+START_SECTION(void reserve(Size nr_spectra, Size nr_peaks))
+{
+  ColumnarMSExperiment col;
+  col.reserve(10, 1000);
+  TEST_EQUAL(col.size(), 0)
+  TEST_EQUAL(col.getMZArray().capacity() >= 1000, true)
+}
+END_SECTION
+
+START_SECTION(void clear(bool clear_memory = false))
+{
+  ColumnarMSExperiment col(exp);
+  col.clear();
+  TEST_EQUAL(col.size(), 0)
+  TEST_EQUAL(col.getNrPeaks(), 0)
+  TEST_EQUAL(col.getOffsets().size(), 1)
+  col = ColumnarMSExperiment(exp);
+  col.clear(true);
+  TEST_EQUAL(col.size(), 0)
+  TEST_EQUAL(col.getOffsets().size(), 1)
+}
+END_SECTION
+
+START_SECTION(bool operator==(const ColumnarMSExperiment& rhs) const)
+{
+  ColumnarMSExperiment col1(exp), col2(exp), empty;
+  TEST_EQUAL(col1 == col2, true)
+  TEST_EQUAL(col1 == empty, false)
+}
+END_SECTION
+
+START_SECTION(SpectrumView operator[](Size index) const)
+{
+  ColumnarMSExperiment col(exp);
+  ColumnarMSExperiment::SpectrumView v0 = col[0];
+  TEST_EQUAL(v0.size(), 3)
+  TEST_EQUAL(v0.empty(), false)
+  TEST_REAL_SIMILAR(v0.getRT(), 10.0)
+  TEST_EQUAL(v0.getMSLevel(), 1)
+  TEST_EQUAL(v0.getNativeID(), "scan=1")
+  TEST_EQUAL(v0.getType(), SpectrumSettings::PROFILE)
+  TEST_REAL_SIMILAR(v0.getMZ(1), 200.0)
+  TEST_REAL_SIMILAR(v0.getIntensity(2), 3.0)
+  TEST_EQUAL(v0.mzEnd() - v0.mzBegin(), 3)
+  TEST_EQUAL(v0.intensityEnd() - v0.intensityBegin(), 3)
+  // views point into the shared arrays
+  TEST_EQUAL(v0.mzBegin() == col.getMZArray().data(), true)
+
+  ColumnarMSExperiment::SpectrumView v1 = col[1];
+  TEST_EQUAL(v1.mzBegin() == col.getMZArray().data() + 3, true)
+  TEST_REAL_SIMILAR(v1.getPrecursorMZ(), 500.5)
+  TEST_EQUAL(v1.getPrecursorCharge(), 2)
+
+  TEST_EQUAL(col[2].empty(), true)
+}
+END_SECTION
+
+START_SECTION([EXTRA] SpectrumView::ConstIterator)
+{
+  ColumnarMSExperiment col(exp);
+  ColumnarMSExperiment::SpectrumView v0 = col[0];
+  TEST_EQUAL(v0.end() - v0.begin(), 3)
+  TEST_REAL_SIMILAR((*v0.begin()).getMZ(), 100.0)
+  TEST_REAL_SIMILAR(v0.begin()[2].getIntensity(), 3.0)
+  TEST_REAL_SIMILAR(v0[1].getMZ(), 200.0)
+
+  std::vector<Peak1D> peaks(v0.begin(), v0.end());
+  TEST_EQUAL(peaks.size(), 3)
+  TEST_EQUAL(peaks[2] == exp[0][2], true)
+  TEST_EQUAL(col[2].begin() == col[2].end(), true)
+}
+END_SECTION
+
+START_SECTION(SpectrumView getSpectrumView(Size index) const)
+{
+  ColumnarMSExperiment col(exp);
+  TEST_EQUAL(col.getSpectrumView(1).size(), 1)
+  TEST_EXCEPTION(Exception::IndexOverflow, col.getSpectrumView(3))
+}
+END_SECTION
+
+START_SECTION(MSSpectrum getSpectrum(Size index) const)
+{
+  ColumnarMSExperiment col(exp);
+  MSSpectrum s0 = col.getSpectrum(0);
+  TEST_EQUAL(s0.size(), 3)
+  TEST_REAL_SIMILAR(s0[0].getMZ(), 100.0)
+  TEST_REAL_SIMILAR(s0[0].getIntensity(), 1.0)
+  TEST_REAL_SIMILAR(s0.getRT(), 10.0)
+  TEST_EQUAL(s0.getNativeID(), "scan=1")
+  TEST_EQUAL(s0.getPrecursors().size(), 0)
+
+  MSSpectrum s1 = col.getSpectrum(1);
+  TEST_EQUAL(s1.getMSLevel(), 2)
+  TEST_EQUAL(s1.getPrecursors().size(), 1)
+  TEST_REAL_SIMILAR(s1.getPrecursors()[0].getMZ(), 500.5)
+  TEST_EQUAL(s1.getPrecursors()[0].getCharge(), 2)
+
+  TEST_EXCEPTION(Exception::IndexOverflow, col.getSpectrum(3))
+}
+END_SECTION
+
+START_SECTION(void copySpectrumMeta(Size index, MSSpectrum& spectrum) const)
+{
+  ColumnarMSExperiment col(exp);
+  MSSpectrum s;
+  s.emplace_back(1.0, 1.0f);
+  col.copySpectrumMeta(1, s);
+  TEST_EQUAL(s.size(), 1)
+  TEST_REAL_SIMILAR(s.getRT(), 20.0)
+  TEST_EQUAL(s.getMSLevel(), 2)
+  TEST_EQUAL(s.getNativeID(), "scan=2")
+  TEST_EQUAL(s.getPrecursors().size(), 1)
+
+  // precursors are replaced
+  col.copySpectrumMeta(0, s);
+  TEST_EQUAL(s.getPrecursors().size(), 0)
+  TEST_EQUAL(s.getType(), SpectrumSettings::PROFILE)
+
+  TEST_EXCEPTION(Exception::IndexOverflow, col.copySpectrumMeta(3, s))
+}
+END_SECTION
+
+START_SECTION(void toExperiment(PeakMap& exp) const)
+{
+  ColumnarMSExperiment col(exp);
+  PeakMap out;
+  col.toExperiment(out);
+  TEST_EQUAL(out.size(), 3)
+  TEST_EQUAL(out[0].size(), 3)
+  TEST_EQUAL(out[2].size(), 0)
+  TEST_REAL_SIMILAR(out[1].getRT(), 20.0)
+  TEST_EQUAL(ColumnarMSExperiment(out) == col, true)
+}
+END_SECTION
+
+START_SECTION(Size RTBegin(double rt) const)
+{
+  ColumnarMSExperiment col(exp);
+  TEST_EQUAL(col.RTBegin(0.0), 0)
+  TEST_EQUAL(col.RTBegin(10.0), 0)
+  TEST_EQUAL(col.RTBegin(15.0), 1)
+  TEST_EQUAL(col.RTBegin(30.0), 2)
+  TEST_EQUAL(col.RTBegin(35.0), 3)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
@@ -1021,6 +1021,22 @@ START_SECTION((DataValue& operator=(const unsigned long long)))
 }
 END_SECTION
 
+START_SECTION(([EXTRA] copies share string values))
+{
+  DataValue a("shared string");
+  DataValue b(a);
+  DataValue c;
+  c = b;
+  TEST_EQUAL(a.toChar() == b.toChar(), true)
+  TEST_EQUAL(a.toChar() == c.toChar(), true)
+  a = "changed";
+  TEST_STRING_EQUAL(a.toString(), "changed")
+  TEST_STRING_EQUAL(b.toString(), "shared string")
+  b.clear();
+  TEST_STRING_EQUAL(c.toString(), "shared string")
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
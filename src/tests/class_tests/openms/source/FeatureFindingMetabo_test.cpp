@@ -40,6 +40,11 @@
 #include <OpenMS/FILTERING/DATAREDUCTION/MassTraceDetection.h>
 #include <OpenMS/FILTERING/DATAREDUCTION/ElutionPeakDetection.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
+#include <OpenMS/CHEMISTRY/ISOTOPEDISTRIBUTION/CoarseIsotopePatternGenerator.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
 
 ///////////////////////////
 #include <OpenMS/FILTERING/DATAREDUCTION/FeatureFindingMetabo.h>
@@ -48,6 +53,39 @@
 using namespace OpenMS;
 using namespace std;
 
+class FeatureFindingMetaboTest :
+  public FeatureFindingMetabo
+{
+public:
+  double computeAveragineSimScore(const std::vector<double>& intensities, const double& molecular_weight) const
+  {
+    return computeAveragineSimScore_(intensities, molecular_weight);
+  }
+};
+
+// averagine intensities of the first n isotopic peaks
+std::vector<double> averagineIntensities(double mass, Size n, Size max_isotope)
+{
+  IsotopeDistribution d = CoarseIsotopePatternGenerator(max_isotope).estimateFromPeptideWeight(mass);
+  std::vector<double> result;
+  for (Size i = 0; i < n; ++i)
+  {
+    result.push_back(d.getContainer()[i].getIntensity());
+  }
+  return result;
+}
+
+// cosine similarity of the intensities to a monoisotopic peak only, i.e. {1, 0, 0, ...}
+double monoisotopicSimilarity(const std::vector<double>& intensities)
+{
+  double squared_sum(0.0);
+  for (double i : intensities)
+  {
+    squared_sum += i * i;
+  }
+  return intensities[0] / std::sqrt(squared_sum);
+}
+
 START_TEST(FeatureFindingMetabo, "$Id$")
 
 /////////////////////////////////////////////////////////////
@@ -131,6 +169,64 @@ START_SECTION((void run(std::vector< MassTrace > &, FeatureMap &, chromatograms
 END_SECTION
 
 
+START_SECTION(([EXTRA] isotope_filtering_model 'peptides'))
+{
+  FeatureFindingMetaboTest test_ffm;
+  Param p = test_ffm.getParameters();
+  p.setValue("isotope_filtering_model", "peptides");
+  test_ffm.setParameters(p);
+
+  // the traces are sorted by m/z in run(), the averagine cache covers masses
+  // up to the highest m/z times the highest charge
+  std::vector<MassTrace> traces(splitted_mt);
+  FeatureMap fm_peptides;
+  test_ffm.run(traces, fm_peptides, chromatograms);
+  TEST_EQUAL(fm_peptides.empty(), false)
+  const double mass = std::floor(traces.back().getCentroidMZ()) + 0.3;
+
+  // the result does not depend on the number of threads
+#ifdef _OPENMP
+  const int num_threads = omp_get_max_threads();
+  omp_set_num_threads(1);
+#endif
+  std::vector<MassTrace> traces_single(splitted_mt);
+  FeatureMap fm_single;
+  test_ffm.run(traces_single, fm_single, chromatograms);
+#ifdef _OPENMP
+  omp_set_num_threads(num_threads);
+#endif
+  TEST_EQUAL(fm_single.size(), fm_peptides.size())
+  ABORT_IF(fm_single.size() != fm_peptides.size())
+  for (Size i = 0; i < fm_peptides.size(); ++i)
+  {
+    TEST_REAL_SIMILAR(fm_single[i].getMZ(), fm_peptides[i].getMZ())
+    TEST_REAL_SIMILAR(fm_single[i].getRT(), fm_peptides[i].getRT())
+    TEST_REAL_SIMILAR(fm_single[i].getOverallQuality(), fm_peptides[i].getOverallQuality())
+    TEST_EQUAL(fm_single[i].getCharge(), fm_peptides[i].getCharge())
+  }
+
+  // cache hit: the pattern of the 1 Da mass window (centered at x.5) is used
+  std::vector<double> window_pattern = averagineIntensities(std::floor(mass) + 0.5, 3, 20);
+  TEST_REAL_SIMILAR(test_ffm.computeAveragineSimScore(window_pattern, mass), 1.0)
+  std::vector<double> mono(3, 0.0);
+  mono[0] = 1.0;
+  TEST_REAL_SIMILAR(test_ffm.computeAveragineSimScore(mono, mass), monoisotopicSimilarity(window_pattern))
+
+  // fallback: more isotopic peaks than cached, the pattern for the exact mass is computed
+  std::vector<double> exact_pattern = averagineIntensities(mass, 25, 25);
+  TEST_REAL_SIMILAR(test_ffm.computeAveragineSimScore(exact_pattern, mass), 1.0)
+  std::vector<double> mono_long(25, 0.0);
+  mono_long[0] = 1.0;
+  TEST_REAL_SIMILAR(test_ffm.computeAveragineSimScore(mono_long, mass), monoisotopicSimilarity(exact_pattern))
+
+  // fallback: mass outside of the cached range (nothing is cached before run() is called)
+  FeatureFindingMetaboTest ffm_no_cache;
+  std::vector<double> exact_short = averagineIntensities(mass, 3, 3);
+  TEST_REAL_SIMILAR(ffm_no_cache.computeAveragineSimScore(exact_short, mass), 1.0)
+  TEST_REAL_SIMILAR(ffm_no_cache.computeAveragineSimScore(mono, mass), monoisotopicSimilarity(exact_short))
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -39,6 +39,8 @@
 #include <OpenMS/FORMAT/HANDLERS/IndexedMzMLDecoder.h>
 ///////////////////////////
 
+#include <fstream>
+
 #define MULTI_LINE_STRING(...) #__VA_ARGS__ 
 
 using namespace OpenMS;
@@ -90,6 +92,101 @@ START_SECTION((std::streampos findIndexListOffset(String filename, int buffersiz
 
 END_SECTION
 
+START_SECTION((int scanOffsets(String filename, OffsetVector& spectra_offsets, OffsetVector& chromatograms_offsets, Size chunk_size = 16 * 1024 * 1024)))
+{
+  IndexedMzMLDecoder decoder;
+  IndexedMzMLDecoder::OffsetVector spectra_offsets, chromatograms_offsets;
+
+  // the reconstructed index matches the one stored in the file
+  std::streampos index_offset = decoder.findIndexListOffset(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
+  IndexedMzMLDecoder::OffsetVector stored_spectra, stored_chromatograms;
+  decoder.parseOffsets(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), index_offset, stored_spectra, stored_chromatograms);
+
+  TEST_EQUAL(decoder.scanOffsets(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), spectra_offsets, chromatograms_offsets), 0)
+  TEST_EQUAL(spectra_offsets.size(), 2)
+  TEST_EQUAL(chromatograms_offsets.size(), 1)
+  TEST_EQUAL(spectra_offsets == stored_spectra, true)
+  TEST_EQUAL(chromatograms_offsets == stored_chromatograms, true)
+
+  // tiny chunks (tags spanning chunk borders) give the same result
+  IndexedMzMLDecoder::OffsetVector small_spectra, small_chromatograms;
+  TEST_EQUAL(decoder.scanOffsets(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), small_spectra, small_chromatograms, 7), 0)
+  TEST_EQUAL(small_spectra == stored_spectra, true)
+  TEST_EQUAL(small_chromatograms == stored_chromatograms, true)
+
+  // non-indexed file
+  TEST_EQUAL(decoder.scanOffsets(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), spectra_offsets, chromatograms_offsets, 1024), 0)
+  TEST_EQUAL(spectra_offsets.size(), 4)
+  TEST_EQUAL(chromatograms_offsets.size(), 2)
+  ABORT_IF(spectra_offsets.size() != 4 || chromatograms_offsets.size() != 2)
+  TEST_STRING_EQUAL(spectra_offsets[0].first, "index=0")
+  TEST_STRING_EQUAL(spectra_offsets[3].first, "index=3")
+  TEST_STRING_EQUAL(chromatograms_offsets[0].first, "tic native")
+  TEST_STRING_EQUAL(chromatograms_offsets[1].first, "sic native")
+
+  TEST_EXCEPTION(Exception::FileNotFound, decoder.scanOffsets(OPENMS_GET_TEST_DATA_PATH("fileDoesNotExist"), spectra_offsets, chromatograms_offsets))
+}
+END_SECTION
+
+START_SECTION((bool validateOffsets(String filename, const OffsetVector& spectra_offsets, const OffsetVector& chromatograms_offsets)))
+{
+  IndexedMzMLDecoder decoder;
+  IndexedMzMLDecoder::OffsetVector spectra_offsets, chromatograms_offsets;
+  decoder.scanOffsets(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), spectra_offsets, chromatograms_offsets);
+  TEST_EQUAL(decoder.validateOffsets(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), spectra_offsets, chromatograms_offsets), true)
+
+  // offsets that do not point to a tag are rejected
+  IndexedMzMLDecoder::OffsetVector shifted = spectra_offsets;
+  shifted.back().second += 1;
+  TEST_EQUAL(decoder.validateOffsets(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), shifted, chromatograms_offsets), false)
+  TEST_EQUAL(decoder.validateOffsets(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), chromatograms_offsets, spectra_offsets), false)
+}
+END_SECTION
+
+START_SECTION((static String getSidecarFilename(const String& filename)))
+{
+  TEST_STRING_EQUAL(IndexedMzMLDecoder::getSidecarFilename("data/test.mzML"), "data/test.mzML.offsets")
+}
+END_SECTION
+
+START_SECTION((bool storeSidecarIndex(String filename, const OffsetVector& spectra_offsets, const OffsetVector& chromatograms_offsets)))
+{
+  NOT_TESTABLE // see loadSidecarIndex
+}
+END_SECTION
+
+START_SECTION((int loadSidecarIndex(String filename, OffsetVector& spectra_offsets, OffsetVector& chromatograms_offsets)))
+{
+  // work on a copy of the file, the sidecar index is written next to it
+  String filename;
+  NEW_TMP_FILE(filename)
+  {
+    std::ifstream in(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), std::ios_base::binary);
+    std::ofstream out(filename.c_str(), std::ios_base::binary);
+    out << in.rdbuf();
+  }
+
+  IndexedMzMLDecoder decoder;
+  IndexedMzMLDecoder::OffsetVector spectra_offsets, chromatograms_offsets;
+  IndexedMzMLDecoder::OffsetVector loaded_spectra, loaded_chromatograms;
+  TEST_EQUAL(decoder.loadSidecarIndex(filename, loaded_spectra, loaded_chromatograms), -1)
+
+  decoder.scanOffsets(filename, spectra_offsets, chromatograms_offsets);
+  TEST_EQUAL(decoder.storeSidecarIndex(filename, spectra_offsets, chromatograms_offsets), true)
+  TEST_EQUAL(decoder.loadSidecarIndex(filename, loaded_spectra, loaded_chromatograms), 0)
+  TEST_EQUAL(loaded_spectra == spectra_offsets, true)
+  TEST_EQUAL(loaded_chromatograms == chromatograms_offsets, true)
+
+  // a modified file invalidates the sidecar index
+  {
+    std::ofstream out(filename.c_str(), std::ios_base::app);
+    out << "\n";
+  }
+  TEST_EQUAL(decoder.loadSidecarIndex(filename, loaded_spectra, loaded_chromatograms), -1)
+  std::remove(IndexedMzMLDecoder::getSidecarFilename(filename).c_str());
+}
+END_SECTION
+
     
 
 /////////////////////////////////////////////////////////////
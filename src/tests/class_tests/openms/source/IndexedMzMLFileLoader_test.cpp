@@ -128,7 +128,9 @@ START_SECTION([EXTRA]CheckParsing)
   OnDiscPeakMap exp;
   bool success;
   success = file.load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
-  TEST_EQUAL(success, false)
+  // the index of a non-indexed file is reconstructed
+  TEST_EQUAL(success, true)
+  TEST_EQUAL(exp.getNrSpectra(), 4)
   success = file.load(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"),exp);
   TEST_EQUAL(success, true)
 }
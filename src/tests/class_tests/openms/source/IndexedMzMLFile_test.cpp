@@ -110,7 +110,17 @@ START_SECTION(( bool getParsingSuccess() const))
   }
 
   {
+    // the index of a non-indexed file is reconstructed
     IndexedMzMLHandler file(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
+    TEST_EQUAL(file.getParsingSuccess(), true)
+    TEST_EQUAL(file.getNrSpectra(), 4)
+    TEST_EQUAL(file.getNrChromatograms(), 2)
+  }
+
+  {
+    IndexedMzMLHandler file;
+    file.setIndexReconstruction(false);
+    file.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
     TEST_EQUAL(file.getParsingSuccess(), false)
   }
 
@@ -127,9 +137,46 @@ START_SECTION(( void openFile(String filename) ))
   TEST_EXCEPTION(Exception::FileNotFound, file.openFile(OPENMS_GET_TEST_DATA_PATH("fileDoesNotExist")))
   TEST_EQUAL(file.getParsingSuccess(), false)
   file.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
-  TEST_EQUAL(file.getParsingSuccess(), false)
+  TEST_EQUAL(file.getParsingSuccess(), true)
+  TEST_EQUAL(file.getNrSpectra(), 4)
   file.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
   TEST_EQUAL(file.getParsingSuccess(), true)
+  TEST_EQUAL(file.getNrSpectra(), 2)
+}
+END_SECTION
+
+START_SECTION(( void setIndexReconstruction(bool reconstruct) ))
+{
+  IndexedMzMLHandler file;
+  file.setIndexReconstruction(false);
+  file.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
+  TEST_EQUAL(file.getParsingSuccess(), false)
+  TEST_EQUAL(file.getNrSpectra(), 0)
+
+  // reconstructed spectra and chromatograms are identical to a full load
+  file.setIndexReconstruction(true);
+  file.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
+  TEST_EQUAL(file.getParsingSuccess(), true)
+
+  PeakMap exp;
+  MzMLFile().load(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), exp);
+  ABORT_IF(file.getNrSpectra() != exp.size())
+  for (Size i = 0; i < exp.size(); ++i)
+  {
+    MSSpectrum s = file.getMSSpectrumById(i);
+    TEST_EQUAL(s.size(), exp[i].size())
+    TEST_EQUAL(s.getNativeID(), exp[i].getNativeID())
+  }
+  ABORT_IF(file.getNrChromatograms() != exp.getChromatograms().size())
+  MSChromatogram c = file.getMSChromatogramById(1);
+  TEST_EQUAL(c.size(), exp.getChromatograms()[1].size())
+  TEST_EQUAL(c.getNativeID(), "sic native")
+}
+END_SECTION
+
+START_SECTION(( void setWriteSidecarIndex(bool write) ))
+{
+  NOT_TESTABLE // see IndexedMzMLDecoder_test
 }
 END_SECTION
 
@@ -126,6 +126,44 @@ START_SECTION(void smoothData(const DoubleVector&, const DoubleVector&, DoubleVe
         TEST_REAL_SIMILAR(out[i], targetFunction(idx));
     }
 
+    // unsorted input gives the same result, in input order
+    std::vector<double> x_rev(x.rbegin(), x.rend()), y_rev(y.rbegin(), y.rend());
+    out.clear();
+    lowsmooth.smoothData(x_rev, y_rev, out);
+    TEST_EQUAL(out.size(), x_rev.size())
+    for (Size i = 0; i < out.size(); ++i)
+    {
+        TEST_REAL_SIMILAR(out[i], targetFunction(x_rev[i]));
+    }
+
+    // with delta, only every third point is fitted and the others are interpolated
+    lowpar.setValue("delta", 2.5);
+    lowsmooth.setParameters(lowpar);
+    out.clear();
+    lowsmooth.smoothData(x, y, out);
+    TEST_EQUAL(out.size(), x.size())
+    for (Size i = 0; i < out.size(); i += 3)
+    {
+        TEST_REAL_SIMILAR(out[i], targetFunction(x[i]));
+    }
+    // linear interpolation of a convex function lies above it
+    TEST_EQUAL(out[1] > targetFunction(x[1]), true)
+    TEST_REAL_SIMILAR(out[1], (2.0 * targetFunction(x[0]) + targetFunction(x[3])) / 3.0)
+
+    // results are appended to the output, also for inputs too short to be smoothed
+    out.assign(1, -1.0);
+    lowsmooth.smoothData(x, y, out);
+    TEST_EQUAL(out.size(), x.size() + 1)
+    TEST_REAL_SIMILAR(out[0], -1.0)
+    TEST_REAL_SIMILAR(out[1], targetFunction(x[0]))
+
+    std::vector<double> x_short(x.begin(), x.begin() + 2), y_short(y.begin(), y.begin() + 2);
+    out.assign(1, -1.0);
+    lowsmooth.smoothData(x_short, y_short, out);
+    TEST_EQUAL(out.size(), 3)
+    TEST_REAL_SIMILAR(out[0], -1.0)
+    TEST_REAL_SIMILAR(out[1], y_short[0])
+    TEST_REAL_SIMILAR(out[2], y_short[1])
 }
 END_SECTION
 
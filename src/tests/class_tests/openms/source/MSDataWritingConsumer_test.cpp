@@ -32,86 +32,204 @@
 // $Authors: $
 // --------------------------------------------------------------------------
 
+
 #include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
 
 ///////////////////////////
 #include <OpenMS/FORMAT/DATAACCESS/MSDataWritingConsumer.h>
 ///////////////////////////
 
+#include <OpenMS/FORMAT/MzMLFile.h>
+
 using namespace OpenMS;
 using namespace std;
 
+namespace
+{
+  // MS1 spectra with varying number of peaks
+  PeakMap createTestExperiment(Size nr_spectra, Size nr_chromatograms)
+  {
+    PeakMap exp;
+    for (Size i = 0; i < nr_spectra; ++i)
+    {
+      MSSpectrum s;
+      s.setRT(10.0 + i);
+      s.setMSLevel(1);
+      s.setNativeID(String("spectrum=") + i);
+      for (Size j = 0; j < i % 7 + 1; ++j)
+      {
+        s.emplace_back(100.0 + j + i * 0.25, 10.0f * (j + 1) + i);
+      }
+      exp.addSpectrum(s);
+    }
+    for (Size i = 0; i < nr_chromatograms; ++i)
+    {
+      MSChromatogram c;
+      c.setNativeID(String("chromatogram=") + i);
+      c.push_back(ChromatogramPeak(1.0, 2.0 + i));
+      c.push_back(ChromatogramPeak(2.0, 3.0 + i));
+      exp.addChromatogram(c);
+    }
+    return exp;
+  }
+
+  // write all spectra, then all chromatograms (the consumer is destroyed at the end)
+  void writeWithConsumer(const String& filename, PeakMap& exp)
+  {
+    PlainMSDataWritingConsumer consumer(filename);
+    consumer.setExpectedSize(exp.size(), exp.getNrChromatograms());
+    consumer.setExperimentalSettings(exp);
+    for (Size i = 0; i < exp.size(); ++i)
+    {
+      consumer.consumeSpectrum(exp[i]);
+    }
+    for (Size i = 0; i < exp.getNrChromatograms(); ++i)
+    {
+      consumer.consumeChromatogram(exp.getChromatogram(i));
+    }
+  }
+}
+
 START_TEST(MSDataWritingConsumer, "$Id$")
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 
-MSDataWritingConsumer* ptr = 0;
-MSDataWritingConsumer* null_ptr = 0;
-START_SECTION(MSDataWritingConsumer())
+MSDataWritingConsumer* ptr = nullptr;
+MSDataWritingConsumer* null_ptr = nullptr;
+START_SECTION(MSDataWritingConsumer(String filename))
 {
-	ptr = new MSDataWritingConsumer();
-	TEST_NOT_EQUAL(ptr, null_ptr)
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file)
+  ptr = new PlainMSDataWritingConsumer(tmp_file);
+  TEST_NOT_EQUAL(ptr, null_ptr)
 }
 END_SECTION
 
 START_SECTION(~MSDataWritingConsumer())
 {
-	delete ptr;
+  delete ptr;
 }
 END_SECTION
 
-START_SECTION((virtual void setExperimentalSettings(const ExperimentalSettings &exp)))
-{
-  // TODO
-}
-END_SECTION
-
-START_SECTION((virtual void setExpectedSize(Size expectedSpectra, Size expectedChromatograms)))
+START_SECTION((virtual void consumeSpectrum(SpectrumType &s)))
 {
-  // TODO
+  // spectra are written in batches: check output across (and not filling) batch boundaries
+  Size sizes[] = {1, 63, 64, 65, 130};
+  for (Size n : sizes)
+  {
+    PeakMap exp = createTestExperiment(n, 0);
+    String tmp_file;
+    NEW_TMP_FILE(tmp_file)
+    writeWithConsumer(tmp_file, exp);
+
+    PeakMap loaded;
+    MzMLFile().load(tmp_file, loaded);
+    TEST_EQUAL(loaded.size(), n)
+    for (Size i = 0; i < loaded.size(); ++i)
+    {
+      TEST_EQUAL(loaded[i].getNativeID(), exp[i].getNativeID())
+      TEST_REAL_SIMILAR(loaded[i].getRT(), exp[i].getRT())
+      TEST_EQUAL(loaded[i].size(), exp[i].size())
+      for (Size j = 0; j < loaded[i].size(); ++j)
+      {
+        TEST_REAL_SIMILAR(loaded[i][j].getMZ(), exp[i][j].getMZ())
+        TEST_REAL_SIMILAR(loaded[i][j].getIntensity(), exp[i][j].getIntensity())
+      }
+    }
+  }
 }
 END_SECTION
 
-START_SECTION((virtual void consumeSpectrum(SpectrumType &s)))
+START_SECTION((virtual void consumeChromatogram(ChromatogramType &c)))
 {
-  // TODO
+  // buffered spectra are written before the spectrum list is closed
+  PeakMap exp = createTestExperiment(70, 2);
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file)
+  writeWithConsumer(tmp_file, exp);
+
+  PeakMap loaded;
+  MzMLFile().load(tmp_file, loaded);
+  TEST_EQUAL(loaded.size(), 70)
+  TEST_EQUAL(loaded.getNrChromatograms(), 2)
+  TEST_EQUAL(loaded[69].getNativeID(), "spectrum=69")
+  TEST_EQUAL(loaded[69].size(), exp[69].size())
+  TEST_EQUAL(loaded.getChromatogram(1).getNativeID(), "chromatogram=1")
+  TEST_EQUAL(loaded.getChromatogram(1).size(), 2)
 }
 END_SECTION
 
-START_SECTION((virtual void consumeChromatogram(ChromatogramType &c)))
+START_SECTION((virtual ~MSDataWritingConsumer()))
 {
-  // TODO
+  // a partial batch is written when the consumer is destroyed
+  PeakMap exp = createTestExperiment(10, 0);
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file)
+  {
+    PlainMSDataWritingConsumer consumer(tmp_file);
+    consumer.setExpectedSize(exp.size(), 0);
+    for (Size i = 0; i < exp.size(); ++i)
+    {
+      consumer.consumeSpectrum(exp[i]);
+    }
+    TEST_EQUAL(consumer.getNrSpectraWritten(), 10)
+  }
+
+  PeakMap loaded;
+  MzMLFile().load(tmp_file, loaded);
+  TEST_EQUAL(loaded.size(), 10)
+  TEST_EQUAL(loaded[9].getNativeID(), "spectrum=9")
+  TEST_EQUAL(loaded[9].size(), exp[9].size())
 }
 END_SECTION
 
-START_SECTION((MSDataWritingConsumer(String filename)))
+START_SECTION((virtual void setExperimentalSettings(const ExperimentalSettings &exp)))
 {
-  // TODO
+  NOT_TESTABLE // tested above
 }
 END_SECTION
 
-START_SECTION((virtual ~MSDataWritingConsumer()))
+START_SECTION((virtual void setExpectedSize(Size expectedSpectra, Size expectedChromatograms)))
 {
-  // TODO
+  NOT_TESTABLE // tested above
 }
 END_SECTION
 
 START_SECTION((virtual void addDataProcessing(DataProcessing d)))
 {
-  // TODO
+  PeakMap exp = createTestExperiment(3, 0);
+  String tmp_file;
+  NEW_TMP_FILE(tmp_file)
+  {
+    PlainMSDataWritingConsumer consumer(tmp_file);
+    consumer.setExpectedSize(exp.size(), 0);
+    DataProcessing dp;
+    dp.getProcessingActions().insert(DataProcessing::SMOOTHING);
+    consumer.addDataProcessing(dp);
+    for (Size i = 0; i < exp.size(); ++i)
+    {
+      consumer.consumeSpectrum(exp[i]);
+    }
+  }
+
+  PeakMap loaded;
+  MzMLFile().load(tmp_file, loaded);
+  TEST_EQUAL(loaded.size(), 3)
+  TEST_EQUAL(loaded[2].getDataProcessing().empty(), false)
 }
 END_SECTION
 
 START_SECTION((virtual Size getNrSpectraWritten()))
 {
-  // TODO
+  NOT_TESTABLE // tested above
 }
 END_SECTION
 
 START_SECTION((virtual Size getNrChromatogramsWritten()))
 {
-  // TODO
+  NOT_TESTABLE // tested above
 }
 END_SECTION
 
@@ -119,6 +237,3 @@ END_SECTION
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
-
-
-
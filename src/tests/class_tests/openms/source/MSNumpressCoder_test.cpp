@@ -333,6 +333,30 @@ START_SECTION([EXTRA] decodeNP_SLOF)
 }
 END_SECTION
 
+START_SECTION([EXTRA] decodeNP_SLOF with odd number of bytes)
+{
+  std::vector< double > in = setup_test_vec1();
+
+  MSNumpressCoder::NumpressConfig config;
+  config.np_compression = MSNumpressCoder::SLOF;
+  config.estimate_fixed_point = true;
+
+  String encoded;
+  MSNumpressCoder().encodeNPRaw(in, encoded, config);
+  TEST_EQUAL(encoded.size(), 16)
+
+  // a trailing incomplete value is ignored (and not read past the end of the input)
+  encoded += '\x7f';
+  std::vector<double> out;
+  MSNumpressCoder().decodeNPRaw(encoded, out, config);
+
+  TEST_EQUAL(out.size(), 4)
+  TOLERANCE_RELATIVE(1+ 1e-4)
+  TEST_REAL_SIMILAR(out[0], 100.0)
+  TEST_REAL_SIMILAR(out[3], 400.00010)
+}
+END_SECTION
+
 ///////////////////////////////////////////////////////////////////////////
 // Large test
 ///////////////////////////////////////////////////////////////////////////
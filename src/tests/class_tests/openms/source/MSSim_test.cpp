@@ -227,6 +227,9 @@ START_SECTION((void simulate(const SimRandomNumberGenerator &rnd_gen, SimTypes::
 
   mssim.setParameters(sim_params);
 
+  // noise and m/z error are disabled by default, so the raw signal (and thus
+  // precursor selection and all counts tested below) does not depend on the
+  // random streams used by RawMSSignalSimulation
   mssim.simulate(sim_rnd_ptr, channels);
 
   // results of simulate are tested individually in the accessors below
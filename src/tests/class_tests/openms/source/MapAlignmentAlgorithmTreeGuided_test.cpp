@@ -105,6 +105,11 @@ START_SECTION((static void buildTree(std::vector<FeatureMap>& feature_maps, std:
   TEST_EQUAL(maps_ranges[0].size(), 6);
   TEST_EQUAL(maps_ranges[1].size(), 5);
   TEST_EQUAL(maps_ranges[2].size(), 5);
+
+  vector<FeatureMap> no_maps;
+  vector<BinaryTreeNode> no_tree;
+  vector<vector<double>> no_ranges;
+  TEST_EXCEPTION(Exception::IllegalArgument, OpenMS::MapAlignmentAlgorithmTreeGuided::buildTree(no_maps, no_tree, no_ranges));
 }
 END_SECTION
 
@@ -133,6 +138,12 @@ START_SECTION((void treeGuidedAlignment(const std::vector<BinaryTreeNode>& tree,
   {
     TEST_EQUAL(map_transformed[i].metaValueExists("original_RT"), true);
   }
+
+  vector<FeatureMap> no_maps;
+  vector<vector<double>> no_ranges;
+  FeatureMap no_map_transformed;
+  vector<Size> no_trafo_order;
+  TEST_EXCEPTION(Exception::IllegalArgument, aligner.treeGuidedAlignment(vector<BinaryTreeNode>(), no_maps, no_ranges, no_map_transformed, no_trafo_order));
 }
 END_SECTION
 
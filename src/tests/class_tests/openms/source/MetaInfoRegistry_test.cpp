@@ -176,6 +176,16 @@ START_SECTION((MetaInfoRegistry& operator=(const MetaInfoRegistry& rhs)))
 	TEST_STRING_EQUAL(mir2.getUnit(1025), "sec")
 	TEST_STRING_EQUAL(mir2.getUnit("testname"), "")
 	TEST_STRING_EQUAL(mir2.getUnit("retention time"), "sec")
+
+	// repeated assignment replaces (and frees) the previous names
+	for (Size i = 0; i < 100; ++i)
+	{
+		mir2.registerName("extra_" + String(i));
+		mir2 = mir;
+	}
+	TEST_EQUAL(mir2.getIndex("extra_0"), UInt(-1))
+	TEST_EQUAL(mir2.getIndex("retention time"), 1025)
+	TEST_STRING_EQUAL(mir2.getName(1024), "testname")
 END_SECTION
 
 START_SECTION([EXTRA] multithreaded example)
@@ -234,6 +244,31 @@ START_SECTION([EXTRA] multithreaded example)
 }
 END_SECTION
 
+START_SECTION([EXTRA] concurrent registration and lookup)
+{
+  // registering many names grows the lock-free tables while other threads read them
+  MetaInfoRegistry reg;
+  int nr_names = 5000;
+  int errors = 0;
+#pragma omp parallel for reduction(+: errors)
+  for (int k = 0; k < nr_names; ++k)
+  {
+    String name = "concurrent_" + String(k);
+    UInt index = reg.registerName(name);
+    if (reg.getIndex(name) != index) ++errors;
+    if (reg.getName(index) != name) ++errors;
+    if (reg.getIndex("isotopic_range") != 1) ++errors;
+  }
+  TEST_EQUAL(errors, 0)
+  TEST_EQUAL(reg.getIndex("concurrent_" + String(nr_names)), UInt(-1))
+  TEST_EXCEPTION(Exception::InvalidValue, reg.getName(1024 + nr_names))
+
+  MetaInfoRegistry reg2(reg);
+  TEST_EQUAL(reg2.getName(reg.getIndex("concurrent_42")), "concurrent_42")
+  TEST_EQUAL(reg2.registerName("another one"), 1024 + nr_names)
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -251,6 +251,65 @@ START_SECTION((void removeValue(const String& name)))
 	i.removeValue("icon");
 END_SECTION
 
+START_SECTION((MetaInfo(MetaInfo&&)))
+	MetaInfo i;
+	i.setValue("label", String("bla"));
+	i.setValue("icon", 5);
+	MetaInfo i2(std::move(i));
+	TEST_EQUAL(i2.getValue("label"), "bla")
+	TEST_EQUAL((Int)i2.getValue("icon"), 5)
+	TEST_EQUAL(i.empty(), true)
+END_SECTION
+
+START_SECTION((MetaInfo& operator=(MetaInfo&&) &))
+	MetaInfo i, i2;
+	for (UInt k = 1; k <= 10; ++k) i.setValue(k, k);
+	i2.setValue("label", String("bla"));
+	i2 = std::move(i);
+	TEST_EQUAL(i2.exists("label"), false)
+	TEST_EQUAL((UInt)i2.getValue(10), 10)
+	TEST_EQUAL(i.empty(), true)
+END_SECTION
+
+START_SECTION(([EXTRA] many values))
+	MetaInfo i;
+	// insert out of order, past the inline capacity
+	UInt order[] = {7, 3, 11, 1, 5, 9, 2, 13, 4, 12};
+	for (UInt k : order) i.setValue(k, String(k));
+	std::vector<UInt> keys;
+	i.getKeys(keys);
+	TEST_EQUAL(keys.size(), 10)
+	for (Size k = 1; k < keys.size(); ++k) TEST_EQUAL(keys[k - 1] < keys[k], true)
+	for (UInt k : order) TEST_EQUAL(i.getValue(k), String(k))
+
+	// setting a value from a reference to another value of the same object
+	i.setValue(6, i.getValue(13));
+	TEST_EQUAL(i.getValue(6), "13")
+
+	for (UInt k : order) i.removeValue(k);
+	i.getKeys(keys);
+	TEST_EQUAL(keys.size(), 1)
+	TEST_EQUAL(i.getValue(6), "13")
+
+	MetaInfo small;
+	small.setValue(2, 2.0);
+	small.setValue(1, String("one"));
+	small.setValue(1, i.getValue(6));
+	small.getKeys(keys);
+	TEST_EQUAL(keys.size(), 2)
+	TEST_EQUAL(keys[0], 1)
+	TEST_EQUAL(small.getValue(1), "13")
+	MetaInfo copy(small);
+	TEST_EQUAL(copy == small, true)
+	small.removeValue(2);
+	TEST_EQUAL(copy == small, false)
+END_SECTION
+
+START_SECTION(([EXTRA] memory footprint))
+	// every annotated object carries a MetaInfo, it must not be larger than a vector
+	TEST_EQUAL(sizeof(MetaInfo) <= sizeof(std::vector<std::pair<UInt, DataValue> >), true)
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
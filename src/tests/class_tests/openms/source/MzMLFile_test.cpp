@@ -1233,6 +1233,44 @@ START_SECTION(void transform(const String& filename_in, Interfaces::IMSDataConsu
 }
 END_SECTION
 
+START_SECTION([EXTRA] transform with decoding pipeline)
+{
+  String in = OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML");
+  PeakMap reference;
+  MzMLFile().load(in, reference);
+
+  // pipeline disabled, tiny queue, tiny memory cap (always waits for the oldest item) and default settings
+  std::vector<std::pair<Size, Size> > settings = { {0, 1024}, {1, 1024 * 1024}, {100, 1}, {100, 256 * 1024 * 1024} };
+  for (const auto& setting : settings)
+  {
+    TICConsumer consumer;
+    MzMLFile mzml;
+    PeakMap map;
+    PeakFileOptions opt = mzml.getOptions();
+    opt.setPipelineQueueDepth(setting.first);
+    opt.setPipelineMemoryCap(setting.second);
+    mzml.setOptions(opt);
+    mzml.transform(in, &consumer, map, true, true);
+
+    TEST_EQUAL(consumer.nr_spectra, 4)
+    TEST_EQUAL(consumer.nr_peaks, 40)
+    TEST_REAL_SIMILAR(consumer.TIC, 350)
+
+    // same data in the original order
+    ABORT_IF(map.size() != reference.size())
+    for (Size i = 0; i < map.size(); ++i)
+    {
+      TEST_EQUAL(map[i] == reference[i], true)
+    }
+    ABORT_IF(map.getChromatograms().size() != reference.getChromatograms().size())
+    for (Size i = 0; i < map.getChromatograms().size(); ++i)
+    {
+      TEST_EQUAL(map.getChromatograms()[i] == reference.getChromatograms()[i], true)
+    }
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -281,6 +281,55 @@ START_SECTION( void readSpectra(std::vector<MSSpectrum> & exp, const std::vector
     std::vector<int> indices = {5};
     TEST_EXCEPTION(Exception::IllegalArgument, handler.readSpectra(exp, indices, false));
   }
+
+  // non-contiguous indices
+  {
+    std::string tmp_filename;
+    NEW_TMP_FILE(tmp_filename);
+
+    // delete file if present
+    QFile file (String(tmp_filename).toQString());
+    file.remove();
+
+    auto spectra = exp2.getSpectra();
+    spectra.push_back(exp2.getSpectra()[0]);
+    spectra.back().setNativeID("third");
+
+    {
+      MzMLSqliteHandler handler(tmp_filename);
+      handler.createTables();
+      handler.writeSpectra(spectra);
+    }
+
+    MzMLSqliteHandler handler(tmp_filename);
+    {
+      std::vector<MSSpectrum> exp;
+      std::vector<int> indices = {0, 2};
+      handler.readSpectra(exp, indices, true);
+      TEST_EQUAL(exp.size(), 2)
+      TEST_EQUAL(exp[0].size(), 0)
+      TEST_EQUAL(exp[1].size(), 0)
+      TEST_STRING_EQUAL(exp[0].getNativeID(), spectra[0].getNativeID())
+      TEST_STRING_EQUAL(exp[1].getNativeID(), "third")
+    }
+
+    {
+      std::vector<MSSpectrum> exp;
+      std::vector<int> indices = {2, 0};
+      handler.readSpectra(exp, indices, false);
+      TEST_EQUAL(exp.size(), 2)
+      TEST_EQUAL(exp[0].size(), 19914)
+      TEST_EQUAL(exp[1].size(), 19914)
+      TEST_STRING_EQUAL(exp[0].getNativeID(), spectra[0].getNativeID())
+      TEST_STRING_EQUAL(exp[1].getNativeID(), "third")
+    }
+
+    {
+      std::vector<MSSpectrum> exp;
+      std::vector<int> indices = {0, 5};
+      TEST_EXCEPTION(Exception::IllegalArgument, handler.readSpectra(exp, indices, false));
+    }
+  }
 }
 END_SECTION
 
@@ -328,6 +377,8 @@ START_SECTION(void readChromatograms(std::vector<MSChromatogram> & exp, const st
     auto chroms = exp_orig.getChromatograms();
     chroms.push_back(exp_orig.getChromatograms()[0]);
     chroms.back().setNativeID("second");
+    chroms.push_back(exp_orig.getChromatograms()[0]);
+    chroms.back().setNativeID("third");
 
     {
       MzMLSqliteHandler handler(tmp_filename);
@@ -365,6 +416,35 @@ START_SECTION(void readChromatograms(std::vector<MSChromatogram> & exp, const st
       TEST_STRING_EQUAL(exp[1].getNativeID(), "second")
     }
 
+    // non-contiguous indices
+    {
+      std::vector<MSChromatogram> exp;
+      std::vector<int> indices = {0, 2};
+      handler.readChromatograms(exp, indices, true);
+      TEST_EQUAL(exp.size(), 2)
+      TEST_EQUAL(exp[0].size(), 0)
+      TEST_EQUAL(exp[1].size(), 0)
+      TEST_STRING_EQUAL(exp[0].getNativeID(), "TIC")
+      TEST_STRING_EQUAL(exp[1].getNativeID(), "third")
+    }
+
+    {
+      std::vector<MSChromatogram> exp;
+      std::vector<int> indices = {2, 0};
+      handler.readChromatograms(exp, indices, false);
+      TEST_EQUAL(exp.size(), 2)
+      TEST_EQUAL(exp[0].size(), exp_orig.getChromatograms()[0].size())
+      TEST_EQUAL(exp[1].size(), exp_orig.getChromatograms()[0].size())
+      TEST_STRING_EQUAL(exp[0].getNativeID(), "TIC")
+      TEST_STRING_EQUAL(exp[1].getNativeID(), "third")
+    }
+
+    {
+      std::vector<MSChromatogram> exp;
+      std::vector<int> indices = {0, 5};
+      TEST_EXCEPTION(Exception::IllegalArgument, handler.readChromatograms(exp, indices, false));
+    }
+
   }
 
 }
@@ -39,6 +39,8 @@
 #include <OpenMS/FORMAT/MzTabFile.h>
 #include <OpenMS/FORMAT/MzTab.h>
 #include <OpenMS/FORMAT/TextFile.h>
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
 ///////////////////////////
 
 using namespace OpenMS;
@@ -121,6 +123,56 @@ START_SECTION(void store(const String& filename, MzTab& mzTab) )
 }
 END_SECTION
 
+START_SECTION(void storeConsensusMap(const String& filename, const ConsensusMap& cmap, const bool first_run_inference_only, const bool export_unidentified_features, const bool export_unassigned_ids, const bool export_subfeatures, const bool export_empty_pep_ids = false, const String& title = "ConsensusMap export from OpenMS") const)
+{
+  // the streamed export must write the same file as exporting to an MzTab object first
+  // (input files and inference settings as in the MzTabExporter TOPP tests)
+  std::vector<std::pair<String, bool> > files_to_test;
+  files_to_test.push_back(std::make_pair("../../../topp/Epifany_2_out.consensusXML", false));
+  files_to_test.push_back(std::make_pair("../../../topp/MzTabExporter_5_in.consensusXML", true));
+
+  for (const std::pair<String, bool>& f : files_to_test)
+  {
+    ConsensusMap cmap;
+    ConsensusXMLFile().load(OPENMS_GET_TEST_DATA_PATH(f.first), cmap);
+
+    for (int export_subfeatures = 0; export_subfeatures < 2; ++export_subfeatures)
+    {
+      String streamed, reference;
+      NEW_TMP_FILE(streamed)
+      NEW_TMP_FILE(reference)
+
+      MzTabFile().storeConsensusMap(streamed, cmap, f.second, true, true, export_subfeatures, false, "test export");
+      MzTab mztab = MzTab::exportConsensusMapToMzTab(cmap, f.first, f.second, true, true, export_subfeatures, false, "test export");
+      MzTabFile().store(reference, mztab);
+
+      TEST_FILE_EQUAL(streamed.c_str(), reference.c_str())
+    }
+  }
+}
+END_SECTION
+
+START_SECTION(void storeIdentifications(const String& filename, const std::vector<ProteinIdentification>& protein_identifications, const std::vector<PeptideIdentification>& peptide_identifications, const bool first_run_inference_only, const bool export_empty_pep_ids = false, const String& title = "ID export from OpenMS") const)
+{
+  std::vector<ProteinIdentification> prot_ids;
+  std::vector<PeptideIdentification> pep_ids;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), prot_ids, pep_ids);
+
+  for (int export_empty_pep_ids = 0; export_empty_pep_ids < 2; ++export_empty_pep_ids)
+  {
+    String streamed, reference;
+    NEW_TMP_FILE(streamed)
+    NEW_TMP_FILE(reference)
+
+    MzTabFile().storeIdentifications(streamed, prot_ids, pep_ids, false, export_empty_pep_ids);
+    MzTab mztab = MzTab::exportIdentificationsToMzTab(prot_ids, pep_ids, "IdXMLFile_whole.idXML", false, export_empty_pep_ids);
+    MzTabFile().store(reference, mztab);
+
+    TEST_FILE_EQUAL(streamed.c_str(), reference.c_str())
+  }
+}
+END_SECTION
+
 START_SECTION(~MzTabFile())
 {
   delete ptr;
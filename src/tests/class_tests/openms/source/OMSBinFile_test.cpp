@@ -0,0 +1,222 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry               
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+// 
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution 
+//    may be used to endorse or promote products derived from this software 
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS. 
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING 
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL, 
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO, 
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS; 
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY, 
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR 
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF 
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+// 
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/FORMAT/OMSBinFile.h>
+///////////////////////////
+
+#include <OpenMS/FORMAT/ConsensusXMLFile.h>
+#include <OpenMS/FORMAT/FeatureXMLFile.h>
+#include <OpenMS/FORMAT/FileHandler.h>
+#include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/KERNEL/ConsensusMap.h>
+#include <OpenMS/KERNEL/FeatureMap.h>
+
+#include <fstream>
+#include <limits>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(OMSBinFile, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+OMSBinFile* ptr = nullptr;
+OMSBinFile* null_ptr = nullptr;
+START_SECTION(OMSBinFile())
+{
+  ptr = new OMSBinFile();
+  TEST_NOT_EQUAL(ptr, null_ptr)
+}
+END_SECTION
+
+START_SECTION(~OMSBinFile())
+{
+  delete ptr;
+}
+END_SECTION
+
+// round trips are checked by writing the original and the reloaded data back to XML
+
+START_SECTION((void store(const String& filename, const FeatureMap& map)))
+{
+  FeatureMap fm, fm2;
+  FeatureXMLFile().load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), fm);
+  DataProcessing dp;
+  dp.getSoftware().setName("SoftwareName");
+  dp.getSoftware().setMetaValue("software_meta", "value");
+  dp.setMetaValue("processing_meta", 1.5);
+  fm.getDataProcessing().push_back(dp);
+
+  String bin_file;
+  NEW_TMP_FILE(bin_file)
+  OMSBinFile().store(bin_file, fm);
+  TEST_EQUAL(OMSBinFile::getContentType(bin_file), OMSBinFile::FEATURES)
+  TEST_EQUAL(FileHandler::getTypeByContent(bin_file), FileTypes::OMSBIN)
+
+  OMSBinFile().load(bin_file, fm2);
+  TEST_EQUAL(fm2.size(), fm.size())
+  TEST_EQUAL(fm2.getUniqueId(), fm.getUniqueId())
+  TEST_EQUAL(fm2.getProteinIdentifications().size(), fm.getProteinIdentifications().size())
+  TEST_EQUAL(fm2.getUnassignedPeptideIdentifications().size(), fm.getUnassignedPeptideIdentifications().size())
+  ABORT_IF(fm2.getDataProcessing().size() != fm.getDataProcessing().size())
+  TEST_EQUAL(fm2.getDataProcessing().back().getSoftware().getMetaValue("software_meta"), "value")
+  TEST_REAL_SIMILAR(fm2.getDataProcessing().back().getMetaValue("processing_meta"), 1.5)
+
+  String xml_file, xml_file2;
+  NEW_TMP_FILE(xml_file)
+  NEW_TMP_FILE(xml_file2)
+  FeatureXMLFile().store(xml_file, fm);
+  FeatureXMLFile().store(xml_file2, fm2);
+  TEST_FILE_SIMILAR(xml_file2, xml_file)
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename, FeatureMap& map)))
+{
+  FeatureMap fm;
+  TEST_EXCEPTION(Exception::FileNotFound, OMSBinFile().load("this_file_does_not_exist.omsbin", fm))
+  TEST_EXCEPTION(Exception::ParseError, OMSBinFile().load(OPENMS_GET_TEST_DATA_PATH("FeatureXMLFile_1.featureXML"), fm))
+
+  // a file with a different content type is rejected
+  String bin_file;
+  NEW_TMP_FILE(bin_file)
+  OMSBinFile().store(bin_file, vector<ProteinIdentification>(), vector<PeptideIdentification>());
+  TEST_EXCEPTION(Exception::ParseError, OMSBinFile().load(bin_file, fm))
+}
+END_SECTION
+
+START_SECTION((void store(const String& filename, const ConsensusMap& map)))
+{
+  ConsensusMap cm, cm2;
+  ConsensusXMLFile().load(OPENMS_GET_TEST_DATA_PATH("ConsensusXMLFile_1.consensusXML"), cm);
+
+  String bin_file;
+  NEW_TMP_FILE(bin_file)
+  OMSBinFile().store(bin_file, cm);
+  TEST_EQUAL(OMSBinFile::getContentType(bin_file), OMSBinFile::CONSENSUS)
+  OMSBinFile().load(bin_file, cm2);
+  TEST_EQUAL(cm2.size(), cm.size())
+  TEST_EQUAL(cm2.getColumnHeaders().size(), cm.getColumnHeaders().size())
+
+  String xml_file, xml_file2;
+  NEW_TMP_FILE(xml_file)
+  NEW_TMP_FILE(xml_file2)
+  ConsensusXMLFile().store(xml_file, cm);
+  ConsensusXMLFile().store(xml_file2, cm2);
+  TEST_FILE_SIMILAR(xml_file2, xml_file)
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename, ConsensusMap& map)))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+START_SECTION((void store(const String& filename, const std::vector<ProteinIdentification>& protein_ids, const std::vector<PeptideIdentification>& peptide_ids)))
+{
+  vector<ProteinIdentification> proteins, proteins2;
+  vector<PeptideIdentification> peptides, peptides2;
+  String document_id;
+  IdXMLFile().load(OPENMS_GET_TEST_DATA_PATH("IdXMLFile_whole.idXML"), proteins, peptides, document_id);
+
+  String bin_file;
+  NEW_TMP_FILE(bin_file)
+  OMSBinFile().store(bin_file, proteins, peptides);
+  TEST_EQUAL(OMSBinFile::getContentType(bin_file), OMSBinFile::IDENTIFICATIONS)
+  OMSBinFile().load(bin_file, proteins2, peptides2);
+  TEST_EQUAL(proteins2.size(), proteins.size())
+  TEST_EQUAL(peptides2.size(), peptides.size())
+  ABORT_IF(peptides2.empty())
+  TEST_EQUAL(peptides2[0] == peptides[0], true)
+
+  String xml_file, xml_file2;
+  NEW_TMP_FILE(xml_file)
+  NEW_TMP_FILE(xml_file2)
+  IdXMLFile().store(xml_file, proteins, peptides, document_id);
+  IdXMLFile().store(xml_file2, proteins2, peptides2, document_id);
+  TEST_FILE_SIMILAR(xml_file2, xml_file)
+}
+END_SECTION
+
+START_SECTION((void load(const String& filename, std::vector<ProteinIdentification>& protein_ids, std::vector<PeptideIdentification>& peptide_ids)))
+{
+  String bin_file;
+  NEW_TMP_FILE(bin_file)
+  OMSBinFile().store(bin_file, vector<ProteinIdentification>(), vector<PeptideIdentification>());
+
+  // the output vectors are cleared
+  vector<ProteinIdentification> proteins(2);
+  vector<PeptideIdentification> peptides(3);
+  OMSBinFile().load(bin_file, proteins, peptides);
+  TEST_EQUAL(proteins.size(), 0)
+  TEST_EQUAL(peptides.size(), 0)
+
+  // the body starts with the number of proteins (after the 40 byte file header);
+  // huge counts are rejected without allocating memory
+  {
+    std::fstream f(bin_file.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(40);
+    UInt64 count = std::numeric_limits<UInt64>::max();
+    f.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  }
+  TEST_EXCEPTION(Exception::ParseError, OMSBinFile().load(bin_file, proteins, peptides))
+
+  // the same for the number of strings in the header
+  OMSBinFile().store(bin_file, vector<ProteinIdentification>(), vector<PeptideIdentification>());
+  {
+    std::fstream f(bin_file.c_str(), std::ios::in | std::ios::out | std::ios::binary);
+    f.seekp(32);
+    UInt64 count = std::numeric_limits<UInt64>::max() / 2;
+    f.write(reinterpret_cast<const char*>(&count), sizeof(count));
+  }
+  TEST_EXCEPTION(Exception::ParseError, OMSBinFile().load(bin_file, proteins, peptides))
+}
+END_SECTION
+
+START_SECTION((static ContentType getContentType(const String& filename)))
+{
+  NOT_TESTABLE // tested above
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
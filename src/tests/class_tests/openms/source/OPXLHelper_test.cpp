@@ -488,7 +488,7 @@ START_SECTION(static void OPXLHelper::isoPeakMeans(OPXLDataStructs::CrossLinkSpe
   TEST_REAL_SIMILAR(csm.num_iso_peaks_mean_xlinks_beta, 2.25)
 END_SECTION
 
-START_SECTION(filterPrecursorsByTags(std::vector <OPXLDataStructs::XLPrecursor>& candidates, std::vector<std::string>& tags))
+START_SECTION(static void filterPrecursorsByTags(std::vector <OPXLDataStructs::XLPrecursor>& candidates, std::vector< int >& precursor_correction_positions, const std::vector<OPXLDataStructs::AASeqWithMass>& peptide_masses, const std::vector<std::string>& tags))
 
   std::cout << std::endl;
   std::vector< int > spectrum_precursor_correction_positions;
@@ -500,7 +500,7 @@ START_SECTION(filterPrecursorsByTags(std::vector <OPXLDataStructs::XLPrecursor>&
   TEST_EQUAL(precursors.size(), 9604);
 
   // filter candidates
-  OPXLHelper::filterPrecursorsByTags(precursors, spectrum_precursor_correction_positions, tags);
+  OPXLHelper::filterPrecursorsByTags(precursors, spectrum_precursor_correction_positions, peptides, tags);
   TEST_EQUAL(precursors.size(), 4372);
 
 
@@ -510,7 +510,7 @@ START_SECTION(filterPrecursorsByTags(std::vector <OPXLDataStructs::XLPrecursor>&
   // std::cout << std::endl;
   // for (int i = 0; i < 30000; ++i)
   // {
-  //   OPXLHelper::filterPrecursorsByTags(precursors, spectrum_precursor_correction_positions, tags);
+  //   OPXLHelper::filterPrecursorsByTags(precursors, spectrum_precursor_correction_positions, peptides, tags);
   // }
   // TEST_EQUAL(precursors.size(), 4372);
 
@@ -87,13 +87,13 @@ START_SECTION((bool operator== (const OnDiscMSExperiment& rhs) const))
   OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
   OnDiscPeakMap tmp2; tmp2.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
   OnDiscPeakMap same; same.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
-  OnDiscPeakMap failed; failed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
+  OnDiscPeakMap non_indexed; non_indexed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
 
   TEST_EQUAL(tmp==same, true);
   TEST_EQUAL(tmp2==same, false);
   TEST_EQUAL(tmp2==tmp2, true);
   TEST_EQUAL((*tmp.getExperimentalSettings())==(*same.getExperimentalSettings()), true);
-  TEST_EQUAL(tmp==failed, false);
+  TEST_EQUAL(tmp==non_indexed, false);
 }
 END_SECTION
 
@@ -102,11 +102,11 @@ START_SECTION((bool operator!= (const OnDiscMSExperiment& rhs) const))
   OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
   OnDiscPeakMap tmp2; tmp2.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
   OnDiscPeakMap same; same.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
-  OnDiscPeakMap failed; failed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
+  OnDiscPeakMap non_indexed; non_indexed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
 
   TEST_EQUAL(tmp!=same, false);
   TEST_EQUAL(tmp2!=same, true);
-  TEST_EQUAL(tmp!=failed, true);
+  TEST_EQUAL(tmp!=non_indexed, true);
 }
 END_SECTION
 
@@ -114,7 +114,7 @@ START_SECTION(( bool openFile(const String& filename, bool skipMetaData = false)
 {
   OnDiscPeakMap tmp;
   OnDiscPeakMap same;
-  OnDiscPeakMap failed;
+  OnDiscPeakMap non_indexed;
 
   bool res;
   res = tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
@@ -129,10 +129,15 @@ START_SECTION(( bool openFile(const String& filename, bool skipMetaData = false)
   res = same.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
   TEST_EQUAL(res, true)
 
-  res = failed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
-  TEST_EQUAL(res, false)
+  // the index of a non-indexed file is reconstructed
+  res = non_indexed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
+  TEST_EQUAL(res, true)
 
-  res = failed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), true);
+  res = non_indexed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"), true);
+  TEST_EQUAL(res, true)
+
+  OnDiscPeakMap failed;
+  res = failed.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_3_broken.mzML"), true);
   TEST_EQUAL(res, false)
 }
 END_SECTION
@@ -148,10 +153,10 @@ START_SECTION((Size size() const))
 {
   OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
   OnDiscPeakMap tmp2; tmp2.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
-  OnDiscPeakMap failed; failed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
+  OnDiscPeakMap non_indexed; non_indexed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
   TEST_EQUAL(tmp.size(), 2);
   TEST_EQUAL(tmp2.size(), 2);
-  TEST_EQUAL(failed.size(), 0);
+  TEST_EQUAL(non_indexed.size(), 4);
 }
 END_SECTION
 
@@ -159,10 +164,10 @@ START_SECTION((bool empty() const))
 {
   OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
   OnDiscPeakMap tmp2; tmp2.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
-  OnDiscPeakMap failed; failed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
+  OnDiscPeakMap non_indexed; non_indexed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
   TEST_EQUAL(tmp.empty(), false);
   TEST_EQUAL(tmp2.empty(), false);
-  TEST_EQUAL(failed.empty(), true);
+  TEST_EQUAL(non_indexed.empty(), false);
 }
 END_SECTION
 
@@ -170,10 +175,10 @@ START_SECTION((Size getNrSpectra() const))
 {
   OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
   OnDiscPeakMap tmp2; tmp2.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
-  OnDiscPeakMap failed; failed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
+  OnDiscPeakMap non_indexed; non_indexed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
   TEST_EQUAL(tmp.getNrSpectra(), 2);
   TEST_EQUAL(tmp2.getNrSpectra(), 2);
-  TEST_EQUAL(failed.getNrSpectra(), 0);
+  TEST_EQUAL(non_indexed.getNrSpectra(), 4);
 }
 END_SECTION
 
@@ -181,10 +186,10 @@ START_SECTION((Size getNrChromatograms() const))
 {
   OnDiscPeakMap tmp; tmp.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"));
   OnDiscPeakMap tmp2; tmp2.openFile(OPENMS_GET_TEST_DATA_PATH("IndexedmzMLFile_1.mzML"), true);
-  OnDiscPeakMap failed; failed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
+  OnDiscPeakMap non_indexed; non_indexed.openFile(OPENMS_GET_TEST_DATA_PATH("MzMLFile_1.mzML"));
   TEST_EQUAL(tmp.getNrChromatograms(), 1);
   TEST_EQUAL(tmp2.getNrChromatograms(), 1);
-  TEST_EQUAL(failed.getNrChromatograms(), 0);
+  TEST_EQUAL(non_indexed.getNrChromatograms(), 2);
 }
 END_SECTION
 
@@ -273,6 +273,64 @@ START_SECTION((OpenSwath::SpectrumPtr OpenSwathScoring::fetchSpectrumSwath(std::
 }
 END_SECTION
 
+START_SECTION((void setSpectrumCache(const SpectrumCachePtr& cache)))
+{
+  PeakMap* eptr = new PeakMap;
+  MSSpectrum s;
+  s.emplace_back(20.0, 200.0);
+  s.setRT(10.0);
+  eptr->addSpectrum(s);
+  s.setRT(20.0);
+  eptr->addSpectrum(s);
+  s.setRT(30.0);
+  eptr->addSpectrum(s);
+  boost::shared_ptr<PeakMap > swath_map (eptr);
+  OpenSwath::SpectrumAccessPtr swath_ptr = SimpleOpenMSSpectraFactory::getSpectrumAccessOpenMSPtr(swath_map);
+
+  OpenSwathScoring sc;
+  OpenSwath_Scores_Usage su;
+  sc.initialize(1.0, 1, 0.005, 0.0, su, "resample");
+  TEST_EQUAL(sc.getSpectrumCache() != nullptr, true)
+
+  // repeated requests for the same spectra are served from the cache
+  OpenSwath::SpectrumPtr sp1 = sc.fetchSpectrumSwath(swath_ptr, 20.0, 3, 0, 0);
+  OpenSwath::SpectrumPtr sp2 = sc.fetchSpectrumSwath(swath_ptr, 21.0, 3, 0, 0);
+  TEST_EQUAL(sp1 == sp2, true)
+  TEST_EQUAL(sc.getSpectrumCache()->size(), 1)
+
+  // a different set of spectra or different settings are not
+  OpenSwath::SpectrumPtr sp3 = sc.fetchSpectrumSwath(swath_ptr, 30.0, 3, 0, 0);
+  TEST_EQUAL(sp1 == sp3, false)
+  sc.initialize(1.0, 1, 0.005, 0.0, su, "simple");
+  sp3 = sc.fetchSpectrumSwath(swath_ptr, 20.0, 3, 0, 0);
+  TEST_EQUAL(sp1 == sp3, false)
+  TEST_EQUAL(sp3->getMZArray()->data.size(), 3)
+  TEST_EQUAL(sc.getSpectrumCache()->size(), 3)
+
+  // a shared cache is used by several scoring objects and evicts old entries
+  OpenSwathScoring::SpectrumCachePtr cache(new OpenSwathScoring::SpectrumCache(1));
+  TEST_EQUAL(cache->getCapacity(), 1)
+  OpenSwathScoring sc2;
+  sc2.initialize(1.0, 1, 0.005, 0.0, su, "resample");
+  sc.setSpectrumCache(cache);
+  sc2.setSpectrumCache(cache);
+  sp3 = sc.fetchSpectrumSwath(swath_ptr, 20.0, 3, 0, 0);
+  TEST_EQUAL(sc2.fetchSpectrumSwath(swath_ptr, 20.0, 3, 0, 0) == sp3, false) // different addition method
+  TEST_EQUAL(cache->size(), 1)
+  sp1 = sc2.fetchSpectrumSwath(swath_ptr, 20.0, 3, 0, 0);
+  TEST_EQUAL(sc2.fetchSpectrumSwath(swath_ptr, 20.0, 3, 0, 0) == sp1, true)
+  cache->clear();
+  TEST_EQUAL(cache->size(), 0)
+
+  // without a cache, every request computes a new spectrum
+  sc2.setSpectrumCache(OpenSwathScoring::SpectrumCachePtr());
+  sp1 = sc2.fetchSpectrumSwath(swath_ptr, 20.0, 3, 0, 0);
+  sp2 = sc2.fetchSpectrumSwath(swath_ptr, 20.0, 3, 0, 0);
+  TEST_EQUAL(sp1 == sp2, false)
+  TEST_REAL_SIMILAR(sp1->getIntensityArray()->data[0], sp2->getIntensityArray()->data[0])
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
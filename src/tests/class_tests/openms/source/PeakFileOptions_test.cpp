@@ -246,6 +246,42 @@ START_SECTION(void setMaxDataPoolSize(Size size))
 }
 END_SECTION
 
+START_SECTION(Size getPipelineQueueDepth() const)
+{
+	PeakFileOptions tmp;
+	TEST_EQUAL(tmp.getPipelineQueueDepth()!=0,true);
+}
+END_SECTION
+
+START_SECTION(void setPipelineQueueDepth(Size depth))
+{
+	PeakFileOptions tmp;
+	tmp.setPipelineQueueDepth(0);
+	TEST_EQUAL(tmp.getPipelineQueueDepth(),0);
+	tmp.setPipelineQueueDepth(20);
+	TEST_EQUAL(tmp.getPipelineQueueDepth(),20);
+	PeakFileOptions copy(tmp);
+	TEST_EQUAL(copy.getPipelineQueueDepth(),20);
+}
+END_SECTION
+
+START_SECTION(Size getPipelineMemoryCap() const)
+{
+	PeakFileOptions tmp;
+	TEST_EQUAL(tmp.getPipelineMemoryCap()!=0,true);
+}
+END_SECTION
+
+START_SECTION(void setPipelineMemoryCap(Size bytes))
+{
+	PeakFileOptions tmp;
+	tmp.setPipelineMemoryCap(1024);
+	TEST_EQUAL(tmp.getPipelineMemoryCap(),1024);
+	PeakFileOptions copy(tmp);
+	TEST_EQUAL(copy.getPipelineMemoryCap(),1024);
+}
+END_SECTION
+
 
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
@@ -35,6 +35,7 @@
 #include <OpenMS/CONCEPT/ClassTest.h>
 #include <OpenMS/test_config.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
+#include <OpenMS/KERNEL/ColumnarMSExperiment.h>
 
 ///////////////////////////
 #include <OpenMS/TRANSFORMATIONS/RAW2PEAK/PeakPickerHiRes.h>
@@ -163,6 +164,21 @@ START_SECTION((template <typename PeakType, typename ChromatogramPeakT> void pic
   }
 END_SECTION
 
+START_SECTION(void pickExperiment(const ColumnarMSExperiment& input, PeakMap& output, const bool check_spectrum_type = true) const)
+  PeakMap tmp_exp;
+  pp_hires.pickExperiment(ColumnarMSExperiment(input), tmp_exp);
+
+  TEST_EQUAL(tmp_exp.size(), output.size())
+  for (Size scan_idx = 0; scan_idx < tmp_exp.size(); ++scan_idx)
+  {
+    for (Size peak_idx = 0; peak_idx < tmp_exp[scan_idx].size(); ++peak_idx)
+    {
+      TEST_REAL_SIMILAR(tmp_exp[scan_idx][peak_idx].getMZ(), output[scan_idx][peak_idx].getMZ())
+      TEST_REAL_SIMILAR(tmp_exp[scan_idx][peak_idx].getIntensity(), output[scan_idx][peak_idx].getIntensity())
+    }
+  }
+END_SECTION
+
 output.clear(true);
 
 ///////////////////////////////////////////
@@ -216,6 +232,22 @@ START_SECTION([EXTRA](template <typename PeakType> void pickExperiment(const MSE
   }
 END_SECTION
 
+START_SECTION([EXTRA] void pickExperiment(const ColumnarMSExperiment& input, PeakMap& output, const bool check_spectrum_type = true) const)
+  // with S/N estimation enabled, spectra are copied into an MSSpectrum before picking
+  PeakMap tmp_exp;
+  pp_hires.pickExperiment(ColumnarMSExperiment(input), tmp_exp);
+
+  TEST_EQUAL(tmp_exp.size(), output.size())
+  for (Size scan_idx = 0; scan_idx < tmp_exp.size(); ++scan_idx)
+  {
+    for (Size peak_idx = 0; peak_idx < tmp_exp[scan_idx].size(); ++peak_idx)
+    {
+      TEST_REAL_SIMILAR(tmp_exp[scan_idx][peak_idx].getMZ(), output[scan_idx][peak_idx].getMZ())
+      TEST_REAL_SIMILAR(tmp_exp[scan_idx][peak_idx].getIntensity(), output[scan_idx][peak_idx].getIntensity())
+    }
+  }
+END_SECTION
+
 output.clear(true);
 input.clear(true);
 //
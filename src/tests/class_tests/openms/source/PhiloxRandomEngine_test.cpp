@@ -0,0 +1,146 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+#include <OpenMS/SIMULATION/SimTypes.h>
+///////////////////////////
+
+#include <boost/random/normal_distribution.hpp>
+
+using namespace OpenMS;
+using namespace std;
+
+START_TEST(PhiloxRandomEngine, "$Id$")
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+
+SimTypes::PhiloxRandomEngine* ptr = nullptr;
+SimTypes::PhiloxRandomEngine* nullPointer = nullptr;
+
+START_SECTION((PhiloxRandomEngine(UInt64 key, UInt64 stream)))
+{
+  ptr = new SimTypes::PhiloxRandomEngine(0, 0);
+  TEST_NOT_EQUAL(ptr, nullPointer)
+  delete ptr;
+}
+END_SECTION
+
+START_SECTION((static void philox4x32(const UInt32 counter[4], const UInt32 key[2], UInt32 out[4])))
+{
+  // known answers of the Random123 reference implementation
+  UInt32 out[4];
+  const UInt32 c0[4] = {0, 0, 0, 0};
+  const UInt32 k0[2] = {0, 0};
+  SimTypes::PhiloxRandomEngine::philox4x32(c0, k0, out);
+  TEST_EQUAL(out[0], 0x6627e8d5u)
+  TEST_EQUAL(out[1], 0xe169c58du)
+  TEST_EQUAL(out[2], 0xbc57ac4cu)
+  TEST_EQUAL(out[3], 0x9b00dbd8u)
+
+  const UInt32 c1[4] = {0x243f6a88u, 0x85a308d3u, 0x13198a2eu, 0x03707344u};
+  const UInt32 k1[2] = {0xa4093822u, 0x299f31d0u};
+  SimTypes::PhiloxRandomEngine::philox4x32(c1, k1, out);
+  TEST_EQUAL(out[0], 0xd16cfe09u)
+  TEST_EQUAL(out[1], 0x94fdccebu)
+  TEST_EQUAL(out[2], 0x5001e420u)
+  TEST_EQUAL(out[3], 0x24126ea1u)
+}
+END_SECTION
+
+START_SECTION((result_type operator()()))
+{
+  // the first numbers of stream 0 with key 0 are the first block
+  SimTypes::PhiloxRandomEngine rng(0, 0);
+  TEST_EQUAL(rng(), 0x6627e8d5u)
+  TEST_EQUAL(rng(), 0xe169c58du)
+  TEST_EQUAL(rng(), 0xbc57ac4cu)
+  TEST_EQUAL(rng(), 0x9b00dbd8u)
+
+  // same key and stream give the same sequence, different streams differ
+  SimTypes::PhiloxRandomEngine a(42, 7), b(42, 7), c(42, 8), d(43, 7);
+  bool all_equal(true), any_equal_c(false), any_equal_d(false);
+  for (Size i = 0; i < 100; ++i)
+  {
+    UInt32 x = a();
+    all_equal &= (x == b());
+    any_equal_c |= (x == c());
+    any_equal_d |= (x == d());
+  }
+  TEST_EQUAL(all_equal, true)
+  TEST_EQUAL(any_equal_c, false)
+  TEST_EQUAL(any_equal_d, false)
+
+  // usable with Boost.Random distributions
+  SimTypes::PhiloxRandomEngine e(1, 1);
+  boost::normal_distribution<double> ndist(10.0, 1.0);
+  double sum(0);
+  for (Size i = 0; i < 10000; ++i) sum += ndist(e);
+  TOLERANCE_ABSOLUTE(0.1)
+  TEST_REAL_SIMILAR(sum / 10000, 10.0)
+}
+END_SECTION
+
+START_SECTION((void discard(UInt64 n)))
+{
+  for (Size n = 0; n < 11; ++n)
+  {
+    SimTypes::PhiloxRandomEngine a(5, 3), b(5, 3);
+    a(); b(); // start in the middle of a block
+    for (Size i = 0; i < n; ++i) a();
+    b.discard(n);
+    TEST_EQUAL(a(), b())
+    TEST_EQUAL(a(), b())
+  }
+}
+END_SECTION
+
+START_SECTION((static constexpr result_type min()))
+{
+  TEST_EQUAL(SimTypes::PhiloxRandomEngine::min(), 0u)
+}
+END_SECTION
+
+START_SECTION((static constexpr result_type max()))
+{
+  TEST_EQUAL(SimTypes::PhiloxRandomEngine::max(), 0xFFFFFFFFu)
+}
+END_SECTION
+
+/////////////////////////////////////////////////////////////
+/////////////////////////////////////////////////////////////
+END_TEST
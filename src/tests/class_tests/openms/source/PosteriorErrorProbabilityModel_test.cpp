@@ -144,6 +144,41 @@ START_SECTION((void fit( std::vector<double>& search_engine_scores, std::vector<
 	}
 }
 
+{
+	// starting the EM on a subsample must converge to the same fit on all scores
+	vector<double> rand_score_vector;
+	CsvFile gauss_mix (OPENMS_GET_TEST_DATA_PATH("GaussMix_2_1D.csv"), ';');
+	StringList gauss_mix_strings;
+	gauss_mix.getRow(0, gauss_mix_strings);
+	for (StringList::const_iterator it = gauss_mix_strings.begin(); it != gauss_mix_strings.end(); ++it)
+	{
+		if (!it->empty())
+		{
+			rand_score_vector.push_back(it->toDouble());
+		}
+	}
+
+	Param param;
+	param.setValue("incorrectly_assigned", "Gauss");
+	PosteriorErrorProbabilityModel full;
+	full.setParameters(param);
+	vector<double> full_scores(rand_score_vector);
+	TEST_EQUAL(full.fit(full_scores, "none"), true)
+
+	param.setValue("max_subsample_size", 200);
+	PosteriorErrorProbabilityModel subsampled;
+	subsampled.setParameters(param);
+	vector<double> subsampled_scores(rand_score_vector);
+	TEST_EQUAL(subsampled.fit(subsampled_scores, "none"), true)
+
+	TOLERANCE_ABSOLUTE(0.01)
+	TEST_REAL_SIMILAR(subsampled.getCorrectlyAssignedFitResult().x0, full.getCorrectlyAssignedFitResult().x0)
+	TEST_REAL_SIMILAR(subsampled.getCorrectlyAssignedFitResult().sigma, full.getCorrectlyAssignedFitResult().sigma)
+	TEST_REAL_SIMILAR(subsampled.getIncorrectlyAssignedFitResult().x0, full.getIncorrectlyAssignedFitResult().x0)
+	TEST_REAL_SIMILAR(subsampled.getIncorrectlyAssignedFitResult().sigma, full.getIncorrectlyAssignedFitResult().sigma)
+	TEST_REAL_SIMILAR(subsampled.getNegativePrior(), full.getNegativePrior())
+}
+
 {
 	vector<double> score_vector;
 	score_vector.push_back(-0.39);
@@ -0,0 +1,201 @@
+// --------------------------------------------------------------------------
+//                   OpenMS -- Open-Source Mass Spectrometry
+// --------------------------------------------------------------------------
+// Copyright The OpenMS Team -- Eberhard Karls University Tuebingen,
+// ETH Zurich, and Freie Universitaet Berlin 2002-2020.
+//
+// This software is released under a three-clause BSD license:
+//  * Redistributions of source code must retain the above copyright
+//    notice, this list of conditions and the following disclaimer.
+//  * Redistributions in binary form must reproduce the above copyright
+//    notice, this list of conditions and the following disclaimer in the
+//    documentation and/or other materials provided with the distribution.
+//  * Neither the name of any author or any participating institution
+//    may be used to endorse or promote products derived from this software
+//    without specific prior written permission.
+// For a full list of authors, refer to the file AUTHORS.
+// --------------------------------------------------------------------------
+// THIS SOFTWARE IS PROVIDED BY THE COPYRIGHT HOLDERS AND CONTRIBUTORS "AS IS"
+// AND ANY EXPRESS OR IMPLIED WARRANTIES, INCLUDING, BUT NOT LIMITED TO, THE
+// IMPLIED WARRANTIES OF MERCHANTABILITY AND FITNESS FOR A PARTICULAR PURPOSE
+// ARE DISCLAIMED. IN NO EVENT SHALL ANY OF THE AUTHORS OR THE CONTRIBUTING
+// INSTITUTIONS BE LIABLE FOR ANY DIRECT, INDIRECT, INCIDENTAL, SPECIAL,
+// EXEMPLARY, OR CONSEQUENTIAL DAMAGES (INCLUDING, BUT NOT LIMITED TO,
+// PROCUREMENT OF SUBSTITUTE GOODS OR SERVICES; LOSS OF USE, DATA, OR PROFITS;
+// OR BUSINESS INTERRUPTION) HOWEVER CAUSED AND ON ANY THEORY OF LIABILITY,
+// WHETHER IN CONTRACT, STRICT LIABILITY, OR TORT (INCLUDING NEGLIGENCE OR
+// OTHERWISE) ARISING IN ANY WAY OUT OF THE USE OF THIS SOFTWARE, EVEN IF
+// ADVISED OF THE POSSIBILITY OF SUCH DAMAGE.
+//
+// --------------------------------------------------------------------------
+// $Maintainer: Timo Sachsenberg $
+// $Authors: $
+// --------------------------------------------------------------------------
+
+#include <OpenMS/CONCEPT/ClassTest.h>
+#include <OpenMS/test_config.h>
+
+///////////////////////////
+
+#include <OpenMS/SYSTEM/Profiler.h>
+#include <OpenMS/CONCEPT/ProgressLogger.h>
+
+#include <sstream>
+
+///////////////////////////
+
+using namespace OpenMS;
+
+START_TEST(Profiler, "$Id$")
+
+Profiler& profiler = Profiler::getInstance();
+
+START_SECTION(static Profiler& getInstance())
+{
+  TEST_EQUAL(&Profiler::getInstance(), &profiler)
+}
+END_SECTION
+
+START_SECTION(static bool isEnabled())
+{
+  TEST_EQUAL(Profiler::isEnabled(), false)
+}
+END_SECTION
+
+START_SECTION(ScopedTimer(const char* name, const char* category, bool trace = true))
+{
+  // disabled: nothing is recorded
+  {
+    OPENMS_PROFILE_SCOPE("disabled", "test");
+    OPENMS_PROFILE_COUNT("disabled_counter", 1);
+  }
+  TEST_EQUAL(profiler.getEvents().size(), 0)
+  TEST_EQUAL(profiler.getCounters().size(), 0)
+
+  profiler.setEnabled(true);
+  TEST_EQUAL(Profiler::isEnabled(), true)
+  {
+    OPENMS_PROFILE_SCOPE("outer", "test");
+    for (Size i = 0; i < 3; ++i)
+    {
+      OPENMS_PROFILE_ACCUMULATE("inner", "test");
+    }
+  }
+  std::vector<Profiler::Event> events = profiler.getEvents();
+  TEST_EQUAL(events.size(), 1)
+  TEST_EQUAL(events[0].name, "outer")
+  TEST_EQUAL(events[0].category, "test")
+  TEST_EQUAL(events[0].phase, 'X')
+  TEST_EQUAL(events[0].duration_us >= 0.0, true)
+
+  std::map<String, Profiler::Summary> summary = profiler.getSummary();
+  TEST_EQUAL(summary.size(), 2)
+  TEST_EQUAL(summary["outer"].calls, 1)
+  TEST_EQUAL(summary["inner"].calls, 3)
+  TEST_EQUAL(summary["inner"].max_us <= summary["inner"].total_us, true)
+}
+END_SECTION
+
+START_SECTION(void addCounter(const String& name, Int64 delta = 1))
+{
+#pragma omp parallel for
+  for (SignedSize i = 0; i < 100; ++i)
+  {
+    OPENMS_PROFILE_COUNT("parallel", 2);
+  }
+  profiler.addCounter("single");
+  TEST_EQUAL(profiler.getCounters()["parallel"], 200)
+  TEST_EQUAL(profiler.getCounters()["single"], 1)
+}
+END_SECTION
+
+START_SECTION(void recordMemory(const String& label))
+{
+  profiler.recordMemory("probe");
+  std::vector<Profiler::Event> events = profiler.getEvents();
+  TEST_EQUAL(events.back().name, "probe")
+  TEST_EQUAL(events.back().phase, 'C')
+  TEST_EQUAL(profiler.getPeakMemory() >= Size(events.back().value), true)
+}
+END_SECTION
+
+START_SECTION([EXTRA] ProgressLogger integration)
+{
+  Size before = profiler.getEvents().size();
+  ProgressLogger pl;
+  pl.startProgress(0, 10, "progress region");
+  pl.endProgress();
+  std::vector<Profiler::Event> events = profiler.getEvents();
+  TEST_EQUAL(events.size() > before, true)
+  bool found = false;
+  for (const Profiler::Event& e : events)
+  {
+    if (e.name == "progress region" && e.category == "progress") found = true;
+  }
+  TEST_EQUAL(found, true)
+
+  // nothing is recorded for regions ending while the profiler is disabled,
+  // or starting before it was enabled
+  before = profiler.getEvents().size();
+  pl.startProgress(0, 10, "outer region");
+  profiler.setEnabled(false);
+  pl.startProgress(0, 10, "inner region");
+  profiler.setEnabled(true);
+  pl.endProgress();
+  profiler.setEnabled(false);
+  pl.endProgress();
+  profiler.setEnabled(true);
+  TEST_EQUAL(profiler.getEvents().size(), before)
+
+  // a region started while profiling is recorded, even if an enclosing one is not
+  profiler.setEnabled(false);
+  pl.startProgress(0, 10, "unprofiled outer region");
+  profiler.setEnabled(true);
+  pl.startProgress(0, 10, "profiled inner region");
+  pl.endProgress();
+  pl.endProgress();
+  found = false;
+  for (const Profiler::Event& e : profiler.getEvents())
+  {
+    TEST_NOT_EQUAL(e.name, "unprofiled outer region")
+    if (e.name == "profiled inner region" && e.category == "progress") found = true;
+  }
+  TEST_EQUAL(found, true)
+}
+END_SECTION
+
+START_SECTION(void writeTrace(std::ostream& os) const)
+{
+  profiler.addEvent("quote\"d", "test", 1.0, 2.0);
+  std::stringstream ss;
+  profiler.writeTrace(ss);
+  String trace = ss.str();
+  TEST_EQUAL(trace.hasPrefix("{\n\"traceEvents\": ["), true)
+  TEST_EQUAL(trace.hasSubstring("\"name\": \"quote\\\"d\""), true)
+  TEST_EQUAL(trace.hasSubstring("\"ph\": \"X\", \"ts\": 1.000, \"dur\": 2.000"), true)
+  TEST_EQUAL(trace.hasSubstring("\"parallel\": 200"), true)
+  TEST_EQUAL(trace.hasSubstring("\"peak_memory_kb\": "), true)
+}
+END_SECTION
+
+START_SECTION(void store(const String& filename) const)
+{
+  String filename;
+  NEW_TMP_FILE(filename)
+  profiler.store(filename);
+  TEST_EXCEPTION(Exception::UnableToCreateFile, profiler.store("/this/directory/does/not/exist/trace.json"))
+}
+END_SECTION
+
+START_SECTION(void clear())
+{
+  profiler.clear();
+  profiler.setEnabled(false);
+  TEST_EQUAL(profiler.getEvents().size(), 0)
+  TEST_EQUAL(profiler.getSummary().size(), 0)
+  TEST_EQUAL(profiler.getCounters().size(), 0)
+  TEST_EQUAL(profiler.getPeakMemory(), 0)
+}
+END_SECTION
+
+END_TEST
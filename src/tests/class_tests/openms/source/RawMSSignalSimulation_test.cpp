@@ -39,6 +39,14 @@
 #include <OpenMS/SIMULATION/RawMSSignalSimulation.h>
 ///////////////////////////
 
+#include <OpenMS/CHEMISTRY/AASequence.h>
+#include <OpenMS/CONCEPT/Constants.h>
+#include <OpenMS/DATASTRUCTURES/ListUtils.h>
+
+#ifdef _OPENMP
+#include <omp.h>
+#endif
+
 using namespace OpenMS;
 using namespace std;
 
@@ -95,7 +103,89 @@ END_SECTION
 
 START_SECTION((void generateRawSignals(SimTypes::FeatureMapSim &features, SimTypes::MSSimExperiment &experiment, SimTypes::MSSimExperiment &experiment_ct, SimTypes::FeatureMapSim &contaminants)))
 {
-  // TODO
+  // a small LC-MS run: 30 scans, one feature per peptide
+  SimTypes::MSSimExperiment exp_template;
+  ScanWindow sw;
+  sw.begin = 400.0;
+  sw.end = 600.0;
+  for (Size i = 0; i < 30; ++i)
+  {
+    SimTypes::MSSimExperiment::SpectrumType spec;
+    spec.setRT(10.0 * i);
+    spec.setMSLevel(1);
+    spec.setMetaValue("distortion", 1.0);
+    spec.getInstrumentSettings().getScanWindows().push_back(sw);
+    exp_template.addSpectrum(spec);
+  }
+
+  SimTypes::FeatureMapSim features_template;
+  const StringList peptides = ListUtils::create<String>("PEPTIDER,SAMPLERK,DFPIANGER,HVLTSIGEK");
+  for (Size i = 0; i < peptides.size(); ++i)
+  {
+    PeptideIdentification pep_id;
+    pep_id.insertHit(PeptideHit(0.0, 1, 2, AASequence::fromString(peptides[i])));
+    Feature f;
+    f.getPeptideIdentifications().push_back(pep_id);
+    f.setCharge(2);
+    f.setMZ((AASequence::fromString(peptides[i]).getMonoWeight() + 2 * Constants::PROTON_MASS_U) / 2.0);
+    f.setRT(50.0 + 30.0 * i);
+    f.setIntensity(1000.0 * (i + 1));
+    f.setMetaValue("charge_adducts", "H2");
+    f.setMetaValue("RT_egh_variance", 25.0);
+    f.setMetaValue("RT_egh_tau", 0.0);
+    features_template.push_back(f);
+  }
+
+  // enable all random components (low resolution keeps the sampling grid small)
+  Param p;
+  p.setValue("resolution:value", 10000);
+  p.setValue("contaminants:file", "");
+  p.setValue("variation:mz:error_stddev", 0.001);
+  p.setValue("variation:intensity:scale_stddev", 0.1);
+  p.setValue("noise:shot:rate", 1.0);
+  p.setValue("noise:white:stddev", 1.0);
+  p.setValue("noise:detector:mean", 1.0);
+  p.setValue("noise:detector:stddev", 0.5);
+
+  // the simulated signal does not depend on the number of threads
+  std::vector<SimTypes::MSSimExperiment> results;
+  std::vector<int> thread_counts(1, 1);
+#ifdef _OPENMP
+  const int num_threads = omp_get_max_threads();
+  thread_counts.push_back(std::max(num_threads, 4));
+#endif
+  for (int threads : thread_counts)
+  {
+#ifdef _OPENMP
+    omp_set_num_threads(threads);
+#endif
+    SimTypes::MutableSimRandomNumberGeneratorPtr rnd_gen(new SimTypes::SimRandomNumberGenerator);
+    rnd_gen->initialize(false, false);
+    RawMSSignalSimulation raw_sim(rnd_gen);
+    raw_sim.setParameters(p);
+
+    SimTypes::FeatureMapSim features(features_template), contaminants;
+    SimTypes::MSSimExperiment experiment(exp_template), experiment_ct(exp_template);
+    raw_sim.generateRawSignals(features, experiment, experiment_ct, contaminants);
+    results.push_back(experiment);
+  }
+#ifdef _OPENMP
+  omp_set_num_threads(num_threads);
+#endif
+
+  const SimTypes::MSSimExperiment& single = results[0];
+  TEST_EQUAL(single.size(), 30)
+  TEST_EQUAL(single.getSize() > 0, true)
+  for (Size r = 1; r < results.size(); ++r)
+  {
+    TEST_EQUAL(results[r].size(), single.size())
+    ABORT_IF(results[r].size() != single.size())
+    for (Size i = 0; i < single.size(); ++i)
+    {
+      TEST_EQUAL(results[r][i].size(), single[i].size())
+      TEST_EQUAL(results[r][i] == single[i], true)
+    }
+  }
 }
 END_SECTION
 
@@ -144,6 +144,29 @@ START_SECTION((template < typename MapType > void mergeSpectraPrecursors(MapType
     TEST_EQUAL(exp[i].getMSLevel (), exp2[i].getMSLevel ())
   }
 
+  // single linkage: chained precursors end up in one cluster, distant ones stay separate
+  {
+    PeakMap chain;
+    const double rts[] = {10.0, 14.0, 18.0, 30.0, 14.5};
+    const double mzs[] = {500.0, 500.00005, 500.0001, 500.0, 600.0};
+    for (Size i = 0; i < 5; ++i)
+    {
+      MSSpectrum s;
+      s.setMSLevel(2);
+      s.setRT(rts[i]);
+      Precursor pc;
+      pc.setMZ(mzs[i]);
+      s.setPrecursors(std::vector<Precursor>(1, pc));
+      Peak1D peak;
+      peak.setMZ(100.0 + i);
+      peak.setIntensity(1.0);
+      s.push_back(peak);
+      chain.addSpectrum(s);
+    }
+    merger.mergeSpectraPrecursors(chain);
+    TEST_EQUAL(chain.size(), 3)
+  }
+
 END_SECTION
 
 START_SECTION((template < typename MapType > void averageGaussian(MapType &exp)))
@@ -249,6 +249,62 @@ START_SECTION(void getAllSpectra(std::vector< OpenSwath::SpectrumPtr > & spectra
 }
 END_SECTION
 
+START_SECTION(void getSpectraById(const std::vector<int> & ids, std::vector< OpenSwath::SpectrumPtr > & spectra, std::vector< OpenSwath::SpectrumMeta > & spectra_meta) const)
+{
+  OpenMS::Internal::MzMLSqliteHandler handler(OPENMS_GET_TEST_DATA_PATH("SqliteMassFile_1.sqMass"));
+
+  // results are returned in the order requested, duplicates are allowed
+  {
+    ptr = new SpectrumAccessSqMass(handler);
+
+    std::vector<int> ids;
+    ids.push_back(1);
+    ids.push_back(0);
+    ids.push_back(1);
+
+    std::vector< OpenSwath::SpectrumPtr > spectra;
+    std::vector< OpenSwath::SpectrumMeta > spectra_meta;
+    ptr->getSpectraById(ids, spectra, spectra_meta);
+
+    TEST_EQUAL(spectra.size(), 3)
+    TEST_EQUAL(spectra_meta.size(), 3)
+
+    TEST_EQUAL(spectra[0]->getMZArray()->data.size(), 19800)
+    TEST_EQUAL(spectra[1]->getMZArray()->data.size(), 19914)
+    TEST_EQUAL(spectra[1]->getIntensityArray()->data.size(), 19914)
+    TEST_EQUAL(spectra[2]->getMZArray()->data.size(), 19800)
+    TEST_EQUAL(spectra_meta[0].id, spectra_meta[2].id)
+    TEST_NOT_EQUAL(spectra_meta[0].id, spectra_meta[1].id)
+
+    // out of range without a subset
+    ids.push_back((int)ptr->getNrSpectra());
+    TEST_EXCEPTION(Exception::IllegalArgument, ptr->getSpectraById(ids, spectra, spectra_meta))
+    delete ptr;
+  }
+
+  // ids refer to the subset of spectra of the interface
+  {
+    std::vector<int> indices;
+    indices.push_back(1);
+    ptr = new SpectrumAccessSqMass(handler, indices);
+
+    std::vector<int> ids;
+    ids.push_back(0);
+
+    std::vector< OpenSwath::SpectrumPtr > spectra;
+    std::vector< OpenSwath::SpectrumMeta > spectra_meta;
+    ptr->getSpectraById(ids, spectra, spectra_meta);
+
+    TEST_EQUAL(spectra.size(), 1)
+    TEST_EQUAL(spectra[0]->getMZArray()->data.size(), 19800)
+
+    ids.push_back(1);
+    TEST_EXCEPTION(Exception::IllegalArgument, ptr->getSpectraById(ids, spectra, spectra_meta))
+    delete ptr;
+  }
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -206,6 +206,33 @@ START_SECTION((static OpenMS::MSSpectrum addUpSpectra(std::vector< OpenMS::Spect
 }
 END_SECTION
 
+START_SECTION((static OpenMS::MSSpectrum addUpSpectra(std::vector<OpenMS::MSSpectrum>&& all_spectra, double sampling_rate, bool filter_zeros)))
+{
+  MSSpectrum s1;
+  s1.push_back(Peak1D(100.0, 1.0));
+  s1.push_back(Peak1D(101.0, 2.0));
+  MSSpectrum s2;
+  s2.push_back(Peak1D(100.0, 3.0));
+  s2.push_back(Peak1D(101.0, 4.0));
+
+  // a single spectrum is passed through unchanged
+  std::vector<MSSpectrum> single(1, s1);
+  MSSpectrum result = SpectrumAddition::addUpSpectra(std::move(single), 0.1, true);
+  TEST_EQUAL(result == s1, true);
+
+  // multiple spectra give the same result as the const reference overload
+  std::vector<MSSpectrum> all_spectra;
+  all_spectra.push_back(s1);
+  all_spectra.push_back(s2);
+  MSSpectrum expected = SpectrumAddition::addUpSpectra(all_spectra, 0.1, true);
+  result = SpectrumAddition::addUpSpectra(std::move(all_spectra), 0.1, true);
+  TEST_EQUAL(result.size(), expected.size());
+  TEST_EQUAL(result.size(), 2);
+  TEST_REAL_SIMILAR(result[0].getIntensity(), 4.0);
+  TEST_REAL_SIMILAR(result[1].getIntensity(), 6.0);
+}
+END_SECTION
+
 /////////////////////////////////////////////////////////////
 /////////////////////////////////////////////////////////////
 END_TEST
@@ -382,6 +382,8 @@ protected:
 
       std::cout << "Checking mzML file for valid indices ... " << std::endl;
       Internal::IndexedMzMLHandler ifile;
+      // only accept the index stored in the file
+      ifile.setIndexReconstruction(false);
       ifile.openFile(in);
       if (ifile.getParsingSuccess())
       {
@@ -37,6 +37,9 @@
 #include <OpenMS/MATH/STATISTICS/PosteriorErrorProbabilityModel.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
 
+#include <exception>
+#include <memory>
+
 using namespace OpenMS;
 using namespace Math; //PosteriorErrorProbabilityModel
 using namespace std;
@@ -81,6 +84,8 @@ using namespace std;
     If parameter @p top_hits_only is set, only the top hits of each peptide identification are used for the estimation process.
     Additionally, if 'top_hits_only' is set, target/decoy information is available and a @ref TOPP_FalseDiscoveryRate run was performed previously, an additional plot will be generated with target and decoy bins ('out_plot' must not be empty).
     A peptide hit is assumed to be a target if its q-value is smaller than @p fdr_for_targets_smaller.
+    Models for different search engines (and charge states, if @p split_charge is set) are fitted in parallel, unless plots are requested.
+    For very large inputs, the 'max_subsample_size' parameter of the fit algorithm starts the fit on a subsample of the scores.
     The plots are saved as a Gnuplot file. An attempt is made to call Gnuplot, which will create a PDF file containing all steps of the estimation. If this fails, the user has to run Gnuplot manually - or adjust the PATH environment such that Gnuplot can be found and retry.
 
     @note Currently mzIdentML (mzid) is not directly supported as an input/output format of this tool. Convert mzid files to/from idXML using @ref TOPP_IDFileConverter if necessary.
@@ -168,8 +173,6 @@ protected:
     vector<ProteinIdentification> protein_ids;
     vector<PeptideIdentification> peptide_ids;
     file.load(inputfile_name, protein_ids, peptide_ids);
-    PosteriorErrorProbabilityModel PEP_model;
-    PEP_model.setParameters(fit_algorithm);
     //-------------------------------------------------------------
     // calculations
     //-------------------------------------------------------------
@@ -206,26 +209,60 @@ protected:
 
     String out_plot = fit_algorithm.getValue("out_plot").toString().trim();
 
-    for (auto & score : all_scores)
-    {
-      vector<String> engine_info;
-      score.first.split(',', engine_info);
-      String engine = engine_info[0];
-      Int charge = (engine_info.size() == 2) ? engine_info[1].toInt() : -1;
+    // the models of different engines/charge states are independent, so they can be fitted concurrently;
+    // writing the plots is not thread-safe, so fit sequentially if plots are requested
+    vector<map<String, vector<vector<double> > >::iterator> entries;
+    for (auto it = all_scores.begin(); it != all_scores.end(); ++it) { entries.push_back(it); }
 
-      if (split_charge)
+    vector<std::unique_ptr<PosteriorErrorProbabilityModel> > PEP_models(entries.size());
+    vector<int> fitted(entries.size(), 0);
+    for (Size i = 0; i < entries.size(); ++i)
+    {
+      PEP_models[i].reset(new PosteriorErrorProbabilityModel());
+      if (split_charge && !out_plot.empty())
       {
         // only adapt plot output if plot is requested (this badly violates the output rules and needs to change!)
         // one way to fix this: plot charges into a single file (no renaming of output file needed) - but this requires major code restructuring
-        if (!out_plot.empty()) fit_algorithm.setValue("out_plot", out_plot + "_charge_" + String(charge));
-        PEP_model.setParameters(fit_algorithm);
+        const String& key = entries[i]->first;
+        fit_algorithm.setValue("out_plot", out_plot + "_charge_" + key.suffix(','));
       }
+      PEP_models[i]->setParameters(fit_algorithm);
+    }
+
+    std::exception_ptr fit_exception;
+#ifdef _OPENMP
+#pragma omp parallel for schedule(dynamic) if (out_plot.empty())
+#endif
+    for (SignedSize i = 0; i < (SignedSize)entries.size(); ++i)
+    {
+      try
+      {
+        // fit to score vector
+        //TODO choose outlier handling based on search engine? If not set by user?
+        //XTandem is prone to accumulation at min values/censoring
+        //OMSSA is prone to outliers
+        fitted[i] = PEP_models[i]->fit(entries[i]->second[0], outlier_handling);
+      }
+      catch (...)
+      {
+#ifdef _OPENMP
+#pragma omp critical (IDPosteriorErrorProbability_fit)
+#endif
+        if (!fit_exception) { fit_exception = std::current_exception(); }
+      }
+    }
+    if (fit_exception) { std::rethrow_exception(fit_exception); }
+
+    for (Size i = 0; i < entries.size(); ++i)
+    {
+      auto & score = *entries[i];
+      PosteriorErrorProbabilityModel & PEP_model = *PEP_models[i];
+      vector<String> engine_info;
+      score.first.split(',', engine_info);
+      String engine = engine_info[0];
+      Int charge = (engine_info.size() == 2) ? engine_info[1].toInt() : -1;
 
-      // fit to score vector
-      //TODO choose outlier handling based on search engine? If not set by user?
-      //XTandem is prone to accumulation at min values/censoring
-      //OMSSA is prone to outliers
-      bool return_value = PEP_model.fit(score.second[0], outlier_handling);
+      bool return_value = (fitted[i] != 0);
 
       if (!return_value) 
       {
@@ -845,13 +845,12 @@ protected:
         auto n_ind_prot = consensus.getProteinIdentifications()[0].getIndistinguishableProteins().size();
         cout << "MzTab Export: " << n_ind_prot << endl;
 */
-        // fill MzTab with meta data and quants annotated in identification data structure
+        // export meta data and quants annotated in identification data structure
 
         const bool report_unmapped(true);
         const bool report_unidentified_features(false);
         const bool report_subfeatures(false);
-        MzTab m = MzTab::exportConsensusMapToMzTab(consensus, in, !inference_in_cxml, report_unidentified_features, report_unmapped, report_subfeatures);
-        MzTabFile().store(mztab, m);
+        MzTabFile().storeConsensusMap(mztab, consensus, !inference_in_cxml, report_unidentified_features, report_unmapped, report_subfeatures);
       }
     }
 
@@ -37,16 +37,21 @@
 #include <OpenMS/CHEMISTRY/ModificationsDB.h>
 #include <OpenMS/CONCEPT/LogStream.h>
 #include <OpenMS/CONCEPT/Factory.h>
+#include <OpenMS/COMPARISON/SPECTRA/BinnedSpectralLibrary.h>
 #include <OpenMS/COMPARISON/SPECTRA/BinnedSpectrum.h>
 #include <OpenMS/COMPARISON/SPECTRA/SpectraSTSimilarityScore.h>
 #include <OpenMS/COMPARISON/SPECTRA/ZhangSimilarityScore.h>
 #include <OpenMS/FORMAT/IdXMLFile.h>
+#include <OpenMS/SYSTEM/File.h>
 #include <OpenMS/FORMAT/MSPFile.h>
 #include <OpenMS/FORMAT/MzMLFile.h>
 #include <OpenMS/KERNEL/MSExperiment.h>
 #include <OpenMS/MATH/MISC/MathFunctions.h>
 #include <OpenMS/METADATA/PeptideIdentification.h>
 
+#include <QtCore/QDateTime>
+#include <QtCore/QFileInfo>
+
 #include <ctime>
 #include <vector>
 #include <map>
@@ -77,6 +82,13 @@ using namespace std;
     </table>
 </CENTER>
 
+    With @p compare_function set to @p BinnedSpectralContrastAngle, the library is binned into a single sparse matrix
+    sorted by precursor m/z (see BinnedSpectralLibrary) and all query spectra of an input file are scored in
+    multithreaded blocks by sparse matrix products. The binned library can be cached with @p binned_library, which
+    avoids parsing and binning the MSP library in subsequent runs with the same library. The cache file records the
+    size and modification time of the MSP library and the binning and preprocessing parameters; it is rebuilt if any
+    of them changed.
+
     @experimental This TOPP-tool is not well tested and not all features might be properly implemented and tested.
 
     @note Currently mzIdentML (mzid) is not directly supported as an input/output format of this tool. Convert mzid files to/from idXML using @ref TOPP_IDFileConverter if necessary.
@@ -138,7 +150,16 @@ protected:
 
     registerStringOption_("compare_function", "<string>", "ZhangSimilarityScore", "function for similarity comparison", false);
     PeakSpectrumCompareFunctor::registerChildren();
-    setValidStrings_("compare_function", Factory<PeakSpectrumCompareFunctor>::registeredProducts());
+    StringList compare_functions = Factory<PeakSpectrumCompareFunctor>::registeredProducts();
+    compare_functions.push_back("BinnedSpectralContrastAngle");
+    setValidStrings_("compare_function", compare_functions);
+
+    registerStringOption_("binned_library", "<file>", "", "Cache file of the binned library (only used with compare_function 'BinnedSpectralContrastAngle'). Loaded instead of the MSP library if it exists and is up to date, otherwise (re-)created from it.", false, true);
+    registerDoubleOption_("fragment:bin_size", "<size>", BinnedSpectrum::DEFAULT_BIN_WIDTH_LOWRES, "Bin size (Th) used to bin spectra for compare_function 'BinnedSpectralContrastAngle'.", false, true);
+    setMinFloat_("fragment:bin_size", 1e-4);
+    registerDoubleOption_("fragment:bin_offset", "<offset>", BinnedSpectrum::DEFAULT_BIN_OFFSET_LOWRES, "Bin offset used to bin spectra for compare_function 'BinnedSpectralContrastAngle'.", false, true);
+    setMinFloat_("fragment:bin_offset", 0.0);
+    setMaxFloat_("fragment:bin_offset", 1.0);
 
     registerTOPPSubsection_("report", "Reporting Options");
     registerIntOption_("report:top_hits", "<num>", 10, "Maximum number of top scoring hits per spectrum that are reported.", false, true);
@@ -164,7 +185,26 @@ protected:
   }
 
   using MapLibraryPrecursorToLibrarySpectrum = multimap<double, PeakSpectrum>;
+
+  /// query (and isotope correction) scored in a batch against the binned library
+  struct BatchTarget
+  {
+    Size pid_index; ///< index of the PeptideIdentification receiving the hits
+    UInt query_index; ///< index of the query spectrum
+    Int query_charge;
+    Int isotope;
+  };
     
+  /// describes the library file and the parameters that determine the content of the binned library
+  String binnedLibraryFingerprint_(const String& in_lib, float remove_peaks_below_threshold, const StringList& variable_modifications, const StringList& fixed_modifications) const
+  {
+    QFileInfo fi(in_lib.toQString());
+    return File::absolutePath(in_lib) + "|" + String(fi.size()) + "|" + String(fi.lastModified().toMSecsSinceEpoch()) +
+           "|threshold=" + String(remove_peaks_below_threshold) +
+           "|variable=" + ListUtils::concatenate(variable_modifications, ",") +
+           "|fixed=" + ListUtils::concatenate(fixed_modifications, ",");
+  }
+
   MapLibraryPrecursorToLibrarySpectrum annotateIdentificationsToSpectra_(const vector<PeptideIdentification>& ids, 
     const PeakMap& library, 
     StringList variable_modifications, 
@@ -300,6 +340,9 @@ protected:
     StringList fixed_modifications = getStringList_("modifications:fixed");
     StringList variable_modifications = getStringList_("modifications:variable");
 
+    const bool binned_search = compare_function == "BinnedSpectralContrastAngle";
+    String binned_library_file = getStringOption_("binned_library");
+
     if (top_hits < -1)
     {
       writeLog_("top_hits (should be  >= -1 )");
@@ -330,35 +373,122 @@ protected:
 
     // library containing already identified peptide spectra
     vector<PeptideIdentification> ids;
-    spectral_library.load(in_lib, ids, library);
-
-    /*
-    // Output bin histogram
-    BinnedSpectrum bin_frequency(0.01, 1, PeakSpectrum());
-    for (auto const & s : library)
+    MapLibraryPrecursorToLibrarySpectrum mslib;
+    const float bin_size = getDoubleOption_("fragment:bin_size");
+    const float bin_offset = getDoubleOption_("fragment:bin_offset");
+    BinnedSpectralLibrary binned_lib(bin_size, false, 0, bin_offset);
+    binned_lib.setLogType(log_type_);
+    String fingerprint;
+
+    // library hit of each row of the binned library
+    vector<PeptideHit> binned_lib_hits;
+
+    bool use_binned_cache = false;
+    if (binned_search && !binned_library_file.empty())
     {
-      BinnedSpectrum b(0.01, 1, s);
-      // e.g.: bin_frequency.getBins() += b.getBins();  // sum up itensities
-      // e.g.: bin_frequency.getBins() += b.getBins().coeffs().cwiseMin(1.0f); // count occupied bins (by truncating intensities >= 1 to 1)
+      fingerprint = binnedLibraryFingerprint_(in_lib, remove_peaks_below_threshold, variable_modifications, fixed_modifications);
+      if (File::exists(binned_library_file))
+      {
+        OPENMS_LOG_INFO << "Loading binned library from '" << binned_library_file << "'." << endl;
+        try
+        {
+          binned_lib.load(binned_library_file);
+          use_binned_cache = binned_lib.getSourceFingerprint() == fingerprint &&
+                             binned_lib.getBinSize() == bin_size && binned_lib.getOffset() == bin_offset;
+          if (!use_binned_cache)
+          {
+            OPENMS_LOG_INFO << "The binned library does not match the library file or parameters. Rebuilding it." << endl;
+          }
+        }
+        catch (Exception::ParseError& e)
+        {
+          OPENMS_LOG_WARN << "Warning: the binned library could not be read (" << e.what() << "). Rebuilding it." << endl;
+        }
+        if (!use_binned_cache)
+        {
+          binned_lib = BinnedSpectralLibrary(bin_size, false, 0, bin_offset);
+          binned_lib.setLogType(log_type_);
+        }
+      }
     }
 
-    for (BinnedSpectrum::SparseVectorIteratorType it(bin_frequency.getBins()); it; ++it)
+    if (!use_binned_cache)
     {
-      // output m/z of bin start and average bin intensity
-      cout << it.index() * bin_frequency.getBinSize()  << "\t" << static_cast<float>(it.value()/library.size()) << "\n";
-      cout << static_cast<float>(it.value()) << "\n";
-      cout << static_cast<float>(library.size()) << "\n";
+      spectral_library.load(in_lib, ids, library);
+
+      /*
+      // Output bin histogram
+      BinnedSpectrum bin_frequency(0.01, 1, PeakSpectrum());
+      for (auto const & s : library)
+      {
+        BinnedSpectrum b(0.01, 1, s);
+        // e.g.: bin_frequency.getBins() += b.getBins();  // sum up itensities
+        // e.g.: bin_frequency.getBins() += b.getBins().coeffs().cwiseMin(1.0f); // count occupied bins (by truncating intensities >= 1 to 1)
+      }
+
+      for (BinnedSpectrum::SparseVectorIteratorType it(bin_frequency.getBins()); it; ++it)
+      {
+        // output m/z of bin start and average bin intensity
+        cout << it.index() * bin_frequency.getBinSize()  << "\t" << static_cast<float>(it.value()/library.size()) << "\n";
+        cout << static_cast<float>(it.value()) << "\n";
+        cout << static_cast<float>(library.size()) << "\n";
+      }
+      cout << endl;
+      */
+
+      mslib = annotateIdentificationsToSpectra_(ids, library, variable_modifications, fixed_modifications, remove_peaks_below_threshold);
+
+      if (binned_search)
+      {
+        // charge and sequence of the library hit are stored with each row of the binned library
+        vector<PeakSpectrum> lib_spectra;
+        vector<String> lib_identifiers;
+        vector<PeptideHit> lib_hits;
+        lib_spectra.reserve(mslib.size());
+        lib_identifiers.reserve(mslib.size());
+        lib_hits.reserve(mslib.size());
+        for (auto& entry : mslib)
+        {
+          lib_hits.push_back(entry.second.getPeptideIdentifications()[0].getHits()[0]);
+          const Int charge = lib_hits.back().getCharge();
+          lib_identifiers.push_back(lib_hits.back().getSequence().toString());
+          lib_spectra.push_back(std::move(entry.second));
+          lib_spectra.back().getPrecursors()[0].setCharge(charge);
+        }
+        mslib.clear();
+        library.clear(true);
+        binned_lib.build(lib_spectra, lib_identifiers);
+
+        // rows are sorted by precursor m/z, map them back to the library hits
+        binned_lib_hits.reserve(binned_lib.size());
+        for (Size input_index : binned_lib.getInputIndices())
+        {
+          binned_lib_hits.push_back(std::move(lib_hits[input_index]));
+        }
+
+        if (!binned_library_file.empty())
+        {
+          binned_lib.setSourceFingerprint(fingerprint);
+          binned_lib.store(binned_library_file);
+        }
+      }
     }
-    cout << endl;
-    */
 
-    MapLibraryPrecursorToLibrarySpectrum mslib = annotateIdentificationsToSpectra_(ids, library, variable_modifications, fixed_modifications, remove_peaks_below_threshold);
+    else if (binned_search)
+    {
+      // the cache stores everything MSPFile reads for a library hit: sequence and charge
+      binned_lib_hits.reserve(binned_lib.size());
+      for (Size row = 0; row < binned_lib.size(); ++row)
+      {
+        binned_lib_hits.emplace_back(0, 0, binned_lib.getPrecursorCharges()[row], AASequence::fromString(binned_lib.getIdentifiers()[row]));
+      }
+    }
 
     time_t end_build_time = time(nullptr);
     OPENMS_LOG_INFO << "Time needed for preprocessing data: " << (end_build_time - start_build_time) << "\n";
 
     //compare function
-    PeakSpectrumCompareFunctor* comparor = Factory<PeakSpectrumCompareFunctor>::create(compare_function);
+    PeakSpectrumCompareFunctor* comparor = binned_search ? nullptr : Factory<PeakSpectrumCompareFunctor>::create(compare_function);
  
    //-------------------------------------------------------------
     // calculations
@@ -400,6 +530,11 @@ protected:
       prot_id.setSearchParameters(search_parameters);
 
 
+      // queries collected for batched scoring against the binned library
+      vector<BinnedSpectrum> batch_queries;
+      vector<BinnedSpectralLibrary::RowRange> batch_ranges;
+      vector<BatchTarget> batch_targets;
+
       /***********SEARCH**********/
       for (UInt j = 0; j < query.size(); ++j)
       {
@@ -458,6 +593,13 @@ protected:
         
         if (query_charge > 0 && (query_charge < pc_min_charge || query_charge > pc_max_charge)) { continue; } 
 
+        // bin the query once for all isotope corrections
+        BinnedSpectrum binned_query;
+        if (binned_search)
+        {
+          binned_query = binned_lib.binSpectrum(filtered_query);
+        }
+
         for (auto const & iso : isotopes)
         {
           // isotopic misassignment corrected query
@@ -491,6 +633,15 @@ protected:
           */
 
 
+          // defer scoring to one batched search over all queries
+          if (binned_search)
+          {
+            batch_queries.push_back(binned_query);
+            batch_ranges.push_back(binned_lib.getPrecursorRange(ic_query_mz - 0.5 * precursor_mass_tolerance_mz, ic_query_mz + 0.5 * precursor_mass_tolerance_mz));
+            batch_targets.push_back(BatchTarget{peptide_ids.size(), j, query_charge, iso});
+            continue;
+          }
+
           // determine MS2 precursors that match to the current peptide mass
           MapLibraryPrecursorToLibrarySpectrum::const_iterator low_it, up_it;
         
@@ -577,6 +728,45 @@ protected:
         }
         peptide_ids.push_back(pid);
       }
+
+      if (binned_search)
+      {
+        vector<vector<double> > batch_scores;
+        binned_lib.scoreBatch(batch_queries, batch_ranges, batch_scores);
+
+        for (Size k = 0; k < batch_targets.size(); ++k)
+        {
+          const BatchTarget& target = batch_targets[k];
+          const BinnedSpectralLibrary::RowRange& range = batch_ranges[k];
+          PeptideIdentification& pid = peptide_ids[target.pid_index];
+
+          for (Size row = range.first; row < range.second; ++row)
+          {
+            // check if charge state between library and experimental spectrum match
+            if (target.query_charge > 0 && binned_lib_hits[row].getCharge() != target.query_charge) { continue; }
+
+            PeptideHit hit = binned_lib_hits[row];
+            hit.setScore(batch_scores[k][row - range.first]);
+            hit.setMetaValue("lib:RT", binned_lib.getRTs()[row]);
+            hit.setMetaValue("lib:MZ", binned_lib.getPrecursorMZs()[row]);
+            hit.setMetaValue(Constants::UserParam::ISOTOPE_ERROR, target.isotope);
+            PeptideEvidence pe;
+            pe.setProteinAccession(String(target.query_index));
+            hit.addPeptideEvidence(pe);
+            pid.insertHit(hit);
+          }
+
+          // finalize once all isotope corrections of this query are scored
+          if (k + 1 == batch_targets.size() || batch_targets[k + 1].pid_index != target.pid_index)
+          {
+            pid.sort();
+            if (top_hits != -1 && (UInt)top_hits < pid.getHits().size())
+            {
+              pid.getHits().resize(top_hits);
+            }
+          }
+        }
+      }
       protein_ids.push_back(prot_id);
 
       //-------------------------------------------------------------
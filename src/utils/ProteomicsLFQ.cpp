@@ -1717,18 +1717,19 @@ protected:
       ConsensusXMLFile().store(getStringOption_("out_cxml"), consensus);
     }
 
-    // Fill MzTab with meta data and quants annotated in identification data structure
+    // Export meta data and quants annotated in identification data structure
+    // (streamed to disk, without building an MzTab object in memory)
     const bool report_unmapped(true);
     const bool report_unidentified_features(false);
+    const bool report_subfeatures(true);
 
-    MzTab m = MzTab::exportConsensusMapToMzTab(
-      consensus, 
-      String("null"),
+    MzTabFile().storeConsensusMap(
+      out,
+      consensus,
       true,
-      report_unidentified_features, 
+      report_unidentified_features,
       report_unmapped,
-      "Export from ProteomicsLFQ workflow in OpenMS.");
-    MzTabFile().store(out, m);
+      report_subfeatures);
 
     if (!out_msstats.empty())
     {